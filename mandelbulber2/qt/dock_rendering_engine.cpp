@@ -177,7 +177,7 @@ void cDockRenderingEngine::slotNetRenderClientListUpdate() const
 	{
 		QStringList header;
 		header << tr("Name") << tr("Host") << tr("CPUs") << tr("Status") << tr("Lines done")
-					 << tr("Actions");
+					 << tr("Frames done") << tr("Time per frame") << tr("Actions");
 		table->setColumnCount(header.size());
 		table->setHorizontalHeaderLabels(header);
 	}
@@ -236,7 +236,14 @@ void cDockRenderingEngine::slotNetRenderClientListUpdate(int i, int j) const
 			break;
 		}
 		case 4: cell->setText(QString::number(gNetRender->GetClient(i).linesRendered)); break;
-		case 5:
+		case 5: cell->setText(QString::number(gNetRender->GetClient(i).framesRendered)); break;
+		case 6:
+		{
+			double frameRenderTime = gNetRender->GetClient(i).frameRenderTime;
+			cell->setText(frameRenderTime > 0.0 ? QString("%1 s").arg(frameRenderTime, 0, 'f', 1) : "");
+			break;
+		}
+		case 7:
 		{
 			QFrame *frame = new QFrame;
 			QGridLayout *gridLayout = new QGridLayout;
@@ -50,9 +50,11 @@
 #include "files.h"
 #include "global_data.hpp"
 #include "headless.h"
+#include "image_save_queue.hpp"
 #include "initparameters.hpp"
 #include "interface.hpp"
 #include "netrender.hpp"
+#include "netrender_animation.hpp"
 #include "opencl_engine_render_fractal.h"
 #include "opencl_global.h"
 #include "render_job.hpp"
@@ -322,6 +324,9 @@ void cFlightAnimation::RecordFlight(bool continueRecording)
 
 	image->SetFastPreview(true);
 
+	// recorded frames are saved in background thread
+	cImageSaveQueue saveQueue(gMainInterface->mainWindow);
+
 	// vector for speed and rotation control
 	CVector3 cameraSpeed;
 	CVector3 cameraAcceleration;
@@ -493,13 +498,15 @@ void cFlightAnimation::RecordFlight(bool continueRecording)
 		const QString filename = GetFlightFilename(index);
 		const ImageFileSave::enumImageFileType fileType =
 			ImageFileSave::enumImageFileType(params->Get<int>("flight_animation_image_type"));
-		SaveImage(filename, fileType, image, gMainInterface->mainWindow);
+		saveQueue.Enqueue(filename, fileType, image);
 
 		gApplication->processEvents();
 
 		index++;
 	}
 
+	saveQueue.Flush();
+
 	if (!systemData.noGui && image->IsMainImage())
 	{
 		mainInterface->mainWindow->GetWidgetDockNavigation()->UnlockAllFunctions();
@@ -752,6 +759,10 @@ bool cFlightAnimation::RenderFlight(bool *stopRequest)
 		config.EnableNetRender();
 	}
 
+	// when whole frames are distributed between clients, every frame is rendered locally
+	const bool distributeFrames = cNetRenderAnimation::IsEnabled(params);
+	if (distributeFrames) config.DisableNetRender();
+
 	renderJob->Init(cRenderJob::flightAnim, config);
 	*stopRequest = false;
 
@@ -764,6 +775,9 @@ bool cFlightAnimation::RenderFlight(bool *stopRequest)
 		imageWidget->SetEnableClickModes(false);
 	}
 
+	// frames are saved in background while next frames are rendered
+	cImageSaveQueue saveQueue(gMainInterface->mainWindow);
+
 	try
 	{
 		const int startFrame = params->Get<int>("flight_first_to_render");
@@ -831,69 +845,96 @@ bool cFlightAnimation::RenderFlight(bool *stopRequest)
 			}
 		}
 
-		for (int index = 0; index < frames->GetNumberOfFrames(); ++index)
+		if (distributeFrames)
 		{
+			QMap<int, QString> frameFiles;
+			for (int index = 0; index < frames->GetNumberOfFrames(); ++index)
+			{
+				if (!frames->GetFrame(index).alreadyRendered)
+					frameFiles.insert(index, GetFlightFilename(index));
+			}
 
-			double percentDoneFrame;
-			if (unrenderedTotal > 0)
-				percentDoneFrame = (frames->GetUnrenderedTillIndex(index) * 1.0) / unrenderedTotal;
-			else
-				percentDoneFrame = 1.0;
-
-			const QString progressTxt = progressText.getText(percentDoneFrame);
+			cNetRenderAnimation netRenderAnimation(
+				params, fractalParams, frames, nullptr, image, renderJob.data(), stopRequest);
+			connect(&netRenderAnimation,
+				SIGNAL(updateProgressAndStatus(
+					const QString &, const QString &, double, cProgressText::enumProgressType)),
+				this,
+				SIGNAL(updateProgressAndStatus(
+					const QString &, const QString &, double, cProgressText::enumProgressType)));
 
-			// Skip already rendered frames
-			if (frames->GetFrame(index).alreadyRendered)
+			const ImageFileSave::enumImageFileType fileType =
+				ImageFileSave::enumImageFileType(params->Get<int>("flight_animation_image_type"));
+			if (!netRenderAnimation.RenderAndSave(frameFiles, fileType, &saveQueue)) throw false;
+		}
+		else
+		{
+			for (int index = 0; index < frames->GetNumberOfFrames(); ++index)
 			{
-				// int firstMissing = index;
-				while (index < frames->GetNumberOfFrames() && frames->GetFrame(index).alreadyRendered)
+
+				double percentDoneFrame;
+				if (unrenderedTotal > 0)
+					percentDoneFrame = (frames->GetUnrenderedTillIndex(index) * 1.0) / unrenderedTotal;
+				else
+					percentDoneFrame = 1.0;
+
+				const QString progressTxt = progressText.getText(percentDoneFrame);
+
+				// Skip already rendered frames
+				if (frames->GetFrame(index).alreadyRendered)
 				{
-					index++;
+					// int firstMissing = index;
+					while (index < frames->GetNumberOfFrames() && frames->GetFrame(index).alreadyRendered)
+					{
+						index++;
+					}
+					index--;
+					// qDebug() << QObject::tr("Skip already rendered frame(s) %1 -
+					// %2").arg(firstMissing).arg(index);
+					continue;
 				}
-				index--;
-				// qDebug() << QObject::tr("Skip already rendered frame(s) %1 -
-				// %2").arg(firstMissing).arg(index);
-				continue;
-			}
 
-			emit updateProgressAndStatus(QObject::tr("Animation start"),
-				QObject::tr("Frame %1 of %2").arg((index + 1)).arg(frames->GetNumberOfFrames()) + " "
-					+ progressTxt,
-				percentDoneFrame, cProgressText::progress_ANIMATION);
+				emit updateProgressAndStatus(QObject::tr("Animation start"),
+					QObject::tr("Frame %1 of %2").arg((index + 1)).arg(frames->GetNumberOfFrames()) + " "
+						+ progressTxt,
+					percentDoneFrame, cProgressText::progress_ANIMATION);
 
-			if (*stopRequest) throw false;
+				if (*stopRequest) throw false;
 
-			frames->GetFrameAndConsolidate(index, params, fractalParams);
+				frames->GetFrameAndConsolidate(index, params, fractalParams);
 
-			if (!systemData.noGui && image->IsMainImage())
-			{
-				mainInterface->SynchronizeInterface(params, fractalParams, qInterface::write);
+				if (!systemData.noGui && image->IsMainImage())
+				{
+					mainInterface->SynchronizeInterface(params, fractalParams, qInterface::write);
 
-				// show distance in statistics table
-				const double distance = mainInterface->GetDistanceForPoint(
-					params->Get<CVector3>("camera"), params, fractalParams);
-				mainInterface->mainWindow->GetWidgetDockStatistics()->UpdateDistanceToFractal(distance);
-			}
+					// show distance in statistics table
+					const double distance = mainInterface->GetDistanceForPoint(
+						params->Get<CVector3>("camera"), params, fractalParams);
+					mainInterface->mainWindow->GetWidgetDockStatistics()->UpdateDistanceToFractal(distance);
+				}
 
-			if (gNetRender->IsServer())
-			{
-				gNetRender->WaitForAllClientsReady(10.0);
-			}
+				if (gNetRender->IsServer())
+				{
+					gNetRender->WaitForAllClientsReady(10.0);
+				}
 
-			params->Set("frame_no", index);
+				params->Set("frame_no", index);
 
-			renderJob->UpdateParameters(params, fractalParams);
-			const int result = renderJob->Execute();
-			if (!result) throw false;
+				renderJob->UpdateParameters(params, fractalParams);
+				const int result = renderJob->Execute();
+				if (!result) throw false;
 
-			const QString filename = GetFlightFilename(index);
-			const ImageFileSave::enumImageFileType fileType =
-				ImageFileSave::enumImageFileType(params->Get<int>("flight_animation_image_type"));
-			SaveImage(filename, fileType, image, gMainInterface->mainWindow);
+				const QString filename = GetFlightFilename(index);
+				const ImageFileSave::enumImageFileType fileType =
+					ImageFileSave::enumImageFileType(params->Get<int>("flight_animation_image_type"));
+				saveQueue.Enqueue(filename, fileType, image);
 
-			gApplication->processEvents();
+				gApplication->processEvents();
+			}
 		}
 
+		saveQueue.Flush();
+
 		emit updateProgressAndStatus(QObject::tr("Animation finished"), progressText.getText(1.0), 1.0,
 			cProgressText::progress_IMAGE);
 		emit notifyRenderFlightRenderStatus(
@@ -902,6 +943,9 @@ bool cFlightAnimation::RenderFlight(bool *stopRequest)
 	}
 	catch (bool ex)
 	{
+		// already rendered frames are still saved
+		saveQueue.Flush();
+
 		QString resultStatus = QObject::tr("Rendering terminated");
 		if (ex) resultStatus += " - " + QObject::tr("Error occured, see log output");
 		emit updateProgressAndStatus(
@@ -48,8 +48,10 @@
 #include "files.h"
 #include "global_data.hpp"
 #include "headless.h"
+#include "image_save_queue.hpp"
 #include "interface.hpp"
 #include "netrender.hpp"
+#include "netrender_animation.hpp"
 #include "render_job.hpp"
 #include "render_window.hpp"
 #include "rendered_image_widget.hpp"
@@ -569,6 +571,10 @@ bool cKeyframeAnimation::RenderKeyframes(bool *stopRequest)
 		config.EnableNetRender();
 	}
 
+	// when whole frames are distributed between clients, every frame is rendered locally
+	const bool distributeFrames = cNetRenderAnimation::IsEnabled(params);
+	if (distributeFrames) config.DisableNetRender();
+
 	renderJob->Init(cRenderJob::keyframeAnim, config);
 
 	cProgressText progressText;
@@ -597,6 +603,9 @@ bool cKeyframeAnimation::RenderKeyframes(bool *stopRequest)
 		imageWidget->SetEnableClickModes(false);
 	}
 
+	// frames are saved in background while next frames are rendered
+	cImageSaveQueue saveQueue(gMainInterface->mainWindow);
+
 	try
 	{
 		// updating parameters
@@ -708,74 +717,105 @@ bool cKeyframeAnimation::RenderKeyframes(bool *stopRequest)
 
 		keyframes->ClearMorphCache();
 
-		// main loop for rendering of frames
-		for (int index = 0; index < keyframes->GetNumberOfFrames() - 1; ++index)
+		if (distributeFrames)
 		{
-			//-------------- rendering of interpolated keyframes ----------------
-			for (int subIndex = 0; subIndex < keyframes->GetFramesPerKeyframe(); subIndex++)
+			QMap<int, QString> frameFiles;
+			for (int index = 0; index < keyframes->GetNumberOfFrames() - 1; ++index)
 			{
-				// skip already rendered frame
-				if (keyframes->GetFrame(index).alreadyRenderedSubFrames[subIndex])
+				for (int subIndex = 0; subIndex < keyframes->GetFramesPerKeyframe(); subIndex++)
 				{
-					continue;
+					if (keyframes->GetFrame(index).alreadyRenderedSubFrames[subIndex]) continue;
+					frameFiles.insert(index * keyframes->GetFramesPerKeyframe() + subIndex,
+						GetKeyframeFilename(index, subIndex));
 				}
+			}
 
-				const int frameIndex = index * keyframes->GetFramesPerKeyframe() + subIndex;
+			cNetRenderAnimation netRenderAnimation(
+				params, fractalParams, nullptr, keyframes, image, renderJob.data(), stopRequest);
+			connect(&netRenderAnimation,
+				SIGNAL(updateProgressAndStatus(
+					const QString &, const QString &, double, cProgressText::enumProgressType)),
+				this,
+				SIGNAL(updateProgressAndStatus(
+					const QString &, const QString &, double, cProgressText::enumProgressType)));
+
+			const ImageFileSave::enumImageFileType fileType =
+				ImageFileSave::enumImageFileType(params->Get<int>("keyframe_animation_image_type"));
+			if (!netRenderAnimation.RenderAndSave(frameFiles, fileType, &saveQueue)) throw false;
+		}
+		else
+		{
+			// main loop for rendering of frames
+			for (int index = 0; index < keyframes->GetNumberOfFrames() - 1; ++index)
+			{
+				//-------------- rendering of interpolated keyframes ----------------
+				for (int subIndex = 0; subIndex < keyframes->GetFramesPerKeyframe(); subIndex++)
+				{
+					// skip already rendered frame
+					if (keyframes->GetFrame(index).alreadyRenderedSubFrames[subIndex])
+					{
+						continue;
+					}
 
-				double percentDoneFrame;
-				if (unrenderedTotal > 0)
-					percentDoneFrame =
-						(keyframes->GetUnrenderedTillIndex(frameIndex) * 1.0) / unrenderedTotal;
-				else
-					percentDoneFrame = 1.0;
+					const int frameIndex = index * keyframes->GetFramesPerKeyframe() + subIndex;
 
-				const QString progressTxt = progressText.getText(percentDoneFrame);
+					double percentDoneFrame;
+					if (unrenderedTotal > 0)
+						percentDoneFrame =
+							(keyframes->GetUnrenderedTillIndex(frameIndex) * 1.0) / unrenderedTotal;
+					else
+						percentDoneFrame = 1.0;
 
-				emit updateProgressAndStatus(QObject::tr("Rendering animation"),
-					QObject::tr("Frame %1 of %2 (key %3)").arg(frameIndex).arg(totalFrames).arg(index) + " "
-						+ progressTxt,
-					percentDoneFrame, cProgressText::progress_ANIMATION);
+					const QString progressTxt = progressText.getText(percentDoneFrame);
 
-				if (*stopRequest) throw false;
-				keyframes->GetInterpolatedFrameAndConsolidate(frameIndex, params, fractalParams);
+					emit updateProgressAndStatus(QObject::tr("Rendering animation"),
+						QObject::tr("Frame %1 of %2 (key %3)").arg(frameIndex).arg(totalFrames).arg(index) + " "
+							+ progressTxt,
+						percentDoneFrame, cProgressText::progress_ANIMATION);
 
-				// recalculation of camera rotation and distance (just for display purposes)
-				const CVector3 camera = params->Get<CVector3>("camera");
-				const CVector3 target = params->Get<CVector3>("target");
-				const CVector3 top = params->Get<CVector3>("camera_top");
-				cCameraTarget cameraTarget(camera, target, top);
-				params->Set("camera_rotation", cameraTarget.GetRotation() * 180.0 / M_PI);
-				params->Set("camera_distance_to_target", cameraTarget.GetDistance());
+					if (*stopRequest) throw false;
+					keyframes->GetInterpolatedFrameAndConsolidate(frameIndex, params, fractalParams);
 
-				if (!systemData.noGui && image->IsMainImage())
-				{
-					mainInterface->SynchronizeInterface(params, fractalParams, qInterface::write);
+					// recalculation of camera rotation and distance (just for display purposes)
+					const CVector3 camera = params->Get<CVector3>("camera");
+					const CVector3 target = params->Get<CVector3>("target");
+					const CVector3 top = params->Get<CVector3>("camera_top");
+					cCameraTarget cameraTarget(camera, target, top);
+					params->Set("camera_rotation", cameraTarget.GetRotation() * 180.0 / M_PI);
+					params->Set("camera_distance_to_target", cameraTarget.GetDistance());
 
-					// show distance in statistics table
-					const double distance = mainInterface->GetDistanceForPoint(
-						params->Get<CVector3>("camera"), params, fractalParams);
-					mainInterface->mainWindow->GetWidgetDockStatistics()->UpdateDistanceToFractal(distance);
-				}
+					if (!systemData.noGui && image->IsMainImage())
+					{
+						mainInterface->SynchronizeInterface(params, fractalParams, qInterface::write);
 
-				if (gNetRender->IsServer())
-				{
-					gNetRender->WaitForAllClientsReady(10.0);
-				}
+						// show distance in statistics table
+						const double distance = mainInterface->GetDistanceForPoint(
+							params->Get<CVector3>("camera"), params, fractalParams);
+						mainInterface->mainWindow->GetWidgetDockStatistics()->UpdateDistanceToFractal(distance);
+					}
 
-				params->Set("frame_no", frameIndex);
-				renderJob->UpdateParameters(params, fractalParams);
-				const int result = renderJob->Execute();
-				if (!result) throw false;
-				const QString filename = GetKeyframeFilename(index, subIndex);
-				const ImageFileSave::enumImageFileType fileType =
-					ImageFileSave::enumImageFileType(params->Get<int>("keyframe_animation_image_type"));
-				SaveImage(filename, fileType, image, gMainInterface->mainWindow);
+					if (gNetRender->IsServer())
+					{
+						gNetRender->WaitForAllClientsReady(10.0);
+					}
 
-				gApplication->processEvents();
+					params->Set("frame_no", frameIndex);
+					renderJob->UpdateParameters(params, fractalParams);
+					const int result = renderJob->Execute();
+					if (!result) throw false;
+					const QString filename = GetKeyframeFilename(index, subIndex);
+					const ImageFileSave::enumImageFileType fileType =
+						ImageFileSave::enumImageFileType(params->Get<int>("keyframe_animation_image_type"));
+					saveQueue.Enqueue(filename, fileType, image);
+
+					gApplication->processEvents();
+				}
+				//--------------------------------------------------------------------
 			}
-			//--------------------------------------------------------------------
 		}
 
+		saveQueue.Flush();
+
 		emit updateProgressAndStatus(QObject::tr("Animation finished"), progressText.getText(1.0), 1.0,
 			cProgressText::progress_IMAGE);
 		emit updateProgressHide();
@@ -784,6 +824,9 @@ bool cKeyframeAnimation::RenderKeyframes(bool *stopRequest)
 	}
 	catch (bool ex)
 	{
+		// already rendered frames are still saved
+		saveQueue.Flush();
+
 		QString resultStatus = QObject::tr("Rendering terminated");
 		if (ex) resultStatus += " - " + QObject::tr("Error occured, see log output");
 		emit updateProgressAndStatus(
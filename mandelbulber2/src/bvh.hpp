@@ -0,0 +1,161 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2026 Mandelbulber Team        §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * sBvhNode, BuildBvh(), TraverseBvh() - bounding volume hierarchy shared by primitives and lights
+ *
+ * Hierarchy is built over a list of item indices. Each range is split at the median of item
+ * centers along the longest axis, so leaves point to consecutive ranges of the reordered list.
+ * Bound type has to provide Distance(point), which is positive only outside the bound.
+ */
+
+#ifndef MANDELBULBER2_SRC_BVH_HPP_
+#define MANDELBULBER2_SRC_BVH_HPP_
+
+#include <algorithm>
+#include <cmath>
+
+#include <QVector>
+
+#include "algebra.hpp"
+
+// node of bounding volume hierarchy. Leaf nodes have count > 0 and point to range of items,
+// other nodes have two children
+template <typename Bound>
+struct sBvhNode
+{
+	Bound bound;
+	int first;
+	int count;
+	int left;
+	int right;
+};
+
+// builds node for items order[first] .. order[first + count - 1] and its children. Item i is
+// enclosed by sphere center(i), radius(i). makeBound(first, count, minCorner, maxCorner) creates
+// bound of node from the box enclosing all its items. Returns index of the node
+template <typename Bound, typename Center, typename Radius, typename MakeBound>
+int BuildBvh(QVector<sBvhNode<Bound>> *nodes, QVector<int> *order, int first, int count,
+	int maxItemsInLeaf, const Center &center, const Radius &radius, const MakeBound &makeBound)
+{
+	CVector3 minCorner(1e300, 1e300, 1e300);
+	CVector3 maxCorner(-1e300, -1e300, -1e300);
+	for (int i = first; i < first + count; i++)
+	{
+		const int item = order->at(i);
+		const CVector3 itemCenter = center(item);
+		const double itemRadius = fabs(radius(item));
+		minCorner.x = std::min(minCorner.x, itemCenter.x - itemRadius);
+		minCorner.y = std::min(minCorner.y, itemCenter.y - itemRadius);
+		minCorner.z = std::min(minCorner.z, itemCenter.z - itemRadius);
+		maxCorner.x = std::max(maxCorner.x, itemCenter.x + itemRadius);
+		maxCorner.y = std::max(maxCorner.y, itemCenter.y + itemRadius);
+		maxCorner.z = std::max(maxCorner.z, itemCenter.z + itemRadius);
+	}
+
+	sBvhNode<Bound> node;
+	node.bound = makeBound(first, count, minCorner, maxCorner);
+	node.first = first;
+	node.count = count;
+	node.left = -1;
+	node.right = -1;
+
+	const int nodeIndex = nodes->size();
+	nodes->append(node);
+
+	if (count > maxItemsInLeaf)
+	{
+		// split at median of centers along the longest axis
+		const CVector3 extent = maxCorner - minCorner;
+		const int axis =
+			(extent.x > extent.y && extent.x > extent.z) ? 0 : (extent.y > extent.z ? 1 : 2);
+		auto coordinate = [axis](const CVector3 &v) {
+			return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+		};
+		std::nth_element(order->begin() + first, order->begin() + first + count / 2,
+			order->begin() + first + count,
+			[&](int a, int b) { return coordinate(center(a)) < coordinate(center(b)); });
+
+		const int left =
+			BuildBvh(nodes, order, first, count / 2, maxItemsInLeaf, center, radius, makeBound);
+		const int right = BuildBvh(nodes, order, first + count / 2, count - count / 2,
+			maxItemsInLeaf, center, radius, makeBound);
+		(*nodes)[nodeIndex].count = 0;
+		(*nodes)[nodeIndex].left = left;
+		(*nodes)[nodeIndex].right = right;
+	}
+	return nodeIndex;
+}
+
+// visits leaves of hierarchy which can be relevant for the point. Nearer child is visited first.
+// Node is skipped when skip(distance to its bound) is true. skip() is called just before the
+// node is visited, so it can use results of already visited leaves.
+// visitLeaf(first, count) gets range of items of the leaf
+template <typename Bound, typename Skip, typename VisitLeaf>
+void TraverseBvh(
+	const QVector<sBvhNode<Bound>> &nodes, CVector3 point, const Skip &skip, VisitLeaf &&visitLeaf)
+{
+	if (nodes.isEmpty()) return;
+
+	// depth of balanced hierarchy is much lower than 64
+	int stack[64];
+	double stackDistance[64];
+	int stackSize = 0;
+	stack[stackSize] = 0;
+	stackDistance[stackSize] = nodes[0].bound.Distance(point);
+	stackSize++;
+
+	while (stackSize > 0)
+	{
+		stackSize--;
+		if (skip(stackDistance[stackSize])) continue;
+
+		const sBvhNode<Bound> &node = nodes[stack[stackSize]];
+		if (node.count > 0)
+		{
+			visitLeaf(node.first, node.count);
+		}
+		else
+		{
+			// the farther child is pushed first, so it is more likely to be skipped
+			const double leftDistance = nodes[node.left].bound.Distance(point);
+			const double rightDistance = nodes[node.right].bound.Distance(point);
+			const bool leftFirst = leftDistance < rightDistance;
+			stack[stackSize] = leftFirst ? node.right : node.left;
+			stackDistance[stackSize] = leftFirst ? rightDistance : leftDistance;
+			stackSize++;
+			stack[stackSize] = leftFirst ? node.left : node.right;
+			stackDistance[stackSize] = leftFirst ? leftDistance : rightDistance;
+			stackSize++;
+		}
+	}
+}
+
+#endif /* MANDELBULBER2_SRC_BVH_HPP_ */
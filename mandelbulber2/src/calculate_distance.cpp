@@ -38,6 +38,8 @@
 
 #include "calculate_distance.hpp"
 
+#include <vector>
+
 #include <QVector>
 
 #include "compute_fractal.hpp"
@@ -52,6 +54,96 @@
 
 using namespace std;
 
+static double LimitBoxDistance(const sParamRender &params, const CVector3 &point)
+{
+	const double distance_a = max(point.x - params.limitMax.x, -(point.x - params.limitMin.x));
+	const double distance_b = max(point.y - params.limitMax.y, -(point.y - params.limitMin.y));
+	const double distance_c = max(point.z - params.limitMax.z, -(point.z - params.limitMin.z));
+	return max(max(distance_a, distance_b), distance_c);
+}
+
+// distance to primitives, limits and minimum view distance
+static double FinalizeDistance(const sParamRender &params, const sDistanceIn &in, double distance,
+	double limitBoxDist, sDistanceOut *out, sRenderData *data)
+{
+	distance =
+		min(distance, params.primitives.TotalDistance(in.point, distance, &out->objectId, data));
+
+	//****************************************************
+
+	if (params.limitsEnabled)
+	{
+		if (limitBoxDist < in.detailSize)
+		{
+			distance = max(distance, limitBoxDist);
+		}
+	}
+
+	if (CheckNAN(distance)) // check if not a number
+	{
+		distance = 0.0;
+	}
+
+	const double distFromCamera = (in.point - params.camera).Length();
+	const double distanceLimitMin = params.viewDistanceMin - distFromCamera;
+	if (distanceLimitMin > in.detailSize)
+	{
+		out->maxiter = false;
+		out->objectId = 0;
+		out->iters = 0;
+	}
+
+	distance = max(distance, distanceLimitMin);
+
+	out->distance = distance;
+
+	return distance;
+}
+
+// corrections of distance calculated with analytic DE
+static double AnalyticDistance(
+	const sParamRender &params, const sDistanceIn &in, const sFractalOut &fractOut, sDistanceOut *out)
+{
+	double distance = fractOut.distance;
+	// qDebug() << "computed distance" << distance;
+	out->maxiter = fractOut.maxiter;
+	out->iters = fractOut.iters;
+	out->colorIndex = fractOut.colorIndex;
+	out->totalIters += fractOut.iters;
+
+	// if (distance < 1e-20) distance = 1e-20;
+
+	if (out->maxiter) distance = 0.0;
+
+	if (fractOut.iters < params.minN && distance < in.detailSize) distance = in.detailSize;
+
+	if (params.interiorMode && !in.normalCalculationMode)
+	{
+		if (distance < 0.5 * in.detailSize || fractOut.maxiter)
+		{
+			distance = in.detailSize;
+			out->maxiter = false;
+		}
+	}
+	else if (params.interiorMode && in.normalCalculationMode)
+	{
+		if (distance < 0.9 * in.detailSize)
+		{
+			distance = in.detailSize - distance;
+			out->maxiter = false;
+		}
+	}
+
+	if (params.common.iterThreshMode && !in.normalCalculationMode && !fractOut.maxiter)
+	{
+		if (distance < in.detailSize)
+		{
+			distance = in.detailSize * 1.01;
+		}
+	}
+	return distance;
+}
+
 double CalculateDistance(const sParamRender &params, const cNineFractals &fractals,
 	const sDistanceIn &in, sDistanceOut *out, sRenderData *data)
 {
@@ -62,13 +154,7 @@ double CalculateDistance(const sParamRender &params, const cNineFractals &fracta
 	double limitBoxDist = 0.0;
 	if (params.limitsEnabled)
 	{
-		const double distance_a =
-			max(in.point.x - params.limitMax.x, -(in.point.x - params.limitMin.x));
-		const double distance_b =
-			max(in.point.y - params.limitMax.y, -(in.point.y - params.limitMin.y));
-		const double distance_c =
-			max(in.point.z - params.limitMax.z, -(in.point.z - params.limitMin.z));
-		limitBoxDist = max(max(distance_a, distance_b), distance_c);
+		limitBoxDist = LimitBoxDistance(params, in.point);
 
 		if (limitBoxDist > in.detailSize)
 		{
@@ -192,38 +278,7 @@ double CalculateDistance(const sParamRender &params, const cNineFractals &fracta
 		distance = DisplacementMap(distance, pointFractalized, 0, data, reduceDisplacement);
 	}
 
-	distance =
-		min(distance, params.primitives.TotalDistance(in.point, distance, &out->objectId, data));
-
-	//****************************************************
-
-	if (params.limitsEnabled)
-	{
-		if (limitBoxDist < in.detailSize)
-		{
-			distance = max(distance, limitBoxDist);
-		}
-	}
-
-	if (CheckNAN(distance)) // check if not a number
-	{
-		distance = 0.0;
-	}
-
-	const double distFromCamera = (in.point - params.camera).Length();
-	const double distanceLimitMin = params.viewDistanceMin - distFromCamera;
-	if (distanceLimitMin > in.detailSize)
-	{
-		out->maxiter = false;
-		out->objectId = 0;
-		out->iters = 0;
-	}
-
-	distance = max(distance, distanceLimitMin);
-
-	out->distance = distance;
-
-	return distance;
+	return FinalizeDistance(params, in, distance, limitBoxDist, out, data);
 }
 
 double CalculateDistanceSimple(const sParamRender &params, const cNineFractals &fractals,
@@ -241,43 +296,7 @@ double CalculateDistanceSimple(const sParamRender &params, const cNineFractals &
 	if (fractals.GetDEType(forcedFormulaIndex) == fractal::analyticDEType)
 	{
 		Compute<fractal::calcModeNormal>(fractals, fractIn, &fractOut);
-		distance = fractOut.distance;
-		// qDebug() << "computed distance" << distance;
-		out->maxiter = fractOut.maxiter;
-		out->iters = fractOut.iters;
-		out->colorIndex = fractOut.colorIndex;
-		out->totalIters += fractOut.iters;
-
-		// if (distance < 1e-20) distance = 1e-20;
-
-		if (out->maxiter) distance = 0.0;
-
-		if (fractOut.iters < params.minN && distance < in.detailSize) distance = in.detailSize;
-
-		if (params.interiorMode && !in.normalCalculationMode)
-		{
-			if (distance < 0.5 * in.detailSize || fractOut.maxiter)
-			{
-				distance = in.detailSize;
-				out->maxiter = false;
-			}
-		}
-		else if (params.interiorMode && in.normalCalculationMode)
-		{
-			if (distance < 0.9 * in.detailSize)
-			{
-				distance = in.detailSize - distance;
-				out->maxiter = false;
-			}
-		}
-
-		if (params.common.iterThreshMode && !in.normalCalculationMode && !fractOut.maxiter)
-		{
-			if (distance < in.detailSize)
-			{
-				distance = in.detailSize * 1.01;
-			}
-		}
+		distance = AnalyticDistance(params, in, fractOut, out);
 	}
 	else
 	{
@@ -377,6 +396,72 @@ double CalculateDistanceSimple(const sParamRender &params, const cNineFractals &
 	return distance;
 }
 
+void CalculateDistanceBatch(const sParamRender &params, const cNineFractals &fractals,
+	const sDistanceBatchIn &in, sDistanceOut *out, sRenderData *data)
+{
+	// only single fractal with analytic DE can be calculated in batch. Others point by point
+	if (params.booleanOperatorsEnabled || fractals.GetDEType(-1) != fractal::analyticDEType)
+	{
+		for (int i = 0; i < in.count; i++)
+		{
+			const sDistanceIn pointIn(
+				CVector3(in.x[i], in.y[i], in.z[i]), in.detailSize, in.normalCalculationMode);
+			CalculateDistance(params, fractals, pointIn, &out[i], data);
+		}
+		return;
+	}
+
+	const int N =
+		(in.normalCalculationMode && params.common.iterThreshMode) ? params.N * 5 : params.N;
+
+	// small batches (like for normal vectors) don't need memory allocation
+	const int bufferSize = 16;
+	sFractalOut fractOutBuffer[bufferSize];
+	std::vector<sFractalOut> fractOutAllocated;
+	sFractalOut *fractOut = fractOutBuffer;
+	if (in.count > bufferSize)
+	{
+		fractOutAllocated.resize(in.count);
+		fractOut = fractOutAllocated.data();
+	}
+	for (int i = 0; i < in.count; i++)
+		fractOut[i].colorIndex = 0;
+
+	sFractalBatchIn fractIn(in.x, in.y, in.z, in.count, params.minN, N, params.common, -1);
+	Compute<fractal::calcModeNormal>(fractals, fractIn, fractOut);
+
+	for (int i = 0; i < in.count; i++)
+	{
+		const sDistanceIn pointIn(
+			CVector3(in.x[i], in.y[i], in.z[i]), in.detailSize, in.normalCalculationMode);
+		sDistanceOut *pointOut = &out[i];
+		pointOut->objectId = 0;
+		pointOut->totalIters = 0;
+
+		double limitBoxDist = 0.0;
+		if (params.limitsEnabled)
+		{
+			limitBoxDist = LimitBoxDistance(params, pointIn.point);
+			if (limitBoxDist > in.detailSize)
+			{
+				pointOut->maxiter = false;
+				pointOut->distance = limitBoxDist;
+				pointOut->iters = 0;
+				continue;
+			}
+		}
+
+		double distance = AnalyticDistance(params, pointIn, fractOut[i], pointOut);
+
+		double reduceDisplacement = 1.0;
+		CVector3 pointFractalized =
+			FractalizeTexture(pointIn.point, data, params, fractals, -1, &reduceDisplacement);
+		distance = DisplacementMap(distance, pointFractalized, 0, data, reduceDisplacement);
+
+		FinalizeDistance(params, pointIn, distance, limitBoxDist, pointOut, data);
+	}
+}
+
 double CalculateDistanceMinPlane(const sParamRender &params, const cNineFractals &fractals,
 	const CVector3 planePoint, const CVector3 direction, const CVector3 orthDirection,
 	bool *stopRequest)
@@ -57,6 +57,27 @@ struct sDistanceIn
 	}
 };
 
+// many points for CalculateDistanceBatch(). Coordinates are stored as structure of arrays
+struct sDistanceBatchIn
+{
+	const double *x;
+	const double *y;
+	const double *z;
+	int count;
+	double detailSize;
+	bool normalCalculationMode;
+	sDistanceBatchIn(const double *_x, const double *_y, const double *_z, int _count,
+		double _detailSize, bool _normalCalculationMode)
+			: x(_x),
+				y(_y),
+				z(_z),
+				count(_count),
+				detailSize(_detailSize),
+				normalCalculationMode(_normalCalculationMode)
+	{
+	}
+};
+
 struct sDistanceOut
 {
 	double distance;
@@ -69,6 +90,8 @@ struct sDistanceOut
 
 double CalculateDistance(const sParamRender &params, const cNineFractals &fractals,
 	const sDistanceIn &in, sDistanceOut *out, sRenderData *data = nullptr);
+void CalculateDistanceBatch(const sParamRender &params, const cNineFractals &fractals,
+	const sDistanceBatchIn &in, sDistanceOut *out, sRenderData *data = nullptr);
 double CalculateDistanceSimple(const sParamRender &params, const cNineFractals &fractals,
 	const sDistanceIn &in, sDistanceOut *out, int forcedFormulaIndex);
 double CalculateDistanceMinPlane(const sParamRender &params, const cNineFractals &fractals,
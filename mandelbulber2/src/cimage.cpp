@@ -92,14 +92,12 @@ bool cImage::AllocMem()
 				imageFloat.reset(new sRGBFloat[quint64(width) * quint64(height)]);
 				postImageFloat.reset(new sRGBFloat[quint64(width) * quint64(height)]);
 				image16.reset(new sRGB16[quint64(width) * quint64(height)]);
-				image8.reset(new sRGB8[quint64(width) * quint64(height)]);
 				zBuffer.reset(new float[quint64(width) * quint64(height)]);
-				alphaBuffer8.reset(new quint8[quint64(width) * quint64(height)]);
 				alphaBuffer16.reset(new quint16[quint64(width) * quint64(height)]);
 				opacityBuffer.reset(new quint16[quint64(width) * quint64(height)]);
 				colourBuffer.reset(new sRGB8[quint64(width) * quint64(height)]);
-				if (opt.optionalNormal) AllocRGB(normalFloat, normal16, normal8);
-				if (opt.optionalSpecular) AllocRGB(specularFloat, specular16, specular8);
+				if (opt.optionalNormal) AllocRGB(normalFloat, normalHalf);
+				if (opt.optionalSpecular) AllocRGB(specularFloat, specularHalf);
 				ClearImage();
 			}
 			catch (std::bad_alloc &ba)
@@ -126,12 +124,35 @@ bool cImage::AllocMem()
 	return true;
 }
 
-void cImage::AllocRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGB16> &rgb16,
-	QScopedArrayPointer<sRGB8> &rgb8)
+void cImage::AllocRGB(
+	QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGBHalf> &rgbHalf)
+{
+	if (opt.optionalHalfFloat)
+		rgbHalf.reset(new sRGBHalf[quint64(width) * quint64(height)]);
+	else
+		rgbFloat.reset(new sRGBFloat[quint64(width) * quint64(height)]);
+}
+
+template <typename T>
+T *cImage::AllocLazy(QScopedArrayPointer<T> &buffer)
+{
+	QMutexLocker lock(&lazyAllocMutex);
+	if (!buffer)
+	{
+		buffer.reset(new T[quint64(width) * quint64(height)]);
+		memset(static_cast<void *>(buffer.data()), 0, sizeof(T) * quint64(width) * quint64(height));
+	}
+	return buffer.data();
+}
+
+sRGB8 *cImage::GetImage8Ptr()
 {
-	rgbFloat.reset(new sRGBFloat[quint64(width) * quint64(height)]);
-	rgb16.reset(new sRGB16[quint64(width) * quint64(height)]);
-	rgb8.reset(new sRGB8[quint64(width) * quint64(height)]);
+	return AllocLazy(image8);
+}
+
+quint8 *cImage::GetAlphaBufPtr8()
+{
+	return AllocLazy(alphaBuffer8);
 }
 
 bool cImage::ChangeSize(int w, int h, sImageOptional optional)
@@ -156,23 +177,26 @@ void cImage::ClearImage()
 	memset(imageFloat.data(), 0, sizeof(sRGBFloat) * quint64(width) * quint64(height));
 	memset(postImageFloat.data(), 0, sizeof(sRGBFloat) * quint64(width) * quint64(height));
 	memset(image16.data(), 0, sizeof(sRGB16) * quint64(width) * quint64(height));
-	memset(image8.data(), 0, sizeof(sRGB8) * quint64(width) * quint64(height));
-	memset(alphaBuffer8.data(), 0, sizeof(quint8) * quint64(width) * quint64(height));
+	if (image8) memset(image8.data(), 0, sizeof(sRGB8) * quint64(width) * quint64(height));
+	if (alphaBuffer8)
+		memset(alphaBuffer8.data(), 0, sizeof(quint8) * quint64(width) * quint64(height));
 	memset(alphaBuffer16.data(), 0, sizeof(quint16) * quint64(width) * quint64(height));
 	memset(opacityBuffer.data(), 0, sizeof(quint16) * quint64(width) * quint64(height));
 	memset(colourBuffer.data(), 0, sizeof(sRGB8) * quint64(width) * quint64(height));
 
-	if (opt.optionalNormal) ClearRGB(normalFloat, normal16, normal8);
-	if (opt.optionalSpecular) ClearRGB(specularFloat, specular16, specular8);
+	if (opt.optionalNormal) ClearRGB(normalFloat, normalHalf, normal16, normal8);
+	if (opt.optionalSpecular) ClearRGB(specularFloat, specularHalf, specular16, specular8);
 
 	for (quint64 i = 0; i < quint64(width) * quint64(height); ++i)
 		zBuffer[i] = float(1e20);
 }
 
-void cImage::ClearRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGB16> &rgb16,
+void cImage::ClearRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat,
+	QScopedArrayPointer<sRGBHalf> &rgbHalf, QScopedArrayPointer<sRGB16> &rgb16,
 	QScopedArrayPointer<sRGB8> &rgb8)
 {
 	if (rgbFloat) memset(rgbFloat.data(), 0, sizeof(sRGBFloat) * quint64(width) * quint64(height));
+	if (rgbHalf) memset(rgbHalf.data(), 0, sizeof(sRGBHalf) * quint64(width) * quint64(height));
 	if (rgb16) memset(rgb16.data(), 0, sizeof(sRGB16) * quint64(width) * quint64(height));
 	if (rgb8) memset(rgb8.data(), 0, sizeof(sRGB8) * quint64(width) * quint64(height));
 }
@@ -191,35 +215,34 @@ void cImage::FreeImage()
 	colourBuffer.reset();
 	zBuffer.reset();
 
-	FreeRGB(normalFloat, normal16, normal8);
-	FreeRGB(specularFloat, specular16, specular8);
+	FreeRGB(normalFloat, normalHalf, normal16, normal8);
+	FreeRGB(specularFloat, specularHalf, specular16, specular8);
 
 	gammaTable.reset();
 	gammaTablePrepared = false;
 }
 
-void cImage::FreeRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGB16> &rgb16,
+void cImage::FreeRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat,
+	QScopedArrayPointer<sRGBHalf> &rgbHalf, QScopedArrayPointer<sRGB16> &rgb16,
 	QScopedArrayPointer<sRGB8> &rgb8)
 {
 	rgbFloat.reset();
+	rgbHalf.reset();
 	rgb16.reset();
 	rgb8.reset();
 }
 
-sRGB16 cImage::CalculatePixel(sRGBFloat pixel)
+// brightness, contrast, HDR and saturation. Results (0...65535) are indexes to the gamma table.
+// Written without branches on pixel data, so it can be vectorised
+static inline void ToneMapPixel(const sImageAdjustments &adj, float &R, float &G, float &B)
 {
-	CalculateGammaTable();
-	float R = pixel.R * adj.brightness;
-	float G = pixel.G * adj.brightness;
-	float B = pixel.B * adj.brightness;
+	R = (R * adj.brightness - 0.5f) * adj.contrast + 0.5f;
+	G = (G * adj.brightness - 0.5f) * adj.contrast + 0.5f;
+	B = (B * adj.brightness - 0.5f) * adj.contrast + 0.5f;
 
-	R = (R - 0.5f) * adj.contrast + 0.5f;
-	G = (G - 0.5f) * adj.contrast + 0.5f;
-	B = (B - 0.5f) * adj.contrast + 0.5f;
-
-	if (R < 0.0f) R = 0.0f;
-	if (G < 0.0f) G = 0.0f;
-	if (B < 0.0f) B = 0.0f;
+	R = qMax(R, 0.0f);
+	G = qMax(G, 0.0f);
+	B = qMax(B, 0.0f);
 
 	if (adj.hdrEnabled)
 	{
@@ -232,83 +255,177 @@ sRGB16 cImage::CalculatePixel(sRGBFloat pixel)
 	float const rFactor = 0.299f;
 	float const gFactor = .587f;
 	float const bFactor = .114f;
-	double V = sqrt(R * R * rFactor + G * G * gFactor + B * B * bFactor);
+	float V = sqrtf(R * R * rFactor + G * G * gFactor + B * B * bFactor);
 	R = V + (R - V) * adj.saturation;
 	G = V + (G - V) * adj.saturation;
 	B = V + (B - V) * adj.saturation;
 
-	R = clamp(R, 0.0f, 1.0f);
-	G = clamp(G, 0.0f, 1.0f);
-	B = clamp(B, 0.0f, 1.0f);
-
-	sRGB16 newPixel16;
-
-	newPixel16.R = quint16(R * 65535.0f);
-	newPixel16.G = quint16(G * 65535.0f);
-	newPixel16.B = quint16(B * 65535.0f);
-	newPixel16.R = quint16(gammaTable[newPixel16.R]);
-	newPixel16.G = quint16(gammaTable[newPixel16.G]);
-	newPixel16.B = quint16(gammaTable[newPixel16.B]);
+	R = clamp(R, 0.0f, 1.0f) * 65535.0f;
+	G = clamp(G, 0.0f, 1.0f) * 65535.0f;
+	B = clamp(B, 0.0f, 1.0f) * 65535.0f;
+}
 
-	return newPixel16;
+sRGB16 cImage::CalculatePixel(sRGBFloat pixel)
+{
+	CalculateGammaTable();
+	ToneMapPixel(adj, pixel.R, pixel.G, pixel.B);
+	return sRGB16(gammaTable[quint16(pixel.R)], gammaTable[quint16(pixel.G)],
+		gammaTable[quint16(pixel.B)]);
 }
 
 void cImage::CalculateGammaTable()
 {
 	if (!gammaTablePrepared)
 	{
-		gammaTable.reset(new int[65536]);
+		gammaTable.reset(new quint16[65536]);
 
 		for (int i = 0; i < 65536; i++)
 		{
-			gammaTable[i] = int(powf(i / 65536.0f, 1.0f / adj.imageGamma) * 65535.0f);
+			gammaTable[i] = quint16(powf(i / 65536.0f, 1.0f / adj.imageGamma) * 65535.0f);
 		}
 		gammaTablePrepared = true;
 	}
 }
 
-void cImage::CompileImage(QList<int> *list)
+// converts postImageFloat to image16 (and image8 if to8 is not null) for pixels
+// [address, address + count). Gamma table has to be already calculated
+void cImage::CompileSpan(qint64 address, qint64 count, sRGB8 *to8) const
 {
-	int listIndex = 0;
-	for (int y = 0; y < height; y++)
+	const sRGBFloat *from = postImageFloat.data() + address;
+	sRGB16 *to16 = image16.data() + address;
+	if (to8) to8 += address;
+	const quint16 *gamma = gammaTable.data();
+	const sImageAdjustments adjustments = adj;
+
+	// arithmetic part is done in blocks, so the compiler can use SIMD instructions.
+	// Table lookups (gather) are done in a second, scalar loop
+	const int blockSize = 64;
+	quint16 indexR[blockSize];
+	quint16 indexG[blockSize];
+	quint16 indexB[blockSize];
+
+	for (qint64 blockStart = 0; blockStart < count; blockStart += blockSize)
 	{
-		if (list)
+		const int blockCount = int(qMin(qint64(blockSize), count - blockStart));
+
+#pragma omp simd
+		for (int i = 0; i < blockCount; i++)
 		{
-			if (listIndex >= list->size()) break;
-			y = list->at(listIndex);
-			listIndex++;
+			sRGBFloat pixel = from[blockStart + i];
+			ToneMapPixel(adjustments, pixel.R, pixel.G, pixel.B);
+			indexR[i] = quint16(pixel.R);
+			indexG[i] = quint16(pixel.G);
+			indexB[i] = quint16(pixel.B);
 		}
-		for (int x = 0; x < width; x++)
+
+		for (int i = 0; i < blockCount; i++)
 		{
-			qint64 address = qint64(x) + qint64(y) * width;
-			sRGBFloat pixel = postImageFloat[address];
-			sRGB16 newPixel16 = CalculatePixel(pixel);
-			image16[address] = newPixel16;
+			sRGB16 pixel16(gamma[indexR[i]], gamma[indexG[i]], gamma[indexB[i]]);
+			to16[blockStart + i] = pixel16;
+			if (to8)
+				to8[blockStart + i] = sRGB8(pixel16.R / 256, pixel16.G / 256, pixel16.B / 256);
 		}
 	}
 }
 
-void cImage::CompileImage(const QList<QRect> *list)
+void cImage::CompileRows(QList<int> *list, sRGB8 *to8)
+{
+	CalculateGammaTable();
+
+	if (list)
+	{
+		const int count = list->size();
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int i = 0; i < count; i++)
+		{
+			CompileSpan(qint64(list->at(i)) * width, width, to8);
+		}
+	}
+	else
+	{
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int y = 0; y < height; y++)
+		{
+			CompileSpan(qint64(y) * width, width, to8);
+		}
+	}
+}
+
+void cImage::CompileRects(const QList<QRect> *list, sRGB8 *to8)
 {
 	if (imageFloat && postImageFloat)
 	{
+		CalculateGammaTable();
+
 		for (auto rect : *list)
 		{
+#pragma omp parallel for schedule(dynamic, 1)
 			for (int y = rect.top(); y <= rect.bottom(); y++)
 			{
-				for (int x = rect.left(); x <= rect.right(); x++)
-				{
-					qint64 address = qint64(x) + qint64(y) * width;
-					sRGBFloat pixel = postImageFloat[address];
-					sRGB16 newPixel16 = CalculatePixel(pixel);
-					image16[address] = newPixel16;
-				}
+				CompileSpan(qint64(rect.left()) + qint64(y) * width, rect.width(), to8);
 			}
 		}
 	}
 }
 
+void cImage::CompileImage(QList<int> *list)
+{
+	CompileRows(list, nullptr);
+}
+
+void cImage::CompileImage(const QList<QRect> *list)
+{
+	CompileRects(list, nullptr);
+}
+
+quint8 *cImage::CompileImageAndConvertTo8bit(QList<int> *list)
+{
+	// whole image has to be converted when 8-bit buffer is allocated for the first time
+	if (!image8) list = nullptr;
+	CompileRows(list, AllocLazy(image8));
+	return reinterpret_cast<quint8 *>(image8.data());
+}
+
+quint8 *cImage::CompileImageAndConvertTo8bit(const QList<QRect> *list)
+{
+	if (!image8)
+	{
+		CompileRects(list, nullptr);
+		return ConvertTo8bit();
+	}
+	CompileRects(list, image8.data());
+	return reinterpret_cast<quint8 *>(image8.data());
+}
+
 int cImage::GetUsedMB() const
+{
+	const quint64 pixels = quint64(width) * quint64(height);
+	quint64 bytes = 0;
+
+	// only allocated layers
+	if (imageFloat) bytes += pixels * sizeof(sRGBFloat);
+	if (postImageFloat) bytes += pixels * sizeof(sRGBFloat);
+	if (image16) bytes += pixels * sizeof(sRGB16);
+	if (image8) bytes += pixels * sizeof(sRGB8);
+	if (alphaBuffer16) bytes += pixels * sizeof(quint16);
+	if (alphaBuffer8) bytes += pixels * sizeof(quint8);
+	if (opacityBuffer) bytes += pixels * sizeof(quint16);
+	if (colourBuffer) bytes += pixels * sizeof(sRGB8);
+	if (zBuffer) bytes += pixels * sizeof(float);
+	if (normalFloat) bytes += pixels * sizeof(sRGBFloat);
+	if (normalHalf) bytes += pixels * sizeof(sRGBHalf);
+	if (normal16) bytes += pixels * sizeof(sRGB16);
+	if (normal8) bytes += pixels * sizeof(sRGB8);
+	if (specularFloat) bytes += pixels * sizeof(sRGBFloat);
+	if (specularHalf) bytes += pixels * sizeof(sRGBHalf);
+	if (specular16) bytes += pixels * sizeof(sRGB16);
+	if (specular8) bytes += pixels * sizeof(sRGB8);
+
+	return int(bytes / 1024 / 1024);
+}
+
+// memory which would be used if all layers were allocated together with the image
+int cImage::GetUsedMBAllLayersAllocated() const
 {
 	quint64 mb;
 
@@ -335,6 +452,15 @@ int cImage::GetUsedMB() const
 	return int(mb);
 }
 
+QString cImage::GetMemoryReport() const
+{
+	return QString("Image %1x%2: %3 MB allocated (%4 MB with all layers allocated)")
+		.arg(width)
+		.arg(height)
+		.arg(GetUsedMB())
+		.arg(GetUsedMBAllLayersAllocated());
+}
+
 void cImage::SetImageParameters(sImageAdjustments adjustments)
 {
 	adj = adjustments;
@@ -344,29 +470,29 @@ void cImage::SetImageParameters(sImageAdjustments adjustments)
 
 quint8 *cImage::ConvertTo8bit()
 {
-	for (quint64 i = 0; i < quint64(width) * quint64(height); i++)
+	AllocLazy(image8);
+	const qint64 size = qint64(width) * qint64(height);
+#pragma omp parallel for schedule(static)
+	for (qint64 i = 0; i < size; i++)
 	{
-		image8[i].R = image16[i].R / 256;
-		image8[i].G = image16[i].G / 256;
-		image8[i].B = image16[i].B / 256;
+		image8[i] = sRGB8(image16[i].R / 256, image16[i].G / 256, image16[i].B / 256);
 	}
 	return reinterpret_cast<quint8 *>(image8.data());
 }
 
 quint8 *cImage::ConvertTo8bit(const QList<QRect> *list)
 {
+	AllocLazy(image8);
 	for (auto rect : *list)
 	{
+#pragma omp parallel for schedule(static)
+		for (int y = rect.top(); y <= rect.bottom(); y++)
 		{
-			for (int y = rect.top(); y <= rect.bottom(); y++)
+			for (int x = rect.left(); x <= rect.right(); x++)
 			{
-				for (int x = rect.left(); x <= rect.right(); x++)
-				{
-					qint64 address = qint64(x) + qint64(y) * width;
-					image8[address].R = image16[address].R / 256;
-					image8[address].G = image16[address].G / 256;
-					image8[address].B = image16[address].B / 256;
-				}
+				qint64 address = qint64(x) + qint64(y) * width;
+				image8[address] =
+					sRGB8(image16[address].R / 256, image16[address].G / 256, image16[address].B / 256);
 			}
 		}
 	}
@@ -375,33 +501,44 @@ quint8 *cImage::ConvertTo8bit(const QList<QRect> *list)
 
 quint8 *cImage::ConvertAlphaTo8bit()
 {
-	for (quint64 i = 0; i < quint64(width) * quint64(height); i++)
+	AllocLazy(alphaBuffer8);
+	const qint64 size = qint64(width) * qint64(height);
+#pragma omp parallel for schedule(static)
+	for (qint64 i = 0; i < size; i++)
 	{
 		alphaBuffer8[i] = alphaBuffer16[i] / 256;
 	}
 	return alphaBuffer8.data();
 }
 
-quint8 *cImage::ConvertGenericRGBTo8bit(
-	QScopedArrayPointer<sRGBFloat> &from, QScopedArrayPointer<sRGB8> &to)
+quint8 *cImage::ConvertGenericRGBTo8bit(const QScopedArrayPointer<sRGBFloat> &fromFloat,
+	const QScopedArrayPointer<sRGBHalf> &fromHalf, QScopedArrayPointer<sRGB8> &to)
 {
-	for (quint64 i = 0; i < quint64(width) * quint64(height); i++)
+	AllocLazy(to);
+	const qint64 size = qint64(width) * qint64(height);
+#pragma omp parallel for schedule(static)
+	for (qint64 i = 0; i < size; i++)
 	{
-		to[i].R = quint8(from[i].R * 255.0f);
-		to[i].G = quint8(from[i].G * 255.0f);
-		to[i].B = quint8(from[i].B * 255.0f);
+		sRGBFloat pixel = GetPixelLayer(fromFloat, fromHalf, i);
+		to[i].R = quint8(pixel.R * 255.0f);
+		to[i].G = quint8(pixel.G * 255.0f);
+		to[i].B = quint8(pixel.B * 255.0f);
 	}
 	return reinterpret_cast<quint8 *>(to.data());
 }
 
-quint8 *cImage::ConvertGenericRGBTo16bit(
-	QScopedArrayPointer<sRGBFloat> &from, QScopedArrayPointer<sRGB16> &to)
+quint8 *cImage::ConvertGenericRGBTo16bit(const QScopedArrayPointer<sRGBFloat> &fromFloat,
+	const QScopedArrayPointer<sRGBHalf> &fromHalf, QScopedArrayPointer<sRGB16> &to)
 {
-	for (quint64 i = 0; i < quint64(width) * quint64(height); i++)
+	AllocLazy(to);
+	const qint64 size = qint64(width) * qint64(height);
+#pragma omp parallel for schedule(static)
+	for (qint64 i = 0; i < size; i++)
 	{
-		to[i].R = quint16(from[i].R * 65535.0f);
-		to[i].G = quint16(from[i].G * 65535.0f);
-		to[i].B = quint16(from[i].B * 65535.0f);
+		sRGBFloat pixel = GetPixelLayer(fromFloat, fromHalf, i);
+		to[i].R = quint16(pixel.R * 65535.0f);
+		to[i].G = quint16(pixel.G * 65535.0f);
+		to[i].B = quint16(pixel.B * 65535.0f);
 	}
 	return reinterpret_cast<quint8 *>(to.data());
 }
@@ -409,25 +546,25 @@ quint8 *cImage::ConvertGenericRGBTo16bit(
 quint8 *cImage::ConvertNormalTo16Bit()
 {
 	if (!opt.optionalNormal) return nullptr;
-	return ConvertGenericRGBTo16bit(normalFloat, normal16);
+	return ConvertGenericRGBTo16bit(normalFloat, normalHalf, normal16);
 }
 
 quint8 *cImage::ConvertNormalTo8Bit()
 {
 	if (!opt.optionalNormal) return nullptr;
-	return ConvertGenericRGBTo8bit(normalFloat, normal8);
+	return ConvertGenericRGBTo8bit(normalFloat, normalHalf, normal8);
 }
 
 quint8 *cImage::ConvertSpecularTo16Bit()
 {
 	if (!opt.optionalSpecular) return nullptr;
-	return ConvertGenericRGBTo16bit(specularFloat, specular16);
+	return ConvertGenericRGBTo16bit(specularFloat, specularHalf, specular16);
 }
 
 quint8 *cImage::ConvertSpecularTo8Bit()
 {
 	if (!opt.optionalSpecular) return nullptr;
-	return ConvertGenericRGBTo8bit(specularFloat, specular8);
+	return ConvertGenericRGBTo8bit(specularFloat, specularHalf, specular8);
 }
 
 sRGB8 cImage::Interpolation(float x, float y) const
@@ -493,6 +630,7 @@ void cImage::UpdatePreview(QList<int> *list)
 {
 	if (previewAllocated && !allocLater)
 	{
+		AllocLazy(image8);
 		previewMutex.lock();
 		int w = previewWidth;
 		int h = previewHeight;
@@ -583,6 +721,7 @@ void cImage::UpdatePreview(const QList<QRect> *list)
 {
 	if (previewAllocated && !allocLater)
 	{
+		AllocLazy(image8);
 		previewMutex.lock();
 		int w = previewWidth;
 		int h = previewHeight;
@@ -1069,9 +1208,6 @@ void cImage::GetStereoLeftRightImages(cImage *left, cImage *right)
 				qint64 ptrLeft = x + y * width;
 				qint64 ptrRight = (x + halfWidth) + y * width;
 
-				left->image8[ptrNew] = image8[ptrLeft];
-				right->image8[ptrNew] = image8[ptrRight];
-
 				left->image16[ptrNew] = image16[ptrLeft];
 				right->image16[ptrNew] = image16[ptrRight];
 
@@ -1081,9 +1217,6 @@ void cImage::GetStereoLeftRightImages(cImage *left, cImage *right)
 				left->postImageFloat[ptrNew] = postImageFloat[ptrLeft];
 				right->postImageFloat[ptrNew] = postImageFloat[ptrRight];
 
-				left->alphaBuffer8[ptrNew] = alphaBuffer8[ptrLeft];
-				right->alphaBuffer8[ptrNew] = alphaBuffer8[ptrRight];
-
 				left->alphaBuffer16[ptrNew] = alphaBuffer16[ptrLeft];
 				right->alphaBuffer16[ptrNew] = alphaBuffer16[ptrRight];
 
@@ -1096,29 +1229,59 @@ void cImage::GetStereoLeftRightImages(cImage *left, cImage *right)
 				left->zBuffer[ptrNew] = zBuffer[ptrLeft];
 				right->zBuffer[ptrNew] = zBuffer[ptrRight];
 
+				// 8-bit and 16-bit versions are converted when needed
 				if (opt.optionalNormal)
 				{
-					left->normalFloat[ptrNew] = normalFloat[ptrLeft];
-					right->normalFloat[ptrNew] = normalFloat[ptrRight];
-
-					left->normal8[ptrNew] = normal8[ptrLeft];
-					right->normal8[ptrNew] = normal8[ptrRight];
-
-					left->normal16[ptrNew] = normal16[ptrLeft];
-					right->normal16[ptrNew] = normal16[ptrRight];
+					left->PutPixelLayer(left->normalFloat, left->normalHalf, ptrNew,
+						GetPixelLayer(normalFloat, normalHalf, ptrLeft));
+					right->PutPixelLayer(right->normalFloat, right->normalHalf, ptrNew,
+						GetPixelLayer(normalFloat, normalHalf, ptrRight));
 				}
 				if (opt.optionalSpecular)
 				{
-					left->specularFloat[ptrNew] = specularFloat[ptrLeft];
-					right->specularFloat[ptrNew] = specularFloat[ptrRight];
-
-					left->specular8[ptrNew] = specular8[ptrLeft];
-					right->specular8[ptrNew] = specular8[ptrRight];
-
-					left->specular16[ptrNew] = specular16[ptrLeft];
-					right->specular16[ptrNew] = specular16[ptrRight];
+					left->PutPixelLayer(left->specularFloat, left->specularHalf, ptrNew,
+						GetPixelLayer(specularFloat, specularHalf, ptrLeft));
+					right->PutPixelLayer(right->specularFloat, right->specularHalf, ptrNew,
+						GetPixelLayer(specularFloat, specularHalf, ptrRight));
 				}
 			}
 		}
 	}
 }
+
+// copies all image layers needed to save the image (e.g. snapshot for saving in background)
+bool cImage::CopyFrom(const cImage *source)
+{
+	if (!ChangeSize(int(source->width), int(source->height), source->opt)) return false;
+
+	adj = source->adj;
+	gammaTablePrepared = false;
+	isStereoLeftRight = source->isStereoLeftRight;
+
+	const quint64 size = quint64(width) * quint64(height);
+	memcpy(imageFloat.data(), source->imageFloat.data(), sizeof(sRGBFloat) * size);
+	memcpy(postImageFloat.data(), source->postImageFloat.data(), sizeof(sRGBFloat) * size);
+	memcpy(image16.data(), source->image16.data(), sizeof(sRGB16) * size);
+	memcpy(alphaBuffer16.data(), source->alphaBuffer16.data(), sizeof(quint16) * size);
+	memcpy(opacityBuffer.data(), source->opacityBuffer.data(), sizeof(quint16) * size);
+	memcpy(colourBuffer.data(), source->colourBuffer.data(), sizeof(sRGB8) * size);
+	memcpy(zBuffer.data(), source->zBuffer.data(), sizeof(float) * size);
+
+	// 8-bit versions and 16-bit versions of optional layers are always converted when needed
+	if (opt.optionalNormal)
+	{
+		if (opt.optionalHalfFloat)
+			memcpy(normalHalf.data(), source->normalHalf.data(), sizeof(sRGBHalf) * size);
+		else
+			memcpy(normalFloat.data(), source->normalFloat.data(), sizeof(sRGBFloat) * size);
+	}
+	if (opt.optionalSpecular)
+	{
+		if (opt.optionalHalfFloat)
+			memcpy(specularHalf.data(), source->specularHalf.data(), sizeof(sRGBHalf) * size);
+		else
+			memcpy(specularFloat.data(), source->specularFloat.data(), sizeof(sRGBFloat) * size);
+	}
+
+	return true;
+}
@@ -47,15 +47,16 @@
 
 struct sImageOptional
 {
-	sImageOptional() : optionalNormal(false), optionalSpecular(false) {}
+	sImageOptional() : optionalNormal(false), optionalSpecular(false), optionalHalfFloat(false) {}
 	inline bool operator==(sImageOptional other) const
 	{
-		return other.optionalNormal == optionalNormal;
-		return other.optionalSpecular == optionalSpecular;
+		return other.optionalNormal == optionalNormal && other.optionalSpecular == optionalSpecular
+					 && other.optionalHalfFloat == optionalHalfFloat;
 	}
 
 	bool optionalNormal;
 	bool optionalSpecular;
+	bool optionalHalfFloat; // normal and specular layers stored as half floats
 };
 
 struct sAllImageData
@@ -79,12 +80,11 @@ public:
 	bool IsAllocated() const { return isAllocated; }
 	bool ChangeSize(int w, int h, sImageOptional optional);
 	void ClearImage();
-	void ClearRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGB16> &rgb16,
-		QScopedArrayPointer<sRGB8> &rgb8);
-	void AllocRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGB16> &rgb16,
-		QScopedArrayPointer<sRGB8> &rgb8);
-	void FreeRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGB16> &rgb16,
-		QScopedArrayPointer<sRGB8> &rgb8);
+	void ClearRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGBHalf> &rgbHalf,
+		QScopedArrayPointer<sRGB16> &rgb16, QScopedArrayPointer<sRGB8> &rgb8);
+	void AllocRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGBHalf> &rgbHalf);
+	void FreeRGB(QScopedArrayPointer<sRGBFloat> &rgbFloat, QScopedArrayPointer<sRGBHalf> &rgbHalf,
+		QScopedArrayPointer<sRGB16> &rgb16, QScopedArrayPointer<sRGB8> &rgb8);
 
 	bool IsUsed() const { return isUsed; }
 	void BlockImage() { isUsed = true; }
@@ -140,11 +140,11 @@ public:
 	}
 	inline void PutPixelNormal(qint64 x, qint64 y, sRGBFloat pixel)
 	{
-		normalFloat[getImageIndex(x, y)] = pixel;
+		PutPixelLayer(normalFloat, normalHalf, getImageIndex(x, y), pixel);
 	}
 	inline void PutPixelSpecular(qint64 x, qint64 y, sRGBFloat pixel)
 	{
-		specularFloat[getImageIndex(x, y)] = pixel;
+		PutPixelLayer(specularFloat, specularHalf, getImageIndex(x, y), pixel);
 	}
 	inline sRGBFloat GetPixelImage(qint64 x, qint64 y) const
 	{
@@ -172,7 +172,8 @@ public:
 	inline float GetPixelZBuffer(qint64 x, qint64 y) const { return zBuffer[getImageIndex(x, y)]; }
 	inline sRGBFloat GetPixelNormal(qint64 x, qint64 y)
 	{
-		return GetPixelGeneric(normalFloat, opt.optionalNormal, x, y);
+		if (!opt.optionalNormal) return BlackFloat();
+		return GetPixelLayer(normalFloat, normalHalf, getImageIndex(x, y));
 	}
 	inline sRGB16 GetPixelNormal16(qint64 x, qint64 y)
 	{
@@ -184,7 +185,8 @@ public:
 	}
 	inline sRGBFloat GetPixelSpecular(qint64 x, qint64 y)
 	{
-		return GetPixelGeneric(specularFloat, opt.optionalSpecular, x, y);
+		if (!opt.optionalSpecular) return BlackFloat();
+		return GetPixelLayer(specularFloat, specularHalf, getImageIndex(x, y));
 	}
 	inline sRGB16 GetPixelSpecular16(qint64 x, qint64 y)
 	{
@@ -195,11 +197,20 @@ public:
 		return GetPixelGeneric8(specular8, opt.optionalSpecular, x, y);
 	}
 
-	inline sRGBFloat GetPixelGeneric(
-		QScopedArrayPointer<sRGBFloat> &from, bool available, qint64 x, qint64 y)
+	// optional HDR layers are stored as float or half float
+	inline void PutPixelLayer(QScopedArrayPointer<sRGBFloat> &layerFloat,
+		QScopedArrayPointer<sRGBHalf> &layerHalf, qint64 index, sRGBFloat pixel)
 	{
-		if (!available) return BlackFloat();
-		return from[getImageIndex(x, y)];
+		if (opt.optionalHalfFloat)
+			layerHalf[index] = sRGBHalf(pixel);
+		else
+			layerFloat[index] = pixel;
+	}
+	inline sRGBFloat GetPixelLayer(const QScopedArrayPointer<sRGBFloat> &layerFloat,
+		const QScopedArrayPointer<sRGBHalf> &layerHalf, qint64 index) const
+	{
+		if (opt.optionalHalfFloat) return layerHalf[index].ToFloat();
+		return layerFloat[index];
 	}
 	inline sRGB16 GetPixelGeneric16(
 		QScopedArrayPointer<sRGB16> &from, bool available, qint64 x, qint64 y)
@@ -241,9 +252,9 @@ public:
 	sRGBFloat *GetImageFloatPtr() { return imageFloat.data(); }
 	sRGBFloat *GetPostImageFloatPtr() { return postImageFloat.data(); }
 	sRGB16 *GetImage16Ptr() { return image16.data(); }
-	sRGB8 *GetImage8Ptr() { return image8.data(); }
+	sRGB8 *GetImage8Ptr();
 	quint16 *GetAlphaBufPtr() { return alphaBuffer16.data(); }
-	quint8 *GetAlphaBufPtr8() { return alphaBuffer8.data(); }
+	quint8 *GetAlphaBufPtr8();
 	float *GetZBufferPtr() { return zBuffer.data(); }
 	sRGB8 *GetColorPtr() { return colourBuffer.data(); }
 	quint16 *GetOpacityPtr() { return opacityBuffer.data(); }
@@ -252,6 +263,9 @@ public:
 
 	void CompileImage(QList<int> *list = nullptr);
 	void CompileImage(const QList<QRect> *list);
+	// CompileImage() and ConvertTo8bit() fused into one pass over the image
+	quint8 *CompileImageAndConvertTo8bit(QList<int> *list = nullptr);
+	quint8 *CompileImageAndConvertTo8bit(const QList<QRect> *list);
 	void NullPostEffect(QList<int> *list = nullptr);
 	void NullPostEffect(const QList<QRect> *list);
 
@@ -262,15 +276,17 @@ public:
 	int GetPreviewVisibleWidth() const { return previewVisibleWidth; }
 	int GetPreviewVisibleHeight() const { return previewVisibleHeight; }
 	int GetUsedMB() const;
+	int GetUsedMBAllLayersAllocated() const;
+	QString GetMemoryReport() const;
 	void SetImageParameters(sImageAdjustments adjustments);
 	sImageAdjustments *GetImageAdjustments() { return &adj; }
 	void SetImageOptional(sImageOptional optInput) { opt = optInput; }
 	sImageOptional *GetImageOptional() { return &opt; }
 
-	quint8 *ConvertGenericRGBTo8bit(
-		QScopedArrayPointer<sRGBFloat> &from, QScopedArrayPointer<sRGB8> &to);
-	quint8 *ConvertGenericRGBTo16bit(
-		QScopedArrayPointer<sRGBFloat> &from, QScopedArrayPointer<sRGB16> &to);
+	quint8 *ConvertGenericRGBTo8bit(const QScopedArrayPointer<sRGBFloat> &fromFloat,
+		const QScopedArrayPointer<sRGBHalf> &fromHalf, QScopedArrayPointer<sRGB8> &to);
+	quint8 *ConvertGenericRGBTo16bit(const QScopedArrayPointer<sRGBFloat> &fromFloat,
+		const QScopedArrayPointer<sRGBHalf> &fromHalf, QScopedArrayPointer<sRGB16> &to);
 	quint8 *ConvertTo8bit();
 	quint8 *ConvertTo8bit(const QList<QRect> *list);
 	quint8 *ConvertAlphaTo8bit();
@@ -304,6 +320,7 @@ public:
 		isStereoLeftRight = isStereoLeftRightInput;
 	}
 	void GetStereoLeftRightImages(cImage *left, cImage *right);
+	bool CopyFrom(const cImage *source);
 
 	int progressiveFactor;
 
@@ -312,10 +329,17 @@ private:
 	sRGB8 Interpolation(float x, float y) const;
 	bool AllocMem();
 	void FreeImage();
+	template <typename T>
+	T *AllocLazy(QScopedArrayPointer<T> &buffer);
+	void CompileSpan(qint64 address, qint64 count, sRGB8 *to8) const;
+	void CompileRows(QList<int> *list, sRGB8 *to8);
+	void CompileRects(const QList<QRect> *list, sRGB8 *to8);
 	static inline sRGB16 Black16() { return sRGB16(0, 0, 0); }
 	static inline sRGB8 Black8() { return sRGB8(0, 0, 0); }
 	static inline sRGBFloat BlackFloat() { return sRGBFloat(0, 0, 0); }
 
+	// 8-bit versions of layers (image8, alphaBuffer8, normal8, specular8) and 16-bit versions of
+	// optional layers are allocated when they are converted for the first time
 	QScopedArrayPointer<sRGB8> image8;
 	QScopedArrayPointer<sRGB16> image16;
 	QScopedArrayPointer<sRGBFloat> imageFloat;
@@ -329,10 +353,12 @@ private:
 
 	// optional image buffers
 	QScopedArrayPointer<sRGBFloat> normalFloat;
+	QScopedArrayPointer<sRGBHalf> normalHalf;
 	QScopedArrayPointer<sRGB8> normal8;
 	QScopedArrayPointer<sRGB16> normal16;
 
 	QScopedArrayPointer<sRGBFloat> specularFloat;
+	QScopedArrayPointer<sRGBHalf> specularHalf;
 	QScopedArrayPointer<sRGB8> specular8;
 	QScopedArrayPointer<sRGB16> specular16;
 
@@ -344,7 +370,7 @@ private:
 	sImageOptional opt;
 	qint64 width;
 	qint64 height;
-	QScopedArrayPointer<int> gammaTable;
+	QScopedArrayPointer<quint16> gammaTable;
 	bool previewAllocated;
 	int previewWidth;
 	int previewHeight;
@@ -358,6 +384,7 @@ private:
 	bool fastPreview;
 
 	QMutex previewMutex;
+	QMutex lazyAllocMutex;
 
 	std::atomic<bool> isUsed;
 };
@@ -35,6 +35,8 @@
 #ifndef MANDELBULBER2_SRC_COLOR_STRUCTURES_HPP_
 #define MANDELBULBER2_SRC_COLOR_STRUCTURES_HPP_
 
+#include <cstring>
+
 #include <QtCore>
 
 template <typename T>
@@ -103,4 +105,77 @@ using sRGBA8 = tsRGBA<quint8>;
 using sRGBA16 = tsRGBA<quint16>;
 using sRGBAfloat = tsRGBA<float>;
 
+// conversion of float to IEEE 754 half precision float (rounding to nearest even)
+inline quint16 FloatToHalf(float value)
+{
+	quint32 bits;
+	memcpy(&bits, &value, sizeof(bits));
+	const quint32 sign = (bits >> 16) & 0x8000u;
+	const quint32 absBits = bits & 0x7fffffffu;
+
+	// overflow, infinity or NaN
+	if (absBits >= 0x47800000u)
+	{
+		if (absBits > 0x7f800000u) return quint16(sign | 0x7e00u);
+		return quint16(sign | 0x7c00u);
+	}
+
+	// denormalized half or zero
+	if (absBits < 0x38800000u)
+	{
+		if (absBits < 0x33000000u) return quint16(sign);
+		const quint32 mantissa = (absBits & 0x007fffffu) | 0x00800000u;
+		const quint32 shift = 126u - (absBits >> 23);
+		quint32 half = mantissa >> shift;
+		const quint32 remainder = mantissa & ((1u << shift) - 1u);
+		const quint32 halfway = 1u << (shift - 1u);
+		if (remainder > halfway || (remainder == halfway && (half & 1u))) half++;
+		return quint16(sign | half);
+	}
+
+	quint32 half = (absBits - 0x38000000u) >> 13;
+	const quint32 remainder = absBits & 0x1fffu;
+	if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) half++;
+	return quint16(sign | half);
+}
+
+inline float HalfToFloat(quint16 half)
+{
+	const quint32 sign = quint32(half & 0x8000u) << 16;
+	const quint32 exponent = (half >> 10) & 0x1fu;
+	const quint32 mantissa = half & 0x3ffu;
+
+	quint32 bits;
+	if (exponent == 0x1fu)
+	{
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	}
+	else if (exponent != 0)
+	{
+		bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+	}
+	else
+	{
+		// zero or denormalized number
+		const float value = mantissa * (1.0f / 16777216.0f);
+		return sign ? -value : value;
+	}
+
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+// RGB pixel stored as half floats (used to reduce memory of HDR image layers)
+struct sRGBHalf
+{
+	quint16 R, G, B;
+	sRGBHalf() : R(0), G(0), B(0) {}
+	explicit sRGBHalf(const sRGBFloat &pixel)
+			: R(FloatToHalf(pixel.R)), G(FloatToHalf(pixel.G)), B(FloatToHalf(pixel.B))
+	{
+	}
+	sRGBFloat ToFloat() const { return sRGBFloat(HalfToFloat(R), HalfToFloat(G), HalfToFloat(B)); }
+};
+
 #endif /* MANDELBULBER2_SRC_COLOR_STRUCTURES_HPP_ */
@@ -34,6 +34,9 @@
 
 #include "compute_fractal.hpp"
 
+#include <cstdint>
+#include <cstring>
+
 #include "common_math.h"
 #include "fractal.h"
 #include "fractal_formulas.hpp"
@@ -42,9 +45,209 @@
 
 using namespace fractal;
 
+// distance estimation for single formula calculated with analytic DE
+static double AnalyticFormulaDistance(
+	const cNineFractals &fractals, int sequence, double r, CVector4 &z, const sExtendedAux &aux)
+{
+	double distance = r;
+	switch (fractals.GetDEAnalyticFunction(sequence))
+	{
+		case analyticFunctionLogarithmic:
+		{
+			if (aux.DE > 0)
+				distance = 0.5 * r * log(r) / aux.DE;
+			else
+				distance = r;
+			break;
+		}
+		case analyticFunctionLinear:
+		{
+			distance = r / fabs(aux.DE);
+			break;
+		}
+		case analyticFunctionIFS:
+		{
+			distance = (r - 2.0) / fabs(aux.DE);
+			break;
+		}
+		case analyticFunctionPseudoKleinian:
+		{
+			if (aux.DE > 0)
+			{
+				double rxy = sqrt(z.x * z.x + z.y * z.y);
+				distance = max(rxy - aux.pseudoKleinianDE, fabs(rxy * z.z) / r) / (aux.DE);
+			}
+			else
+				distance = r;
+			break;
+		}
+		case analyticFunctionJosKleinian:
+		{
+			if (fractals.GetFractal(sequence)->transformCommon.functionEnabled)
+				z.y = min(z.y, fractals.GetFractal(sequence)->transformCommon.foldingValue - z.y);
+
+			distance =
+				min(z.y, fractals.GetFractal(sequence)->analyticDE.tweak005)
+				/ max(aux.pseudoKleinianDE, fractals.GetFractal(sequence)->analyticDE.offset1);
+			break;
+		}
+
+		case analyticFunctionNone: distance = -1.0; break;
+		case analyticFunctionUndefined: distance = r; break;
+	}
+	return distance;
+}
+
+// formula function known at compile time or taken from cNineFractals if not specified
+template <fractalFormulaFcn formulaFcn>
+inline fractalFormulaFcn SingleFormulaFunction(const cNineFractals &fractals)
+{
+	Q_UNUSED(fractals);
+	return formulaFcn;
+}
+
+template <>
+inline fractalFormulaFcn SingleFormulaFunction<nullptr>(const cNineFractals &fractals)
+{
+	return fractals.GetFractalFormulaFunction(0);
+}
+
+// Iteration loop for single formula without hybrid sequence, foldings and boolean operators.
+// Used only for DE modes. All conditions which are constant for the whole render are checked
+// before the loop. If formulaFcn is given as template argument, the formula is called directly
+// instead of calling by function pointer
+template <fractal::enumCalculationMode Mode, fractalFormulaFcn formulaFcn>
+static void ComputeSingleFormula(const cNineFractals &fractals, const sFractalIn &in, sFractalOut *out)
+{
+	const fractalFormulaFcn fractalFormulaFunction = SingleFormulaFunction<formulaFcn>(fractals);
+	const sFractal *defaultFractal = fractals.GetFractal(0);
+
+	// repeat, move and rotate
+	CVector3 pointTransformed = (in.point - in.common.fractalPosition).mod(in.common.repeat);
+	pointTransformed = in.common.mRotFractalRotation.RotateVector(pointTransformed);
+
+	CVector4 z = CVector4(pointTransformed, fractals.GetInitialWAxis(0));
+	double r = z.Length();
+
+	out->orbitTrapR = 0.0;
+	out->maxiter = in.common.iterThreshMode;
+
+	sExtendedAux extendedAux;
+
+	extendedAux.c = z;
+	extendedAux.const_c = z;
+	extendedAux.old_z = CVector4(0.0, 0.0, 0.0, 0.0);
+	extendedAux.sum_z = CVector4(0.0, 0.0, 0.0, 0.0);
+	extendedAux.pos_neg = 1.0;
+	extendedAux.cw = 0;
+
+	extendedAux.r = r;
+	extendedAux.DE = 1.0;
+	extendedAux.pseudoKleinianDE = 1.0;
+
+	extendedAux.actualScale = defaultFractal->mandelbox.scale;
+	extendedAux.actualScaleA = 0.0;
+
+	extendedAux.color = 1.0;
+	extendedAux.colorHybrid = 0.0;
+
+	extendedAux.temp100 = 100.0;
+	extendedAux.addDist = 0.0;
+
+	// constant parameters of the formula
+	const bool addCConstant = fractals.IsAddCConstant(0);
+	const bool juliaEnabled = fractals.IsJuliaEnabled(0);
+	const CVector3 constantMultiplier = fractals.GetConstantMultiplier(0);
+	const CVector4 juliaConstant = CVector4(fractals.GetJuliaConstant(0) * constantMultiplier, 0.0);
+	const bool checkForBailout =
+		fractals.IsCheckForBailout(0) && (Mode == calcModeNormal || Mode == calcModeDeltaDE1);
+	const double bailout = fractals.GetBailout(0);
+
+	CVector4 lastZ;
+
+	// main iteration loop
+	int i;
+	for (i = 0; i < in.maxN; i++)
+	{
+		lastZ = z;
+
+		extendedAux.r = r;
+		extendedAux.i = i;
+
+		fractalFormulaFunction(z, defaultFractal, extendedAux);
+
+		// addition of constant
+		if (addCConstant)
+		{
+			if (juliaEnabled)
+				z += juliaConstant;
+			else
+				z += extendedAux.const_c * constantMultiplier;
+		}
+
+		r = z.Length();
+
+		if (z.IsNotANumber())
+		{
+			z = lastZ;
+			r = z.Length();
+			out->maxiter = true;
+			break;
+		}
+
+		// escape condition
+		if (checkForBailout && r > bailout)
+		{
+			out->maxiter = false;
+			break;
+		}
+	}
+
+	// final calculations
+	if (Mode == calcModeNormal) // analytic
+	{
+		out->distance = AnalyticFormulaDistance(fractals, 0, r, z, extendedAux);
+	}
+	else
+	{
+		out->distance = 0.0;
+
+		// needed for JosKleinian fractal to calculate spheres in deltaDE mode
+		if (fractals.GetDEFunctionType(0) == fractal::josKleinianDEFunction)
+		{
+			if (defaultFractal->transformCommon.functionEnabled)
+				z.y = min(z.y, defaultFractal->transformCommon.foldingValue - z.y);
+		}
+	}
+
+	out->iters = i + 1;
+	out->z = z.GetXYZ();
+}
+
 template <fractal::enumCalculationMode Mode>
 void Compute(const cNineFractals &fractals, const sFractalIn &in, sFractalOut *out)
 {
+	// specialized loop for single formula, selected once per render by cNineFractals
+	if ((Mode == calcModeNormal || Mode == calcModeDeltaDE1 || Mode == calcModeDeltaDE2)
+			&& fractals.GetSingleFormulaLoop() != singleFormulaLoopNone && in.forcedFormulaIndex <= 0
+			&& !in.common.foldings.boxEnable && !in.common.foldings.sphericalEnable)
+	{
+		switch (fractals.GetSingleFormulaLoop())
+		{
+			case singleFormulaLoopMandelbulb:
+				ComputeSingleFormula<Mode, MandelbulbIteration>(fractals, in, out);
+				return;
+			case singleFormulaLoopMandelbox:
+				ComputeSingleFormula<Mode, MandelboxIteration>(fractals, in, out);
+				return;
+			case singleFormulaLoopMengerSponge:
+				ComputeSingleFormula<Mode, MengerSpongeIteration>(fractals, in, out);
+				return;
+			case singleFormulaLoopGeneric: ComputeSingleFormula<Mode, nullptr>(fractals, in, out); return;
+			case singleFormulaLoopNone: break;
+		}
+	}
+
 	fractalFormulaFcn fractalFormulaFunction;
 
 	// repeat, move and rotate
@@ -462,52 +665,7 @@ void Compute(const cNineFractals &fractals, const sFractalIn &in, sFractalOut *o
 		}
 		else
 		{
-			switch (fractals.GetDEAnalyticFunction(sequence))
-			{
-				case analyticFunctionLogarithmic:
-				{
-					if (extendedAux.DE > 0)
-						out->distance = 0.5 * r * log(r) / extendedAux.DE;
-					else
-						out->distance = r;
-					break;
-				}
-				case analyticFunctionLinear:
-				{
-					out->distance = r / fabs(extendedAux.DE);
-					break;
-				}
-				case analyticFunctionIFS:
-				{
-					out->distance = (r - 2.0) / fabs(extendedAux.DE);
-					break;
-				}
-				case analyticFunctionPseudoKleinian:
-				{
-					if (extendedAux.DE > 0)
-					{
-						double rxy = sqrt(z.x * z.x + z.y * z.y);
-						out->distance =
-							max(rxy - extendedAux.pseudoKleinianDE, fabs(rxy * z.z) / r) / (extendedAux.DE);
-					}
-					else
-						out->distance = r;
-					break;
-				}
-				case analyticFunctionJosKleinian:
-				{
-					if (fractals.GetFractal(sequence)->transformCommon.functionEnabled)
-						z.y = min(z.y, fractals.GetFractal(sequence)->transformCommon.foldingValue - z.y);
-
-					out->distance =
-						min(z.y, fractals.GetFractal(sequence)->analyticDE.tweak005)
-						/ max(extendedAux.pseudoKleinianDE, fractals.GetFractal(sequence)->analyticDE.offset1);
-					break;
-				}
-
-				case analyticFunctionNone: out->distance = -1.0; break;
-				case analyticFunctionUndefined: out->distance = r; break;
-			}
+			out->distance = AnalyticFormulaDistance(fractals, sequence, r, z, extendedAux);
 		}
 	}
 
@@ -546,3 +704,254 @@ template void Compute<calcModeOrbitTrap>(
 	const cNineFractals &fractals, const sFractalIn &in, sFractalOut *out);
 template void Compute<calcModeCubeOrbitTrap>(
 	const cNineFractals &fractals, const sFractalIn &in, sFractalOut *out);
+
+// number of points calculated together by vectorized formulas
+#define FRACTAL_BATCH_LANES 8
+
+enum enumBatchFormula
+{
+	batchFormulaNone,
+	batchFormulaMandelbulb,
+	batchFormulaMandelbox
+};
+
+// checks if the scene can be calculated by vectorized formulas. Only single formula
+// without hybrid sequence, foldings and additional bailout conditions is supported
+static enumBatchFormula GetBatchFormula(const cNineFractals &fractals, int formulaIndex,
+	const sCommonParams &common, enumCalculationMode mode)
+{
+	if (mode != calcModeNormal) return batchFormulaNone;
+	if (fractals.IsHybrid()) return batchFormulaNone;
+	if (common.foldings.boxEnable || common.foldings.sphericalEnable) return batchFormulaNone;
+	if (!fractals.IsCheckForBailout(formulaIndex) || fractals.UseAdditionalBailoutCond(formulaIndex))
+		return batchFormulaNone;
+
+	enumDEAnalyticFunction DEFunction = fractals.GetDEAnalyticFunction(formulaIndex);
+	if (DEFunction != analyticFunctionLogarithmic && DEFunction != analyticFunctionLinear)
+		return batchFormulaNone;
+
+	const sFractal *fractal = fractals.GetFractal(formulaIndex);
+	switch (fractal->formula)
+	{
+		case mandelbulb: return batchFormulaMandelbulb;
+		case mandelbox:
+			if (fractal->mandelbox.rotationsEnabled || fractal->mandelbox.mainRotationEnabled)
+				return batchFormulaNone;
+			return batchFormulaMandelbox;
+		default: return batchFormulaNone;
+	}
+}
+
+// gsl_finite() can't be vectorized and std::isfinite() is removed by -ffast-math
+static inline bool IsFiniteBits(double value)
+{
+	uint64_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	return (bits & 0x7FF0000000000000ULL) != 0x7FF0000000000000ULL;
+}
+
+// calculates FRACTAL_BATCH_LANES points. Vectorized equivalent of Compute<calcModeNormal>
+// for single Mandelbulb or Mandelbox formula
+template <enumBatchFormula formula>
+static void ComputeBatchLanes(const cNineFractals &fractals, const sFractalBatchIn &in,
+	int formulaIndex, int first, sFractalOut *out)
+{
+	const sFractal *fractal = fractals.GetFractal(formulaIndex);
+	const double bailout = fractals.GetBailout(formulaIndex);
+
+	double zx[FRACTAL_BATCH_LANES], zy[FRACTAL_BATCH_LANES], zz[FRACTAL_BATCH_LANES],
+		zw[FRACTAL_BATCH_LANES];
+	double cx[FRACTAL_BATCH_LANES], cy[FRACTAL_BATCH_LANES], cz[FRACTAL_BATCH_LANES],
+		cw[FRACTAL_BATCH_LANES];
+	double r[FRACTAL_BATCH_LANES], DE[FRACTAL_BATCH_LANES];
+	int iters[FRACTAL_BATCH_LANES], active[FRACTAL_BATCH_LANES], maxiter[FRACTAL_BATCH_LANES];
+
+	// repeat, move and rotate. Missing points at the end of array are just copies of the last one
+	const double initialW = fractals.GetInitialWAxis(formulaIndex);
+	const bool addC = fractals.IsAddCConstant(formulaIndex);
+	const bool julia = fractals.IsJuliaEnabled(formulaIndex);
+	const CVector3 constantMultiplier = fractals.GetConstantMultiplier(formulaIndex);
+	const CVector3 juliaC = fractals.GetJuliaConstant(formulaIndex) * constantMultiplier;
+	for (int l = 0; l < FRACTAL_BATCH_LANES; l++)
+	{
+		int index = min(first + l, in.count - 1);
+		CVector3 point(in.x[index], in.y[index], in.z[index]);
+		CVector3 pointTransformed = (point - in.common.fractalPosition).mod(in.common.repeat);
+		pointTransformed = in.common.mRotFractalRotation.RotateVector(pointTransformed);
+		zx[l] = pointTransformed.x;
+		zy[l] = pointTransformed.y;
+		zz[l] = pointTransformed.z;
+		zw[l] = initialW;
+
+		// constant added in each iteration
+		if (!addC)
+		{
+			cx[l] = cy[l] = cz[l] = cw[l] = 0.0;
+		}
+		else if (julia)
+		{
+			cx[l] = juliaC.x;
+			cy[l] = juliaC.y;
+			cz[l] = juliaC.z;
+			cw[l] = 0.0;
+		}
+		else
+		{
+			cx[l] = zx[l] * constantMultiplier.x;
+			cy[l] = zy[l] * constantMultiplier.y;
+			cz[l] = zz[l] * constantMultiplier.z;
+			cw[l] = zw[l];
+		}
+
+		r[l] = sqrt(zx[l] * zx[l] + zy[l] * zy[l] + zz[l] * zz[l] + zw[l] * zw[l]);
+		DE[l] = 1.0;
+		iters[l] = in.maxN + 1;
+		active[l] = 1;
+		maxiter[l] = in.common.iterThreshMode;
+	}
+
+	const double power = fractal->bulb.power;
+	const double alphaAngleOffset = fractal->bulb.alphaAngleOffset;
+	const double betaAngleOffset = fractal->bulb.betaAngleOffset;
+	const double foldingLimit = fractal->mandelbox.foldingLimit;
+	const double foldingValue = fractal->mandelbox.foldingValue;
+	const CVector4 offset = fractal->mandelbox.offset;
+	const double mR2 = fractal->mandelbox.mR2;
+	const double fR2 = fractal->mandelbox.fR2;
+	const double mboxFactor1 = fractal->mandelbox.mboxFactor1;
+	const double scale = fractal->mandelbox.scale;
+
+	for (int i = 0; i < in.maxN; i++)
+	{
+		int activeCount = 0;
+
+#pragma omp simd reduction(+ : activeCount)
+		for (int l = 0; l < FRACTAL_BATCH_LANES; l++)
+		{
+			double nx, ny, nz, nw, newDE;
+			if (formula == batchFormulaMandelbulb)
+			{
+				// MandelbulbIteration()
+				const double th0 = asin(zz[l] / r[l]) + betaAngleOffset;
+				const double ph0 = atan2(zy[l], zx[l]) + alphaAngleOffset;
+				double rp = pow(r[l], power - 1.0);
+				const double th = th0 * power;
+				const double ph = ph0 * power;
+				const double cth = cos(th);
+				newDE = (rp * DE[l]) * power + 1.0;
+				rp *= r[l];
+				nx = cth * cos(ph) * rp;
+				ny = cth * sin(ph) * rp;
+				nz = sin(th) * rp;
+				nw = zw[l];
+			}
+			else
+			{
+				// MandelboxIteration() without rotations
+				nx = fabs(zx[l]) > foldingLimit ? (zx[l] > 0.0 ? foldingValue : -foldingValue) - zx[l]
+																				: zx[l];
+				ny = fabs(zy[l]) > foldingLimit ? (zy[l] > 0.0 ? foldingValue : -foldingValue) - zy[l]
+																				: zy[l];
+				nz = fabs(zz[l]) > foldingLimit ? (zz[l] > 0.0 ? foldingValue : -foldingValue) - zz[l]
+																				: zz[l];
+				nw = zw[l];
+
+				const double r2 = nx * nx + ny * ny + nz * nz + nw * nw;
+				const double sphereFactor = r2 < mR2 ? mboxFactor1 : (r2 < fR2 ? fR2 / r2 : 1.0);
+				nx = ((nx + offset.x) * sphereFactor - offset.x) * scale;
+				ny = ((ny + offset.y) * sphereFactor - offset.y) * scale;
+				nz = ((nz + offset.z) * sphereFactor - offset.z) * scale;
+				nw = ((nw + offset.w) * sphereFactor - offset.w) * scale;
+				newDE = DE[l] * sphereFactor * fabs(scale) + 1.0;
+			}
+
+			// addition of constant
+			nx += cx[l];
+			ny += cy[l];
+			nz += cz[l];
+			nw += cw[l];
+
+			const double newR = sqrt(nx * nx + ny * ny + nz * nz + nw * nw);
+			const bool finite =
+				IsFiniteBits(nx) & IsFiniteBits(ny) & IsFiniteBits(nz) & IsFiniteBits(nw);
+
+			// lanes which are already finished keep their values
+			const bool update = active[l] != 0;
+			const bool updateZ = update && finite;
+			zx[l] = updateZ ? nx : zx[l];
+			zy[l] = updateZ ? ny : zy[l];
+			zz[l] = updateZ ? nz : zz[l];
+			zw[l] = updateZ ? nw : zw[l];
+			r[l] = updateZ ? newR : r[l];
+			DE[l] = update ? newDE : DE[l];
+
+			// NaN detection or bailout
+			const bool finished = update && (!finite || newR > bailout);
+			maxiter[l] = finished ? !finite : maxiter[l];
+			iters[l] = finished ? i + 1 : iters[l];
+			active[l] = update && !finished;
+			activeCount += active[l];
+		}
+
+		if (activeCount == 0) break;
+	}
+
+	// final calculations
+	const enumDEAnalyticFunction DEFunction = fractals.GetDEAnalyticFunction(formulaIndex);
+	const int count = min(FRACTAL_BATCH_LANES, in.count - first);
+	for (int l = 0; l < count; l++)
+	{
+		sFractalOut &pointOut = out[first + l];
+		if (DEFunction == analyticFunctionLogarithmic)
+			pointOut.distance = DE[l] > 0 ? 0.5 * r[l] * log(r[l]) / DE[l] : r[l];
+		else
+			pointOut.distance = r[l] / fabs(DE[l]);
+		pointOut.z = CVector3(zx[l], zy[l], zz[l]);
+		pointOut.iters = iters[l];
+		pointOut.maxiter = maxiter[l];
+		pointOut.orbitTrapR = 0.0;
+	}
+}
+
+template <fractal::enumCalculationMode Mode>
+void Compute(const cNineFractals &fractals, const sFractalBatchIn &in, sFractalOut *out)
+{
+	const int formulaIndex = max(in.forcedFormulaIndex, 0);
+	const enumBatchFormula batchFormula = GetBatchFormula(fractals, formulaIndex, in.common, Mode);
+
+	switch (batchFormula)
+	{
+		case batchFormulaMandelbulb:
+			for (int first = 0; first < in.count; first += FRACTAL_BATCH_LANES)
+				ComputeBatchLanes<batchFormulaMandelbulb>(fractals, in, formulaIndex, first, out);
+			break;
+		case batchFormulaMandelbox:
+			for (int first = 0; first < in.count; first += FRACTAL_BATCH_LANES)
+				ComputeBatchLanes<batchFormulaMandelbox>(fractals, in, formulaIndex, first, out);
+			break;
+		case batchFormulaNone:
+		{
+			// no vectorized version - point by point
+			for (int i = 0; i < in.count; i++)
+			{
+				sFractalIn pointIn(CVector3(in.x[i], in.y[i], in.z[i]), in.minN, in.maxN, in.common,
+					in.forcedFormulaIndex, in.material);
+				Compute<Mode>(fractals, pointIn, &out[i]);
+			}
+			break;
+		}
+	}
+}
+
+template void Compute<calcModeNormal>(
+	const cNineFractals &fractals, const sFractalBatchIn &in, sFractalOut *out);
+template void Compute<calcModeDeltaDE1>(
+	const cNineFractals &fractals, const sFractalBatchIn &in, sFractalOut *out);
+template void Compute<calcModeDeltaDE2>(
+	const cNineFractals &fractals, const sFractalBatchIn &in, sFractalOut *out);
+template void Compute<calcModeColouring>(
+	const cNineFractals &fractals, const sFractalBatchIn &in, sFractalOut *out);
+template void Compute<calcModeOrbitTrap>(
+	const cNineFractals &fractals, const sFractalBatchIn &in, sFractalOut *out);
+template void Compute<calcModeCubeOrbitTrap>(
+	const cNineFractals &fractals, const sFractalBatchIn &in, sFractalOut *out);
@@ -77,7 +77,40 @@ struct sFractalOut
 	bool maxiter;
 };
 
+// input for calculation of many points at once. Coordinates are stored as structure of arrays
+struct sFractalBatchIn
+{
+	const double *x;
+	const double *y;
+	const double *z;
+	int count;
+	int minN;
+	int maxN;
+	sCommonParams common;
+	int forcedFormulaIndex;
+	const cMaterial *material;
+
+	sFractalBatchIn(const double *_x, const double *_y, const double *_z, int _count, int _minN,
+		int _maxN, sCommonParams _common, int _forcedFormulaIndex, const cMaterial *_material = nullptr)
+			: x(_x),
+				y(_y),
+				z(_z),
+				count(_count),
+				minN(_minN),
+				maxN(_maxN),
+				common(std::move(_common)),
+				forcedFormulaIndex(_forcedFormulaIndex),
+				material(_material)
+	{
+	}
+};
+
 template <fractal::enumCalculationMode Mode>
 void Compute(const cNineFractals &fractals, const sFractalIn &in, sFractalOut *out);
 
+// calculates in.count points. Formulas which have vectorized version are calculated for many
+// points at once, other ones point by point. out has to be an array of in.count elements
+template <fractal::enumCalculationMode Mode>
+void Compute(const cNineFractals &fractals, const sFractalBatchIn &in, sFractalOut *out);
+
 #endif /* MANDELBULBER2_SRC_COMPUTE_FRACTAL_HPP_ */
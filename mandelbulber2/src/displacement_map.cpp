@@ -43,16 +43,15 @@ double DisplacementMap(
 	double oldDistance, CVector3 point, int objectId, sRenderData *data, double reduce)
 {
 	double distance = oldDistance;
-	if (data)
+	if (data && data->anyDisplacementMap)
 	{
-		const cMaterial *mat = &data->materials[data->objectData[objectId].materialId];
-
-		if (mat->displacementTexture.IsLoaded())
+		const sRenderObject &object = data->objects.at(objectId);
+		if (object.displacementMap)
 		{
+			const cMaterial *mat = object.material;
 			CVector2<double> textureCoordinates;
-			textureCoordinates =
-				TextureMapping(point, CVector3(0.0, 0.0, 1.0), data->objectData[objectId], mat)
-				+ CVector2<double>(0.5, 0.5);
+			textureCoordinates = TextureMapping(point, CVector3(0.0, 0.0, 1.0), *object.object, mat)
+													 + CVector2<double>(0.5, 0.5);
 			sRGBFloat bump3 = mat->displacementTexture.Pixel(textureCoordinates);
 			double bump = bump3.R;
 			distance -= bump * mat->displacementTextureHeight / reduce;
@@ -69,11 +68,12 @@ CVector3 FractalizeTexture(const CVector3 &point, sRenderData *data, const sPara
 	if (objectId < 0) objectId = 0;
 
 	CVector3 pointFractalized = point;
-	if (data)
+	if (data && data->anyFractalizedTexture)
 	{
-		const cMaterial *mat = &data->materials[data->objectData[objectId].materialId];
-		if (mat->textureFractalize)
+		const sRenderObject &object = data->objects.at(objectId);
+		if (object.fractalizedTexture)
 		{
+			const cMaterial *mat = object.material;
 			sFractalIn fractIn(point, 0, params.N, params.common, forcedFormulaIndex, mat);
 			sFractalOut fractOut;
 			Compute<fractal::calcModeCubeOrbitTrap>(fractals, fractIn, &fractOut);
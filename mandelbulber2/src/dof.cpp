@@ -35,9 +35,11 @@
 #include "dof.hpp"
 
 #include <algorithm>
+#include <vector>
 
 #include "common_math.h"
 #include "global_data.hpp"
+#include "pixel_random.hpp"
 #include "progress_text.hpp"
 
 using std::max;
@@ -52,12 +54,28 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 {
 	int imageWidth = image->GetWidth();
 	int imageHeight = image->GetHeight();
+	quint64 numberOfPixels = quint64(imageWidth) * quint64(imageHeight);
 
-	sRGBFloat *temp_image = new sRGBFloat[quint64(imageWidth) * quint64(imageHeight)];
-	unsigned short *temp_alpha = new unsigned short[quint64(imageWidth) * quint64(imageHeight)];
+	// direct access to image buffers. All coordinates used below are already inside the image
+	sRGBFloat *postImage = image->GetPostImageFloatPtr();
+	quint16 *alphaBuffer = image->GetAlphaBufPtr();
+	const float *zBuffer = image->GetZBufferPtr();
+
+	sRGBFloat *temp_image = new sRGBFloat[numberOfPixels];
+	unsigned short *temp_alpha = new unsigned short[numberOfPixels];
 	quint64 sortBufferSize = quint64(screenRegion.height) * quint64(screenRegion.width);
 	sSortZ<float> *temp_sort = new sSortZ<float>[sortBufferSize];
 
+	// circle of confusion (signed blur radius) calculated once for every pixel
+	float *blurMap = new float[numberOfPixels];
+
+#pragma omp parallel for schedule(static)
+	for (qint64 ptr = 0; ptr < qint64(numberOfPixels); ptr++)
+	{
+		float z = zBuffer[ptr];
+		blurMap[ptr] = (z - neutral) / z * deep;
+	}
+
 	{
 		quint64 index = 0;
 		for (int y = screenRegion.y1; y < screenRegion.y2; y++)
@@ -65,9 +83,9 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 			for (int x = screenRegion.x1; x < screenRegion.x2; x++)
 			{
 				quint64 ptr = quint64(x) + quint64(y) * quint64(imageWidth);
-				temp_image[ptr] = image->GetPixelPostImage(x, y);
-				temp_alpha[ptr] = image->GetPixelAlpha(x, y);
-				temp_sort[index].z = image->GetPixelZBuffer(x, y);
+				temp_image[ptr] = postImage[ptr];
+				temp_alpha[ptr] = alphaBuffer[ptr];
+				temp_sort[index].z = zBuffer[ptr];
 				temp_sort[index].i = ptr;
 				index++;
 			}
@@ -94,87 +112,72 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 	try
 	{
 		// preprocessing (1-st phase)
-		for (int y = screenRegion.y1; y < screenRegion.y2; y++)
+		// region is divided into tiles. Tiles are calculated in parallel in batches, so all threads
+		// are busy also for narrow images and progress can be checked between batches
+		const int tileSize = 16;
+		const int tilesX = (screenRegion.width + tileSize - 1) / tileSize;
+		const int tilesY = (screenRegion.height + tileSize - 1) / tileSize;
+		const int numberOfTiles = tilesX * tilesY;
+		const int tilesInBatch = max(256, tilesX);
+
+		// the biggest circle of confusion in the tile bounds the gather range of all its pixels.
+		// Tiles which are entirely in focus don't need to gather anything
+		std::vector<float> tileMaxBlur(numberOfTiles);
+
+#pragma omp parallel for schedule(static)
+		for (int tile = 0; tile < numberOfTiles; tile++)
+		{
+			const cRegion<int> tileRegion = TileRegion(screenRegion, tile, tilesX, tileSize);
+			float maxBlur = 0.0f;
+			for (int y = tileRegion.y1; y < tileRegion.y2; y++)
+			{
+				for (int x = tileRegion.x1; x < tileRegion.x2; x++)
+				{
+					maxBlur = max(maxBlur, fabsf(blurMap[quint64(x) + quint64(y) * quint64(imageWidth)]));
+				}
+			}
+			tileMaxBlur[tile] = min(maxBlur, maxRadius);
+		}
+
+		for (int batchStart = 0; batchStart < numberOfTiles; batchStart += tilesInBatch)
 		{
 			if (*stopRequest) throw tr("DOF terminated");
 
-#pragma omp parallel for schedule(dynamic, 1)
+			const int batchEnd = min(batchStart + tilesInBatch, numberOfTiles);
 
-			for (int x = screenRegion.x1; x < screenRegion.x2; x++)
+#pragma omp parallel for schedule(dynamic, 1)
+			for (int tile = batchStart; tile < batchEnd; tile++)
 			{
-				float z = image->GetPixelZBuffer(x, y);
-				float blur1 = (z - neutral) / z * deep;
-				float blur = fabs(blur1);
-				if (blur > maxRadius) blur = maxRadius;
-				int size = int(blur);
-				int xStart = max(x - size, 0);
-				int xStop = min(x + size, screenRegion.x2 - 1);
-				int yStart = max(y - size, 0);
-				int yStop = min(y + size, screenRegion.y2 - 1);
-
-				float totalWeight = 0.0f;
-				sRGBFloat tempPixel;
-				for (int yy = yStart; yy <= yStop; yy++)
+				const cRegion<int> tileRegion = TileRegion(screenRegion, tile, tilesX, tileSize);
+
+				// circles smaller than one pixel contain only the pixel itself
+				if (tileMaxBlur[tile] < 1.0f)
 				{
-					for (int xx = xStart; xx <= xStop; xx++)
+					for (int y = tileRegion.y1; y < tileRegion.y2; y++)
 					{
-						float dx = x - xx;
-						float dy = y - yy;
-						float r = sqrtf(dx * dx + dy * dy);
-						float weight = blur - r;
-						if (weight < 0.0f) weight = 0.0f;
-						if (weight > 1.0f) weight = 1.0f;
-
-						float z2 = image->GetPixelZBuffer(xx, yy);
-						float blur2 = (z2 - neutral) / z2 * deep;
-						if (blur1 > blur2)
-						{
-							if (blur1 * blur2 < 0)
-							{
-								weight = 0.0;
-							}
-							else
-							{
-								float weight2 = 0.0f;
-								if (blur1 > 0.0f)
-									weight2 = 1.1f - blur1 / blur2;
-								else
-									weight2 = 1.1f - blur2 / blur1;
-								if (weight2 < 0.0f) weight2 = 0.0f;
-								weight *= weight2 * 10.0f;
-							}
-						}
-
-						totalWeight += weight;
-						if (weight > 0.0f)
-						{
-							sRGBFloat pix = image->GetPixelPostImage(xx, yy);
-							tempPixel.R += pix.R * weight;
-							tempPixel.G += pix.G * weight;
-							tempPixel.B += pix.B * weight;
-						}
+						const quint64 rowPtr = quint64(y) * quint64(imageWidth);
+						std::copy(postImage + rowPtr + tileRegion.x1, postImage + rowPtr + tileRegion.x2,
+							temp_image + rowPtr + tileRegion.x1);
 					}
+					continue;
 				}
 
-				sRGBFloat newPixel;
-				if (totalWeight > 0.0f)
+				for (int y = tileRegion.y1; y < tileRegion.y2; y++)
 				{
-					newPixel = sRGBFloat(
-						tempPixel.R / totalWeight, tempPixel.G / totalWeight, tempPixel.B / totalWeight);
-				}
-				else
-				{
-					newPixel = image->GetPixelPostImage(x, y);
+					for (int x = tileRegion.x1; x < tileRegion.x2; x++)
+					{
+						quint64 ptr = quint64(x) + quint64(y) * quint64(imageWidth);
+						temp_image[ptr] =
+							GatherPixel(x, y, screenRegion, imageWidth, postImage, blurMap, maxRadius);
+					}
 				}
-				quint64 ptr = quint64(x) + quint64(y) * quint64(imageWidth);
-				temp_image[ptr] = newPixel;
 			}
 
 			if (timerRefreshProgressBar.elapsed() > 100)
 			{
 				timerRefreshProgressBar.restart();
 
-				percentDone = float(y - screenRegion.y1) / screenRegion.height;
+				percentDone = float(batchEnd) / numberOfTiles;
 				progressTxt = progressText.getText(percentDone / (numberOfPasses + 1));
 
 				emit updateProgressAndStatus(statusText, progressTxt, percentDone / (numberOfPasses + 1));
@@ -184,11 +187,9 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 
 		for (int y = screenRegion.y1; y < screenRegion.y2; y++)
 		{
-			for (int x = screenRegion.x1; x < screenRegion.x2; x++)
-			{
-				int ptr = x + y * imageWidth;
-				image->PutPixelPostImage(x, y, temp_image[ptr]);
-			}
+			quint64 rowPtr = quint64(y) * quint64(imageWidth);
+			std::copy(temp_image + rowPtr + screenRegion.x1, temp_image + rowPtr + screenRegion.x2,
+				postImage + rowPtr + screenRegion.x1);
 		}
 
 		image->CompileImage();
@@ -207,7 +208,7 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 			statusText, QObject::tr("Sorting zBuffer"), 1.0 / (numberOfPasses + 1.0));
 		gApplication->processEvents();
 
-		QuickSortZBuffer(temp_sort, 1, sortBufferSize - 1);
+		SortZBuffer(temp_sort, sortBufferSize);
 
 		for (int pass = 0; pass < numberOfPasses; pass++)
 		{
@@ -221,61 +222,22 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 			lastRefreshTime = 0;
 
 			// Randomize Z-buffer
+			// sorted buffer is shuffled in independent chunks, every one with its own random numbers,
+			// so chunks can be processed in parallel and the result doesn't depend on threads
+			const qint64 chunkSize = 65536;
+			const qint64 numberOfChunks = (qint64(sortBufferSize) + chunkSize - 1) / chunkSize;
 
-			for (qint64 i = sortBufferSize - 1; i >= 0; i--)
+#pragma omp parallel for schedule(dynamic, 1)
+			for (qint64 chunk = 0; chunk < numberOfChunks; chunk++)
 			{
-				if (*stopRequest) throw tr("DOF terminated");
-				sSortZ<float> temp;
-				temp = temp_sort[i];
-				float z1 = temp.z;
-				float size1 = (z1 - neutral) / z1 * deep;
-
-				qint64 randomStep = i;
-
-				bool done = false;
-				qint64 ii;
-				do
-				{
-					ii = i - Random(randomStep);
-					if (ii <= 0) ii = 0;
-					sSortZ<float> temp2 = temp_sort[ii];
-					float z2 = temp2.z;
-					float size2 = (z2 - neutral) / z2 * deep;
-
-					if (size1 * size2 > 0)
-					{
-						float sizeCompare;
-						if (size1 > 0)
-						{
-							sizeCompare = size2 / size1;
-						}
-						else
-						{
-							sizeCompare = size1 / size2;
-						}
-
-						int intDiff = int((1.0f - sizeCompare) * 500);
-						intDiff *= intDiff;
-						if (intDiff < Random(10000))
-						{
-							done = true;
-						}
-						else
-						{
-							done = false;
-						}
-					}
-					else
-					{
-						done = false;
-					}
-					randomStep = int(randomStep * 0.7 - 1.0);
-
-					if (randomStep <= 0) done = true;
-				} while (!done);
-				temp_sort[i] = temp_sort[ii];
-				temp_sort[ii] = temp;
+				if (*stopRequest) continue;
+				const qint64 chunkStart = chunk * chunkSize;
+				const qint64 chunkEnd = min(chunkStart + chunkSize, qint64(sortBufferSize));
+				cPixelRandom random;
+				random.SetKey(int(chunk), pass, 0, 0);
+				RandomizeZBuffer(temp_sort + chunkStart, chunkEnd - chunkStart, blurMap, &random);
 			}
+			if (*stopRequest) throw tr("DOF terminated");
 
 			for (int i = 0; i < screenRegion.width; i++)
 			{
@@ -287,36 +249,46 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 					quint64 ii = temp_sort[sortBufferSize - index - 1].i;
 					int x = int(ii % quint64(imageWidth));
 					int y = int(ii / quint64(imageWidth));
-					float z = image->GetPixelZBuffer(x, y);
+					float z = zBuffer[ii];
 					float blur = fabs(z - neutral) / z * deep + 1.0f;
 					if (blur > maxRadius) blur = maxRadius;
 					int size = int(blur);
-					sRGBFloat center = temp_image[x + y * imageWidth];
-					unsigned short center_alpha = temp_alpha[x + y * imageWidth];
+					sRGBFloat center = temp_image[ii];
+					unsigned short center_alpha = temp_alpha[ii];
 					float blur_2 = blur * blur;
 					float factor = (float(M_PI) * (blur_2 - blur) + 1.0f) / blurOpacity;
 
-					for (int yy = y - size; yy <= y + size; yy++)
+					// circle clipped to the screen region
+					int yStart = max(y - size, screenRegion.y1);
+					int yStop = min(y + size, screenRegion.y2 - 1);
+					int xStart = max(x - size, screenRegion.x1);
+					int xStop = min(x + size, screenRegion.x2 - 1);
+
+					for (int yy = yStart; yy <= yStop; yy++)
 					{
-						for (int xx = x - size; xx <= x + size; xx++)
+						const quint64 rowPtr = quint64(yy) * quint64(imageWidth);
+						int dy = yy - y;
+						for (int xx = xStart; xx <= xStop; xx++)
 						{
-							if (xx >= screenRegion.x1 && xx < screenRegion.x2 && yy >= screenRegion.y1
-									&& yy < screenRegion.y2)
+							int dx = xx - x;
+							float r_2 = dx * dx + dy * dy;
+							if (blur_2 > r_2)
 							{
-								int dx = xx - x;
-								int dy = yy - y;
-								float r_2 = dx * dx + dy * dy;
-								if (blur_2 > r_2)
-								{
-									float r = sqrt(r_2);
-									float op = (blur - r);
-									if (op < 0.0f) op = 0.0f;
-									if (op > 1.0f) op = 1.0f;
-									op /= factor;
-									if (op > 1.0f) op = 1.0f;
-									image->BlendPixelPostImage(xx, yy, op, center);
-									image->BlendPixelAlpha(xx, yy, op, center_alpha);
-								}
+								float r = sqrt(r_2);
+								float op = (blur - r);
+								if (op < 0.0f) op = 0.0f;
+								if (op > 1.0f) op = 1.0f;
+								op /= factor;
+								if (op > 1.0f) op = 1.0f;
+
+								// the same as cImage::BlendPixelPostImage() and cImage::BlendPixelAlpha()
+								float opN = 1.0f - op;
+								sRGBFloat &pixel = postImage[rowPtr + xx];
+								pixel.R = pixel.R * opN + center.R * op;
+								pixel.G = pixel.G * opN + center.G * op;
+								pixel.B = pixel.B * opN + center.B * op;
+								quint16 &alpha = alphaBuffer[rowPtr + xx];
+								alpha = quint16(alpha * opN + center_alpha * op);
 							}
 						}
 					}
@@ -338,8 +310,7 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 				{
 					timerRefresh.restart();
 
-					image->CompileImage();
-					image->ConvertTo8bit();
+					image->CompileImageAndConvertTo8bit();
 					image->UpdatePreview();
 					emit updateImage();
 
@@ -358,54 +329,154 @@ void cPostRenderingDOF::Render(cRegion<int> screenRegion, float deep, float neut
 		delete[] temp_image;
 		delete[] temp_alpha;
 		delete[] temp_sort;
+		delete[] blurMap;
 	}
 }
 
-template <class T>
-void cPostRenderingDOF::QuickSortZBuffer(sSortZ<T> *buffer, quint64 l, quint64 r)
+cRegion<int> cPostRenderingDOF::TileRegion(
+	const cRegion<int> &screenRegion, int tile, int tilesX, int tileSize)
 {
-	// Sorts buffer by value of z asc
-	quint64 i, j;
-	// Operating buffer typed variables
-	sSortZ<T> pivot, swap;
-	i = l;
-	j = r;
-	// set pivot to center of buffer
-	pivot = buffer[(l + r) / 2];
-	do
+	const int x1 = screenRegion.x1 + (tile % tilesX) * tileSize;
+	const int y1 = screenRegion.y1 + (tile / tilesX) * tileSize;
+	return cRegion<int>(
+		x1, y1, min(x1 + tileSize, screenRegion.x2), min(y1 + tileSize, screenRegion.y2));
+}
+
+sRGBFloat cPostRenderingDOF::GatherPixel(int x, int y, const cRegion<int> &screenRegion,
+	int imageWidth, const sRGBFloat *postImage, const float *blurMap, float maxRadius)
+{
+	quint64 ptr = quint64(x) + quint64(y) * quint64(imageWidth);
+	float blur1 = blurMap[ptr];
+	float blur = fabs(blur1);
+	if (blur > maxRadius) blur = maxRadius;
+	int size = int(blur);
+	int yStart = max(y - size, 0);
+	int yStop = min(y + size, screenRegion.y2 - 1);
+	const float blur_2 = blur * blur;
+
+	float totalWeight = 0.0f;
+	sRGBFloat tempPixel;
+	for (int yy = yStart; yy <= yStop; yy++)
 	{
-		while (buffer[i].z < pivot.z)
-		{
-			i++;
-		}
-		while (pivot.z < buffer[j].z)
-		{
-			j--;
-		}
-		if (i <= j)
+		const quint64 rowPtr = quint64(yy) * quint64(imageWidth);
+		const float dy = y - yy;
+
+		// only the part of the row which is inside the circle of confusion
+		const float chord_2 = blur_2 - dy * dy;
+		if (chord_2 <= 0.0f) continue;
+		const int halfChord = int(sqrtf(chord_2));
+		int xStart = max(x - min(size, halfChord), 0);
+		int xStop = min(x + min(size, halfChord), screenRegion.x2 - 1);
+
+		for (int xx = xStart; xx <= xStop; xx++)
 		{
-			/* buffer[i] is to the left of pivot but greater
-			 *  buffer[j] is to the right of pivot but smaller
-			 * -> swap values of buffer[i] <> buffer[j] */
-			swap = buffer[i];
-			buffer[i] = buffer[j];
-			buffer[j] = swap;
-			i++;
-			j--;
+			float dx = x - xx;
+			float r = sqrtf(dx * dx + dy * dy);
+			float weight = blur - r;
+			if (weight <= 0.0f) continue; // pixel outside the circle of confusion
+			if (weight > 1.0f) weight = 1.0f;
+
+			float blur2 = blurMap[rowPtr + xx];
+			if (blur1 > blur2)
+			{
+				if (blur1 * blur2 < 0)
+				{
+					weight = 0.0;
+				}
+				else
+				{
+					float weight2 = 0.0f;
+					if (blur1 > 0.0f)
+						weight2 = 1.1f - blur1 / blur2;
+					else
+						weight2 = 1.1f - blur2 / blur1;
+					if (weight2 < 0.0f) weight2 = 0.0f;
+					weight *= weight2 * 10.0f;
+				}
+			}
+
+			totalWeight += weight;
+			if (weight > 0.0f)
+			{
+				const sRGBFloat &pix = postImage[rowPtr + xx];
+				tempPixel.R += pix.R * weight;
+				tempPixel.G += pix.G * weight;
+				tempPixel.B += pix.B * weight;
+			}
 		}
-	} while (i <= j);
+	}
 
-	// sort left side of pivot element
-	if (l < j)
+	if (totalWeight > 0.0f)
+	{
+		return sRGBFloat(
+			tempPixel.R / totalWeight, tempPixel.G / totalWeight, tempPixel.B / totalWeight);
+	}
+	else
 	{
-		QuickSortZBuffer(buffer, l, j);
+		return postImage[ptr];
 	}
+}
 
-	// sort right side of pivot element
-	if (i < r)
+void cPostRenderingDOF::RandomizeZBuffer(
+	sSortZ<float> *buffer, qint64 size, const float *blurMap, cPixelRandom *random)
+{
+	for (qint64 i = size - 1; i >= 0; i--)
 	{
-		QuickSortZBuffer(buffer, i, r);
+		sSortZ<float> temp;
+		temp = buffer[i];
+		float size1 = blurMap[temp.i];
+
+		qint64 randomStep = i;
+
+		bool done = false;
+		qint64 ii;
+		do
+		{
+			ii = i - random->Random(int(randomStep));
+			if (ii <= 0) ii = 0;
+			float size2 = blurMap[buffer[ii].i];
+
+			if (size1 * size2 > 0)
+			{
+				float sizeCompare;
+				if (size1 > 0)
+				{
+					sizeCompare = size2 / size1;
+				}
+				else
+				{
+					sizeCompare = size1 / size2;
+				}
+
+				int intDiff = int((1.0f - sizeCompare) * 500);
+				intDiff *= intDiff;
+				if (intDiff < random->Random(10000))
+				{
+					done = true;
+				}
+				else
+				{
+					done = false;
+				}
+			}
+			else
+			{
+				done = false;
+			}
+			randomStep = int(randomStep * 0.7 - 1.0);
+
+			if (randomStep <= 0) done = true;
+		} while (!done);
+		buffer[i] = buffer[ii];
+		buffer[ii] = temp;
 	}
 }
-template void cPostRenderingDOF::QuickSortZBuffer<float>(
-	sSortZ<float> *buffer, quint64 l, quint64 p);
+
+template <class T>
+void cPostRenderingDOF::SortZBuffer(sSortZ<T> *buffer, quint64 size)
+{
+	// Sorts buffer by value of z asc
+	std::sort(buffer, buffer + size,
+		[](const sSortZ<T> &a, const sSortZ<T> &b) { return a.z < b.z; });
+}
+template void cPostRenderingDOF::SortZBuffer<float>(sSortZ<float> *buffer, quint64 size);
@@ -38,6 +38,8 @@
 #include "cimage.hpp"
 #include "region.hpp"
 
+class cPixelRandom;
+
 class cPostRenderingDOF : public QObject
 {
 	Q_OBJECT
@@ -54,10 +56,19 @@ public:
 	void Render(cRegion<int> screenRegion, float deep, float neutral, int numberOfPasses,
 		float blurOpacity, float maxRadius, bool *stopRequest);
 	template <class T>
-	static void QuickSortZBuffer(sSortZ<T> *buffer, quint64 l, quint64 p);
+	static void SortZBuffer(sSortZ<T> *buffer, quint64 size);
+	// phase I for one pixel: average of pixels inside its circle of confusion
+	static sRGBFloat GatherPixel(int x, int y, const cRegion<int> &screenRegion, int imageWidth,
+		const sRGBFloat *postImage, const float *blurMap, float maxRadius);
 
 	cImage *image;
 
+private:
+	static cRegion<int> TileRegion(
+		const cRegion<int> &screenRegion, int tile, int tilesX, int tileSize);
+	static void RandomizeZBuffer(
+		sSortZ<float> *buffer, qint64 size, const float *blurMap, cPixelRandom *random);
+
 signals:
 	void updateProgressAndStatus(const QString &text, const QString &progressText, double progress);
 	void updateImage();
@@ -44,6 +44,15 @@ cErrorMessage *gErrorMessage = nullptr;
 
 void cErrorMessage::showMessage(QString text, enumMessageType messageType, QWidget *parent)
 {
+	// message box can be created only in GUI thread (e.g. error when image is saved in background)
+	if (gErrorMessage && QThread::currentThread() != gErrorMessage->thread())
+	{
+		QMetaObject::invokeMethod(gErrorMessage, "slotShowMessage", Qt::QueuedConnection,
+			Q_ARG(QString, text), Q_ARG(cErrorMessage::enumMessageType, messageType),
+			Q_ARG(QWidget *, parent));
+		return;
+	}
+
 	QTextStream out(stdout);
 	QTextStream outErr(stderr);
 
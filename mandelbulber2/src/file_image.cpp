@@ -69,6 +69,11 @@ ImageFileSave::ImageFileSave(QString filename, cImage *image, ImageConfig imageC
 	currentChannel = 0;
 	totalChannel = 0;
 	currentChannelKey = IMAGE_CONTENT_COLOR;
+	parallelChannels = false;
+
+	appendAlphaPreference = gPar->Get<bool>("append_alpha_png");
+	linearColorspace = gPar->Get<bool>("linear_colorspace");
+	jpegQuality = gPar->Get<int>("jpeg_quality");
 }
 
 ImageFileSave *ImageFileSave::create(
@@ -145,8 +150,38 @@ QString ImageFileSave::ImageNameWithoutExtension(QString path)
 	return fi.path() + QDir::separator() + fileName;
 }
 
+void ImageFileSave::SaveChannels()
+{
+	QList<structSaveImageChannel> channels = imageConfig.values();
+	currentChannel = 0;
+	totalChannel = channels.size();
+
+	if (parallelChannels)
+	{
+		// every channel is written to own file and converted from own image layer
+#pragma omp parallel for schedule(dynamic, 1)
+		for (int i = 0; i < channels.size(); i++)
+		{
+			SaveChannel(channels.at(i));
+		}
+	}
+	else
+	{
+		for (int i = 0; i < channels.size(); i++)
+		{
+			currentChannelKey = channels.at(i).contentType;
+			emit updateProgressAndStatus(getJobName(),
+				QObject::tr("Saving channel: %1").arg(ImageChannelName(currentChannelKey)),
+				1.0 * currentChannel / totalChannel);
+			SaveChannel(channels.at(i));
+			currentChannel++;
+		}
+	}
+}
+
 void ImageFileSave::updateProgressAndStatusChannel(double progress)
 {
+	if (parallelChannels) return;
 	emit updateProgressAndStatus(getJobName(),
 		QObject::tr("Saving channel: %1").arg(ImageChannelName(currentChannelKey)),
 		(1.0 * currentChannel / totalChannel) + (progress / totalChannel));
@@ -164,77 +199,63 @@ void ImageFileSavePNG::SaveImage()
 {
 	updateProgressAndStatusStarted();
 
-	bool appendAlpha = gPar->Get<bool>("append_alpha_png")
-										 && imageConfig.contains(IMAGE_CONTENT_COLOR)
-										 && imageConfig.contains(IMAGE_CONTENT_ALPHA);
+	appendAlpha = appendAlphaPreference && imageConfig.contains(IMAGE_CONTENT_COLOR)
+								&& imageConfig.contains(IMAGE_CONTENT_ALPHA);
 	if (hasAppendAlphaCustom) appendAlpha = appendAlphaCustom;
 
-	currentChannel = 0;
-	totalChannel = imageConfig.size();
-	for (ImageConfig::iterator channel = imageConfig.begin(); channel != imageConfig.end(); ++channel)
-	{
-		currentChannelKey = channel.key();
-		QString fullFilename = filename + channel.value().postfix + ".png";
-		emit updateProgressAndStatus(getJobName(),
-			QObject::tr("Saving channel: %1").arg(ImageChannelName(currentChannelKey)),
-			1.0 * currentChannel / totalChannel);
+	SaveChannels();
+	updateProgressAndStatusFinished();
+}
 
-		switch (currentChannelKey)
-		{
-			case IMAGE_CONTENT_COLOR: SavePNG(fullFilename, image, channel.value(), appendAlpha); break;
-			case IMAGE_CONTENT_ALPHA:
-				if (!appendAlpha) SavePNG(fullFilename, image, channel.value());
-				break;
-			case IMAGE_CONTENT_ZBUFFER:
-			case IMAGE_CONTENT_NORMAL:
-			case IMAGE_CONTENT_SPECULAR:
-			default: SavePNG(fullFilename, image, channel.value()); break;
-		}
-		currentChannel++;
+void ImageFileSavePNG::SaveChannel(const structSaveImageChannel &imageChannel)
+{
+	QString fullFilename = filename + imageChannel.postfix + ".png";
+	switch (imageChannel.contentType)
+	{
+		case IMAGE_CONTENT_COLOR: SavePNG(fullFilename, image, imageChannel, appendAlpha); break;
+		case IMAGE_CONTENT_ALPHA:
+			if (!appendAlpha) SavePNG(fullFilename, image, imageChannel);
+			break;
+		case IMAGE_CONTENT_ZBUFFER:
+		case IMAGE_CONTENT_NORMAL:
+		case IMAGE_CONTENT_SPECULAR:
+		default: SavePNG(fullFilename, image, imageChannel); break;
 	}
-	updateProgressAndStatusFinished();
 }
 
 void ImageFileSaveJPG::SaveImage()
 {
 	updateProgressAndStatusStarted();
+	SaveChannels();
+	updateProgressAndStatusFinished();
+}
 
-	currentChannel = 0;
-	totalChannel = imageConfig.size();
-	for (ImageConfig::iterator channel = imageConfig.begin(); channel != imageConfig.end(); ++channel)
+void ImageFileSaveJPG::SaveChannel(const structSaveImageChannel &imageChannel)
+{
+	QString fullFilename = filename + imageChannel.postfix + ".jpg";
+	switch (imageChannel.contentType)
 	{
-		currentChannelKey = channel.key();
-		QString fullFilename = filename + channel.value().postfix + ".jpg";
-		emit updateProgressAndStatus(getJobName(),
-			QObject::tr("Saving channel: %1").arg(ImageChannelName(currentChannelKey)),
-			1.0 * currentChannel / totalChannel);
-
-		switch (currentChannelKey)
-		{
-			case IMAGE_CONTENT_COLOR:
-				SaveJPEGQt(fullFilename, image->ConvertTo8bit(), image->GetWidth(), image->GetHeight(),
-					gPar->Get<int>("jpeg_quality"));
-				break;
-			case IMAGE_CONTENT_ALPHA:
-				SaveJPEGQtGreyscale(fullFilename, image->ConvertAlphaTo8bit(), image->GetWidth(),
-					image->GetHeight(), gPar->Get<int>("jpeg_quality"));
-				break;
-			case IMAGE_CONTENT_ZBUFFER:
-				qWarning() << "JPG cannot save zbuffer (loss of precision to strong)";
-				break;
-			case IMAGE_CONTENT_NORMAL:
-				SaveJPEGQt(fullFilename, image->ConvertNormalTo8Bit(), image->GetWidth(),
-					image->GetHeight(), gPar->Get<int>("jpeg_quality"));
-				break;
-			case IMAGE_CONTENT_SPECULAR:
-				SaveJPEGQt(fullFilename, image->ConvertSpecularTo8Bit(), image->GetWidth(),
-					image->GetHeight(), gPar->Get<int>("jpeg_quality"));
-				break;
-			default: qWarning() << "Unknown channel for JPG"; break;
-		}
-		currentChannel++;
+		case IMAGE_CONTENT_COLOR:
+			SaveJPEGQt(fullFilename, image->ConvertTo8bit(), image->GetWidth(), image->GetHeight(),
+				jpegQuality);
+			break;
+		case IMAGE_CONTENT_ALPHA:
+			SaveJPEGQtGreyscale(fullFilename, image->ConvertAlphaTo8bit(), image->GetWidth(),
+				image->GetHeight(), jpegQuality);
+			break;
+		case IMAGE_CONTENT_ZBUFFER:
+			qWarning() << "JPG cannot save zbuffer (loss of precision to strong)";
+			break;
+		case IMAGE_CONTENT_NORMAL:
+			SaveJPEGQt(fullFilename, image->ConvertNormalTo8Bit(), image->GetWidth(),
+				image->GetHeight(), jpegQuality);
+			break;
+		case IMAGE_CONTENT_SPECULAR:
+			SaveJPEGQt(fullFilename, image->ConvertSpecularTo8Bit(), image->GetWidth(),
+				image->GetHeight(), jpegQuality);
+			break;
+		default: qWarning() << "Unknown channel for JPG"; break;
 	}
-	updateProgressAndStatusFinished();
 }
 
 #ifdef USE_TIFF
@@ -242,34 +263,27 @@ void ImageFileSaveTIFF::SaveImage()
 {
 	updateProgressAndStatusStarted();
 
-	bool appendAlpha = gPar->Get<bool>("append_alpha_png")
-										 && imageConfig.contains(IMAGE_CONTENT_COLOR)
-										 && imageConfig.contains(IMAGE_CONTENT_ALPHA);
+	appendAlpha = appendAlphaPreference && imageConfig.contains(IMAGE_CONTENT_COLOR)
+								&& imageConfig.contains(IMAGE_CONTENT_ALPHA);
 
-	currentChannel = 0;
-	totalChannel = imageConfig.size();
-	for (ImageConfig::iterator channel = imageConfig.begin(); channel != imageConfig.end(); ++channel)
-	{
-		currentChannelKey = channel.key();
-		QString fullFilename = filename + channel.value().postfix + ".tiff";
-		emit updateProgressAndStatus(getJobName(),
-			QObject::tr("Saving channel: %1").arg(ImageChannelName(currentChannelKey)),
-			1.0 * currentChannel / totalChannel);
+	SaveChannels();
+	updateProgressAndStatusFinished();
+}
 
-		switch (currentChannelKey)
-		{
-			case IMAGE_CONTENT_COLOR: SaveTIFF(fullFilename, image, channel.value(), appendAlpha); break;
-			case IMAGE_CONTENT_ALPHA:
-				if (!appendAlpha) SaveTIFF(fullFilename, image, channel.value());
-				break;
-			case IMAGE_CONTENT_ZBUFFER:
-			case IMAGE_CONTENT_NORMAL:
-			case IMAGE_CONTENT_SPECULAR:
-			default: SaveTIFF(fullFilename, image, channel.value()); break;
-		}
-		currentChannel++;
+void ImageFileSaveTIFF::SaveChannel(const structSaveImageChannel &imageChannel)
+{
+	QString fullFilename = filename + imageChannel.postfix + ".tiff";
+	switch (imageChannel.contentType)
+	{
+		case IMAGE_CONTENT_COLOR: SaveTIFF(fullFilename, image, imageChannel, appendAlpha); break;
+		case IMAGE_CONTENT_ALPHA:
+			if (!appendAlpha) SaveTIFF(fullFilename, image, imageChannel);
+			break;
+		case IMAGE_CONTENT_ZBUFFER:
+		case IMAGE_CONTENT_NORMAL:
+		case IMAGE_CONTENT_SPECULAR:
+		default: SaveTIFF(fullFilename, image, imageChannel); break;
 	}
-	updateProgressAndStatusFinished();
 }
 #endif /* USE_TIFF */
 
@@ -643,124 +657,143 @@ void ImageFileSavePNG::SavePNG16(QString filename, int width, int height, sRGB16
 	}
 }
 
-void ImageFileSavePNG::SaveFromTilesPNG16(const char *filename, int width, int height, int tiles)
+ImageFileSavePNGStream::ImageFileSavePNGStream(
+	QString _filename, int _width, int _height, bool _sixteenBit)
+		: filename(std::move(_filename)),
+			width(_width),
+			height(_height),
+			sixteenBit(_sixteenBit),
+			rowsWritten(0),
+			failed(false),
+			finished(false),
+			fp(nullptr),
+			png_ptr(nullptr),
+			info_ptr(nullptr)
 {
-	/* create file */
-	string filenamePNG(filename);
-	filenamePNG += "_fromTiles.png";
-	FILE *fp = fopen(filenamePNG.c_str(), "wb");
-	if (!fp)
+	try
 	{
-		fprintf(stderr, "[write_png_file] File %s could not be opened for writing", filename);
-		return;
-	}
+		/* create file */
+		fp = fopen(filename.toLocal8Bit().constData(), "wb");
+		if (!fp) throw QString("[write_png_file] File could not be opened for writing.");
 
-	/* initialize stuff */
-	png_structp png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		/* initialize stuff */
+		png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+		if (!png_ptr) throw QString("[write_png_file] png_create_write_struct failed");
 
-	if (!png_ptr)
-	{
-		fprintf(stderr, "[write_png_file] png_create_write_struct failed");
-		fclose(fp);
-		return;
-	}
+		info_ptr = png_create_info_struct(png_ptr);
+		if (!info_ptr) throw QString("[write_png_file] png_create_info_struct failed");
 
-	png_info *info_ptr = png_create_info_struct(png_ptr);
-	if (!info_ptr)
-	{
-		fprintf(stderr, "[write_png_file] png_create_info_struct failed");
-		fclose(fp);
-		return;
-	}
+		if (setjmp(png_jmpbuf(png_ptr))) throw QString("[write_png_file] Error during init_io");
 
-	if (setjmp(png_jmpbuf(png_ptr)))
-	{
-		fprintf(stderr, "[write_png_file] Error during init_io");
-		fclose(fp);
-		return;
-	}
+		png_init_io(png_ptr, fp);
 
-	png_init_io(png_ptr, fp);
+		/* write header */
+		if (setjmp(png_jmpbuf(png_ptr))) throw QString("[write_png_file] Error during writing header");
 
-	/* write header */
-	if (setjmp(png_jmpbuf(png_ptr)))
+		png_set_IHDR(png_ptr, info_ptr, width, height, sixteenBit ? 16 : 8, PNG_COLOR_TYPE_RGB,
+			PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+
+		png_write_info(png_ptr, info_ptr);
+		if (sixteenBit)
+			png_set_swap(png_ptr);
+		else
+			row8.resize(width);
+	}
+	catch (QString &status)
 	{
-		fprintf(stderr, "[write_png_file] Error during writing header");
-		fclose(fp);
-		return;
+		Fail(status);
 	}
+}
 
-	png_set_IHDR(png_ptr, info_ptr, width * tiles, height * tiles, 16, PNG_COLOR_TYPE_RGB,
-		PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_BASE, PNG_FILTER_TYPE_BASE);
+ImageFileSavePNGStream::~ImageFileSavePNGStream()
+{
+	// file not completed (e.g. rendering was stopped)
+	if (!finished) Close();
+}
 
-	png_write_info(png_ptr, info_ptr);
-	png_set_swap(png_ptr);
+bool ImageFileSavePNGStream::WriteRow(const sRGB16 *row)
+{
+	if (failed) return false;
 
-	/* write bytes */
-	if (setjmp(png_jmpbuf(png_ptr)))
+	try
 	{
-		fprintf(stderr, "[write_png_file] Error during writing bytes");
-		fclose(fp);
-		return;
-	}
+		if (rowsWritten >= height) throw QString("[write_png_file] Too many rows");
 
-	FILE **files = new FILE *[tiles];
-
-	sRGB16 *rowBuffer = new sRGB16[width * tiles];
+		/* write bytes */
+		if (setjmp(png_jmpbuf(png_ptr))) throw QString("[write_png_file] Error during writing bytes");
 
-	for (int tileRow = 0; tileRow < tiles; tileRow++)
-	{
-		printf("Compiling image from tiles, row %d\n", tileRow);
-		for (int tile = 0; tile < tiles; tile++)
+		if (sixteenBit)
 		{
-			int fileNumber = tile + tileRow * tiles;
-			string filename2 = IndexFilename(filename, "tile", fileNumber);
-			files[tile] = fopen(filename2.c_str(), "rb");
+			png_write_row(png_ptr, reinterpret_cast<png_bytep>(const_cast<sRGB16 *>(row)));
 		}
-
-		for (int y = 0; y < height; y++)
+		else
 		{
-			for (int tile = 0; tile < tiles; tile++)
+			for (int x = 0; x < width; x++)
 			{
-				size_t result = fread(&rowBuffer[tile * width], 1, sizeof(sRGB16) * width, files[tile]);
-				if (result != sizeof(sRGB16) * width)
-				{
-					printf("Reading error of image tile files");
-					for (int tile2 = 0; tile2 < tiles; tile2++)
-						fclose(files[tile2]);
-					delete[] rowBuffer;
-					delete[] files;
-					return;
-				}
+				row8[x] = sRGB8(row[x].R >> 8, row[x].G >> 8, row[x].B >> 8);
 			}
-			png_write_rows(png_ptr, reinterpret_cast<png_bytep *>(&rowBuffer), 1);
-		}
-
-		for (int tile = 0; tile < tiles; tile++)
-		{
-			fclose(files[tile]);
-			int fileNumber = tile + tileRow * tiles;
-			string filename2 = IndexFilename(filename, "tile", fileNumber);
-			remove(filename2.c_str());
+			png_write_row(png_ptr, reinterpret_cast<png_bytep>(row8.data()));
 		}
+		rowsWritten++;
 	}
+	catch (QString &status)
+	{
+		Fail(status);
+		return false;
+	}
+	return true;
+}
 
-	/* end write */
-	if (setjmp(png_jmpbuf(png_ptr)))
+bool ImageFileSavePNGStream::Finish()
+{
+	if (failed) return false;
+
+	try
 	{
-		fprintf(stderr, "[write_png_file] Error during end of write");
-		delete[] rowBuffer;
-		delete[] files;
-		fclose(fp);
-		return;
+		if (rowsWritten != height) throw QString("[write_png_file] Not all rows were written");
+
+		/* end write */
+		if (setjmp(png_jmpbuf(png_ptr))) throw QString("[write_png_file] Error during end of write");
+
+		png_write_end(png_ptr, info_ptr);
+	}
+	catch (QString &status)
+	{
+		Fail(status);
+		return false;
 	}
 
-	png_write_end(png_ptr, info_ptr);
-	png_destroy_write_struct(&png_ptr, &info_ptr);
-	delete[] rowBuffer;
-	delete[] files;
+	Close();
+	finished = true;
+	return true;
+}
 
-	fclose(fp);
+void ImageFileSavePNGStream::Close()
+{
+	if (png_ptr)
+	{
+		if (info_ptr)
+		{
+			png_destroy_write_struct(&png_ptr, &info_ptr);
+		}
+		else
+		{
+			png_destroy_write_struct(&png_ptr, nullptr);
+		}
+	}
+	png_ptr = nullptr;
+	info_ptr = nullptr;
+	if (fp) fclose(fp);
+	fp = nullptr;
+}
+
+void ImageFileSavePNGStream::Fail(const QString &status)
+{
+	Close();
+	failed = true;
+	cErrorMessage::showMessage(
+		QObject::tr("Can't save image to PNG file!\n") + filename + "\n" + status,
+		cErrorMessage::errorMessage);
 }
 
 bool ImageFileSaveJPG::SaveJPEGQt(
@@ -880,7 +913,7 @@ void ImageFileSaveEXR::SaveEXR(
 	Imf::FrameBuffer frameBuffer;
 
 	header.compression() = Imf::ZIP_COMPRESSION;
-	bool linear = gPar->Get<bool>("linear_colorspace");
+	bool linear = linearColorspace;
 
 	if (imageConfig.contains(IMAGE_CONTENT_COLOR))
 	{
@@ -40,6 +40,7 @@
 #define MANDELBULBER2_SRC_FILE_IMAGE_HPP_
 
 #include <utility>
+#include <vector>
 
 #include <QtCore>
 
@@ -129,6 +130,9 @@ public:
 	virtual QString getJobName() = 0;
 	static const uint64_t SAVE_CHUNK_SIZE = 64;
 
+	// channels stored in separate files are encoded in parallel (without progress per channel)
+	void SetParallelChannels(bool enable) { parallelChannels = enable; }
+
 protected:
 	QString filename;
 	cImage *image;
@@ -136,9 +140,17 @@ protected:
 	enumImageContentType currentChannelKey;
 	int currentChannel;
 	int totalChannel;
+	bool parallelChannels;
+
+	// preferences are read when saver is created, so image can be encoded in other thread
+	bool appendAlphaPreference;
+	bool linearColorspace;
+	int jpegQuality;
 
 	ImageFileSave(QString filename, cImage *image, ImageConfig imageConfig);
 
+	void SaveChannels();
+	virtual void SaveChannel(const structSaveImageChannel &imageChannel) { Q_UNUSED(imageChannel); }
 	void updateProgressAndStatusChannel(double progress);
 	void updateProgressAndStatusStarted();
 	void updateProgressAndStatusFinished();
@@ -156,6 +168,7 @@ public:
 	{
 		hasAppendAlphaCustom = false;
 		appendAlphaCustom = false;
+		appendAlpha = false;
 	}
 	void SetAppendAlphaCustom(bool _appendAlphaCustom)
 	{
@@ -164,15 +177,43 @@ public:
 	}
 	void SaveImage() override;
 	QString getJobName() override { return tr("Saving %1").arg("PNG"); }
+	void SaveChannel(const structSaveImageChannel &imageChannel) override;
 	void SavePNG(
 		QString filename, cImage *image, structSaveImageChannel imageChannel, bool appendAlpha = false);
 	static void SavePNG16(QString filename, int width, int height, sRGB16 *image16);
-	static void SaveFromTilesPNG16(const char *filename, int width, int height, int tiles);
 	static bool SavePNGQtBlackAndWhite(QString filename, unsigned char *image, int width, int height);
 
 private:
 	bool hasAppendAlphaCustom;
 	bool appendAlphaCustom;
+	bool appendAlpha;
+};
+
+// writes RGB PNG file row by row, so the whole image never has to be kept in memory
+class ImageFileSavePNGStream
+{
+public:
+	ImageFileSavePNGStream(QString _filename, int _width, int _height, bool _sixteenBit);
+	~ImageFileSavePNGStream();
+	bool IsOpen() const { return !failed; }
+	bool WriteRow(const sRGB16 *row);
+	bool Finish();
+
+private:
+	void Close();
+	void Fail(const QString &status);
+
+	QString filename;
+	int width;
+	int height;
+	bool sixteenBit;
+	int rowsWritten;
+	bool failed;
+	bool finished;
+	FILE *fp;
+	png_structp png_ptr;
+	png_infop info_ptr;
+	std::vector<sRGB8> row8;
 };
 
 class ImageFileSaveJPG : public ImageFileSave
@@ -185,6 +226,7 @@ public:
 	}
 	void SaveImage() override;
 	QString getJobName() override { return tr("Saving %1").arg("JPG"); }
+	void SaveChannel(const structSaveImageChannel &imageChannel) override;
 	static bool SaveJPEGQt(
 		QString filename, unsigned char *image, int width, int height, int quality);
 	static bool SaveJPEGQtGreyscale(
@@ -199,11 +241,16 @@ public:
 	ImageFileSaveTIFF(QString filename, cImage *image, ImageConfig imageConfig)
 			: ImageFileSave(filename, image, imageConfig)
 	{
+		appendAlpha = false;
 	}
 	void SaveImage() override;
 	QString getJobName() override { return tr("Saving %1").arg("TIFF"); }
+	void SaveChannel(const structSaveImageChannel &imageChannel) override;
 	bool SaveTIFF(
 		QString filename, cImage *image, structSaveImageChannel imageChannel, bool appendAlpha = false);
+
+private:
+	bool appendAlpha;
 };
 #endif /* USE_TIFF */
 
@@ -89,38 +89,130 @@ QString MeshFileSave::MeshNameWithoutExtension(QString path)
 	return fi.path() + QDir::separator() + fileName;
 }
 
+MeshFileSavePLY::~MeshFileSavePLY()
+{
+	delete vertexFile;
+	delete polygonFile;
+}
+
 void MeshFileSavePLY::SaveMesh()
 {
 	emit updateProgressAndStatus(getJobName(), QString("Started"), 0.0);
-	SavePLY();
+	if (BeginStream())
+	{
+		AppendVertices(
+			meshData.vertices->data(), meshData.colorIndices->data(), meshData.colorIndices->size());
+		AppendPolygons(meshData.polygons->data(), meshData.polygons->size() / 3);
+		EndStream();
+	}
 	emit updateProgressAndStatus(getJobName(), QString("Finished"), 1.0);
 }
 
-void MeshFileSavePLY::SavePLY()
+bool MeshFileSavePLY::BeginStream()
 {
-	QFile qFile(filename);
+	withColor = meshConfig.contentTypes.contains(MESH_CONTENT_COLOR);
+	isBinary = meshConfig.fileModeType == MESH_BINARY;
+	numberOfVertices = 0;
+	numberOfPolygons = 0;
 
-	bool withColor = meshConfig.contentTypes.contains(MESH_CONTENT_COLOR);
-	bool isBinary = meshConfig.fileModeType == MESH_BINARY;
+	delete vertexFile;
+	delete polygonFile;
+	vertexFile = new QTemporaryFile(filename + ".vertices.XXXXXX");
+	polygonFile = new QTemporaryFile(filename + ".polygons.XXXXXX");
+
+	if (!vertexFile->open() || !polygonFile->open())
+	{
+		QString statusText = tr("Mesh Export - Failed to open temporary file!");
+		emit updateProgressAndStatus(statusText, "", 1.0);
+		return false;
+	}
+	return true;
+}
 
+void MeshFileSavePLY::AppendVertices(const double *vertices, const sRGB8 *colors, quint64 count)
+{
 	double alpha = 1.0;
+
+	QByteArray buffer;
+	for (quint64 i = 0; i < count; i++)
+	{
+		sRGB8 colour = colors[i];
+		if (isBinary)
+		{
+			double s = colour.R;
+			buffer.append(reinterpret_cast<const char *>(&vertices[i * 3]), sizeof(double) * 3);
+			buffer.append(reinterpret_cast<const char *>(&s), sizeof(double));
+			buffer.append(reinterpret_cast<const char *>(&alpha), sizeof(double));
+			if (withColor) buffer.append(reinterpret_cast<const char *>(&colour), sizeof(sRGB8));
+		}
+		else
+		{
+			buffer.append(QString("%1 %2 %3")
+											.arg(vertices[i * 3])
+											.arg(vertices[i * 3 + 1])
+											.arg(vertices[i * 3 + 2])
+											.toLatin1());
+			buffer.append(QString(" %1 %2").arg(colour.R).arg(alpha).toLatin1());
+			if (withColor)
+			{
+				buffer.append(QString(" %1 %2 %3").arg(colour.R).arg(colour.G).arg(colour.B).toLatin1());
+			}
+			buffer.append('\n');
+		}
+	}
+	vertexFile->write(buffer);
+	numberOfVertices += count;
+}
+
+void MeshFileSavePLY::AppendPolygons(const long long *polygons, quint64 count)
+{
 	char polygonSize = 3;
+
+	QByteArray buffer;
+	for (quint64 i = 0; i < count * 3; i += 3)
+	{
+		if (isBinary)
+		{
+			int p1 = polygons[i + 2];
+			int p2 = polygons[i + 1];
+			int p3 = polygons[i + 0];
+			buffer.append(polygonSize);
+			buffer.append(reinterpret_cast<const char *>(&p1), sizeof(int));
+			buffer.append(reinterpret_cast<const char *>(&p2), sizeof(int));
+			buffer.append(reinterpret_cast<const char *>(&p3), sizeof(int));
+		}
+		else
+		{
+			buffer.append(QString("%1 %2 %3 %4\n")
+											.arg(int(polygonSize))
+											.arg(polygons[i + 2])
+											.arg(polygons[i + 1])
+											.arg(polygons[i + 0])
+											.toLatin1());
+		}
+	}
+	polygonFile->write(buffer);
+	numberOfPolygons += count;
+}
+
+bool MeshFileSavePLY::EndStream()
+{
+	QFile qFile(filename);
 	QString plyFormat = isBinary ? "binary_little_endian" : "ascii";
 
 	if (!qFile.open(QFile::WriteOnly))
 	{
 		QString statusText = tr("Mesh Export - Failed to open output file!");
 		emit updateProgressAndStatus(statusText, "", 1.0);
-		return;
+		return false;
 	}
-	QDataStream oB(&qFile);
-	QTextStream oT(&qFile);
 
 	// write the file header
+	QTextStream oT(&qFile);
 	oT << QString("ply\n").toLatin1();
 	oT << QString("format %1 1.0\n").arg(plyFormat).toLatin1();
 	oT << QString("comment Mandelbulber Exported Mesh\n").toLatin1();
-	oT << QString("element vertex %1\n").arg(meshData.vertices->size() / 3).toLatin1();
+	oT << QString("element vertex %1\n").arg(numberOfVertices).toLatin1();
 	oT << QString("property double x\n").toLatin1();
 	oT << QString("property double y\n").toLatin1();
 	oT << QString("property double z\n").toLatin1();
@@ -132,67 +224,26 @@ void MeshFileSavePLY::SavePLY()
 		oT << QString("property uchar green\n").toLatin1();
 		oT << QString("property uchar blue\n").toLatin1();
 	}
-	oT << QString("element face %1\n").arg(meshData.polygons->size() / 3).toLatin1();
+	oT << QString("element face %1\n").arg(numberOfPolygons).toLatin1();
 	oT << QString("property list uchar int vertex_index\n").toLatin1();
 	oT << QString("end_header\n").toLatin1();
 	oT.flush();
 
-	// write vertices
-	for (unsigned long long i = 0; i < meshData.vertices->size() / 3; i++)
+	// copy vertices and polygons from temporary files
+	const qint64 blockSize = 16 * 1024 * 1024;
+	for (QTemporaryFile *partFile : {vertexFile, polygonFile})
 	{
-		if (isBinary)
-		{
-			oB.writeRawData((char *)&meshData.vertices->at(i * 3), sizeof(double) * 3);
-			oB.writeRawData((char *)&meshData.colorIndices->at(i), sizeof(double) * 1);
-			oB.writeRawData((char *)&alpha, sizeof(double) * 1);
-		}
-		else
+		partFile->seek(0);
+		while (!partFile->atEnd())
 		{
-			oT << QString("%1 %2 %3")
-							.arg(meshData.vertices->at(i * 3))
-							.arg(meshData.vertices->at(i * 3 + 1))
-							.arg(meshData.vertices->at(i * 3 + 2))
-							.toLatin1();
-			oT << QString(" %1 %2").arg(meshData.colorIndices->at(i).R).arg(alpha).toLatin1();
-		}
-
-		if (withColor)
-		{
-			sRGB8 colour = meshData.colorIndices->at(i);
-			if (isBinary)
-			{
-				oB.writeRawData((char *)&colour, sizeof(sRGB8));
-			}
-			else
-			{
-				oT << QString(" %1 %2 %3").arg(colour.R).arg(colour.G).arg(colour.B).toLatin1();
-			}
-		}
-		if (!isBinary) oT << QString("\n").toLatin1();
-	}
-
-	// write polygons
-	for (unsigned long long i = 0; i < meshData.polygons->size(); i += 3)
-	{
-		if (isBinary)
-		{
-			int p1 = meshData.polygons->at(i + 2);
-			int p2 = meshData.polygons->at(i + 1);
-			int p3 = meshData.polygons->at(i + 0);
-			oB.writeRawData((char *)&polygonSize, sizeof(char) * 1);
-			oB.writeRawData((char *)&p1, sizeof(int) * 1);
-			oB.writeRawData((char *)&p2, sizeof(int) * 1);
-			oB.writeRawData((char *)&p3, sizeof(int) * 1);
-		}
-		else
-		{
-			oT << QString("%1 %2 %3 %4\n")
-							.arg((int)polygonSize)
-							.arg(meshData.polygons->at(i + 2))
-							.arg(meshData.polygons->at(i + 1))
-							.arg(meshData.polygons->at(i + 0))
-							.toLatin1();
+			qFile.write(partFile->read(blockSize));
 		}
 	}
 	qFile.close();
+
+	delete vertexFile;
+	delete polygonFile;
+	vertexFile = nullptr;
+	polygonFile = nullptr;
+	return true;
 }
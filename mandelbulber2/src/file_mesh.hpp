@@ -32,7 +32,9 @@
  * file mesh class to store different mesh file formats
  *
  * Each mesh file type derives MeshFileSave and implements the SaveMesh
- * method to store the mesh data with the corresponding file format
+ * method to store the mesh data with the corresponding file format.
+ * Big meshes can be streamed to the file in parts with BeginStream(),
+ * AppendVertices(), AppendPolygons() and EndStream()
  */
 
 #ifndef MANDELBULBER2_SRC_FILE_MESH_HPP_
@@ -114,6 +116,13 @@ public:
 	virtual void SaveMesh() = 0;
 	virtual QString getJobName() = 0;
 
+	// streaming interface. Parts of the mesh are written as soon as they are ready, so the whole
+	// mesh doesn't need to be kept in memory. Indices of polygons are global for the whole mesh
+	virtual bool BeginStream() = 0;
+	virtual void AppendVertices(const double *vertices, const sRGB8 *colors, quint64 count) = 0;
+	virtual void AppendPolygons(const long long *polygons, quint64 count) = 0;
+	virtual bool EndStream() = 0;
+
 protected:
 	QString filename;
 	structSaveMeshConfig meshConfig;
@@ -133,9 +142,23 @@ public:
 			: MeshFileSave(filename, meshConfig, meshData)
 	{
 	}
+	~MeshFileSavePLY() override;
 	void SaveMesh() override;
 	QString getJobName() override { return tr("Saving %1").arg("PLY"); }
-	void SavePLY();
+
+	bool BeginStream() override;
+	void AppendVertices(const double *vertices, const sRGB8 *colors, quint64 count) override;
+	void AppendPolygons(const long long *polygons, quint64 count) override;
+	bool EndStream() override;
+
+private:
+	// vertices and polygons are stored in temporary files until the number of them is known
+	QTemporaryFile *vertexFile = nullptr;
+	QTemporaryFile *polygonFile = nullptr;
+	quint64 numberOfVertices = 0;
+	quint64 numberOfPolygons = 0;
+	bool withColor = false;
+	bool isBinary = false;
 };
 
 #endif /* MANDELBULBER2_SRC_FILE_MESH_HPP_ */
@@ -186,8 +186,7 @@ void BufferNormalize16(sRGB16 *buffer, unsigned int size)
 	}
 }
 
-void SaveImage(QString filename, ImageFileSave::enumImageFileType fileType, cImage *image,
-	QObject *updateReceiver)
+ImageFileSave::ImageConfig ImageConfigFromPreferences()
 {
 	ImageFileSave::ImageConfig imageConfig;
 	QStringList imageChannelNames = ImageFileSave::ImageChannelNames();
@@ -206,6 +205,13 @@ void SaveImage(QString filename, ImageFileSave::enumImageFileType fileType, cIma
 				contentType, ImageFileSave::structSaveImageChannel(contentType, channelQuality, postfix));
 		}
 	}
+	return imageConfig;
+}
+
+void SaveImage(QString filename, ImageFileSave::enumImageFileType fileType, cImage *image,
+	QObject *updateReceiver)
+{
+	ImageFileSave::ImageConfig imageConfig = ImageConfigFromPreferences();
 
 	if (image->IsStereoLeftRight() && gPar->Get<bool>("stereoscopic_in_separate_files"))
 	{
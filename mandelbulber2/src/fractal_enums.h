@@ -86,6 +86,16 @@ enum enumDEAnalyticFunction // DE function for non hybrid fractals
 	analyticFunctionJosKleinian = 5,
 };
 
+// specialized iteration loops used for single (non-hybrid) formula
+enum enumSingleFormulaLoop
+{
+	singleFormulaLoopNone = 0,		// general loop
+	singleFormulaLoopGeneric = 1, // any formula called by function pointer
+	singleFormulaLoopMandelbulb = 2,
+	singleFormulaLoopMandelbox = 3,
+	singleFormulaLoopMengerSponge = 4,
+};
+
 enum enumColoringFunction
 {
 	coloringFunctionUndefined = -1,
@@ -40,166 +40,203 @@
 sParamRender::sParamRender(const cParameterContainer *container, QVector<cObjectData> *objectData)
 		: primitives(container, objectData)
 {
-	antialiasingEnabled = container->Get<bool>("antialiasing_enabled");
-	antialiasingSize = container->Get<int>("antialiasing_size");
-	ambientOcclusion = container->Get<double>("ambient_occlusion");
-	ambientOcclusionEnabled = container->Get<bool>("ambient_occlusion_enabled");
-	ambientOcclusionFastTune = container->Get<double>("ambient_occlusion_fast_tune");
-	ambientOcclusionMode = params::enumAOMode(container->Get<int>("ambient_occlusion_mode"));
-	ambientOcclusionQuality = container->Get<int>("ambient_occlusion_quality");
+	antialiasingEnabled = container->Get<bool>(PARAMETER_HANDLE("antialiasing_enabled"));
+	antialiasingSize = container->Get<int>(PARAMETER_HANDLE("antialiasing_size"));
+	antialiasingAdaptive = container->Get<bool>(PARAMETER_HANDLE("antialiasing_adaptive"));
+	antialiasingAdaptiveThreshold =
+		container->Get<double>(PARAMETER_HANDLE("antialiasing_adaptive_threshold"));
+	ambientOcclusion = container->Get<double>(PARAMETER_HANDLE("ambient_occlusion"));
+	ambientOcclusionEnabled = container->Get<bool>(PARAMETER_HANDLE("ambient_occlusion_enabled"));
+	ambientOcclusionFastTune =
+		container->Get<double>(PARAMETER_HANDLE("ambient_occlusion_fast_tune"));
+	ambientOcclusionMode =
+		params::enumAOMode(container->Get<int>(PARAMETER_HANDLE("ambient_occlusion_mode")));
+	ambientOcclusionQuality = container->Get<int>(PARAMETER_HANDLE("ambient_occlusion_quality"));
 	auxLightNumber = 4;
-	auxLightRandomNumber = container->Get<int>("random_lights_number");
-	auxLightRandomSeed = container->Get<int>("random_lights_random_seed");
-	auxLightRandomCenter = container->Get<CVector3>("random_lights_distribution_center");
-	auxLightRandomRadius = container->Get<double>("random_lights_distribution_radius");
+	auxLightRandomNumber = container->Get<int>(PARAMETER_HANDLE("random_lights_number"));
+	auxLightRandomSeed = container->Get<int>(PARAMETER_HANDLE("random_lights_random_seed"));
+	auxLightRandomCenter =
+		container->Get<CVector3>(PARAMETER_HANDLE("random_lights_distribution_center"));
+	auxLightRandomRadius =
+		container->Get<double>(PARAMETER_HANDLE("random_lights_distribution_radius"));
 	auxLightRandomMaxDistanceFromFractal =
-		container->Get<double>("random_lights_max_distance_from_fractal");
-	auxLightRandomIntensity = container->Get<double>("random_lights_intensity");
-	auxLightRandomEnabled = container->Get<bool>("random_lights_group");
-	auxLightRandomInOneColor = container->Get<bool>("random_lights_one_color_enable");
-	auxLightRandomColor = container->Get<sRGB>("random_lights_color");
-	auxLightVisibility = container->Get<double>("aux_light_visibility");
-	auxLightVisibilitySize = container->Get<double>("aux_light_visibility_size");
-	background3ColorsEnable = container->Get<bool>("background_3_colors_enable");
-	background_color1 = container->Get<sRGB>("background_color", 1);
-	background_color2 = container->Get<sRGB>("background_color", 2);
-	background_color3 = container->Get<sRGB>("background_color", 3);
-	background_brightness = container->Get<double>("background_brightness");
-	backgroundHScale = container->Get<double>("background_h_scale");
-	backgroundVScale = container->Get<double>("background_v_scale");
-	backgroundTextureOffsetX = container->Get<double>("background_texture_offset_x");
-	backgroundTextureOffsetY = container->Get<double>("background_texture_offset_y");
-	backgroundVScale = container->Get<double>("background_v_scale");
-	backgroundRotation = container->Get<CVector3>("background_rotation");
-	booleanOperatorsEnabled = container->Get<bool>("boolean_operators");
-	camera = container->Get<CVector3>("camera");
-	cameraDistanceToTarget = container->Get<double>("camera_distance_to_target");
-	constantDEThreshold = container->Get<bool>("constant_DE_threshold");
-	constantFactor = container->Get<double>("fractal_constant_factor");
-	DEFactor = container->Get<double>("DE_factor");
-	delta_DE_function = fractal::enumDEFunctionType(container->Get<int>("delta_DE_function"));
-	delta_DE_method = fractal::enumDEMethod(container->Get<int>("delta_DE_method"));
-	detailLevel = container->Get<double>("detail_level");
-	DEThresh = container->Get<double>("DE_thresh");
-	DOFEnabled = container->Get<bool>("DOF_enabled");
-	DOFFocus = container->Get<double>("DOF_focus");
-	DOFRadius = container->Get<double>("DOF_radius");
-	DOFMaxRadius = container->Get<double>("DOF_max_radius");
-	DOFHDRMode = container->Get<bool>("DOF_HDR");
-	DOFMonteCarlo = container->Get<bool>("DOF_monte_carlo");
-	DOFMonteCarloGlobalIllumination = container->Get<bool>("DOF_MC_global_illumination");
-	DOFNumberOfPasses = container->Get<int>("DOF_number_of_passes");
-	DOFSamples = container->Get<int>("DOF_samples");
-	DOFMinSamples = container->Get<int>("DOF_min_samples");
-	DOFBlurOpacity = container->Get<double>("DOF_blur_opacity");
-	DOFMaxNoise = container->Get<double>("DOF_max_noise");
-	DOFMonteCarloChromaticAberration = container->Get<bool>("DOF_MC_CA_enable");
-	DOFMonteCarloCADispersionGain = container->Get<double>("DOF_MC_CA_dispersion_gain");
-	DOFMonteCarloCACameraDispersion = container->Get<double>("DOF_MC_CA_camera_dispersion");
-	envMappingEnable = container->Get<bool>("env_mapping_enable");
-	fakeLightsColor = container->Get<sRGB>("fake_lights_color");
-	fakeLightsEnabled = container->Get<bool>("fake_lights_enabled");
-	fakeLightsIntensity = container->Get<double>("fake_lights_intensity");
-	fakeLightsVisibility = container->Get<double>("fake_lights_visibility");
-	fakeLightsVisibilitySize = container->Get<double>("fake_lights_visibility_size");
-	fogColor = container->Get<sRGB>("basic_fog_color");
-	fogEnabled = container->Get<bool>("basic_fog_enabled");
-	fogVisibility = container->Get<double>("basic_fog_visibility");
-	fov = container->Get<double>("fov");
-	frameNo = container->Get<int>("frame_no");
-	glowColor1 = container->Get<sRGB>("glow_color", 1);
-	glowColor2 = container->Get<sRGB>("glow_color", 2);
-	glowEnabled = container->Get<bool>("glow_enabled");
-	glowIntensity = container->Get<double>("glow_intensity");
-	hdrBlurEnabled = container->Get<bool>("hdr_blur_enabled");
-	hdrBlurRadius = container->Get<double>("hdr_blur_radius");
-	hdrBlurIntensity = container->Get<double>("hdr_blur_intensity");
-	hybridFractalEnable = container->Get<bool>("hybrid_fractal_enable");
-	imageAdjustments.brightness = container->Get<double>("brightness");
-	imageAdjustments.contrast = container->Get<double>("contrast");
-	imageAdjustments.hdrEnabled = container->Get<bool>("hdr");
-	imageAdjustments.imageGamma = container->Get<double>("gamma");
-	imageAdjustments.saturation = container->Get<double>("saturation");
-	imageHeight = container->Get<int>("image_height");
-	imageWidth = container->Get<int>("image_width");
-	interiorMode = container->Get<bool>("interior_mode");
-	iterFogBrightnessBoost = container->Get<double>("iteration_fog_brightness_boost");
-	iterFogColor1Maxiter = container->Get<double>("iteration_fog_color_1_maxiter");
-	iterFogColor2Maxiter = container->Get<double>("iteration_fog_color_2_maxiter");
-	iterFogColour1 = container->Get<sRGB>("iteration_fog_color", 1);
-	iterFogColour2 = container->Get<sRGB>("iteration_fog_color", 2);
-	iterFogColour3 = container->Get<sRGB>("iteration_fog_color", 3);
-	iterFogEnabled = container->Get<bool>("iteration_fog_enable");
-	iterFogOpacity = container->Get<double>("iteration_fog_opacity");
-	iterFogOpacityTrim = container->Get<double>("iteration_fog_opacity_trim");
-	iterFogOpacityTrimHigh = container->Get<double>("iteration_fog_opacity_trim_high");
-	iterFogShadows = container->Get<bool>("iteration_fog_shadows");
-	legacyCoordinateSystem = container->Get<bool>("legacy_coordinate_system");
-	limitMax = container->Get<CVector3>("limit_max");
-	limitMin = container->Get<CVector3>("limit_min");
-	limitsEnabled = container->Get<bool>("limits_enabled");
-	mainLightAlpha = container->Get<double>("main_light_alpha");
-	mainLightBeta = container->Get<double>("main_light_beta");
-	mainLightColour = container->Get<sRGB>("main_light_colour");
-	mainLightEnable = container->Get<bool>("main_light_enable");
-	mainLightIntensity = container->Get<double>("main_light_intensity");
-	mainLightPositionAsRelative = container->Get<bool>("main_light_position_relative");
-	mainLightVisibility = container->Get<double>("main_light_visibility");
-	mainLightVisibilitySize = container->Get<double>("main_light_visibility_size");
-	minN = container->Get<int>("minN");
-	monteCarloSoftShadows = container->Get<bool>("MC_soft_shadows_enable");
-	N = container->Get<int>("N");
-	penetratingLights = container->Get<bool>("penetrating_lights");
-	perspectiveType = params::enumPerspectiveType(container->Get<int>("perspective_type"));
-	raytracedReflections = container->Get<bool>("raytraced_reflections");
-	reflectionsMax = container->Get<int>("reflections_max");
-	repeatFrom = container->Get<int>("repeat_from");
+		container->Get<double>(PARAMETER_HANDLE("random_lights_max_distance_from_fractal"));
+	auxLightRandomIntensity = container->Get<double>(PARAMETER_HANDLE("random_lights_intensity"));
+	auxLightRandomEnabled = container->Get<bool>(PARAMETER_HANDLE("random_lights_group"));
+	auxLightRandomInOneColor =
+		container->Get<bool>(PARAMETER_HANDLE("random_lights_one_color_enable"));
+	auxLightRandomColor = container->Get<sRGB>(PARAMETER_HANDLE("random_lights_color"));
+	auxLightCullingThreshold =
+		container->Get<double>(PARAMETER_HANDLE("aux_light_culling_threshold"));
+	auxLightSamplingEnabled = container->Get<bool>(PARAMETER_HANDLE("aux_light_sampling_enabled"));
+	auxLightSamplingCount = container->Get<int>(PARAMETER_HANDLE("aux_light_sampling_count"));
+	auxLightVisibility = container->Get<double>(PARAMETER_HANDLE("aux_light_visibility"));
+	auxLightVisibilitySize = container->Get<double>(PARAMETER_HANDLE("aux_light_visibility_size"));
+	background3ColorsEnable = container->Get<bool>(PARAMETER_HANDLE("background_3_colors_enable"));
+	background_color1 = container->Get<sRGB>(PARAMETER_HANDLE("background_color", 1));
+	background_color2 = container->Get<sRGB>(PARAMETER_HANDLE("background_color", 2));
+	background_color3 = container->Get<sRGB>(PARAMETER_HANDLE("background_color", 3));
+	background_brightness = container->Get<double>(PARAMETER_HANDLE("background_brightness"));
+	backgroundHScale = container->Get<double>(PARAMETER_HANDLE("background_h_scale"));
+	backgroundVScale = container->Get<double>(PARAMETER_HANDLE("background_v_scale"));
+	backgroundTextureOffsetX =
+		container->Get<double>(PARAMETER_HANDLE("background_texture_offset_x"));
+	backgroundTextureOffsetY =
+		container->Get<double>(PARAMETER_HANDLE("background_texture_offset_y"));
+	backgroundVScale = container->Get<double>(PARAMETER_HANDLE("background_v_scale"));
+	backgroundRotation = container->Get<CVector3>(PARAMETER_HANDLE("background_rotation"));
+	booleanOperatorsEnabled = container->Get<bool>(PARAMETER_HANDLE("boolean_operators"));
+	camera = container->Get<CVector3>(PARAMETER_HANDLE("camera"));
+	cameraDistanceToTarget = container->Get<double>(PARAMETER_HANDLE("camera_distance_to_target"));
+	constantDEThreshold = container->Get<bool>(PARAMETER_HANDLE("constant_DE_threshold"));
+	constantFactor = container->Get<double>(PARAMETER_HANDLE("fractal_constant_factor"));
+	DEFactor = container->Get<double>(PARAMETER_HANDLE("DE_factor"));
+	delta_DE_function =
+		fractal::enumDEFunctionType(container->Get<int>(PARAMETER_HANDLE("delta_DE_function")));
+	delta_DE_method = fractal::enumDEMethod(container->Get<int>(PARAMETER_HANDLE("delta_DE_method")));
+	detailLevel = container->Get<double>(PARAMETER_HANDLE("detail_level"));
+	DEThresh = container->Get<double>(PARAMETER_HANDLE("DE_thresh"));
+	DOFEnabled = container->Get<bool>(PARAMETER_HANDLE("DOF_enabled"));
+	DOFFocus = container->Get<double>(PARAMETER_HANDLE("DOF_focus"));
+	DOFRadius = container->Get<double>(PARAMETER_HANDLE("DOF_radius"));
+	DOFMaxRadius = container->Get<double>(PARAMETER_HANDLE("DOF_max_radius"));
+	DOFHDRMode = container->Get<bool>(PARAMETER_HANDLE("DOF_HDR"));
+	DOFMonteCarlo = container->Get<bool>(PARAMETER_HANDLE("DOF_monte_carlo"));
+	DOFMonteCarloGlobalIllumination =
+		container->Get<bool>(PARAMETER_HANDLE("DOF_MC_global_illumination"));
+	DOFNumberOfPasses = container->Get<int>(PARAMETER_HANDLE("DOF_number_of_passes"));
+	DOFSamples = container->Get<int>(PARAMETER_HANDLE("DOF_samples"));
+	DOFMinSamples = container->Get<int>(PARAMETER_HANDLE("DOF_min_samples"));
+	DOFBlurOpacity = container->Get<double>(PARAMETER_HANDLE("DOF_blur_opacity"));
+	DOFMaxNoise = container->Get<double>(PARAMETER_HANDLE("DOF_max_noise"));
+	DOFMonteCarloChromaticAberration = container->Get<bool>(PARAMETER_HANDLE("DOF_MC_CA_enable"));
+	DOFMonteCarloCADispersionGain =
+		container->Get<double>(PARAMETER_HANDLE("DOF_MC_CA_dispersion_gain"));
+	DOFMonteCarloCACameraDispersion =
+		container->Get<double>(PARAMETER_HANDLE("DOF_MC_CA_camera_dispersion"));
+	envMappingEnable = container->Get<bool>(PARAMETER_HANDLE("env_mapping_enable"));
+	fakeLightsColor = container->Get<sRGB>(PARAMETER_HANDLE("fake_lights_color"));
+	fakeLightsEnabled = container->Get<bool>(PARAMETER_HANDLE("fake_lights_enabled"));
+	fakeLightsIntensity = container->Get<double>(PARAMETER_HANDLE("fake_lights_intensity"));
+	fakeLightsVisibility = container->Get<double>(PARAMETER_HANDLE("fake_lights_visibility"));
+	fakeLightsVisibilitySize =
+		container->Get<double>(PARAMETER_HANDLE("fake_lights_visibility_size"));
+	fogColor = container->Get<sRGB>(PARAMETER_HANDLE("basic_fog_color"));
+	fogEnabled = container->Get<bool>(PARAMETER_HANDLE("basic_fog_enabled"));
+	fogVisibility = container->Get<double>(PARAMETER_HANDLE("basic_fog_visibility"));
+	fov = container->Get<double>(PARAMETER_HANDLE("fov"));
+	frameNo = container->Get<int>(PARAMETER_HANDLE("frame_no"));
+	glowColor1 = container->Get<sRGB>(PARAMETER_HANDLE("glow_color", 1));
+	glowColor2 = container->Get<sRGB>(PARAMETER_HANDLE("glow_color", 2));
+	glowEnabled = container->Get<bool>(PARAMETER_HANDLE("glow_enabled"));
+	glowIntensity = container->Get<double>(PARAMETER_HANDLE("glow_intensity"));
+	hdrBlurEnabled = container->Get<bool>(PARAMETER_HANDLE("hdr_blur_enabled"));
+	hdrBlurRadius = container->Get<double>(PARAMETER_HANDLE("hdr_blur_radius"));
+	hdrBlurIntensity = container->Get<double>(PARAMETER_HANDLE("hdr_blur_intensity"));
+	hybridFractalEnable = container->Get<bool>(PARAMETER_HANDLE("hybrid_fractal_enable"));
+	imageAdjustments.brightness = container->Get<double>(PARAMETER_HANDLE("brightness"));
+	imageAdjustments.contrast = container->Get<double>(PARAMETER_HANDLE("contrast"));
+	imageAdjustments.hdrEnabled = container->Get<bool>(PARAMETER_HANDLE("hdr"));
+	imageAdjustments.imageGamma = container->Get<double>(PARAMETER_HANDLE("gamma"));
+	imageAdjustments.saturation = container->Get<double>(PARAMETER_HANDLE("saturation"));
+	imageHeight = container->Get<int>(PARAMETER_HANDLE("image_height"));
+	imageWidth = container->Get<int>(PARAMETER_HANDLE("image_width"));
+	interiorMode = container->Get<bool>(PARAMETER_HANDLE("interior_mode"));
+	iterFogBrightnessBoost =
+		container->Get<double>(PARAMETER_HANDLE("iteration_fog_brightness_boost"));
+	iterFogColor1Maxiter = container->Get<double>(PARAMETER_HANDLE("iteration_fog_color_1_maxiter"));
+	iterFogColor2Maxiter = container->Get<double>(PARAMETER_HANDLE("iteration_fog_color_2_maxiter"));
+	iterFogColour1 = container->Get<sRGB>(PARAMETER_HANDLE("iteration_fog_color", 1));
+	iterFogColour2 = container->Get<sRGB>(PARAMETER_HANDLE("iteration_fog_color", 2));
+	iterFogColour3 = container->Get<sRGB>(PARAMETER_HANDLE("iteration_fog_color", 3));
+	iterFogEnabled = container->Get<bool>(PARAMETER_HANDLE("iteration_fog_enable"));
+	iterFogOpacity = container->Get<double>(PARAMETER_HANDLE("iteration_fog_opacity"));
+	iterFogOpacityTrim = container->Get<double>(PARAMETER_HANDLE("iteration_fog_opacity_trim"));
+	iterFogOpacityTrimHigh =
+		container->Get<double>(PARAMETER_HANDLE("iteration_fog_opacity_trim_high"));
+	iterFogShadows = container->Get<bool>(PARAMETER_HANDLE("iteration_fog_shadows"));
+	legacyCoordinateSystem = container->Get<bool>(PARAMETER_HANDLE("legacy_coordinate_system"));
+	limitMax = container->Get<CVector3>(PARAMETER_HANDLE("limit_max"));
+	limitMin = container->Get<CVector3>(PARAMETER_HANDLE("limit_min"));
+	limitsEnabled = container->Get<bool>(PARAMETER_HANDLE("limits_enabled"));
+	mainLightAlpha = container->Get<double>(PARAMETER_HANDLE("main_light_alpha"));
+	mainLightBeta = container->Get<double>(PARAMETER_HANDLE("main_light_beta"));
+	mainLightColour = container->Get<sRGB>(PARAMETER_HANDLE("main_light_colour"));
+	mainLightEnable = container->Get<bool>(PARAMETER_HANDLE("main_light_enable"));
+	mainLightIntensity = container->Get<double>(PARAMETER_HANDLE("main_light_intensity"));
+	mainLightPositionAsRelative =
+		container->Get<bool>(PARAMETER_HANDLE("main_light_position_relative"));
+	mainLightVisibility = container->Get<double>(PARAMETER_HANDLE("main_light_visibility"));
+	mainLightVisibilitySize = container->Get<double>(PARAMETER_HANDLE("main_light_visibility_size"));
+	minN = container->Get<int>(PARAMETER_HANDLE("minN"));
+	monteCarloSoftShadows = container->Get<bool>(PARAMETER_HANDLE("MC_soft_shadows_enable"));
+	N = container->Get<int>(PARAMETER_HANDLE("N"));
+	penetratingLights = container->Get<bool>(PARAMETER_HANDLE("penetrating_lights"));
+	perspectiveType =
+		params::enumPerspectiveType(container->Get<int>(PARAMETER_HANDLE("perspective_type")));
+	rayPacketsEnabled = container->Get<bool>(PARAMETER_HANDLE("ray_packets_enabled"));
+	raytracedReflections = container->Get<bool>(PARAMETER_HANDLE("raytraced_reflections"));
+	reflectionsMax = container->Get<int>(PARAMETER_HANDLE("reflections_max"));
+	repeatFrom = container->Get<int>(PARAMETER_HANDLE("repeat_from"));
 	resolution = 0.0;
-	shadow = container->Get<bool>("shadows_enabled");
-	shadowConeAngle = container->Get<double>("shadows_cone_angle");
-	slowShading = container->Get<bool>("slow_shading");
-	smoothness = container->Get<double>("smoothness");
-	SSAO_random_mode = container->Get<bool>("SSAO_random_mode");
-	stereoEyeDistance = container->Get<double>("stereo_eye_distance");
-	stereoInfiniteCorrection = container->Get<double>("stereo_infinite_correction");
-	sweetSpotHAngle = container->Get<double>("sweet_spot_horizontal_angle") / 180.0 * M_PI;
-	sweetSpotVAngle = container->Get<double>("sweet_spot_vertical_angle") / 180.0 * M_PI;
-	target = container->Get<CVector3>("target");
-	target = container->Get<CVector3>("target");
-	texturedBackground = container->Get<bool>("textured_background");
-	texturedBackgroundMapType =
-		params::enumTextureMapType(container->Get<int>("textured_background_map_type"));
-	topVector = container->Get<CVector3>("camera_top");
-	useDefaultBailout = container->Get<bool>("use_default_bailout");
-	viewAngle = container->Get<CVector3>("camera_rotation");
-	viewDistanceMax = container->Get<double>("view_distance_max");
-	viewDistanceMin = container->Get<double>("view_distance_min");
-	volFogColour1 = container->Get<sRGB>("fog_color", 1);
-	volFogColour1Distance = container->Get<double>("volumetric_fog_colour_1_distance");
-	volFogColour2 = container->Get<sRGB>("fog_color", 2);
-	volFogColour2Distance = container->Get<double>("volumetric_fog_colour_2_distance");
-	volFogColour3 = container->Get<sRGB>("fog_color", 3);
-	volFogDensity = container->Get<double>("volumetric_fog_density");
-	volFogDistanceFactor = container->Get<double>("volumetric_fog_distance_factor");
-	volFogDistanceFromSurface = container->Get<double>("volumetric_fog_distance_from_surface");
-	volFogEnabled = container->Get<bool>("volumetric_fog_enabled");
-	volumetricLightEnabled[0] = container->Get<bool>("main_light_volumetric_enabled");
-	volumetricLightIntensity[0] = container->Get<double>("main_light_volumetric_intensity");
-	volumetricLightDEFactor = container->Get<double>("volumetric_light_DE_Factor");
+	shadow = container->Get<bool>(PARAMETER_HANDLE("shadows_enabled"));
+	shadowConeAngle = container->Get<double>(PARAMETER_HANDLE("shadows_cone_angle"));
+	slowShading = container->Get<bool>(PARAMETER_HANDLE("slow_shading"));
+	smoothness = container->Get<double>(PARAMETER_HANDLE("smoothness"));
+	SSAO_random_mode = container->Get<bool>(PARAMETER_HANDLE("SSAO_random_mode"));
+	stereoEyeDistance = container->Get<double>(PARAMETER_HANDLE("stereo_eye_distance"));
+	stereoInfiniteCorrection = container->Get<double>(PARAMETER_HANDLE("stereo_infinite_correction"));
+	sweetSpotHAngle =
+		container->Get<double>(PARAMETER_HANDLE("sweet_spot_horizontal_angle")) / 180.0 * M_PI;
+	sweetSpotVAngle =
+		container->Get<double>(PARAMETER_HANDLE("sweet_spot_vertical_angle")) / 180.0 * M_PI;
+	target = container->Get<CVector3>(PARAMETER_HANDLE("target"));
+	target = container->Get<CVector3>(PARAMETER_HANDLE("target"));
+	texturedBackground = container->Get<bool>(PARAMETER_HANDLE("textured_background"));
+	texturedBackgroundMapType = params::enumTextureMapType(
+		container->Get<int>(PARAMETER_HANDLE("textured_background_map_type")));
+	topVector = container->Get<CVector3>(PARAMETER_HANDLE("camera_top"));
+	useDefaultBailout = container->Get<bool>(PARAMETER_HANDLE("use_default_bailout"));
+	viewAngle = container->Get<CVector3>(PARAMETER_HANDLE("camera_rotation"));
+	viewDistanceMax = container->Get<double>(PARAMETER_HANDLE("view_distance_max"));
+	viewDistanceMin = container->Get<double>(PARAMETER_HANDLE("view_distance_min"));
+	volFogColour1 = container->Get<sRGB>(PARAMETER_HANDLE("fog_color", 1));
+	volFogColour1Distance =
+		container->Get<double>(PARAMETER_HANDLE("volumetric_fog_colour_1_distance"));
+	volFogColour2 = container->Get<sRGB>(PARAMETER_HANDLE("fog_color", 2));
+	volFogColour2Distance =
+		container->Get<double>(PARAMETER_HANDLE("volumetric_fog_colour_2_distance"));
+	volFogColour3 = container->Get<sRGB>(PARAMETER_HANDLE("fog_color", 3));
+	volFogDensity = container->Get<double>(PARAMETER_HANDLE("volumetric_fog_density"));
+	volFogDistanceFactor = container->Get<double>(PARAMETER_HANDLE("volumetric_fog_distance_factor"));
+	volFogDistanceFromSurface =
+		container->Get<double>(PARAMETER_HANDLE("volumetric_fog_distance_from_surface"));
+	volFogEnabled = container->Get<bool>(PARAMETER_HANDLE("volumetric_fog_enabled"));
+	volumetricLightEnabled[0] =
+		container->Get<bool>(PARAMETER_HANDLE("main_light_volumetric_enabled"));
+	volumetricLightIntensity[0] =
+		container->Get<double>(PARAMETER_HANDLE("main_light_volumetric_intensity"));
+	volumetricLightDEFactor = container->Get<double>(PARAMETER_HANDLE("volumetric_light_DE_Factor"));
 	mRotBackgroundRotation.SetRotation(backgroundRotation * M_PI / 180.0);
 
 	for (int i = 0; i < 4; ++i)
 	{
-		auxLightPre[i] = container->Get<CVector3>("aux_light_position", i + 1);
-		auxLightPreIntensity[i] = container->Get<double>("aux_light_intensity", i + 1);
-		auxLightPreEnabled[i] = container->Get<bool>("aux_light_enabled", i + 1);
-		auxLightPreColour[i] = container->Get<sRGB>("aux_light_colour", i + 1);
+		auxLightPre[i] =
+			container->Get<CVector3>(PARAMETER_HANDLE_INDEXED("aux_light_position", i + 1, 5));
+		auxLightPreIntensity[i] =
+			container->Get<double>(PARAMETER_HANDLE_INDEXED("aux_light_intensity", i + 1, 5));
+		auxLightPreEnabled[i] =
+			container->Get<bool>(PARAMETER_HANDLE_INDEXED("aux_light_enabled", i + 1, 5));
+		auxLightPreColour[i] =
+			container->Get<sRGB>(PARAMETER_HANDLE_INDEXED("aux_light_colour", i + 1, 5));
 	}
 
 	for (int i = 1; i <= 4; i++)
 	{
-		volumetricLightIntensity[i] = container->Get<double>("aux_light_volumetric_intensity", i);
-		volumetricLightEnabled[i] = container->Get<bool>("aux_light_volumetric_enabled", i);
+		volumetricLightIntensity[i] =
+			container->Get<double>(PARAMETER_HANDLE_INDEXED("aux_light_volumetric_intensity", i, 5));
+		volumetricLightEnabled[i] =
+			container->Get<bool>(PARAMETER_HANDLE_INDEXED("aux_light_volumetric_enabled", i, 5));
 	}
 
 	volumetricLightAnyEnabled = false;
@@ -210,18 +247,23 @@ sParamRender::sParamRender(const cParameterContainer *container, QVector<cObject
 
 	for (int i = 0; i < NUMBER_OF_FRACTALS - 1; i++)
 	{
-		booleanOperator[i] =
-			params::enumBooleanOperator(container->Get<int>("boolean_operator", i + 1));
+		booleanOperator[i] = params::enumBooleanOperator(container->Get<int>(
+			PARAMETER_HANDLE_INDEXED("boolean_operator", i + 1, NUMBER_OF_FRACTALS)));
 	}
 
 	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
 	{
-		formulaPosition[i] = container->Get<CVector3>("formula_position", i + 1);
-		formulaRotation[i] = container->Get<CVector3>("formula_rotation", i + 1);
-		formulaRepeat[i] = container->Get<CVector3>("formula_repeat", i + 1);
-		formulaScale[i] = 1.0 / container->Get<double>("formula_scale", i + 1);
+		formulaPosition[i] = container->Get<CVector3>(
+			PARAMETER_HANDLE_INDEXED("formula_position", i + 1, NUMBER_OF_FRACTALS + 1));
+		formulaRotation[i] = container->Get<CVector3>(
+			PARAMETER_HANDLE_INDEXED("formula_rotation", i + 1, NUMBER_OF_FRACTALS + 1));
+		formulaRepeat[i] = container->Get<CVector3>(
+			PARAMETER_HANDLE_INDEXED("formula_repeat", i + 1, NUMBER_OF_FRACTALS + 1));
+		formulaScale[i] = 1.0 / container->Get<double>(
+			PARAMETER_HANDLE_INDEXED("formula_scale", i + 1, NUMBER_OF_FRACTALS + 1));
 		mRotFormulaRotation[i].SetRotation2(formulaRotation[i] * (M_PI / 180.0));
-		formulaMaterialId[i] = container->Get<int>("formula_material_id", i + 1);
+		formulaMaterialId[i] = container->Get<int>(
+			PARAMETER_HANDLE_INDEXED("formula_material_id", i + 1, NUMBER_OF_FRACTALS + 1));
 
 		if (objectData)
 		{
@@ -237,25 +279,28 @@ sParamRender::sParamRender(const cParameterContainer *container, QVector<cObject
 
 	if (!booleanOperatorsEnabled && objectData)
 	{
-		formulaMaterialId[0] = container->Get<int>("formula_material_id");
+		formulaMaterialId[0] = container->Get<int>(PARAMETER_HANDLE("formula_material_id"));
 		(*objectData)[0].materialId = formulaMaterialId[0];
 	}
 
-	common.fakeLightsMaxIter = container->Get<int>("fake_lights_max_iter");
-	common.fakeLightsMinIter = container->Get<int>("fake_lights_min_iter");
-	common.fakeLightsOrbitTrap = container->Get<CVector3>("fake_lights_orbit_trap");
-	common.foldings.boxEnable = container->Get<bool>("box_folding");
-	common.foldings.boxLimit = container->Get<double>("box_folding_limit");
-	common.foldings.boxValue = container->Get<double>("box_folding_value");
-	common.foldings.sphericalEnable = container->Get<bool>("spherical_folding");
-	common.foldings.sphericalInner = container->Get<double>("spherical_folding_inner");
-	common.foldings.sphericalOuter = container->Get<double>("spherical_folding_outer");
-	common.fractalPosition = container->Get<CVector3>("fractal_position");
-	common.fractalRotation = container->Get<CVector3>("fractal_rotation");
+	common.fakeLightsMaxIter = container->Get<int>(PARAMETER_HANDLE("fake_lights_max_iter"));
+	common.fakeLightsMinIter = container->Get<int>(PARAMETER_HANDLE("fake_lights_min_iter"));
+	common.fakeLightsOrbitTrap = container->Get<CVector3>(PARAMETER_HANDLE("fake_lights_orbit_trap"));
+	common.foldings.boxEnable = container->Get<bool>(PARAMETER_HANDLE("box_folding"));
+	common.foldings.boxLimit = container->Get<double>(PARAMETER_HANDLE("box_folding_limit"));
+	common.foldings.boxValue = container->Get<double>(PARAMETER_HANDLE("box_folding_value"));
+	common.foldings.sphericalEnable = container->Get<bool>(PARAMETER_HANDLE("spherical_folding"));
+	common.foldings.sphericalInner =
+		container->Get<double>(PARAMETER_HANDLE("spherical_folding_inner"));
+	common.foldings.sphericalOuter =
+		container->Get<double>(PARAMETER_HANDLE("spherical_folding_outer"));
+	common.fractalPosition = container->Get<CVector3>(PARAMETER_HANDLE("fractal_position"));
+	common.fractalRotation = container->Get<CVector3>(PARAMETER_HANDLE("fractal_rotation"));
 	common.mRotFractalRotation.SetRotation2(common.fractalRotation / 180.0 * M_PI);
-	common.repeat = container->Get<CVector3>("repeat");
-	common.iterThreshMode = iterThreshMode = container->Get<bool>("iteration_threshold_mode");
-	common.linearDEOffset = container->Get<double>("linear_DE_offset");
+	common.repeat = container->Get<CVector3>(PARAMETER_HANDLE("repeat"));
+	common.iterThreshMode =
+		iterThreshMode = container->Get<bool>(PARAMETER_HANDLE("iteration_threshold_mode"));
+	common.linearDEOffset = container->Get<double>(PARAMETER_HANDLE("linear_DE_offset"));
 
 	// formula = Get<int>("tile_number");
 }
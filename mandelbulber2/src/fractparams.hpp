@@ -73,6 +73,7 @@ struct sParamRender
 	int auxLightNumber;
 	int auxLightRandomNumber;
 	int auxLightRandomSeed;
+	int auxLightSamplingCount;
 	int frameNo;
 	int imageHeight; // image height
 	int imageWidth;	// image width
@@ -93,10 +94,12 @@ struct sParamRender
 	fractal::enumDEFunctionType delta_DE_function;
 
 	bool antialiasingEnabled;
+	bool antialiasingAdaptive;
 	bool ambientOcclusionEnabled; // enable global illumination
 	bool auxLightPreEnabled[4];
 	bool auxLightRandomEnabled;
 	bool auxLightRandomInOneColor;
+	bool auxLightSamplingEnabled;
 	bool background3ColorsEnable;
 	bool booleanOperatorsEnabled;
 	bool constantDEThreshold;
@@ -121,6 +124,7 @@ struct sParamRender
 	bool mainLightPositionAsRelative;
 	bool monteCarloSoftShadows;
 	bool penetratingLights;
+	bool rayPacketsEnabled; // cone marching of primary ray packets
 	bool raytracedReflections;
 	bool shadow;			// enable shadows
 	bool slowShading; // enable fake gradient calculation for shading
@@ -150,12 +154,14 @@ struct sParamRender
 
 	float ambientOcclusion;
 	double ambientOcclusionFastTune;
+	double antialiasingAdaptiveThreshold;
 	double auxLightPreIntensity[4];
 	double auxLightVisibility;
 	double auxLightVisibilitySize;
 	double auxLightRandomRadius;
 	double auxLightRandomMaxDistanceFromFractal;
 	double auxLightRandomIntensity;
+	double auxLightCullingThreshold;
 	double background_brightness;
 	double backgroundHScale;
 	double backgroundVScale;
@@ -51,6 +51,7 @@
 #include "queue.hpp"
 #include "render_job.hpp"
 #include "rendering_configuration.hpp"
+#include "tiled_render.hpp"
 #include "voxel_export.hpp"
 
 cHeadless::cHeadless() : QObject()
@@ -61,6 +62,20 @@ cHeadless::~cHeadless() = default;
 
 void cHeadless::RenderStillImage(QString filename, QString imageFileFormat)
 {
+	// very large images are rendered tile by tile and streamed to the file
+	if (gPar->Get<int>("tiles") > 1)
+	{
+		if (imageFileFormat == "png" || imageFileFormat == "png16")
+		{
+			RenderStillImageTiled(filename, imageFileFormat == "png16");
+			return;
+		}
+		cErrorMessage::showMessage(
+			QObject::tr("Tiled rendering is supported only for png and png16 formats. "
+									"The image will be rendered in one piece."),
+			cErrorMessage::warningMessage);
+	}
+
 	cImage *image = new cImage(gPar->Get<int>("image_width"), gPar->Get<int>("image_height"));
 	cRenderJob *renderJob = new cRenderJob(gPar, gParFractal, image, &gMainInterface->stopRequest);
 
@@ -118,6 +133,24 @@ void cHeadless::RenderStillImage(QString filename, QString imageFileFormat)
 	emit finished();
 }
 
+void cHeadless::RenderStillImageTiled(QString filename, bool sixteenBit)
+{
+	QString filenamePNG = ImageFileSave::ImageNameWithoutExtension(filename) + ".png";
+
+	cTiledRenderer tiledRenderer(gPar, gParFractal, &gMainInterface->stopRequest);
+	QObject::connect(&tiledRenderer,
+		SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)), this,
+		SLOT(slotUpdateProgressAndStatus(const QString &, const QString &, double)));
+
+	if (tiledRenderer.RenderAndSave(filenamePNG, sixteenBit))
+	{
+		QTextStream out(stdout);
+		out << tr("Image saved to: %1\n").arg(filenamePNG);
+	}
+
+	emit finished();
+}
+
 void cHeadless::RenderQueue()
 {
 	gQueue->slotQueueRender();
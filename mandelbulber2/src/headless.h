@@ -61,6 +61,7 @@ public:
 	};
 
 	void RenderStillImage(QString filename, QString imageFileFormat);
+	void RenderStillImageTiled(QString filename, bool sixteenBit);
 	static void RenderQueue();
 	void RenderVoxel(QString voxelFormat);
 	void RenderFlightAnimation() const;
@@ -88,6 +88,20 @@ void cHistogram::Alloc(int size)
 	}
 }
 
+// adds all bins of other histogram of the same size
+void cHistogram::Merge(const cHistogram &source)
+{
+	if (!data || !source.data) return;
+
+	int size = std::min(histSize, source.histSize);
+	for (int i = 0; i <= size; i++)
+	{
+		data[i] += source.data[i];
+	}
+	count += source.count;
+	sum += source.sum;
+}
+
 long cHistogram::GetHist(int index) const
 {
 	if (index >= 0 && index <= histSize)
@@ -115,6 +129,8 @@ void cHistogram::Copy(const cHistogram &source)
 
 void cHistogram::Clear()
 {
+	if (!data) return;
+
 	for (int i = 0; i <= histSize; i++)
 	{
 		data[i] = 0;
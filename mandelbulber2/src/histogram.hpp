@@ -49,6 +49,7 @@ public:
 	~cHistogram();
 	void Resize(int size);
 	void Clear();
+	void Merge(const cHistogram &source);
 
 	inline void Add(int index)
 	{
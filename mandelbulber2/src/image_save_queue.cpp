@@ -0,0 +1,175 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cImageSaveQueue - saving of animation frames in background thread
+ */
+
+#include "image_save_queue.hpp"
+
+#include "cimage.hpp"
+#include "files.h"
+#include "global_data.hpp"
+#include "initparameters.hpp"
+#include "parameters.hpp"
+
+cImageSaveQueue::cImageSaveQueue(QObject *_updateReceiver) : updateReceiver(_updateReceiver)
+{
+	queuedBytes = 0;
+	stopRequest = false;
+	enabled = gPar->Get<bool>("save_images_in_background");
+	memoryLimit = quint64(gPar->Get<int>("save_images_in_background_memory_limit")) * 1024 * 1024;
+
+	if (enabled) start();
+}
+
+cImageSaveQueue::~cImageSaveQueue()
+{
+	// thread finishes all queued jobs before exit
+	mutex.lock();
+	stopRequest = true;
+	jobAvailable.wakeAll();
+	mutex.unlock();
+	wait();
+}
+
+void cImageSaveQueue::Enqueue(
+	const QString &filename, ImageFileSave::enumImageFileType fileType, cImage *image)
+{
+	if (!enabled)
+	{
+		SaveImage(filename, fileType, image, updateReceiver);
+		return;
+	}
+
+	// preferences are read here, because gPar can be modified while image is saved
+	ImageFileSave::ImageConfig imageConfig = ImageConfigFromPreferences();
+	QString fileWithoutExtension = ImageFileSave::ImageNameWithoutExtension(filename);
+	QStringList fileNames;
+
+	sSaveJob job;
+	if (image->IsStereoLeftRight() && gPar->Get<bool>("stereoscopic_in_separate_files"))
+	{
+		cImage *leftImage = new cImage(1, 1, true);
+		cImage *rightImage = new cImage(1, 1, true);
+		image->GetStereoLeftRightImages(leftImage, rightImage);
+		job.images << leftImage << rightImage;
+		fileNames << fileWithoutExtension + "_left" << fileWithoutExtension + "_right";
+	}
+	else
+	{
+		cImage *imageCopy = new cImage(1, 1, true);
+		if (!imageCopy->CopyFrom(image))
+		{
+			// not enough memory for snapshot. Image is saved before any events are processed
+			delete imageCopy;
+			SaveImage(filename, fileType, image, updateReceiver);
+			return;
+		}
+		job.images << imageCopy;
+		fileNames << fileWithoutExtension;
+	}
+
+	for (int i = 0; i < job.images.size(); i++)
+	{
+		ImageFileSave *imageFileSave =
+			ImageFileSave::create(fileNames.at(i), fileType, job.images.at(i), imageConfig);
+		if (imageFileSave)
+		{
+			imageFileSave->SetParallelChannels(true);
+			imageFileSave->moveToThread(this);
+			job.savers.append(imageFileSave);
+		}
+		job.usedBytes += quint64(job.images.at(i)->GetUsedMB()) * 1024 * 1024;
+	}
+
+	// back-pressure: wait until there is memory for the snapshot. Empty queue accepts any image.
+	// Snapshot is made before waiting, because source image can be modified by events processed
+	// in WaitForQueue()
+	WaitForQueue(memoryLimit > job.usedBytes ? memoryLimit - job.usedBytes : 0);
+
+	mutex.lock();
+	jobs.enqueue(job);
+	queuedBytes += job.usedBytes;
+	jobAvailable.wakeOne();
+	mutex.unlock();
+}
+
+void cImageSaveQueue::Flush()
+{
+	if (enabled) WaitForQueue(0);
+}
+
+void cImageSaveQueue::WaitForQueue(quint64 maxQueuedBytes)
+{
+	mutex.lock();
+	while (!jobs.isEmpty() && queuedBytes > maxQueuedBytes)
+	{
+		jobFinished.wait(&mutex, 10);
+
+		// keep GUI responsive while waiting
+		mutex.unlock();
+		gApplication->processEvents();
+		mutex.lock();
+	}
+	mutex.unlock();
+}
+
+void cImageSaveQueue::run()
+{
+	forever
+	{
+		mutex.lock();
+		while (jobs.isEmpty() && !stopRequest)
+			jobAvailable.wait(&mutex);
+
+		if (jobs.isEmpty())
+		{
+			mutex.unlock();
+			return;
+		}
+
+		// job stays in queue until it's saved, so its memory is still counted
+		sSaveJob job = jobs.head();
+		mutex.unlock();
+
+		for (ImageFileSave *imageFileSave : job.savers)
+		{
+			imageFileSave->SaveImage();
+			delete imageFileSave;
+		}
+		qDeleteAll(job.images);
+
+		mutex.lock();
+		jobs.dequeue();
+		queuedBytes -= job.usedBytes;
+		jobFinished.wakeAll();
+		mutex.unlock();
+	}
+}
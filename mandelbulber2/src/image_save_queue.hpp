@@ -0,0 +1,90 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cImageSaveQueue - saving of animation frames in background thread
+ *
+ * Enqueue() makes a snapshot of the image layers and returns immediately, so the next frame
+ * can be rendered while the previous one is encoded. Channels saved to separate files are
+ * encoded in parallel. When the snapshots waiting in the queue would exceed the memory limit,
+ * Enqueue() waits until older frames are saved. The snapshot is made before waiting, so the
+ * source image can be modified by events processed meanwhile. All queued frames are saved
+ * before the queue is destroyed, also when rendering was stopped.
+ */
+
+#ifndef MANDELBULBER2_SRC_IMAGE_SAVE_QUEUE_HPP_
+#define MANDELBULBER2_SRC_IMAGE_SAVE_QUEUE_HPP_
+
+#include <QList>
+#include <QMutex>
+#include <QQueue>
+#include <QThread>
+#include <QWaitCondition>
+
+#include "file_image.hpp"
+
+class cImage;
+
+class cImageSaveQueue : public QThread
+{
+	Q_OBJECT
+public:
+	// updateReceiver gets progress information only when images are saved synchronously
+	explicit cImageSaveQueue(QObject *updateReceiver = nullptr);
+	~cImageSaveQueue() override;
+
+	// saves copy of image in background thread (or directly if background saving is disabled)
+	void Enqueue(const QString &filename, ImageFileSave::enumImageFileType fileType, cImage *image);
+
+	// waits until all queued images are saved
+	void Flush();
+
+private:
+	struct sSaveJob
+	{
+		QList<ImageFileSave *> savers;
+		QList<cImage *> images;
+		quint64 usedBytes = 0;
+	};
+
+	void run() override;
+	void WaitForQueue(quint64 maxQueuedBytes);
+
+	QObject *updateReceiver;
+	QQueue<sSaveJob> jobs;
+	QMutex mutex;
+	QWaitCondition jobAvailable;
+	QWaitCondition jobFinished;
+	quint64 queuedBytes; // memory used by snapshots in queue, including the one being saved
+	quint64 memoryLimit;
+	bool enabled;
+	bool stopRequest;
+};
+
+#endif /* MANDELBULBER2_SRC_IMAGE_SAVE_QUEUE_HPP_ */
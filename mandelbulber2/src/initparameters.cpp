@@ -66,6 +66,8 @@ void InitParams(cParameterContainer *par)
 	par->addParam("image_proportion", 0, morphNone, paramStandard);
 	par->addParam("antialiasing_enabled", false, morphNone, paramStandard);
 	par->addParam("antialiasing_size", 2, 1, 10, morphNone, paramStandard);
+	par->addParam("antialiasing_adaptive", false, morphNone, paramStandard);
+	par->addParam("antialiasing_adaptive_threshold", 0.05, 0.0, 1.0, morphNone, paramStandard);
 
 	// flight animation
 	par->addParam("flight_first_to_render", 0, 0, 9999999, morphNone, paramStandard);
@@ -184,6 +186,7 @@ void InitParams(cParameterContainer *par)
 	par->addParam("limits_enabled", false, morphLinear, paramStandard);
 	par->addParam("limit_outer_bounding", 100.0, 1e-15, 1e15, morphLinear, paramStandard);
 	par->addParam("interior_mode", false, morphLinear, paramStandard);
+	par->addParam("ray_packets_enabled", true, morphNone, paramStandard);
 	par->addParam("constant_DE_threshold", false, morphLinear, paramStandard);
 	par->addParam("hybrid_fractal_enable", false, morphNone, paramStandard);
 	par->addParam("bailout", 1e2, 1.0, 1e15, morphLinear, paramStandard);
@@ -211,6 +214,7 @@ void InitParams(cParameterContainer *par)
 	par->addParam("voxel_samples_y", 100, 2, 65535, morphLinear, paramStandard);
 	par->addParam("voxel_samples_z", 100, 2, 65535, morphLinear, paramStandard);
 	par->addParam("voxel_max_iter", 30, 1, 10000, morphLinear, paramStandard);
+	par->addParam("voxel_skip_empty_space", false, morphNone, paramStandard);
 	par->addParam("voxel_image_path",
 		QDir::toNativeSeparators(systemData.GetSlicesFolder() + QDir::separator()), morphNone,
 		paramStandard);
@@ -354,6 +358,9 @@ void InitParams(cParameterContainer *par)
 	par->addParam("aux_light_colour", 3, sRGB(64884, 64928, 48848), morphLinear, paramStandard);
 	par->addParam("aux_light_colour", 4, sRGB(52704, 62492, 45654), morphLinear, paramStandard);
 	par->addParam("aux_light_place_behind", false, morphNone, paramStandard);
+	par->addParam("aux_light_culling_threshold", 0.0, 0.0, 1e15, morphLinear, paramStandard);
+	par->addParam("aux_light_sampling_enabled", false, morphNone, paramStandard);
+	par->addParam("aux_light_sampling_count", 8, 1, 10000, morphNone, paramStandard);
 
 	par->addParam("volumetric_light_DE_Factor", 1.0, 1e-15, 1e15, morphLinear, paramStandard);
 	for (int i = 1; i <= 4; i++)
@@ -453,6 +460,9 @@ void InitParams(cParameterContainer *par)
 	par->addParam("netrender_client_remote_address", QString("localhost"), morphNone, paramApp);
 	par->addParam("netrender_client_remote_port", 5555, morphNone, paramApp);
 	par->addParam("netrender_server_local_port", 5555, morphNone, paramApp);
+	par->addParam("netrender_distribute_frames", false, morphNone, paramApp);
+	par->addParam("netrender_frames_chunk_time", 10.0, 0.1, 1000.0, morphNone, paramApp);
+	par->addParam("netrender_compression", int(CNetRender::netRenderCodec_LZO), morphNone, paramApp);
 
 	par->addParam("default_image_path", systemData.GetImagesFolder(), morphNone, paramApp);
 	par->addParam("default_textures_path", systemData.sharedDir + "textures", morphNone, paramApp);
@@ -521,9 +531,13 @@ void InitParams(cParameterContainer *par)
 	par->addParam("linear_colorspace", true, morphNone, paramApp);
 	par->addParam("jpeg_quality", 95, 1, 100, morphNone, paramApp);
 	par->addParam("stereoscopic_in_separate_files", false, morphNone, paramApp);
+	par->addParam("optional_layers_half_float", false, morphNone, paramApp);
+	par->addParam("save_images_in_background", true, morphNone, paramApp);
+	par->addParam("save_images_in_background_memory_limit", 2048, 1, 1000000, morphNone, paramApp);
 
 	par->addParam("logging_verbosity", 1, 0, 3, morphNone, paramApp);
 	par->addParam("threads_priority", 2, 0, 3, morphNone, paramApp);
+	par->addParam("undo_memory_limit", 100, 1, 100000, morphNone, paramApp);
 
 	par->addParam("opencl_enabled", false, morphNone, paramApp);
 	par->addParam("opencl_platform", 0, morphNone, paramApp);
@@ -200,8 +200,7 @@ void cInterface::ShowUi()
 	WriteLog("Setup of main image", 2);
 	mainImage = new cImage(gPar->Get<int>("image_width"), gPar->Get<int>("image_height"));
 	mainImage->CreatePreview(1.0, 800, 600, gMainInterface->renderedImage);
-	mainImage->CompileImage();
-	mainImage->ConvertTo8bit();
+	mainImage->CompileImageAndConvertTo8bit();
 	mainImage->UpdatePreview();
 	mainImage->SetAsMainImage();
 	renderedImage->setMinimumSize(
@@ -954,9 +953,7 @@ void cInterface::RefreshMainImage()
 		imageAdjustments.hdrEnabled = gPar->Get<bool>("hdr");
 
 		mainImage->SetImageParameters(imageAdjustments);
-		mainImage->CompileImage();
-
-		mainImage->ConvertTo8bit();
+		mainImage->CompileImageAndConvertTo8bit();
 		mainImage->UpdatePreview();
 		mainImage->GetImageWidget()->update();
 	}
@@ -1029,8 +1026,7 @@ void cInterface::RefreshPostEffects()
 
 				rendererSSAO.RenderSSAO();
 
-				mainImage->CompileImage();
-				mainImage->ConvertTo8bit();
+				mainImage->CompileImageAndConvertTo8bit();
 				mainImage->UpdatePreview();
 				mainImage->GetImageWidget()->update();
 			}
@@ -1080,9 +1076,7 @@ void cInterface::RefreshPostEffects()
 			delete hdrBlur;
 		}
 
-		mainImage->CompileImage();
-
-		mainImage->ConvertTo8bit();
+		mainImage->CompileImageAndConvertTo8bit();
 		mainImage->UpdatePreview();
 		mainImage->GetImageWidget()->update();
 	}
@@ -34,6 +34,9 @@
 
 #include "lights.hpp"
 
+#include <algorithm>
+#include <numeric>
+
 #include "calculate_distance.hpp"
 #include "common_math.h"
 #include "fractal_container.hpp"
@@ -50,6 +53,7 @@ cLights::cLights() : QObject()
 	numberOfLights = 0;
 	lightsReady = false;
 	isAnyLight = false;
+	cullingEnabled = false;
 }
 
 cLights::cLights(const cParameterContainer *_params, const cFractalContainer *_fractal) : QObject()
@@ -58,6 +62,7 @@ cLights::cLights(const cParameterContainer *_params, const cFractalContainer *_f
 	numberOfLights = 0;
 	lightsReady = false;
 	isAnyLight = false;
+	cullingEnabled = false;
 	dummyLight = sLight();
 	Set(_params, _fractal);
 }
@@ -180,6 +185,8 @@ void cLights::Set(const cParameterContainer *_params, const cFractalContainer *_
 		}
 	}
 
+	BuildInfluenceBvh(params->auxLightCullingThreshold);
+
 	lightsReady = true;
 
 	delete params;
@@ -215,9 +222,94 @@ void cLights::Copy(const cLights &_lights)
 	if (lights) delete[] lights;
 	lights = new sLight[numberOfLights];
 	isAnyLight = _lights.isAnyLight;
+	cullingEnabled = _lights.cullingEnabled;
+	influenceRadii = _lights.influenceRadii;
+	lightOrder = _lights.lightOrder;
+	bvhNodes = _lights.bvhNodes;
 
 	for (int i = 0; i < numberOfLights; i++)
 	{
 		lights[i] = _lights.lights[i];
 	}
 }
+
+void cLights::BuildInfluenceBvh(double threshold)
+{
+	// the same normalization as in cRenderWorker::AuxLightsShader()
+	int number = max(numberOfLights, 4);
+
+	cullingEnabled = threshold > 0.0;
+	influenceRadii.fill(0.0, numberOfLights);
+	lightOrder.clear();
+	bvhNodes.clear();
+
+	for (int i = 0; i < numberOfLights; i++)
+	{
+		if (lights[i].enabled && lights[i].intensity > 0.0f)
+		{
+			// distance where intensity of light calculated in LightShading() is equal to threshold.
+			// Specular highlights of shiny materials can be a bit brighter than that
+			if (cullingEnabled)
+				influenceRadii[i] = sqrt(100.0 * lights[i].intensity / (number * 6.0 * threshold));
+			lightOrder.append(i);
+		}
+	}
+
+	if (cullingEnabled && !lightOrder.isEmpty())
+	{
+		const int maxLightsInLeaf = 4;
+		BuildBvh(&bvhNodes, &lightOrder, 0, lightOrder.size(), maxLightsInLeaf,
+			[this](int i) { return lights[i].position; }, [this](int i) { return influenceRadii[i]; },
+			[](int, int, CVector3 minCorner, CVector3 maxCorner) {
+				return sLightBound{minCorner, maxCorner};
+			});
+	}
+}
+
+void cLights::GetLightsAtPoint(CVector3 point, std::vector<int> *indices) const
+{
+	indices->clear();
+
+	if (!cullingEnabled)
+	{
+		indices->insert(indices->end(), lightOrder.begin(), lightOrder.end());
+		return;
+	}
+	// only leaves which contain the point are visited
+	TraverseBvh(bvhNodes, point, [](double boxDistance) { return boxDistance > 0.0; },
+		[&](int first, int count) {
+			for (int i = first; i < first + count; i++)
+			{
+				int index = lightOrder[i];
+				CVector3 d = lights[index].position - point;
+				double radius = influenceRadii[index];
+				if (d.Dot(d) < radius * radius) indices->push_back(index);
+			}
+		});
+}
+
+double cLights::SamplingWeight(
+	const sLight *light, CVector3 point, CVector3 normal, double materialShading)
+{
+	CVector3 d = light->position - point;
+	double distance2 = max(d.Dot(d), 1e-30);
+	double cosine = normal.Dot(d) / sqrt(distance2);
+	// back lit points keep small probability because of specular highlights
+	double shade = max(1.0 - materialShading + cosine * materialShading, 0.05);
+	return light->intensity / distance2 * shade
+				 * (light->colour.R + light->colour.G + light->colour.B + 1.0);
+}
+
+int cLights::SampleCandidate(
+	const std::vector<double> &cumulativeWeights, double random, double *inverseProbability)
+{
+	const int numberOfCandidates = int(cumulativeWeights.size());
+	const double totalWeight = cumulativeWeights.back();
+	int i = int(std::upper_bound(cumulativeWeights.begin(), cumulativeWeights.end(),
+								random * totalWeight)
+							- cumulativeWeights.begin());
+	if (i >= numberOfCandidates) i = numberOfCandidates - 1;
+	double weight = cumulativeWeights[i] - (i > 0 ? cumulativeWeights[i - 1] : 0.0);
+	*inverseProbability = totalWeight / weight;
+	return i;
+}
@@ -35,9 +35,13 @@
 #ifndef MANDELBULBER2_SRC_LIGHTS_HPP_
 #define MANDELBULBER2_SRC_LIGHTS_HPP_
 
+#include <vector>
+
 #include <QObject>
+#include <QVector>
 
 #include "algebra.hpp"
+#include "bvh.hpp"
 #include "color_structures.hpp"
 
 // forward declarations
@@ -53,21 +57,48 @@ struct sLight
 	sLight() : position(), colour(), intensity(), enabled() {}
 };
 
+// box enclosing influence spheres of lights in node of bounding volume hierarchy
+struct sLightBound
+{
+	CVector3 boxMin;
+	CVector3 boxMax;
+	// positive only when point is outside the box
+	double Distance(CVector3 point) const
+	{
+		const double dx = std::max(boxMin.x - point.x, point.x - boxMax.x);
+		const double dy = std::max(boxMin.y - point.y, point.y - boxMax.y);
+		const double dz = std::max(boxMin.z - point.z, point.z - boxMax.z);
+		return std::max(std::max(dx, dy), std::max(dz, 0.0));
+	}
+};
+
 class cLights : public QObject
 {
 	Q_OBJECT
 public:
 	cLights();
-	cLights(const cLights &_lights) : QObject() { Copy(_lights); }
+	cLights(const cLights &_lights) : QObject(), lights(nullptr) { Copy(_lights); }
 	cLights(const cParameterContainer *_params, const cFractalContainer *_fractal);
 	void Set(const cParameterContainer *_params, const cFractalContainer *_fractal);
 	~cLights() override;
 	sLight *GetLight(const int index) const;
 	int GetNumberOfLights() const { return numberOfLights; }
 	int IsAnyLightEnabled() const { return isAnyLight; };
+	// indices of enabled lights which can illuminate the point noticeably
+	void GetLightsAtPoint(CVector3 point, std::vector<int> *indices) const;
+
+	// estimated unshadowed illumination of the point, used as probability of sampling the light
+	static double SamplingWeight(
+		const sLight *light, CVector3 point, CVector3 normal, double materialShading);
+	// chooses candidate with probability proportional to its weight. cumulativeWeights are running
+	// sums of weights, random is in range [0, 1). Returns index of candidate and inverse of
+	// probability of the choice
+	static int SampleCandidate(
+		const std::vector<double> &cumulativeWeights, double random, double *inverseProbability);
 
 private:
 	void Copy(const cLights &);
+	void BuildInfluenceBvh(double threshold);
 
 	sLight *lights;
 	sLight dummyLight;
@@ -75,6 +106,13 @@ private:
 	bool lightsReady;
 	bool isAnyLight;
 
+	// lights are culled by radius where their intensity falls below threshold
+	bool cullingEnabled;
+	QVector<double> influenceRadii;
+	// enabled lights in order of leaves of bounding volume hierarchy
+	QVector<int> lightOrder;
+	QVector<sBvhNode<sLightBound>> bvhNodes;
+
 signals:
 	void updateProgressAndStatus(const QString &text, const QString &progressText, double progress);
 };
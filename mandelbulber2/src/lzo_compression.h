@@ -116,4 +116,29 @@ QByteArray lzoUncompress(QByteArray data)
 	return arr;
 }
 
+// compression into given buffer. Buffers are reused, so there is no allocation for every call
+void lzoCompress(const char *data, int size, QByteArray *out, QByteArray *workMemory)
+{
+	if (workMemory->size() < LZO1X_1_MEM_COMPRESS) workMemory->resize(LZO1X_1_MEM_COMPRESS);
+	lzo_uint len = lzo_uint(size) + size / 16 + 64 + 3;
+	out->resize(int(len));
+
+	int ret = lzo1x_1_compress((lzo_bytep)data, lzo_uint(size), (lzo_bytep)out->data(), &len,
+		(lzo_voidp)workMemory->data());
+
+	assert(ret == LZO_E_OK);
+	Q_UNUSED(ret);
+
+	out->resize(int(len));
+}
+
+// uncompression when the size of uncompressed data is already known
+bool lzoUncompress(const char *data, int size, char *out, int uncompressedSize)
+{
+	lzo_uint len = lzo_uint(uncompressedSize);
+	int ret =
+		lzo1x_decompress_safe((lzo_bytep)data, lzo_uint(size), (lzo_bytep)out, &len, nullptr);
+	return ret == LZO_E_OK && len == lzo_uint(uncompressedSize);
+}
+
 #endif /* MANDELBULBER2_SRC_LZO_COMPRESSION_H_ */
@@ -51,6 +51,7 @@
 #include "opencl_global.h"
 #include "queue.hpp"
 #include "render_data.hpp"
+#include "render_worker_pool.hpp"
 #include "render_window.hpp"
 #include "rendered_image_widget.hpp"
 #include "settings.hpp"
@@ -142,6 +143,9 @@ int main(int argc, char *argv[])
 	// Netrender
 	gNetRender = new CNetRender(systemData.numberOfThreads);
 
+	// threads for rendering, reused by all renders
+	gRenderWorkerPool = new cRenderWorkerPool;
+
 	// loading AppSettings
 	QString iniFileName = systemData.GetIniFile();
 	if (QFile(iniFileName).exists())
@@ -229,6 +233,7 @@ int main(int argc, char *argv[])
 	delete gKeyframes;
 	delete gNetRender;
 	delete gQueue;
+	delete gRenderWorkerPool;
 #ifdef USE_OPENCL
 	delete gOpenCl;
 #endif
@@ -36,11 +36,14 @@
 
 #include "marchingcubes.h"
 
+#include <algorithm>
+
 #include <QMap>
 
 #include "calculate_distance.hpp"
 #include "common_math.h"
 #include "compute_fractal.hpp"
+#include "file_mesh.hpp"
 #include "fractal_container.hpp"
 #include "fractparams.hpp"
 #include "initparameters.hpp"
@@ -49,6 +52,7 @@
 #include "opencl_engine_render_fractal.h"
 #include "opencl_global.h"
 #include "render_data.hpp"
+#include "sparse_voxel_plane.hpp"
 
 // custom includes
 #ifdef USE_OPENCL
@@ -58,9 +62,7 @@
 MarchingCubes::MarchingCubes(const cParameterContainer *paramsContainer,
 	const cFractalContainer *fractalContainer, sParamRender *params, cNineFractals *fractals,
 	sRenderData *renderData, int numx, int numy, int numz, const CVector3 &lower,
-	const CVector3 &upper, double dist_thresh, bool *stop, std::vector<double> &vertices,
-	std::vector<long long> &polygons, std::vector<double> &colorIndices)
-		: vertices{vertices}, polygons{polygons}, colorIndices{colorIndices}
+	const CVector3 &upper, double dist_thresh, bool *stop, MeshFileSave *meshFile)
 {
 	this->numx = numx;
 	this->numy = numy;
@@ -88,31 +90,42 @@ MarchingCubes::MarchingCubes(const cParameterContainer *paramsContainer,
 	yz3 = numy * z3;
 
 	this->stop = stop;
+	this->meshFile = meshFile;
+	numberOfVertices = 0;
 
-	shared_indices = nullptr;
+	edgeIndices = nullptr;
 	voxelBuffer = nullptr;
 	colorBuffer = nullptr;
+	voxelPlane = nullptr;
 
 	coloredMesh = paramsContainer->Get<bool>("mesh_color");
+	palette = paramsContainer->Get<cColorPalette>("mat1_surface_color_palette");
 
 	try
 	{
-		shared_indices = new long long[2 * numy * numz * 3];
+		// edges along y and z axis for two voxel planes and edges along x axis between them
+		edgeIndices = new long long[5 * numyzb];
 		voxelBuffer = new double[2 * numyzb];
 		colorBuffer = new double[2 * numyzb];
+		chunks.resize(numyb);
+		voxelPlane = new cSparseVoxelPlane(params, fractals, renderData, dist_thresh,
+			dMax(dx, dy, dz), paramsContainer->Get<bool>("voxel_skip_empty_space"));
 	}
 	catch (std::bad_alloc &ba)
 	{
 		FreeBuffers();
 		throw ba;
 	}
+
+	std::fill(edgeIndices, edgeIndices + 5 * numyzb, -1LL);
 }
 
 void MarchingCubes::FreeBuffers()
 {
-	if (shared_indices) delete[] shared_indices;
+	if (edgeIndices) delete[] edgeIndices;
 	if (voxelBuffer) delete[] voxelBuffer;
 	if (colorBuffer) delete[] colorBuffer;
+	delete voxelPlane;
 }
 
 void MarchingCubes::RunMarchingCube()
@@ -199,7 +212,7 @@ void MarchingCubes::RunMarchingCube()
 		}
 		if (i > 0)
 		{
-			calculateEdges(i);
+			calculateLayer(i, i == 1);
 		}
 		if (*stop) break;
 	}
@@ -212,6 +225,14 @@ void MarchingCubes::RunMarchingCube()
 	}
 #endif // USE_OPENCL
 
+	if (!openClEnabled)
+	{
+		WriteLog(QString("Mesh export: %1 voxels calculated, %2 voxels skipped as empty space")
+							 .arg(voxelPlane->GetNumberOfCalculatedVoxels())
+							 .arg(voxelPlane->GetNumberOfSkippedVoxels()),
+			2);
+	}
+
 	emit finished();
 }
 
@@ -223,56 +244,91 @@ void MarchingCubes::calculateVoxelPlane(int i)
 	{
 		double xx = lower.x + dx * (ii + i);
 
-		for (long long jj = 0; jj < numyb; ++jj)
+		sVoxelPlane plane;
+		plane.origin = CVector3(xx, lower.y, lower.z);
+		plane.stepU = CVector3(0.0, dy, 0.0);
+		plane.stepV = CVector3(0.0, 0.0, dz);
+		plane.sizeU = numyb;
+		plane.sizeV = numzb;
+		plane.strideU = numzb;
+		plane.strideV = 1;
+
+		long long ptr = ii * numyzb;
+		voxelPlane->Calculate(plane, &voxelBuffer[ptr], &colorBuffer[ptr], stop);
+		if (*stop) return;
+	}
+}
+
+void MarchingCubes::calculateLayer(int i, bool firstLayer)
+{
+	const int plane0 = i % 2;
+	const int plane1 = 1 - plane0;
+
+	// Vertices are generated for every edge only once, by the row of voxels where the edge starts.
+	// Rows are processed in parallel. Every row collects its vertices in own chunk and they get
+	// global indices when the numbers of vertices in all preceding rows are known.
+	// Vertices on edges of the first voxel plane were already generated for the previous layer.
+#pragma omp parallel for schedule(dynamic, 1)
+	for (long long j = 0; j < numyb; ++j)
+	{
+		if (*stop) continue;
+
+		sMeshChunk *chunk = &chunks[j];
+		chunk->vertices.clear();
+		chunk->colorIndices.clear();
+		if (firstLayer)
 		{
-			if (*stop)
-			{
-				return;
-			}
+			calculateRowVertices(i, j, 0, 1, chunk);
+			calculateRowVertices(i, j, 0, 2, chunk);
+		}
+		calculateRowVertices(i, j, 0, 0, chunk);
+		calculateRowVertices(i, j, 1, 1, chunk);
+		calculateRowVertices(i, j, 1, 2, chunk);
 
-			double yy = lower.y + dy * jj;
+		chunk->colors.resize(chunk->colorIndices.size());
+		for (size_t n = 0; n < chunk->colorIndices.size(); n++)
+		{
+			sRGB color = palette.IndexToColour(int(chunk->colorIndices[n]));
+			chunk->colors[n] = sRGB8(color.R, color.G, color.B);
+		}
+	}
+	if (*stop) return;
 
-#ifdef USE_OFFLOAD
-#pragma offload target(mic) inout(voxelBuffer) inout(colorBuffer) nocopy(f)
-#endif // USE_OFFLOAD
+	for (long long j = 0; j < numyb; ++j)
+	{
+		chunks[j].firstVertex = numberOfVertices;
+		numberOfVertices += chunks[j].vertices.size() / 3;
+	}
 
+	// change indices of vertices from local to global and calculate triangles
 #pragma omp parallel for schedule(dynamic, 1)
-			for (long long kk = 0; kk < numzb;
-					 ++kk) // long long is used because size_t doesn't work with msvc and OpenMP
+	for (long long j = 0; j < numyb; ++j)
+	{
+		const long long firstVertex = chunks[j].firstVertex;
+		for (long long k = 0; k < numzb; ++k)
+		{
+			if (firstLayer)
 			{
-				long long ptr = ii * numyzb + jj * numzb + kk;
-
-				double zz = lower.z + dz * kk;
-				voxelBuffer[ptr] = getDistance(xx, yy, zz, &colorBuffer[ptr]);
+				if (EdgeIndex(plane0, 1, j, k) >= 0) EdgeIndex(plane0, 1, j, k) += firstVertex;
+				if (EdgeIndex(plane0, 2, j, k) >= 0) EdgeIndex(plane0, 2, j, k) += firstVertex;
 			}
+			if (EdgeIndex(plane0, 0, j, k) >= 0) EdgeIndex(plane0, 0, j, k) += firstVertex;
+			if (EdgeIndex(plane1, 1, j, k) >= 0) EdgeIndex(plane1, 1, j, k) += firstVertex;
+			if (EdgeIndex(plane1, 2, j, k) >= 0) EdgeIndex(plane1, 2, j, k) += firstVertex;
 		}
 	}
-}
-
-void MarchingCubes::calculateEdges(int i)
-{
-	double x = lower.x + dx * i;
-	double x_dx = lower.x + dx * (i + 1);
-	const int i_mod_2 = i % 2;
-	const int i_mod_2_inv = (i_mod_2 ? 0 : 1);
 
+#pragma omp parallel for schedule(dynamic, 1)
 	for (long long j = 0; j < numy; ++j)
 	{
-		if (*stop)
-		{
-			return;
-		}
+		if (*stop) continue;
 
-		double y = lower.y + dy * j;
-		double y_dy = lower.y + dy * (j + 1);
+		std::vector<long long> &polygons = chunks[j].polygons;
+		polygons.clear();
 
 		for (long long k = 0; k < numz; ++k)
 		{
-			double z = lower.z + dz * k;
-			double z_dz = lower.z + dz * (k + 1);
-
 			double v[8];
-			double colorIndex[8];
 			v[0] = voxelBuffer[j * numzb + k];
 			v[1] = voxelBuffer[numyzb + j * numzb + k];
 			v[2] = voxelBuffer[numyzb + (j + 1) * numzb + k];
@@ -282,145 +338,27 @@ void MarchingCubes::calculateEdges(int i)
 			v[6] = voxelBuffer[numyzb + (j + 1) * numzb + k + 1];
 			v[7] = voxelBuffer[(j + 1) * numzb + k + 1];
 
-			colorIndex[0] = colorBuffer[j * numzb + k];
-			colorIndex[1] = colorBuffer[numyzb + j * numzb + k];
-			colorIndex[2] = colorBuffer[numyzb + (j + 1) * numzb + k];
-			colorIndex[3] = colorBuffer[(j + 1) * numzb + k];
-			colorIndex[4] = colorBuffer[j * numzb + k + 1];
-			colorIndex[5] = colorBuffer[numyzb + j * numzb + k + 1];
-			colorIndex[6] = colorBuffer[numyzb + (j + 1) * numzb + k + 1];
-			colorIndex[7] = colorBuffer[(j + 1) * numzb + k + 1];
-
 			unsigned int cubeindex = 0;
 
 			for (int m = 0; m < 8; ++m)
 				if (v[m] <= dist_thresh) cubeindex |= 1 << m;
 
-			// Generate vertices AVOIDING DUPLICATES.
-
-			int edges = edge_table[cubeindex];
-			std::vector<long long> indices(12, -1);
-			if (edges & 0x040)
-			{
-				indices[6] = vertices.size() / 3;
-				shared_indices[i_mod_2 * yz3 + j * z3 + k * 3 + 0] = indices[6];
-				mc_add_vertex(x_dx, y_dy, z_dz, x, 0, v[6], v[7], dist_thresh, &vertices, colorIndex[6],
-					colorIndex[7], &colorIndices);
-			}
-			if (edges & 0x020)
-			{
-				indices[5] = vertices.size() / 3;
-				shared_indices[i_mod_2 * yz3 + j * z3 + k * 3 + 1] = indices[5];
-				mc_add_vertex(x_dx, y, z_dz, y_dy, 1, v[5], v[6], dist_thresh, &vertices, colorIndex[5],
-					colorIndex[6], &colorIndices);
-			}
-			if (edges & 0x400)
-			{
-				indices[10] = vertices.size() / 3;
-				shared_indices[i_mod_2 * yz3 + j * z3 + k * 3 + 2] = indices[10];
-				mc_add_vertex(x_dx, y + dx, z, z_dz, 2, v[2], v[6], dist_thresh, &vertices, colorIndex[2],
-					colorIndex[6], &colorIndices);
-			}
-
-			if (edges & 0x001)
-			{
-				if (j == 0 || k == 0)
-				{
-					indices[0] = vertices.size() / 3;
-					mc_add_vertex(x, y, z, x_dx, 0, v[0], v[1], dist_thresh, &vertices, colorIndex[0],
-						colorIndex[1], &colorIndices);
-				}
-				else
-					indices[0] = shared_indices[i_mod_2 * yz3 + (j - 1) * z3 + (k - 1) * 3 + 0];
-			}
-			if (edges & 0x002)
-			{
-				if (k == 0)
-				{
-					indices[1] = vertices.size() / 3;
-					mc_add_vertex(x_dx, y, z, y_dy, 1, v[1], v[2], dist_thresh, &vertices, colorIndex[1],
-						colorIndex[2], &colorIndices);
-				}
-				else
-					indices[1] = shared_indices[i_mod_2 * yz3 + j * z3 + (k - 1) * 3 + 1];
-			}
-			if (edges & 0x004)
-			{
-				if (k == 0)
-				{
-					indices[2] = vertices.size() / 3;
-					mc_add_vertex(x_dx, y_dy, z, x, 0, v[2], v[3], dist_thresh, &vertices, colorIndex[2],
-						colorIndex[3], &colorIndices);
-				}
-				else
-					indices[2] = shared_indices[i_mod_2 * yz3 + j * z3 + (k - 1) * 3 + 0];
-			}
-			if (edges & 0x008)
-			{
-				if (i == 0 || k == 0)
-				{
-					indices[3] = vertices.size() / 3;
-					mc_add_vertex(x, y_dy, z, y, 1, v[3], v[0], dist_thresh, &vertices, colorIndex[3],
-						colorIndex[0], &colorIndices);
-				}
-				else
-					indices[3] = shared_indices[i_mod_2_inv * yz3 + j * z3 + (k - 1) * 3 + 1];
-			}
-			if (edges & 0x010)
-			{
-				if (j == 0)
-				{
-					indices[4] = vertices.size() / 3;
-					mc_add_vertex(x, y, z_dz, x_dx, 0, v[4], v[5], dist_thresh, &vertices, colorIndex[4],
-						colorIndex[5], &colorIndices);
-				}
-				else
-					indices[4] = shared_indices[i_mod_2 * yz3 + (j - 1) * z3 + k * 3 + 0];
-			}
-			if (edges & 0x080)
-			{
-				if (i == 0)
-				{
-					indices[7] = vertices.size() / 3;
-					mc_add_vertex(x, y_dy, z_dz, y, 1, v[7], v[4], dist_thresh, &vertices, colorIndex[7],
-						colorIndex[4], &colorIndices);
-				}
-				else
-					indices[7] = shared_indices[i_mod_2_inv * yz3 + j * z3 + k * 3 + 1];
-			}
-			if (edges & 0x100)
-			{
-				if (i == 0 || j == 0)
-				{
-					indices[8] = vertices.size() / 3;
-					mc_add_vertex(x, y, z, z_dz, 2, v[0], v[4], dist_thresh, &vertices, colorIndex[0],
-						colorIndex[4], &colorIndices);
-				}
-				else
-					indices[8] = shared_indices[i_mod_2_inv * yz3 + (j - 1) * z3 + k * 3 + 2];
-			}
-			if (edges & 0x200)
-			{
-				if (j == 0)
-				{
-					indices[9] = vertices.size() / 3;
-					mc_add_vertex(x_dx, y, z, z_dz, 2, v[1], v[5], dist_thresh, &vertices, colorIndex[1],
-						colorIndex[3], &colorIndices);
-				}
-				else
-					indices[9] = shared_indices[i_mod_2 * yz3 + (j - 1) * z3 + k * 3 + 2];
-			}
-			if (edges & 0x800)
-			{
-				if (i == 0)
-				{
-					indices[11] = vertices.size() / 3;
-					mc_add_vertex(x, y_dy, z, z_dz, 2, v[3], v[7], dist_thresh, &vertices, colorIndex[3],
-						colorIndex[7], &colorIndices);
-				}
-				else
-					indices[11] = shared_indices[i_mod_2_inv * yz3 + j * z3 + k * 3 + 2];
-			}
+			if (edge_table[cubeindex] == 0) continue;
+
+			// vertices shared with neighbouring cubes are taken from edge indices
+			long long indices[12];
+			indices[0] = EdgeIndex(plane0, 0, j, k);
+			indices[1] = EdgeIndex(plane1, 1, j, k);
+			indices[2] = EdgeIndex(plane0, 0, j + 1, k);
+			indices[3] = EdgeIndex(plane0, 1, j, k);
+			indices[4] = EdgeIndex(plane0, 0, j, k + 1);
+			indices[5] = EdgeIndex(plane1, 1, j, k + 1);
+			indices[6] = EdgeIndex(plane0, 0, j + 1, k + 1);
+			indices[7] = EdgeIndex(plane0, 1, j, k + 1);
+			indices[8] = EdgeIndex(plane0, 2, j, k);
+			indices[9] = EdgeIndex(plane1, 2, j, k);
+			indices[10] = EdgeIndex(plane1, 2, j + 1, k);
+			indices[11] = EdgeIndex(plane0, 2, j + 1, k);
 
 			int tri;
 			int *triangle_table_ptr = triangle_table[cubeindex];
@@ -428,34 +366,64 @@ void MarchingCubes::calculateEdges(int i)
 				polygons.push_back(indices[tri]);
 		}
 	}
+	if (*stop) return;
+
+	// finished part of the mesh is streamed to the file
+	for (long long j = 0; j < numyb; ++j)
+	{
+		const sMeshChunk &chunk = chunks[j];
+		meshFile->AppendVertices(chunk.vertices.data(), chunk.colors.data(), chunk.colors.size());
+	}
+	for (long long j = 0; j < numy; ++j)
+	{
+		const sMeshChunk &chunk = chunks[j];
+		meshFile->AppendPolygons(chunk.polygons.data(), chunk.polygons.size() / 3);
+	}
 }
 
-#ifdef USE_OFFLOAD
-__declspec(target(mic))
-#endif // USE_OFFLOAD
-	double MarchingCubes::getDistance(double x, double y, double z, double *colorIndex) const
+int MarchingCubes::NumberOfTriangles(unsigned int cubeIndex)
 {
-	CVector3 point;
-	point.x = x;
-	point.y = y;
-	point.z = z;
-
-	sDistanceOut distanceOut;
-	sDistanceIn distanceIn(point, dist_thresh, false);
-
-	double dist = CalculateDistance(*params, *fractals, distanceIn, &distanceOut, renderData);
-
-	cObjectData objectData = renderData->objectData[distanceOut.objectId];
-	cMaterial *material = &renderData->materials[objectData.materialId];
-
-	sFractalIn fractIn(point, params->minN, params->N, params->common, -1, material);
-	sFractalOut fractOut;
+	int count = 0;
+	while (count < 16 && triangle_table[cubeIndex][count] != -1)
+		count++;
+	return count / 3;
+}
 
-	Compute<fractal::calcModeColouring>(*fractals, fractIn, &fractOut);
+void MarchingCubes::calculateRowVertices(
+	int i, long long j, int voxelPlane, int axis, sMeshChunk *chunk)
+{
+	// there are no edges along y axis starting from the last row
+	if (axis == 1 && j == numy) return;
+
+	const int edgePlane = (i + voxelPlane) % 2;
+	const long long neighbourOffset = (axis == 0) ? numyzb : (axis == 1) ? numzb : 1;
+	const long long kMax = (axis == 2) ? numz : numzb;
+	const double *voxels = &voxelBuffer[voxelPlane * numyzb + j * numzb];
+	const double *colors = &colorBuffer[voxelPlane * numyzb + j * numzb];
+	long long *indices = &EdgeIndex(edgePlane, axis, j, 0);
+
+	double x = lower.x + dx * (i + voxelPlane);
+	double y = lower.y + dy * j;
+	double x_dx = lower.x + dx * (i + voxelPlane + 1);
+	double y_dy = lower.y + dy * (j + 1);
+
+	for (long long k = 0; k < kMax; ++k)
+	{
+		double f1 = voxels[k];
+		double f2 = voxels[k + neighbourOffset];
+		if ((f1 <= dist_thresh) == (f2 <= dist_thresh))
+		{
+			indices[k] = -1;
+			continue;
+		}
 
-	*colorIndex = fractOut.colorIndex;
+		indices[k] = chunk->vertices.size() / 3;
 
-	return dist;
+		double z = lower.z + dz * k;
+		double c2 = (axis == 0) ? x_dx : (axis == 1) ? y_dy : lower.z + dz * (k + 1);
+		mc_add_vertex(x, y, z, c2, axis, f1, f2, dist_thresh, &chunk->vertices, colors[k],
+			colors[k + neighbourOffset], &chunk->colorIndices);
+	}
 }
 
 int MarchingCubes::edge_table[256] = {0x000, 0x109, 0x203, 0x30a, 0x406, 0x50f, 0x605, 0x70c, 0x80c,
@@ -43,12 +43,15 @@
 #include <QObject>
 
 #include "algebra.hpp"
+#include "color_palette.hpp"
 
 struct sParamRender;
 class cNineFractals;
 struct sRenderData;
 class cParameterContainer;
 class cFractalContainer;
+class MeshFileSave;
+class cSparseVoxelPlane;
 
 class MarchingCubes : public QObject
 {
@@ -58,11 +61,13 @@ public:
 	MarchingCubes(const cParameterContainer *paramsContainer,
 		const cFractalContainer *fractalContainer, sParamRender *params, cNineFractals *fractals,
 		sRenderData *renderData, int numx, int numy, int numz, const CVector3 &lower,
-		const CVector3 &upper, double dist_thresh, bool *stop, std::vector<double> &vertices,
-		std::vector<long long> &polygons, std::vector<double> &colorIndices);
+		const CVector3 &upper, double dist_thresh, bool *stop, MeshFileSave *meshFile);
 
 	~MarchingCubes() override { FreeBuffers(); }
 
+	// number of triangles of the cube which has corners inside the surface marked in cubeIndex
+	static int NumberOfTriangles(unsigned int cubeIndex);
+
 public slots:
 	void RunMarchingCube();
 
@@ -71,10 +76,20 @@ private:
 	static int edge_table[256];
 	static int triangle_table[256][16];
 
+	// mesh data generated for one row of voxels of currently processed layer
+	struct sMeshChunk
+	{
+		long long firstVertex = 0;
+		std::vector<double> vertices;
+		std::vector<double> colorIndices;
+		std::vector<sRGB8> colors;
+		std::vector<long long> polygons;
+	};
+
 #ifdef USE_OFFLOAD
 	__declspec(target(mic))
 #endif // USE_OFFLOAD
-		long long *shared_indices;
+		long long *edgeIndices;
 
 #ifdef USE_OFFLOAD
 	__declspec(target(mic))
@@ -108,15 +123,28 @@ private:
 	bool coloredMesh;
 
 	bool *stop;
-	std::vector<double> &vertices;
-	std::vector<long long> &polygons;
-	std::vector<double> &colorIndices;
+	cSparseVoxelPlane *voxelPlane;
+	MeshFileSave *meshFile;
+	cColorPalette palette;
+	std::vector<sMeshChunk> chunks;
+	long long numberOfVertices;
 
 	void calculateVoxelPlane(int i);
 
-	void calculateEdges(int i);
+	// generates vertices and triangles of layer of cubes between voxel planes i and i+1
+	void calculateLayer(int i, bool firstLayer);
 
-	double getDistance(double x, double y, double z, double *colorIndex) const;
+	// generates vertices on edges along given axis which start in row j of voxel plane
+	void calculateRowVertices(
+		int i, long long j, int voxelPlane, int axis, sMeshChunk *chunk);
+
+	// index of the mesh vertex placed on the edge which starts in voxel (j, k) of given voxel plane.
+	// Edges along x axis are stored only for the current layer. -1 means no vertex on the edge
+	inline long long &EdgeIndex(int plane, int axis, long long j, long long k)
+	{
+		long long offset = (axis == 0) ? 4 * numyzb : (plane * 2 + axis - 1) * numyzb;
+		return edgeIndices[offset + j * numzb + k];
+	}
 
 	inline double mc_isovalue_interpolation(
 		double isovalue, double f1, double f2, double x1, double x2)
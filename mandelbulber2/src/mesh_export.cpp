@@ -122,17 +122,24 @@ void cMeshExport::ProcessVolume()
 
 	progressText.ResetTimer();
 
-	vector<double> vertices;
-	vector<long long> polygons;
-	vector<double> colorIndices;
+	// mesh is streamed to the file while it is being generated
+	QScopedPointer<MeshFileSave> meshFileSave(MeshFileSave::create(
+		outputFileName, meshConfig, MeshFileSave::structSaveMeshData()));
+	QObject::connect(meshFileSave.data(),
+		SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)), this,
+		SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)));
+	if (!meshFileSave->BeginStream())
+	{
+		emit finished();
+		return;
+	}
 
 	WriteLog("Starting marching cubes...", 2);
 	MarchingCubes *marchingCube;
 	try
 	{
-		marchingCube =
-			new MarchingCubes(gPar, gParFractal, params.data(), fractals.data(), renderData.data(), w, h,
-				l, limitMin, limitMax, dist_thresh, &stop, vertices, polygons, colorIndices);
+		marchingCube = new MarchingCubes(gPar, gParFractal, params.data(), fractals.data(),
+			renderData.data(), w, h, l, limitMin, limitMax, dist_thresh, &stop, meshFileSave.data());
 	}
 	catch (std::bad_alloc &ba)
 	{
@@ -161,23 +168,10 @@ void cMeshExport::ProcessVolume()
 
 	WriteLog("Marching cubes done.", 2);
 
-	cColorPalette palette = gPar->Get<cColorPalette>("mat1_surface_color_palette");
-	std::vector<sRGB8> colorsRGB;
-
-	for (double colorIndice : colorIndices)
-	{
-		sRGB color = palette.IndexToColour(colorIndice);
-		sRGB8 color8(color.R, color.G, color.B);
-		colorsRGB.push_back(color8);
-	}
-
 	// Save to file
-	MeshFileSave::structSaveMeshData meshData(&vertices, &polygons, &colorsRGB);
-	MeshFileSave *meshFileSave = MeshFileSave::create(outputFileName, meshConfig, meshData);
-	QObject::connect(meshFileSave,
-		SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)), this,
-		SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)));
-	meshFileSave->SaveMesh();
+	emit updateProgressAndStatus(meshFileSave->getJobName(), QString("Started"), 0.0);
+	meshFileSave->EndStream();
+	emit updateProgressAndStatus(meshFileSave->getJobName(), QString("Finished"), 1.0);
 
 	QString statusText;
 	if (stop)
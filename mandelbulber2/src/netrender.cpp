@@ -37,13 +37,17 @@
 #include <QAbstractSocket>
 #include <QHostInfo>
 
+#include "animation_frames.hpp"
 #include "error_message.hpp"
 #include "fractal_container.hpp"
 #include "global_data.hpp"
 #include "headless.h"
 #include "initparameters.hpp"
 #include "interface.hpp"
+#include "keyframes.hpp"
 #include "lzo_compression.h"
+#include "netrender_animation.hpp"
+#include "netrender_texture_cache.hpp"
 #include "render_window.hpp"
 #include "settings.hpp"
 #include "system.hpp"
@@ -65,12 +69,21 @@ CNetRender::CNetRender(qint32 workerCount) : QObject(nullptr)
 	totalReceivedUncompressed = 0;
 	totalReceived = 0;
 	isUsed = false;
+	nextClientId = 0;
+	frameRenderer = nullptr;
+	frameRendererThread = nullptr;
+	textureCache = new cNetRenderTextureCache(systemData.GetNetRenderTexturesFolder());
+	pendingJobCommand = netRender_NONE;
+	pendingAnimationMode = 0;
+	codec = netRenderCodec_LZO;
 }
 
 CNetRender::~CNetRender()
 {
+	DeleteFrameRenderer();
 	DeleteServer();
 	DeleteClient();
+	delete textureCache;
 }
 
 void CNetRender::SetServer(qint32 portNo)
@@ -139,6 +152,7 @@ void CNetRender::DeleteClient()
 	if (deviceType != netRender_CLIENT) return;
 	deviceType = netRender_UNKNOWN;
 	WriteLog("NetRender - Delete Client", 2);
+	DeleteFrameRenderer();
 	if (reconnectTimer)
 	{
 		if (reconnectTimer->isActive()) reconnectTimer->stop();
@@ -173,6 +187,7 @@ void CNetRender::HandleNewConnection()
 		// push new socket to list
 		sClient client;
 		client.socket = server->nextPendingConnection();
+		client.id = nextClientId++;
 		clients.append(client);
 
 		connect(client.socket, SIGNAL(disconnected()), this, SLOT(ClientDisconnected()));
@@ -187,6 +202,9 @@ void CNetRender::HandleNewConnection()
 		QString machineName = QHostInfo::localHostName();
 		stream << qint32(machineName.toUtf8().size());
 		stream.writeRawData(machineName.toUtf8().data(), machineName.toUtf8().size());
+		// client chooses compression from supported ones
+		stream << SupportedCodecs();
+		stream << qint32(gPar->Get<int>("netrender_compression"));
 		SendData(client.socket, msg);
 		emit ClientsChanged();
 	}
@@ -244,6 +262,7 @@ void CNetRender::SetClient(QString address, int portNo)
 	this->address = address;
 	this->portNo = portNo;
 	ResetMessage(&msgFromServer);
+	ResetMessage(&msgRenderedLines);
 	clientSocket = new QTcpSocket(this);
 
 	reconnectTimer = new QTimer;
@@ -274,6 +293,7 @@ void CNetRender::ServerDisconnected()
 	NotifyStatus();
 
 	gMainInterface->stopRequest = true;
+	if (frameRenderer) frameRenderer->Stop();
 
 	reconnectTimer->start();
 
@@ -321,44 +341,108 @@ void CNetRender::ReceiveFromServer()
 	ReceiveData(clientSocket, &msgFromServer);
 }
 
-bool CNetRender::SendData(QTcpSocket *socket, sMessage msg) const
+// NetRender message header (28 bytes, little endian):
+//	quint32 magic, quint16 protocol version, quint8 codec, quint8 reserved,
+//	qint32 command, qint32 id, qint32 size, qint32 uncompressed size, quint32 checksum
+// header is followed by <size> bytes of payload compressed with <codec>
+
+static const quint32 messageMagic = 0x524E424D; // "MBNR"
+static const quint16 messageProtocolVersion = 3;
+static const int messageHeaderSize = 28;
+// smaller messages are not compressed
+static const int minimumCompressedSize = 256;
+
+// Adler-32 checksum of the payload
+static quint32 MessageChecksum(const char *data, int size)
 {
-	//			NetRender Message format         (optional)
-	// | qint32		| qint32	| qint32	|( 0 - ???	| quint16  |)
-	// | command	| id			| size		|( payload	| checksum |)
+	const uchar *bytes = reinterpret_cast<const uchar *>(data);
+	quint32 a = 1;
+	quint32 b = 0;
+	while (size > 0)
+	{
+		// the largest block which doesn't overflow 32-bit sums
+		int block = qMin(size, 5552);
+		size -= block;
+		for (int i = 0; i < block; i++)
+		{
+			a += bytes[i];
+			b += a;
+		}
+		bytes += block;
+		a %= 65521;
+		b %= 65521;
+	}
+	return (b << 16) | a;
+}
 
+static bool IsCodecInMask(qint32 codec, qint32 codecMask)
+{
+	return codec >= 0 && codec < 32 && (codecMask & (1 << codec));
+}
+
+static void WriteMessageHeader(uchar *header, quint32 codec, qint32 command, qint32 id,
+	qint32 size, qint32 uncompressedSize, quint32 checksum)
+{
+	qToLittleEndian<quint32>(messageMagic, header);
+	qToLittleEndian<quint16>(messageProtocolVersion, header + 4);
+	header[6] = uchar(codec);
+	header[7] = 0;
+	qToLittleEndian<qint32>(command, header + 8);
+	qToLittleEndian<qint32>(id, header + 12);
+	qToLittleEndian<qint32>(size, header + 16);
+	qToLittleEndian<qint32>(uncompressedSize, header + 20);
+	qToLittleEndian<quint32>(checksum, header + 24);
+}
+
+bool CNetRender::SendData(QTcpSocket *socket, sMessage msg) const
+{
 	if (!socket) return false;
 	if (socket->state() != QAbstractSocket::ConnectedState) return false;
 
-	QByteArray byteArray;
-	QDataStream socketWriteStream(&byteArray, QIODevice::ReadWrite);
-
-	msg.payload = lzoCompress(msg.payload);
-	msg.size = msg.payload.size();
 	msg.id = actualId;
+	msg.uncompressedSize = msg.payload.size();
+	msg.codec = netRenderCodec_NONE;
+	if (msg.uncompressedSize >= minimumCompressedSize) msg.codec = CodecForSocket(socket);
+
+	// compressed data is written into reused buffer
+	const QByteArray *data = &msg.payload;
+	switch (msg.codec)
+	{
+		case netRenderCodec_LZO:
+			lzoCompress(
+				msg.payload.constData(), msg.payload.size(), &compressionBuffer, &compressionWorkMemory);
+			data = &compressionBuffer;
+			break;
+		case netRenderCodec_ZLIB:
+			compressionBuffer = qCompress(msg.payload);
+			data = &compressionBuffer;
+			break;
+		default: break;
+	}
+	if (data->size() >= msg.payload.size())
+	{
+		// data is not compressible
+		msg.codec = netRenderCodec_NONE;
+		data = &msg.payload;
+	}
+	msg.size = data->size();
+	msg.checksum = MessageChecksum(data->constData(), msg.size);
 
-	WriteLog(QString("NetRender - send data, command %1, bytes %2, id %3")
+	WriteLog(QString("NetRender - send data, command %1, bytes %2 (%3), id %4")
 						 .arg(msg.command)
 						 .arg(msg.size)
+						 .arg(msg.uncompressedSize)
 						 .arg(msg.id),
 		3);
 
-	// append header
-	socketWriteStream << msg.command << msg.id << msg.size;
-
-	// append payload
-	if (msg.size > 0)
-	{
-		socketWriteStream.writeRawData(msg.payload.data(), msg.size);
-		// append checksum
-		qint16 checksum = qChecksum(msg.payload.data(), msg.size);
-		socketWriteStream << checksum;
-	}
-
-	// write to socket
+	// write to socket. Header and payload are written separately, so payload is not copied
 	if (socket->isOpen() && socket->state() == QAbstractSocket::ConnectedState)
 	{
-		socket->write(byteArray);
+		uchar header[messageHeaderSize];
+		WriteMessageHeader(
+			header, msg.codec, msg.command, msg.id, msg.size, msg.uncompressedSize, msg.checksum);
+		socket->write(reinterpret_cast<const char *>(header), messageHeaderSize);
+		if (msg.size > 0) socket->write(data->constData(), msg.size);
 	}
 	else
 	{
@@ -379,28 +463,77 @@ void CNetRender::ResetMessage(sMessage *msg)
 		msg->command = netRender_NONE;
 		msg->id = 0;
 		msg->size = 0;
+		msg->uncompressedSize = 0;
+		msg->codec = netRenderCodec_NONE;
+		msg->checksum = 0;
 		if (!msg->payload.isEmpty()) msg->payload.clear();
 	}
 }
 
-void CNetRender::ReceiveData(QTcpSocket *socket, sMessage *msg)
+qint32 CNetRender::CodecForSocket(const QTcpSocket *socket) const
 {
-	QDataStream socketReadStream(socket);
-	qint64 bytesAvailable = socket->bytesAvailable();
+	if (IsServer())
+	{
+		int index = GetClientIndexFromSocket(socket);
+		return index >= 0 ? clients[index].codec : qint32(netRenderCodec_LZO);
+	}
+	return codec;
+}
+
+qint32 CNetRender::SupportedCodecs()
+{
+	return (1 << netRenderCodec_NONE) | (1 << netRenderCodec_LZO) | (1 << netRenderCodec_ZLIB);
+}
+
+bool CNetRender::UncompressPayload(sMessage *msg)
+{
+	switch (msg->codec)
+	{
+		case netRenderCodec_NONE: break;
+		case netRenderCodec_LZO:
+		{
+			QByteArray uncompressed(msg->uncompressedSize, Qt::Uninitialized);
+			if (!lzoUncompress(msg->payload.constData(), msg->payload.size(), uncompressed.data(),
+						uncompressed.size()))
+				return false;
+			msg->payload = uncompressed;
+			break;
+		}
+		case netRenderCodec_ZLIB: msg->payload = qUncompress(msg->payload); break;
+		default: return false;
+	}
+	msg->size = msg->payload.size();
+	return msg->size == msg->uncompressedSize;
+}
 
-	while (bytesAvailable > 0)
+void CNetRender::ReceiveData(QTcpSocket *socket, sMessage *msg)
+{
+	while (socket->bytesAvailable() > 0)
 	{
 		if (msg->command == netRender_NONE)
 		{
-			if (socket->bytesAvailable()
-					< qint64((sizeof(msg->command) + sizeof(msg->id) + sizeof(msg->size))))
+			if (socket->bytesAvailable() < messageHeaderSize)
 			{
 				return;
 			}
 			// meta data available
-			socketReadStream >> msg->command;
-			socketReadStream >> msg->id;
-			socketReadStream >> msg->size;
+			uchar header[messageHeaderSize];
+			socket->read(reinterpret_cast<char *>(header), messageHeaderSize);
+			if (qFromLittleEndian<quint32>(header) != messageMagic
+					|| qFromLittleEndian<quint16>(header + 4) != messageProtocolVersion)
+			{
+				// other version of the program. Nothing can be read from this connection
+				qCritical() << "NetRender - received message with wrong header from"
+										<< socket->peerAddress().toString();
+				socket->readAll();
+				return;
+			}
+			msg->codec = header[6];
+			msg->command = qFromLittleEndian<qint32>(header + 8);
+			msg->id = qFromLittleEndian<qint32>(header + 12);
+			msg->size = qFromLittleEndian<qint32>(header + 16);
+			msg->uncompressedSize = qFromLittleEndian<qint32>(header + 20);
+			msg->checksum = qFromLittleEndian<quint32>(header + 24);
 			WriteLog(QString("NetRender - ReceiveData(), command %1, bytes %2, id %3")
 								 .arg(msg->command)
 								 .arg(msg->size)
@@ -408,39 +541,44 @@ void CNetRender::ReceiveData(QTcpSocket *socket, sMessage *msg)
 				3);
 		}
 
-		bytesAvailable = socket->bytesAvailable();
-
 		if (msg->size > 0)
 		{
-			if (bytesAvailable < qint64(sizeof(quint16) + msg->size))
+			if (socket->bytesAvailable() < msg->size)
 			{
 				return;
 			}
-			// full payload available
-			char *buffer = new char[msg->size];
-			socketReadStream.readRawData(buffer, msg->size);
-			msg->payload.append(buffer, msg->size);
-
-			quint16 crcCalculated = qChecksum(buffer, msg->size);
-			quint16 crcReceived;
-			socketReadStream >> crcReceived;
+			// full payload available. It is read directly into the message buffer
+			msg->payload.resize(msg->size);
+			socket->read(msg->payload.data(), msg->size);
 
-			delete[] buffer;
-			if (crcCalculated != crcReceived)
+			bool damaged = false;
+			if (MessageChecksum(msg->payload.constData(), msg->size) != msg->checksum)
 			{
-				// ResetMessage(msg);
-				// socketReadStream.atEnd();
-				// socketReadStream.skipRawData(socket->bytesAvailable());
 				WriteLog("NetRender - ReceiveData() : crc error", 2);
-
-				return;
+				damaged = true;
+			}
+			else if (!UncompressPayload(msg))
+			{
+				WriteLog("NetRender - ReceiveData() : cannot uncompress data", 2);
+				damaged = true;
+			}
+			if (damaged)
+			{
+				// client doesn't send next lines until ACK, so it has to send these lines again
+				if (IsServer() && msg->command == netRender_DATA)
+				{
+					sMessage outMsg;
+					outMsg.command = netRender_NACK;
+					SendData(socket, outMsg);
+				}
+				ResetMessage(msg);
+				continue;
 			}
-			msg->payload = lzoUncompress(msg->payload);
-			msg->size = msg->payload.size();
 		}
 		ProcessData(socket, msg);
 
-		bytesAvailable = socket->bytesAvailable();
+		// client could be removed while processing data
+		if (IsServer() && GetClientIndexFromSocket(socket) < 0) return;
 	}
 }
 
@@ -466,6 +604,13 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 				buffer.resize(size);
 				stream.readRawData(buffer.data(), size);
 				serverName = QString::fromUtf8(buffer.data(), buffer.size());
+				qint32 serverCodecs;
+				qint32 preferredCodec;
+				stream >> serverCodecs;
+				stream >> preferredCodec;
+				codec = IsCodecInMask(preferredCodec, serverCodecs & SupportedCodecs())
+									? preferredCodec
+									: qint32(netRenderCodec_LZO);
 				if (CompareMajorVersion(serverVersion, version))
 				{
 					QString connectionMsg = "NetRender - version matches (" + QString::number(version) + ")";
@@ -487,6 +632,7 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 					QString machineName = QHostInfo::localHostName();
 					outStream << qint32(machineName.toUtf8().size());
 					outStream.writeRawData(machineName.toUtf8().data(), machineName.toUtf8().size());
+					outStream << codec;
 					status = netRender_READY;
 					emit NewStatusClient();
 					WriteLog(
@@ -509,6 +655,16 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 			{
 				// status = netRender_READY;
 				gMainInterface->stopRequest = true;
+				if (frameRenderer) frameRenderer->Stop();
+				if (pendingJobCommand != netRender_NONE)
+				{
+					// job was still waiting for textures
+					pendingJobCommand = netRender_NONE;
+					missingTextures.clear();
+					pendingFrames.clear();
+					status = netRender_READY;
+					NotifyStatus();
+				}
 				// NotifyStatus();
 				WriteLog("NetRender - ProcessData(), command STOP", 2);
 				break;
@@ -524,94 +680,17 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 				if (inMsg->id == actualId)
 				{
 					WriteLog("NetRender - ProcessData(), command JOB", 2);
+					DeleteFrameRenderer();
 					QDataStream stream(&inMsg->payload, QIODevice::ReadOnly);
-					QByteArray buffer;
-					qint32 size;
 					status = netRender_WORKING;
 					NotifyStatus();
 
-					// read settings
-					stream >> size;
-					buffer.resize(size);
-					stream.readRawData(buffer.data(), size);
-					settingsText = QString::fromUtf8(buffer.data(), buffer.size());
-					WriteLog(
-						QString("NetRender - ProcessData(), command JOB, settings size: %1").arg(size), 2);
-					WriteLog(
-						QString("NetRender - ProcessData(), command JOB, settings: %1").arg(settingsText), 3);
-
-					// getting textures from server
-					textures.clear();
-
-					qint32 numberOfTextures;
-					stream >> numberOfTextures;
-
-					WriteLog(QString("NetRender - ProcessData(), command JOB, number of textures: %1")
-										 .arg(numberOfTextures),
-						2);
-
-					// read textures
-					for (int i = 0; i < numberOfTextures; i++)
-					{
-						qint32 sizeOfName;
-						stream >> sizeOfName;
-
-						QString textureName;
-						if (sizeOfName > 0)
-						{
-							QByteArray bufferForName;
-							bufferForName.resize(sizeOfName);
-							stream.readRawData(bufferForName.data(), sizeOfName);
-							textureName = QString::fromUtf8(bufferForName);
-							WriteLog(QString("NetRender - ProcessData(), command JOB, texture name: %1")
-												 .arg(textureName),
-								2);
-						}
-
-						cTexture texture;
-						stream >> size;
-						WriteLog(
-							QString("NetRender - ProcessData(), command JOB, texture size: %1").arg(size), 2);
-						if (size > 0)
-						{
-							buffer.resize(size);
-							stream.readRawData(buffer.data(), size);
-						}
-						textures.insert(textureName, buffer);
-					}
-
-					cSettings parSettings(cSettings::formatCondensedText);
-					parSettings.BeQuiet(true);
-
-					gInterfaceReadyForSynchronization = false;
-					parSettings.LoadFromString(settingsText);
-					parSettings.Decode(gPar, gParFractal);
-
-					WriteLog("NetRender - ProcessData(), command JOB, starting rendering", 2);
-
-					gInterfaceReadyForSynchronization = true;
-					if (!systemData.noGui)
-					{
-						gMainInterface->SynchronizeInterface(gPar, gParFractal, qInterface::write);
-						gMainInterface->StartRender(true);
-					}
+					ReadJobData(&stream);
+					pendingJobCommand = netRender_JOB;
+					if (missingTextures.isEmpty())
+						StartReceivedJob();
 					else
-					{
-						// in noGui mode it must be started as separate thread to be able to process event loop
-						gMainInterface->headless = new cHeadless;
-
-						QThread *thread = new QThread; // deleted by deleteLater()
-						gMainInterface->headless->moveToThread(thread);
-						QObject::connect(
-							thread, SIGNAL(started()), gMainInterface->headless, SLOT(slotNetRender()));
-						thread->setObjectName("RenderJob");
-						thread->start();
-
-						QObject::connect(gMainInterface->headless, SIGNAL(finished()), gMainInterface->headless,
-							SLOT(deleteLater()));
-						QObject::connect(gMainInterface->headless, SIGNAL(finished()), thread, SLOT(quit()));
-						QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
-					}
+						RequestMissingTextures();
 				}
 				else
 				{
@@ -674,11 +753,22 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 				WriteLog("NetRender - ProcessData(), command ACK", 3);
 				if (inMsg->id == actualId)
 				{
+					ResetMessage(&msgRenderedLines);
 					emit AckReceived();
 				}
 				break;
 			}
 
+			case netRender_NACK:
+			{
+				WriteLog("NetRender - ProcessData(), command NACK", 2);
+				if (inMsg->id == actualId && msgRenderedLines.command == netRender_DATA)
+				{
+					SendData(clientSocket, msgRenderedLines);
+				}
+				break;
+			}
+
 			case netRender_KICK_AND_KILL:
 			{
 				WriteLog("NetRender - ProcessData(), command KICK AND KILL", 2);
@@ -686,6 +776,68 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 				break;
 			}
 
+			case netRender_ANIMATION:
+			{
+				WriteLog("NetRender - ProcessData(), command ANIMATION", 2);
+				// id of animation job is not sent in SETUP message
+				actualId = inMsg->id;
+				DeleteFrameRenderer();
+				QDataStream stream(&inMsg->payload, QIODevice::ReadOnly);
+				qint32 animationMode;
+				stream >> animationMode;
+				ReadJobData(&stream);
+				pendingJobCommand = netRender_ANIMATION;
+				pendingAnimationMode = animationMode;
+				pendingFrames.clear();
+				if (missingTextures.isEmpty())
+					StartReceivedJob();
+				else
+					RequestMissingTextures();
+				break;
+			}
+
+			case netRender_FRAMES:
+			{
+				if (inMsg->id == actualId && (frameRenderer || pendingJobCommand == netRender_ANIMATION))
+				{
+					QDataStream stream(&inMsg->payload, QIODevice::ReadOnly);
+					qint32 numberOfFrames;
+					stream >> numberOfFrames;
+					QList<int> frameIndices;
+					for (int i = 0; i < numberOfFrames; i++)
+					{
+						qint32 frameIndex;
+						stream >> frameIndex;
+						frameIndices.append(frameIndex);
+					}
+					WriteLog(QString("NetRender - ProcessData(), command FRAMES, %1 frames from %2")
+										 .arg(numberOfFrames)
+										 .arg(frameIndices.value(0)),
+						2);
+					status = netRender_WORKING;
+					NotifyStatus();
+					// frames can arrive before textures needed to render them
+					if (frameRenderer)
+						frameRenderer->AddFrames(frameIndices);
+					else
+						pendingFrames.append(frameIndices);
+				}
+				else
+				{
+					WriteLog("NetRender - received FRAMES message with wrong id", 1);
+				}
+				break;
+			}
+
+			case netRender_TEXTURES:
+			{
+				// textures are identified by content, so id of the job is not checked
+				WriteLog("NetRender - ProcessData(), command TEXTURES", 2);
+				QDataStream stream(&inMsg->payload, QIODevice::ReadOnly);
+				ReadTextures(&stream);
+				break;
+			}
+
 			default: break;
 		}
 	}
@@ -720,6 +872,11 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 					buffer.resize(size);
 					stream.readRawData(buffer.data(), size);
 					clients[index].name = QString::fromUtf8(buffer.data(), buffer.size());
+					qint32 clientCodec;
+					stream >> clientCodec;
+					clients[index].codec = IsCodecInMask(clientCodec, SupportedCodecs())
+																	 ? clientCodec
+																	 : qint32(netRenderCodec_LZO);
 
 					if (clients[index].status == netRender_NEW) clients[index].status = netRender_READY;
 					WriteLog("NetRender - new Client #" + QString::number(index) + "(" + clients[index].name
@@ -751,27 +908,36 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 					if (inMsg->id == actualId)
 					{
 						QDataStream stream(&inMsg->payload, QIODevice::ReadOnly);
-						qint32 line;
-						qint32 lineLength;
-						QByteArray lineData;
+						qint32 numberOfLines;
+						qint32 lineSize;
+						stream >> numberOfLines;
+						stream >> lineSize;
+
+						const qint64 dataOffset = qint64(sizeof(qint32)) * (2 + qint64(numberOfLines));
+						if (numberOfLines < 0 || lineSize < 0
+								|| dataOffset + qint64(numberOfLines) * lineSize > inMsg->payload.size())
+						{
+							WriteLog("NetRender - received DATA message with wrong size", 1);
+							break;
+						}
 
-						QList<QByteArray> receivedRenderedLines;
 						QList<int> receivedLineNumbers;
-
-						while (!stream.atEnd())
+						QList<QByteArray> receivedRenderedLines;
+						receivedLineNumbers.reserve(numberOfLines);
+						receivedRenderedLines.reserve(numberOfLines);
+						for (int i = 0; i < numberOfLines; i++)
 						{
+							qint32 line;
 							stream >> line;
-							stream >> lineLength;
-							lineData.resize(lineLength);
-							stream.readRawData(lineData.data(), lineData.size());
 							receivedLineNumbers.append(line);
-							receivedRenderedLines.append(lineData);
-							WriteLog(
-								QString("NetRender - ProcessData(), command DATA, line %1, lineDataLength %2")
-									.arg(line)
-									.arg(lineLength),
-								3);
+							receivedRenderedLines.append(
+								inMsg->payload.mid(int(dataOffset) + i * lineSize, lineSize));
 						}
+						WriteLog(QString("NetRender - ProcessData(), command DATA, %1 lines, line size %2")
+											 .arg(numberOfLines)
+											 .arg(lineSize),
+							3);
+
 						clients[index].linesRendered += receivedLineNumbers.size();
 						emit NewLinesArrived(receivedLineNumbers, receivedRenderedLines);
 
@@ -787,6 +953,57 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 					}
 					break;
 				}
+				case netRender_FRAME:
+				{
+					if (inMsg->id == actualId)
+					{
+						QDataStream stream(&inMsg->payload, QIODevice::ReadOnly);
+						qint32 frameIndex;
+						qint32 renderTimeMs;
+						stream >> frameIndex;
+						stream >> renderTimeMs;
+						QByteArray frameData = inMsg->payload.mid(2 * sizeof(qint32));
+						const double renderTime = renderTimeMs / 1000.0;
+						WriteLog(QString("NetRender - ProcessData(), command FRAME, frame %1, time %2 s")
+											 .arg(frameIndex)
+											 .arg(renderTime),
+							2);
+
+						sClient &client = clients[index];
+						client.framesRendered++;
+						if (client.frameRenderTime > 0.0)
+							client.frameRenderTime = 0.7 * client.frameRenderTime + 0.3 * renderTime;
+						else
+							client.frameRenderTime = renderTime;
+						emit ClientsChanged(index);
+						emit FrameArrived(client.id, frameIndex, renderTime, frameData);
+					}
+					else
+					{
+						WriteLog("NetRender - received FRAME message with wrong id", 1);
+					}
+					break;
+				}
+				case netRender_TEXTURE_REQUEST:
+				{
+					QDataStream stream(&inMsg->payload, QIODevice::ReadOnly);
+					qint32 numberOfTextures;
+					stream >> numberOfTextures;
+					QList<QByteArray> hashes;
+					for (int i = 0; i < numberOfTextures; i++)
+					{
+						qint32 hashSize;
+						stream >> hashSize;
+						QByteArray hash(qMax(hashSize, 0), 0);
+						stream.readRawData(hash.data(), hash.size());
+						hashes.append(hash);
+					}
+					WriteLog(QString("NetRender - ProcessData(), command TEXTURE_REQUEST, %1 textures")
+										 .arg(numberOfTextures),
+						2);
+					SendTextures(clients[index].socket, hashes);
+					break;
+				}
 				case netRender_STATUS:
 				{
 					WriteLog("NetRender - ProcessData(), command STATUS", 3);
@@ -808,18 +1025,43 @@ void CNetRender::ProcessData(QTcpSocket *socket, sMessage *inMsg)
 }
 
 // send rendered lines
-void CNetRender::SendRenderedLines(QList<int> lineNumbers, QList<QByteArray> lines) const
+void CNetRender::SendRenderedLines(QList<int> lineNumbers, QList<QByteArray> lines)
 {
+	//			DATA message payload
+	// | qint32						| qint32			| qint32 * n		| lineSize * n |
+	// | number of lines n	| lineSize	| line numbers	| line data		|
+
+	// all lines of the image have the same size
+	const int lineSize = lines.isEmpty() ? 0 : lines.first().size();
+	for (const QByteArray &line : lines)
+	{
+		if (line.size() != lineSize)
+		{
+			qCritical() << "CNetRender::SendRenderedLines(): lines with different sizes";
+			return;
+		}
+	}
+
 	sMessage msg;
 	msg.command = netRender_DATA;
+	// whole payload is allocated at once
+	msg.payload.reserve(
+		int(sizeof(qint32)) * (2 + lineNumbers.size()) + lineSize * lineNumbers.size());
 	QDataStream stream(&msg.payload, QIODevice::WriteOnly);
-	for (int i = 0; i < lineNumbers.size(); i++)
+	stream << qint32(lineNumbers.size());
+	stream << qint32(lineSize);
+	for (int lineNumber : lineNumbers)
 	{
-		stream << qint32(lineNumbers.at(i));
-		stream << qint32(lines.at(i).size());
-		stream.writeRawData(lines.at(i).data(), lines.at(i).size());
+		stream << qint32(lineNumber);
+	}
+	for (const QByteArray &line : lines)
+	{
+		stream.writeRawData(line.constData(), lineSize);
 	}
 	SendData(clientSocket, msg);
+
+	// message is kept for resending if the server receives it damaged
+	msgRenderedLines = msg;
 }
 
 // stop rendering of all clients
@@ -842,42 +1084,11 @@ void CNetRender::SetCurrentJob(
 	if (dataSize > 0)
 	{
 		QString settingsText = settingsData.GetSettingsText();
+		ResetMessage(&msgCurrentJob);
 		msgCurrentJob.command = netRender_JOB;
 		QDataStream stream(&msgCurrentJob.payload, QIODevice::WriteOnly);
 
-		// write settings
-		stream << qint32(settingsText.toUtf8().size());
-		stream.writeRawData(settingsText.toUtf8().data(), settingsText.toUtf8().size());
-
-		// send number of textures
-		stream << qint32(listOfTextures.size());
-
-		// write textures (from files)
-		for (int i = 0; i < listOfTextures.size(); i++)
-		{
-			// send length of texture name
-			stream << qint32(listOfTextures[i].toUtf8().size());
-
-			// send texture name
-			stream.writeRawData(listOfTextures[i].toUtf8(), listOfTextures[i].length());
-
-			QFile file(listOfTextures[i]);
-			if (file.open(QIODevice::ReadOnly))
-			{
-				QByteArray buffer = file.readAll();
-				// send size of file
-				stream << qint32(buffer.size());
-				// send file content
-				stream.writeRawData(buffer.data(), buffer.size());
-				continue;
-			}
-			else
-			{
-				qCritical() << "Cannot send texture using NetRender. File:" << listOfTextures[i];
-			}
-
-			stream << qint32(0); // empty entry
-		}
+		WriteJobData(&stream, settingsText, listOfTextures);
 
 		for (auto &client : clients)
 		{
@@ -1079,3 +1290,326 @@ QByteArray *CNetRender::GetTexture(QString textureName, int frameNo)
 	QString animatedTextureName = AnimatedFileName(textureName, frameNo, &keys);
 	return &textures[animatedTextureName];
 }
+
+void CNetRender::WriteJobData(
+	QDataStream *stream, const QString &settingsText, const QStringList &listOfTextures)
+{
+	// write settings
+	*stream << qint32(settingsText.toUtf8().size());
+	stream->writeRawData(settingsText.toUtf8().data(), settingsText.toUtf8().size());
+
+	// send number of textures
+	*stream << qint32(listOfTextures.size());
+
+	// write names and hashes of textures. Content is sent only when client asks for it
+	for (const QString &textureName : listOfTextures)
+	{
+		// send length of texture name
+		*stream << qint32(textureName.toUtf8().size());
+
+		// send texture name
+		stream->writeRawData(textureName.toUtf8().data(), textureName.toUtf8().size());
+
+		QByteArray hash = textureCache->HashOfFile(textureName);
+		if (hash.isEmpty())
+		{
+			qCritical() << "Cannot send texture using NetRender. File:" << textureName;
+		}
+
+		// send hash of file content (empty if file is not available)
+		*stream << qint32(hash.size());
+		stream->writeRawData(hash.data(), hash.size());
+	}
+}
+
+void CNetRender::ReadJobData(QDataStream *stream)
+{
+	QByteArray buffer;
+	qint32 size;
+
+	// read settings
+	*stream >> size;
+	buffer.resize(size);
+	stream->readRawData(buffer.data(), size);
+	settingsText = QString::fromUtf8(buffer.data(), buffer.size());
+	WriteLog(QString("NetRender - ReadJobData(), settings size: %1").arg(size), 2);
+	WriteLog(QString("NetRender - ReadJobData(), settings: %1").arg(settingsText), 3);
+
+	// getting textures from cache
+	textures.clear();
+	missingTextures.clear();
+
+	qint32 numberOfTextures;
+	*stream >> numberOfTextures;
+
+	WriteLog(QString("NetRender - ReadJobData(), number of textures: %1").arg(numberOfTextures), 2);
+
+	// read names and hashes of textures
+	for (int i = 0; i < numberOfTextures; i++)
+	{
+		qint32 sizeOfName;
+		*stream >> sizeOfName;
+
+		QString textureName;
+		if (sizeOfName > 0)
+		{
+			QByteArray bufferForName;
+			bufferForName.resize(sizeOfName);
+			stream->readRawData(bufferForName.data(), sizeOfName);
+			textureName = QString::fromUtf8(bufferForName);
+			WriteLog(QString("NetRender - ReadJobData(), texture name: %1").arg(textureName), 2);
+		}
+
+		*stream >> size;
+		QByteArray hash(qMax(size, 0), 0);
+		stream->readRawData(hash.data(), hash.size());
+
+		QByteArray texture;
+		if (!hash.isEmpty() && !textureCache->Find(hash, &texture))
+		{
+			WriteLog(QString("NetRender - ReadJobData(), texture not in cache: %1").arg(textureName), 2);
+			missingTextures.insert(hash, textureName);
+		}
+		textures.insert(textureName, texture);
+	}
+}
+
+void CNetRender::RequestMissingTextures()
+{
+	const QList<QByteArray> hashes = missingTextures.uniqueKeys();
+	WriteLog(QString("NetRender - requesting %1 textures from server").arg(hashes.size()), 2);
+
+	sMessage msg;
+	msg.command = netRender_TEXTURE_REQUEST;
+	QDataStream stream(&msg.payload, QIODevice::WriteOnly);
+	stream << qint32(hashes.size());
+	for (const QByteArray &hash : hashes)
+	{
+		stream << qint32(hash.size());
+		stream.writeRawData(hash.data(), hash.size());
+	}
+	SendData(clientSocket, msg);
+}
+
+void CNetRender::SendTextures(QTcpSocket *socket, const QList<QByteArray> &hashes)
+{
+	sMessage msg;
+	msg.command = netRender_TEXTURES;
+	QDataStream stream(&msg.payload, QIODevice::WriteOnly);
+	stream << qint32(hashes.size());
+	for (const QByteArray &hash : hashes)
+	{
+		QByteArray buffer = textureCache->FileContent(hash);
+		stream << qint32(hash.size());
+		stream.writeRawData(hash.data(), hash.size());
+		stream << qint32(buffer.size());
+		stream.writeRawData(buffer.data(), buffer.size());
+	}
+	SendData(socket, msg);
+}
+
+void CNetRender::ReadTextures(QDataStream *stream)
+{
+	qint32 numberOfTextures;
+	*stream >> numberOfTextures;
+	for (int i = 0; i < numberOfTextures; i++)
+	{
+		qint32 size;
+		*stream >> size;
+		QByteArray hash(qMax(size, 0), 0);
+		stream->readRawData(hash.data(), hash.size());
+
+		*stream >> size;
+		QByteArray buffer(qMax(size, 0), 0);
+		stream->readRawData(buffer.data(), buffer.size());
+		WriteLog(QString("NetRender - ReadTextures(), texture size: %1").arg(size), 2);
+
+		if (cNetRenderTextureCache::Hash(buffer) == hash)
+		{
+			textureCache->Insert(hash, buffer);
+		}
+		else
+		{
+			// file was modified on server or is not available. Texture will be empty
+			qCritical() << "NetRender - received texture doesn't match its hash";
+			buffer.clear();
+		}
+
+		for (const QString &textureName : missingTextures.values(hash))
+			textures.insert(textureName, buffer);
+		missingTextures.remove(hash);
+	}
+
+	if (missingTextures.isEmpty() && pendingJobCommand != netRender_NONE) StartReceivedJob();
+}
+
+void CNetRender::StartReceivedJob()
+{
+	const qint32 jobCommand = pendingJobCommand;
+	pendingJobCommand = netRender_NONE;
+
+	if (jobCommand == netRender_JOB)
+	{
+		cSettings parSettings(cSettings::formatCondensedText);
+		parSettings.BeQuiet(true);
+
+		gInterfaceReadyForSynchronization = false;
+		parSettings.LoadFromString(settingsText);
+		parSettings.Decode(gPar, gParFractal);
+
+		WriteLog("NetRender - ProcessData(), command JOB, starting rendering", 2);
+
+		gInterfaceReadyForSynchronization = true;
+		if (!systemData.noGui)
+		{
+			gMainInterface->SynchronizeInterface(gPar, gParFractal, qInterface::write);
+			gMainInterface->StartRender(true);
+		}
+		else
+		{
+			// in noGui mode it must be started as separate thread to be able to process event loop
+			gMainInterface->headless = new cHeadless;
+
+			QThread *thread = new QThread; // deleted by deleteLater()
+			gMainInterface->headless->moveToThread(thread);
+			QObject::connect(thread, SIGNAL(started()), gMainInterface->headless, SLOT(slotNetRender()));
+			thread->setObjectName("RenderJob");
+			thread->start();
+
+			QObject::connect(gMainInterface->headless, SIGNAL(finished()), gMainInterface->headless,
+				SLOT(deleteLater()));
+			QObject::connect(gMainInterface->headless, SIGNAL(finished()), thread, SLOT(quit()));
+			QObject::connect(thread, SIGNAL(finished()), thread, SLOT(deleteLater()));
+		}
+	}
+	else if (jobCommand == netRender_ANIMATION)
+	{
+		CreateFrameRenderer(pendingAnimationMode);
+		if (pendingFrames.isEmpty())
+		{
+			status = netRender_READY;
+			NotifyStatus();
+		}
+		else
+		{
+			frameRenderer->AddFrames(pendingFrames);
+			pendingFrames.clear();
+		}
+	}
+}
+
+void CNetRender::SetCurrentAnimationJob(const cParameterContainer &settings,
+	const cFractalContainer &fractal, cAnimationFrames *frames, cKeyframes *keyframes,
+	QStringList listOfTextures)
+{
+	WriteLog("NetRender - Sending animation job", 2);
+	cSettings settingsData(cSettings::formatNetRender);
+	size_t dataSize = settingsData.CreateText(&settings, &fractal, frames, keyframes);
+	if (dataSize > 0)
+	{
+		// new id. Frames of previous animation will be ignored
+		actualId = rand();
+
+		QString settingsText = settingsData.GetSettingsText();
+		ResetMessage(&msgCurrentJob);
+		msgCurrentJob.command = netRender_ANIMATION;
+		QDataStream stream(&msgCurrentJob.payload, QIODevice::WriteOnly);
+		stream << qint32(keyframes ? cRenderJob::keyframeAnim : cRenderJob::flightAnim);
+		WriteJobData(&stream, settingsText, listOfTextures);
+
+		for (auto &client : clients)
+		{
+			SendData(client.socket, msgCurrentJob);
+			client.linesRendered = 0;
+			client.framesRendered = 0;
+		}
+	}
+}
+
+void CNetRender::SendFramesToRender(qint32 clientId, QList<int> frameIndices)
+{
+	for (auto &client : clients)
+	{
+		if (client.id == clientId)
+		{
+			WriteLog(QString("NetRender - send %1 frames to client %2 (%3)")
+								 .arg(frameIndices.size())
+								 .arg(clientId)
+								 .arg(client.name),
+				2);
+			sMessage msg;
+			msg.command = netRender_FRAMES;
+			QDataStream stream(&msg.payload, QIODevice::WriteOnly);
+			stream << qint32(frameIndices.size());
+			for (int frameIndex : frameIndices)
+			{
+				stream << qint32(frameIndex);
+			}
+			SendData(client.socket, msg);
+			return;
+		}
+	}
+	qCritical() << "CNetRender::SendFramesToRender(): client doesn't exist:" << clientId;
+}
+
+void CNetRender::SendRenderedFrame(int frameIndex, double renderTime, QByteArray frameData)
+{
+	sMessage msg;
+	msg.command = netRender_FRAME;
+	QDataStream stream(&msg.payload, QIODevice::WriteOnly);
+	stream << qint32(frameIndex);
+	stream << qint32(renderTime * 1000.0);
+	stream.writeRawData(frameData.data(), frameData.size());
+	SendData(clientSocket, msg);
+}
+
+void CNetRender::CreateFrameRenderer(qint32 animationMode)
+{
+	DeleteFrameRenderer();
+
+	// received settings don't contain application settings, so local ones are used
+	cParameterContainer params = *gPar;
+	cFractalContainer fractal = *gParFractal;
+	cAnimationFrames frames;
+	cKeyframes keyframes;
+
+	cSettings parSettings(cSettings::formatCondensedText);
+	parSettings.BeQuiet(true);
+	parSettings.LoadFromString(settingsText);
+	parSettings.Decode(&params, &fractal, &frames, &keyframes);
+
+	frameRenderer = new cNetRenderFrameRenderer(
+		params, fractal, frames, keyframes, cRenderJob::enumMode(animationMode));
+	frameRendererThread = new QThread;
+	frameRendererThread->setObjectName("NetRenderFrames");
+	frameRenderer->moveToThread(frameRendererThread);
+
+	connect(frameRenderer, SIGNAL(frameRendered(int, double, QByteArray)), this,
+		SLOT(SendRenderedFrame(int, double, QByteArray)));
+	connect(frameRenderer, SIGNAL(finished()), this, SLOT(FrameRendererFinished()));
+
+	frameRendererThread->start();
+}
+
+void CNetRender::DeleteFrameRenderer()
+{
+	if (frameRenderer)
+	{
+		frameRenderer->Stop();
+		frameRendererThread->quit();
+		frameRendererThread->wait();
+		delete frameRenderer;
+		delete frameRendererThread;
+		frameRenderer = nullptr;
+		frameRendererThread = nullptr;
+	}
+}
+
+void CNetRender::FrameRendererFinished()
+{
+	if (IsClient() && status == netRender_WORKING)
+	{
+		status = netRender_READY;
+		NotifyStatus();
+	}
+}
@@ -44,6 +44,10 @@
 
 // forward declarations
 struct sRenderData;
+class cAnimationFrames;
+class cKeyframes;
+class cNetRenderFrameRenderer;
+class cNetRenderTextureCache;
 
 class CNetRender : public QObject
 {
@@ -63,13 +67,19 @@ public:
 											 // and suggestion which lines should be rendered first (server to clients)
 		netRender_DATA,		 // data of rendered lines (client to server)
 		netRender_BAD,		 // answer about wrong server version (client to server)
-		netRender_JOB,		 // sending of settings and textures
+		netRender_JOB,		 // sending of settings and hashes of textures
 											 // Receiving of job will start rendering on client (server to clients)
 		netRender_STOP,		 // terminate rendering request (server to clients)
 		netRender_STATUS,	// ask for status (server to clients)
 		netRender_SETUP,	 // send setup job id and starting positions (server to clients)
 		netRender_ACK,		 // acknowledge receiving of rendered lines (server to clients)
-		netRender_KICK_AND_KILL // command to kill the client (program exit) (server to clients)
+		netRender_KICK_AND_KILL, // command to kill the client (program exit) (server to clients)
+		netRender_ANIMATION, // settings with whole animation and hashes of textures (server to clients)
+		netRender_FRAMES,		 // list of animation frames to render (server to clients)
+		netRender_FRAME,		 // data of rendered animation frame (client to server)
+		netRender_TEXTURE_REQUEST, // hashes of textures missing in client cache (client to server)
+		netRender_TEXTURES,				 // content of requested textures (server to clients)
+		netRender_NACK // rendered lines were damaged, request to send them again (server to clients)
 	};
 
 	enum netRenderStatus
@@ -95,15 +105,34 @@ public:
 		netRenderServer
 	};
 
+	// compression of message payload (indices of netrender_compression combo box)
+	enum enumNetRenderCodec
+	{
+		netRenderCodec_NONE,
+		netRenderCodec_LZO,
+		netRenderCodec_ZLIB
+	};
+
 	//---------------- internal data structures ----------------
 private:
 	// general message frame for sending/receiving
 	struct sMessage
 	{
-		sMessage() : command(netRender_NONE), id(0), size(0) {}
+		sMessage()
+				: command(netRender_NONE),
+					id(0),
+					size(0),
+					uncompressedSize(0),
+					codec(netRenderCodec_NONE),
+					checksum(0)
+		{
+		}
 		qint32 command;
 		qint32 id;
-		qint32 size;
+		qint32 size; // size of payload as it is sent (compressed)
+		qint32 uncompressedSize;
+		qint32 codec;
+		quint32 checksum;
 		QByteArray payload;
 	};
 
@@ -111,13 +140,27 @@ public:
 	// all information about connected clients
 	struct sClient
 	{
-		sClient() : socket(nullptr), status(netRender_NEW), linesRendered(0), clientWorkerCount(0) {}
+		sClient()
+				: socket(nullptr),
+					status(netRender_NEW),
+					linesRendered(0),
+					clientWorkerCount(0),
+					id(0),
+					framesRendered(0),
+					frameRenderTime(0.0),
+					codec(netRenderCodec_LZO)
+		{
+		}
 		QTcpSocket *socket;
 		sMessage msg;
 		netRenderStatus status;
 		qint32 linesRendered;
 		qint32 clientWorkerCount;
 		QString name;
+		qint32 id; // unique, doesn't change when other clients are disconnected
+		qint32 framesRendered;
+		double frameRenderTime; // moving average of rendering time of animation frame [s]
+		qint32 codec;						// compression used for messages to this client
 	};
 
 	//----------------- public methods --------------------------
@@ -161,6 +204,12 @@ public:
 
 	bool WaitForAllClientsReady(double timeout);
 
+	// send parameters with whole animation and textures to all clients (frame by frame rendering)
+	void SetCurrentAnimationJob(const cParameterContainer &settings, const cFractalContainer &fractal,
+		cAnimationFrames *frames, cKeyframes *keyframes, QStringList listOfTextures);
+	// send list of animation frames to render to the client with given id
+	void SendFramesToRender(qint32 clientId, QList<int> frameIndices);
+
 	// setting status test
 	static QString GetStatusText(netRenderStatus displayStatus);
 	// setting status color
@@ -178,10 +227,32 @@ private:
 	void ProcessData(QTcpSocket *socket, sMessage *inMsg);
 	// clearing message buffer
 	static void ResetMessage(sMessage *msg);
+	// compression negotiated with given communication partner
+	qint32 CodecForSocket(const QTcpSocket *socket) const;
+	// bit mask of supported compression methods
+	static qint32 SupportedCodecs();
+	// uncompress received payload in place
+	static bool UncompressPayload(sMessage *msg);
 	// get client index by given socket pointer
 	int GetClientIndexFromSocket(const QTcpSocket *socket) const;
 	// compare major version of software
 	static bool CompareMajorVersion(qint32 version1, qint32 version2);
+	// write settings and names and hashes of textures
+	void WriteJobData(
+		QDataStream *stream, const QString &settingsText, const QStringList &listOfTextures);
+	// read settings and take textures from cache
+	void ReadJobData(QDataStream *stream);
+	// ask server for textures which are not in the cache
+	void RequestMissingTextures();
+	// send content of requested textures to the client
+	void SendTextures(QTcpSocket *socket, const QList<QByteArray> &hashes);
+	// read received textures and start the job if nothing is missing
+	void ReadTextures(QDataStream *stream);
+	// start received job (JOB or ANIMATION) when all textures are available
+	void StartReceivedJob();
+	// start thread which renders animation frames on client
+	void CreateFrameRenderer(qint32 animationMode);
+	void DeleteFrameRenderer();
 
 	//---------------- private data -----------------
 private:
@@ -200,7 +271,12 @@ private:
 	typeOfDevice deviceType;
 	sMessage msgFromServer;
 	sMessage msgCurrentJob;
+	sMessage msgRenderedLines; // last sent DATA message, kept until ACK for resending
 	QTimer *reconnectTimer;
+	qint32 nextClientId;
+	qint32 codec; // compression used for messages to the server
+	mutable QByteArray compressionBuffer;
+	mutable QByteArray compressionWorkMemory;
 
 	// client data buffers
 	QString settingsText;
@@ -208,6 +284,13 @@ private:
 	QList<int> startingPositions;
 	bool isUsed;
 	QMap<QString, QByteArray> textures;
+	QMultiMap<QByteArray, QString> missingTextures; // hash, texture name
+	cNetRenderTextureCache *textureCache;
+	qint32 pendingJobCommand; // job which waits for textures
+	qint32 pendingAnimationMode;
+	QList<int> pendingFrames; // frames received before the animation job was started
+	cNetRenderFrameRenderer *frameRenderer;
+	QThread *frameRendererThread;
 
 	//------------------- public slots -------------------
 public slots:
@@ -215,7 +298,7 @@ public slots:
 	void SetCurrentJob(
 		cParameterContainer settings, cFractalContainer fractal, QStringList listOfTextures);
 	// send to server a list of numbers and image data of already rendered lines
-	void SendRenderedLines(QList<int> lineNumbers, QList<QByteArray> lines) const;
+	void SendRenderedLines(QList<int> lineNumbers, QList<QByteArray> lines);
 	// send list of already rendered lines
 	void SendToDoList(int clientIndex, QList<int> done); // send list of already rendered lines
 	// notify the server about client status change
@@ -226,6 +309,8 @@ public slots:
 	void SendSetup(int clientIndex, int id, QList<int> startingPositions);
 	// kicks and kills a client (can be used if client is hanging)
 	void KickAndKillClient(int clientIndex);
+	// send to server data of rendered animation frame
+	void SendRenderedFrame(int frameIndex, double renderTime, QByteArray frameData);
 
 	//------------------- private slots ------------------
 private slots:
@@ -241,6 +326,8 @@ private slots:
 	void ReceiveFromServer();
 	// try to connect to server
 	void TryServerConnect();
+	// all received animation frames are rendered
+	void FrameRendererFinished();
 
 signals:
 	// request to update table of clients
@@ -253,6 +340,8 @@ signals:
 	void ToDoListArrived(QList<int> done);
 	// confirmation of data receive
 	void AckReceived();
+	// data of rendered animation frame
+	void FrameArrived(qint32 clientId, int frameIndex, double renderTime, QByteArray frameData);
 
 	void NewStatusClient();
 	void NewStatusServer();
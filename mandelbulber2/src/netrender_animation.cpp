@@ -0,0 +1,413 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2014-17 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * NetRender distribution of animations frame by frame
+ */
+
+#include "netrender_animation.hpp"
+
+#include "cimage.hpp"
+#include "global_data.hpp"
+#include "image_save_queue.hpp"
+#include "initparameters.hpp"
+#include "interface.hpp"
+#include "netrender.hpp"
+#include "netrender_frame_scheduler.hpp"
+#include "rendering_configuration.hpp"
+#include "system.hpp"
+
+cNetRenderAnimation::cNetRenderAnimation(cParameterContainer *_params,
+	cFractalContainer *_fractal, cAnimationFrames *_frames, cKeyframes *_keyframes, cImage *_image,
+	cRenderJob *_renderJob, bool *_stopRequest)
+		: QObject(nullptr)
+{
+	params = _params;
+	fractal = _fractal;
+	frames = _frames;
+	keyframes = _keyframes;
+	image = _image;
+	renderJob = _renderJob;
+	stopRequest = _stopRequest;
+	fileType = ImageFileSave::IMAGE_FILE_TYPE_JPG;
+	saveQueue = nullptr;
+}
+
+cNetRenderAnimation::~cNetRenderAnimation() = default;
+
+bool cNetRenderAnimation::IsEnabled(const cParameterContainer *params)
+{
+	// stereo images are rendered by the clients in a different way
+	return gNetRender->IsServer() && gNetRender->GetClientCount() > 0
+				 && params->Get<bool>("netrender_distribute_frames")
+				 && !params->Get<bool>("stereo_enabled");
+}
+
+bool cNetRenderAnimation::RenderAndSave(const QMap<int, QString> &_frameFiles,
+	ImageFileSave::enumImageFileType _fileType, cImageSaveQueue *_saveQueue)
+{
+	WriteLog("NetRender - rendering of animation frame by frame", 2);
+
+	frameFiles = _frameFiles;
+	fileType = _fileType;
+	saveQueue = _saveQueue;
+	scheduler.reset(new cNetRenderFrameScheduler(
+		frameFiles.keys(), params->Get<double>("netrender_frames_chunk_time")));
+	progressText.ResetTimer();
+
+	// clients get the whole animation and calculate parameters of frames by themselves
+	gNetRender->SetCurrentAnimationJob(*params, *fractal, keyframes ? nullptr : frames, keyframes,
+		renderJob->CreateListOfUsedTextures());
+
+	connect(gNetRender, SIGNAL(FrameArrived(qint32, int, double, QByteArray)), this,
+		SLOT(slotFrameArrived(qint32, int, double, QByteArray)));
+
+	bool result = true;
+	while (!scheduler->IsFinished())
+	{
+		if (*stopRequest || systemData.globalStopRequest)
+		{
+			result = false;
+			break;
+		}
+
+		DistributeFrames();
+
+		// server renders one frame at a time, so it is never the last one waited for
+		QList<int> localFrames = scheduler->AssignFrames(localWorkerId, 1);
+		if (!localFrames.isEmpty())
+		{
+			if (!RenderLocalFrame(localFrames.first()))
+			{
+				result = false;
+				break;
+			}
+		}
+		else
+		{
+			Wait(10);
+		}
+		gApplication->processEvents();
+	}
+
+	disconnect(gNetRender, SIGNAL(FrameArrived(qint32, int, double, QByteArray)), this,
+		SLOT(slotFrameArrived(qint32, int, double, QByteArray)));
+
+	if (!result) gNetRender->Stop();
+
+	WriteLog(QString("NetRender - animation finished, %1 of %2 frames rendered")
+						 .arg(scheduler->GetNumberOfDoneFrames())
+						 .arg(scheduler->GetNumberOfFrames()),
+		2);
+
+	return result;
+}
+
+void cNetRenderAnimation::DistributeFrames()
+{
+	// frames of disconnected clients are rendered by others
+	QSet<qint32> connectedClients;
+	for (int i = 0; i < gNetRender->GetClientCount(); i++)
+		connectedClients.insert(gNetRender->GetClient(i).id);
+
+	for (int workerId : scheduler->GetWorkerIds())
+	{
+		if (workerId != localWorkerId && !connectedClients.contains(workerId))
+		{
+			WriteLog(QString("NetRender - client %1 lost, frames will be rendered again").arg(workerId),
+				2);
+			scheduler->WorkerLost(workerId);
+		}
+	}
+
+	for (int i = 0; i < gNetRender->GetClientCount(); i++)
+	{
+		const CNetRender::sClient &client = gNetRender->GetClient(i);
+
+		// new client gets the job after sending number of CPUs
+		if (client.status == CNetRender::netRender_NEW
+				|| client.status == CNetRender::netRender_CONNECTING
+				|| client.status == CNetRender::netRender_ERROR)
+			continue;
+
+		// next range is sent before the previous one is finished, so the client is never idle
+		if (scheduler->GetNumberOfPendingFrames(client.id) <= 1)
+		{
+			QList<int> framesForClient = scheduler->AssignFrames(client.id);
+			if (!framesForClient.isEmpty()) gNetRender->SendFramesToRender(client.id, framesForClient);
+		}
+	}
+}
+
+bool cNetRenderAnimation::RenderLocalFrame(int frameIndex)
+{
+	if (keyframes)
+		keyframes->GetInterpolatedFrameAndConsolidate(frameIndex, params, fractal);
+	else
+		frames->GetFrameAndConsolidate(frameIndex, params, fractal);
+	params->Set("frame_no", frameIndex);
+
+	if (!systemData.noGui && image->IsMainImage())
+	{
+		gMainInterface->SynchronizeInterface(params, fractal, qInterface::write);
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	renderJob->UpdateParameters(params, fractal);
+	if (!renderJob->Execute()) return false;
+
+	if (scheduler->FrameDone(localWorkerId, frameIndex, timer.elapsed() / 1000.0))
+	{
+		saveQueue->Enqueue(frameFiles.value(frameIndex), fileType, image);
+		UpdateProgress();
+	}
+	return true;
+}
+
+void cNetRenderAnimation::slotFrameArrived(
+	qint32 clientId, int frameIndex, double renderTime, QByteArray frameData)
+{
+	if (!frameFiles.contains(frameIndex))
+	{
+		WriteLog(QString("NetRender - received frame %1 which was not requested").arg(frameIndex), 1);
+		return;
+	}
+
+	// each frame is decoded to its own image. Shared buffer could be overwritten by next frame
+	// which arrives while events are processed (local rendering, waiting for the save queue)
+	cImage receivedImage(1, 1, true);
+	if (!scheduler->IsFrameDone(frameIndex))
+	{
+		if (!ReadFrameData(frameData, &receivedImage))
+		{
+			qCritical() << "NetRender - wrong data of frame" << frameIndex << "from client" << clientId;
+			// all frames of this client will be rendered again
+			scheduler->WorkerLost(clientId);
+			return;
+		}
+		receivedImage.SetImageParameters(*image->GetImageAdjustments());
+	}
+
+	// duplicated frames (rendered at the end of animation by two workers) are only counted
+	if (scheduler->FrameDone(clientId, frameIndex, renderTime))
+	{
+		saveQueue->Enqueue(frameFiles.value(frameIndex), fileType, &receivedImage);
+		UpdateProgress();
+	}
+
+	// it can be called while the server renders its own frame
+	DistributeFrames();
+}
+
+void cNetRenderAnimation::UpdateProgress()
+{
+	const double percentDone =
+		double(scheduler->GetNumberOfDoneFrames()) / qMax(1, scheduler->GetNumberOfFrames());
+	emit updateProgressAndStatus(QObject::tr("Rendering animation"),
+		QObject::tr("Frame %1 of %2 (%3 clients)")
+				.arg(scheduler->GetNumberOfDoneFrames())
+				.arg(scheduler->GetNumberOfFrames())
+				.arg(gNetRender->GetClientCount())
+			+ " " + progressText.getText(percentDone),
+		percentDone, cProgressText::progress_ANIMATION);
+}
+
+void cNetRenderAnimation::CreateFrameData(cImage *image, QByteArray *frameData)
+{
+	//			NetRender frame data format
+	// | qint32	| qint32	| qint32	| qint32		| layers
+	// | width	| height	| normal	| specular	| RGB float, RGB16, alpha, z, (normal), (specular)
+
+	const int width = image->GetWidth();
+	const int height = image->GetHeight();
+	const qint64 size = qint64(width) * height;
+	const bool normal = image->GetImageOptional()->optionalNormal;
+	const bool specular = image->GetImageOptional()->optionalSpecular;
+
+	frameData->clear();
+	QDataStream stream(frameData, QIODevice::WriteOnly);
+	stream << qint32(width) << qint32(height) << qint32(normal) << qint32(specular);
+
+	stream.writeRawData(
+		reinterpret_cast<char *>(image->GetImageFloatPtr()), int(size * sizeof(sRGBFloat)));
+	stream.writeRawData(reinterpret_cast<char *>(image->GetImage16Ptr()), int(size * sizeof(sRGB16)));
+	stream.writeRawData(
+		reinterpret_cast<char *>(image->GetAlphaBufPtr()), int(size * sizeof(quint16)));
+	stream.writeRawData(reinterpret_cast<char *>(image->GetZBufferPtr()), int(size * sizeof(float)));
+
+	// optional layers can be stored as half floats, so they are copied pixel by pixel
+	QVector<sRGBFloat> layer;
+	if (normal || specular) layer.resize(int(size));
+	for (int l = 0; l < 2; l++)
+	{
+		if ((l == 0 && !normal) || (l == 1 && !specular)) continue;
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				layer[x + y * width] =
+					(l == 0) ? image->GetPixelNormal(x, y) : image->GetPixelSpecular(x, y);
+			}
+		}
+		stream.writeRawData(
+			reinterpret_cast<char *>(layer.data()), int(size * sizeof(sRGBFloat)));
+	}
+}
+
+bool cNetRenderAnimation::ReadFrameData(const QByteArray &frameData, cImage *image)
+{
+	QDataStream stream(frameData);
+	qint32 width, height, normal, specular;
+	stream >> width >> height >> normal >> specular;
+	if (stream.status() != QDataStream::Ok || width <= 0 || height <= 0) return false;
+
+	const qint64 size = qint64(width) * height;
+	const qint64 pixelSize = sizeof(sRGBFloat) + sizeof(sRGB16) + sizeof(quint16) + sizeof(float);
+	qint64 expectedSize = 4 * sizeof(qint32) + size * pixelSize;
+	if (normal) expectedSize += size * sizeof(sRGBFloat);
+	if (specular) expectedSize += size * sizeof(sRGBFloat);
+	if (frameData.size() != expectedSize) return false;
+
+	sImageOptional optional;
+	optional.optionalNormal = normal;
+	optional.optionalSpecular = specular;
+	if (!image->ChangeSize(width, height, optional)) return false;
+
+	stream.readRawData(
+		reinterpret_cast<char *>(image->GetImageFloatPtr()), int(size * sizeof(sRGBFloat)));
+	stream.readRawData(reinterpret_cast<char *>(image->GetImage16Ptr()), int(size * sizeof(sRGB16)));
+	stream.readRawData(
+		reinterpret_cast<char *>(image->GetAlphaBufPtr()), int(size * sizeof(quint16)));
+	stream.readRawData(reinterpret_cast<char *>(image->GetZBufferPtr()), int(size * sizeof(float)));
+
+	QVector<sRGBFloat> layer;
+	if (normal || specular) layer.resize(int(size));
+	for (int l = 0; l < 2; l++)
+	{
+		if ((l == 0 && !normal) || (l == 1 && !specular)) continue;
+		stream.readRawData(reinterpret_cast<char *>(layer.data()), int(size * sizeof(sRGBFloat)));
+		for (int y = 0; y < height; y++)
+		{
+			for (int x = 0; x < width; x++)
+			{
+				if (l == 0)
+					image->PutPixelNormal(x, y, layer[x + y * width]);
+				else
+					image->PutPixelSpecular(x, y, layer[x + y * width]);
+			}
+		}
+	}
+
+	return stream.status() == QDataStream::Ok;
+}
+
+cNetRenderFrameRenderer::cNetRenderFrameRenderer(const cParameterContainer &_params,
+	const cFractalContainer &_fractal, const cAnimationFrames &_frames, const cKeyframes &_keyframes,
+	cRenderJob::enumMode _mode)
+		: QObject(nullptr), params(_params), fractal(_fractal), frames(_frames), keyframes(_keyframes)
+{
+	mode = _mode;
+	busy = false;
+	audioLoaded = false;
+	stopRequest = false;
+	keyframes.SetFramesPerKeyframe(params.Get<int>("frames_per_keyframe"));
+}
+
+cNetRenderFrameRenderer::~cNetRenderFrameRenderer() = default;
+
+void cNetRenderFrameRenderer::AddFrames(const QList<int> &frameIndices)
+{
+	mutex.lock();
+	framesToRender.append(frameIndices);
+	mutex.unlock();
+	QMetaObject::invokeMethod(this, "slotRenderFrames", Qt::QueuedConnection);
+}
+
+void cNetRenderFrameRenderer::slotRenderFrames()
+{
+	// can be called again from the event loop of running render. Frames added in the meantime
+	// are rendered by the first call
+	if (busy) return;
+	busy = true;
+
+	WriteLog("NetRender - cNetRenderFrameRenderer::slotRenderFrames()", 2);
+
+	cAnimationFrames *animation = (mode == cRenderJob::keyframeAnim) ? &keyframes : &frames;
+	if (!audioLoaded)
+	{
+		animation->RefreshAllAudioTracks(&params);
+		audioLoaded = true;
+	}
+
+	cImage image(params.Get<int>("image_width"), params.Get<int>("image_height"));
+	cRenderJob renderJob(&params, &fractal, &image, &stopRequest);
+
+	// complete frames are rendered locally, only textures are taken from the server
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+	config.EnableNetRenderTextures();
+
+	bool result = renderJob.Init(mode, config);
+
+	while (result && !stopRequest)
+	{
+		mutex.lock();
+		if (framesToRender.isEmpty())
+		{
+			mutex.unlock();
+			break;
+		}
+		const int frameIndex = framesToRender.takeFirst();
+		mutex.unlock();
+
+		cParameterContainer frameParams = params;
+		cFractalContainer frameFractal = fractal;
+		if (mode == cRenderJob::keyframeAnim)
+			keyframes.GetInterpolatedFrameAndConsolidate(frameIndex, &frameParams, &frameFractal);
+		else
+			frames.GetFrameAndConsolidate(frameIndex, &frameParams, &frameFractal);
+		frameParams.Set("frame_no", frameIndex);
+
+		QElapsedTimer timer;
+		timer.start();
+		renderJob.UpdateParameters(&frameParams, &frameFractal);
+		result = renderJob.Execute();
+		if (!result || stopRequest) break;
+
+		QByteArray frameData;
+		cNetRenderAnimation::CreateFrameData(&image, &frameData);
+		emit frameRendered(frameIndex, timer.elapsed() / 1000.0, frameData);
+	}
+
+	busy = false;
+	if (!stopRequest) emit finished();
+}
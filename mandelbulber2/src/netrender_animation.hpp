@@ -0,0 +1,145 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2014-17 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * NetRender distribution of animations frame by frame
+ *
+ * cNetRenderAnimation is used by the server. It sends the settings with the whole animation to
+ * all clients, then sends them ranges of frames to render (see cNetRenderFrameScheduler) and
+ * saves the frames which come back. The server renders single frames itself between.
+ *
+ * cNetRenderFrameRenderer is used by clients. It works in a separate thread, calculates
+ * parameters of the requested frames from the received animation and renders complete frames
+ * (with all post effects) locally.
+ */
+
+#ifndef MANDELBULBER2_SRC_NETRENDER_ANIMATION_HPP_
+#define MANDELBULBER2_SRC_NETRENDER_ANIMATION_HPP_
+
+#include <QtCore>
+
+#include "file_image.hpp"
+#include "fractal_container.hpp"
+#include "keyframes.hpp"
+#include "parameters.hpp"
+#include "progress_text.hpp"
+#include "render_job.hpp"
+
+// forward declarations
+class cImage;
+class cImageSaveQueue;
+class cNetRenderFrameScheduler;
+
+class cNetRenderAnimation : public QObject
+{
+	Q_OBJECT
+public:
+	// only one of frames and keyframes is used (keyframes has priority)
+	cNetRenderAnimation(cParameterContainer *_params, cFractalContainer *_fractal,
+		cAnimationFrames *_frames, cKeyframes *_keyframes, cImage *_image, cRenderJob *_renderJob,
+		bool *_stopRequest);
+	~cNetRenderAnimation() override;
+
+	// renders frames (key of the map) on all clients and locally and saves them with given names
+	bool RenderAndSave(const QMap<int, QString> &frameFiles,
+		ImageFileSave::enumImageFileType fileType, cImageSaveQueue *saveQueue);
+
+	// checks if animation frames can be distributed between NetRender clients
+	static bool IsEnabled(const cParameterContainer *params);
+
+	// serialization of all image layers needed to save the frame
+	static void CreateFrameData(cImage *image, QByteArray *frameData);
+	static bool ReadFrameData(const QByteArray &frameData, cImage *image);
+
+	static const int localWorkerId = -1;
+
+private:
+	void DistributeFrames();
+	bool RenderLocalFrame(int frameIndex);
+	void UpdateProgress();
+
+	cParameterContainer *params;
+	cFractalContainer *fractal;
+	cAnimationFrames *frames;
+	cKeyframes *keyframes;
+	cImage *image;
+	cRenderJob *renderJob;
+	bool *stopRequest;
+
+	QScopedPointer<cNetRenderFrameScheduler> scheduler;
+	QMap<int, QString> frameFiles;
+	ImageFileSave::enumImageFileType fileType;
+	cImageSaveQueue *saveQueue;
+	cProgressText progressText;
+
+private slots:
+	void slotFrameArrived(qint32 clientId, int frameIndex, double renderTime, QByteArray frameData);
+
+signals:
+	void updateProgressAndStatus(const QString &text, const QString &progressText, double progress,
+		cProgressText::enumProgressType progressType = cProgressText::progress_IMAGE);
+};
+
+class cNetRenderFrameRenderer : public QObject
+{
+	Q_OBJECT
+public:
+	cNetRenderFrameRenderer(const cParameterContainer &_params, const cFractalContainer &_fractal,
+		const cAnimationFrames &_frames, const cKeyframes &_keyframes, cRenderJob::enumMode _mode);
+	~cNetRenderFrameRenderer() override;
+
+	// thread safe. Frames are rendered in the thread of this object
+	void AddFrames(const QList<int> &frameIndices);
+	// stopped renderer ignores all next frames
+	void Stop() { stopRequest = true; }
+
+private:
+	cParameterContainer params;
+	cFractalContainer fractal;
+	cAnimationFrames frames;
+	cKeyframes keyframes;
+	cRenderJob::enumMode mode;
+
+	QList<int> framesToRender;
+	QMutex mutex;
+	bool busy;
+	bool audioLoaded;
+	bool stopRequest;
+
+private slots:
+	void slotRenderFrames();
+
+signals:
+	void frameRendered(int frameIndex, double renderTime, QByteArray frameData);
+	// all received frames are rendered
+	void finished();
+};
+
+#endif /* MANDELBULBER2_SRC_NETRENDER_ANIMATION_HPP_ */
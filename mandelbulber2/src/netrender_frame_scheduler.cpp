@@ -0,0 +1,182 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2014-17 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cNetRenderFrameScheduler - distribution of animation frames between NetRender clients
+ */
+
+#include "netrender_frame_scheduler.hpp"
+
+#include <algorithm>
+
+cNetRenderFrameScheduler::cNetRenderFrameScheduler(
+	const QList<int> &framesToRender, double _targetChunkTime)
+{
+	queue = framesToRender;
+	std::sort(queue.begin(), queue.end());
+	numberOfFrames = queue.size();
+	targetChunkTime = _targetChunkTime;
+}
+
+QList<int> cNetRenderFrameScheduler::AssignFrames(int workerId, int maxFrames)
+{
+	sWorker &worker = workers[workerId];
+	QList<int> assigned;
+
+	if (queue.isEmpty())
+	{
+		// the end of animation. Idle worker helps the slowest one
+		if (worker.pending.isEmpty())
+		{
+			int frame = FindFrameToDuplicate(workerId);
+			if (frame >= 0)
+			{
+				worker.pending.append(frame);
+				assigned.append(frame);
+			}
+		}
+		return assigned;
+	}
+
+	int chunk = ChunkSize(worker);
+	if (maxFrames > 0) chunk = qMin(chunk, maxFrames);
+
+	assigned = queue.mid(0, chunk);
+	queue.erase(queue.begin(), queue.begin() + assigned.size());
+	worker.pending.append(assigned);
+	return assigned;
+}
+
+bool cNetRenderFrameScheduler::FrameDone(int workerId, int frameIndex, double renderTime)
+{
+	sWorker &worker = workers[workerId];
+	worker.pending.removeOne(frameIndex);
+
+	// moving average of rendering time
+	if (renderTime > 0.0)
+	{
+		if (worker.secondsPerFrame > 0.0)
+			worker.secondsPerFrame = 0.7 * worker.secondsPerFrame + 0.3 * renderTime;
+		else
+			worker.secondsPerFrame = renderTime;
+	}
+
+	if (doneFrames.contains(frameIndex)) return false;
+
+	doneFrames.insert(frameIndex);
+	worker.framesDone++;
+	return true;
+}
+
+void cNetRenderFrameScheduler::WorkerLost(int workerId)
+{
+	if (!workers.contains(workerId)) return;
+
+	for (int frame : workers[workerId].pending)
+	{
+		if (doneFrames.contains(frame) || queue.contains(frame)) continue;
+
+		// frame could be still rendered by other worker (duplicated at the end of animation)
+		bool assignedToOther = false;
+		for (QMap<int, sWorker>::const_iterator it = workers.constBegin(); it != workers.constEnd();
+				 ++it)
+		{
+			if (it.key() != workerId && it.value().pending.contains(frame)) assignedToOther = true;
+		}
+		if (assignedToOther) continue;
+
+		queue.insert(std::lower_bound(queue.begin(), queue.end(), frame), frame);
+	}
+	workers.remove(workerId);
+}
+
+int cNetRenderFrameScheduler::GetNumberOfPendingFrames(int workerId) const
+{
+	return workers.value(workerId).pending.size();
+}
+
+int cNetRenderFrameScheduler::GetNumberOfFramesDone(int workerId) const
+{
+	return workers.value(workerId).framesDone;
+}
+
+double cNetRenderFrameScheduler::GetFramesPerSecond(int workerId) const
+{
+	double secondsPerFrame = workers.value(workerId).secondsPerFrame;
+	return secondsPerFrame > 0.0 ? 1.0 / secondsPerFrame : 0.0;
+}
+
+int cNetRenderFrameScheduler::ChunkSize(const sWorker &worker) const
+{
+	// first frame is used to measure speed of the worker
+	if (worker.secondsPerFrame <= 0.0) return 1;
+
+	int chunk = int(targetChunkTime / worker.secondsPerFrame);
+
+	// smaller ranges when there is not much left, so all workers finish at similar time
+	int fairShare = queue.size() / (2 * qMax(1, workers.size()));
+	return qBound(1, chunk, qMax(1, fairShare));
+}
+
+int cNetRenderFrameScheduler::FindFrameToDuplicate(int workerId) const
+{
+	const double ownTime = workers.value(workerId).secondsPerFrame;
+
+	int bestFrame = -1;
+	double longestTime = 0.0;
+	for (QMap<int, sWorker>::const_iterator it = workers.constBegin(); it != workers.constEnd(); ++it)
+	{
+		if (it.key() == workerId || it.value().pending.isEmpty()) continue;
+
+		// the last frame of the worker will be finished as the last one
+		int frame = it.value().pending.last();
+		if (doneFrames.contains(frame)) continue;
+
+		int copies = 0;
+		for (const sWorker &other : workers)
+			if (other.pending.contains(frame)) copies++;
+		if (copies > 1) continue;
+
+		// not measured worker is treated as very slow
+		double timeToFinish = it.value().secondsPerFrame > 0.0
+														? it.value().pending.size() * it.value().secondsPerFrame
+														: 1e10;
+
+		// it makes sense only if this worker can finish it earlier
+		if (ownTime > 0.0 && ownTime >= timeToFinish) continue;
+
+		if (timeToFinish > longestTime)
+		{
+			longestTime = timeToFinish;
+			bestFrame = frame;
+		}
+	}
+	return bestFrame;
+}
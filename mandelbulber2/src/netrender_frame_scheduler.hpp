@@ -0,0 +1,90 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2014-17 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cNetRenderFrameScheduler - distribution of animation frames between NetRender clients
+ *
+ * Frames are assigned to the workers as ranges of consecutive frames. The size of the range
+ * depends on the measured rendering time of the worker, so every worker gets work for about
+ * targetChunkTime seconds. The first range of every worker has only one frame, which is used to
+ * measure its speed. Frames of a lost worker go back to the queue. When the queue is empty, an
+ * idle worker renders also the last frame which is still waiting at the slowest worker. The
+ * result which comes first is used.
+ */
+
+#ifndef MANDELBULBER2_SRC_NETRENDER_FRAME_SCHEDULER_HPP_
+#define MANDELBULBER2_SRC_NETRENDER_FRAME_SCHEDULER_HPP_
+
+#include <QList>
+#include <QMap>
+#include <QSet>
+
+class cNetRenderFrameScheduler
+{
+public:
+	cNetRenderFrameScheduler(const QList<int> &framesToRender, double targetChunkTime);
+
+	// assigns next range of frames to the worker (maxFrames = 0 - no limit)
+	QList<int> AssignFrames(int workerId, int maxFrames = 0);
+	// returns false if the frame was already delivered by other worker
+	bool FrameDone(int workerId, int frameIndex, double renderTime);
+	// frames assigned to the worker are returned to the queue
+	void WorkerLost(int workerId);
+
+	bool IsFinished() const { return doneFrames.size() == numberOfFrames; }
+	bool IsFrameDone(int frameIndex) const { return doneFrames.contains(frameIndex); }
+	bool IsWorkerKnown(int workerId) const { return workers.contains(workerId); }
+	QList<int> GetWorkerIds() const { return workers.keys(); }
+	int GetNumberOfFrames() const { return numberOfFrames; }
+	int GetNumberOfDoneFrames() const { return doneFrames.size(); }
+	int GetNumberOfPendingFrames(int workerId) const;
+	int GetNumberOfFramesDone(int workerId) const;
+	double GetFramesPerSecond(int workerId) const;
+
+private:
+	struct sWorker
+	{
+		sWorker() : secondsPerFrame(0.0), framesDone(0) {}
+		QList<int> pending;
+		double secondsPerFrame; // 0.0 means not measured yet
+		int framesDone;
+	};
+
+	int ChunkSize(const sWorker &worker) const;
+	int FindFrameToDuplicate(int workerId) const;
+
+	QList<int> queue; // sorted list of not assigned frames
+	QSet<int> doneFrames;
+	QMap<int, sWorker> workers;
+	int numberOfFrames;
+	double targetChunkTime;
+};
+
+#endif /* MANDELBULBER2_SRC_NETRENDER_FRAME_SCHEDULER_HPP_ */
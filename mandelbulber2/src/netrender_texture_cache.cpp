@@ -0,0 +1,161 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2014-17 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cNetRenderTextureCache - content addressed cache of textures used by NetRender
+ */
+
+#include "netrender_texture_cache.hpp"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "system.hpp"
+
+cNetRenderTextureCache::cNetRenderTextureCache(const QString &_cacheFolder)
+		: cacheFolder(_cacheFolder), memoryCache(maxMemoryUsage)
+{
+}
+
+QByteArray cNetRenderTextureCache::Hash(const QByteArray &data)
+{
+	return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+QByteArray cNetRenderTextureCache::HashOfFile(const QString &fileName)
+{
+	QFileInfo fileInfo(fileName);
+	if (!fileInfo.exists()) return QByteArray();
+
+	const sFileHash &known = fileHashes[fileName];
+	if (!known.hash.isEmpty() && known.lastModified == fileInfo.lastModified()
+			&& known.size == fileInfo.size())
+	{
+		return known.hash;
+	}
+
+	QFile file(fileName);
+	if (!file.open(QIODevice::ReadOnly)) return QByteArray();
+
+	QCryptographicHash hashCrypt(QCryptographicHash::Sha1);
+	hashCrypt.addData(&file);
+
+	sFileHash fileHash;
+	fileHash.lastModified = fileInfo.lastModified();
+	fileHash.size = fileInfo.size();
+	fileHash.hash = hashCrypt.result();
+	fileHashes.insert(fileName, fileHash);
+	filesByHash.insert(fileHash.hash, fileName);
+
+	return fileHash.hash;
+}
+
+QByteArray cNetRenderTextureCache::FileContent(const QByteArray &hash) const
+{
+	const QString fileName = filesByHash.value(hash);
+	QFile file(fileName);
+	if (fileName.isEmpty() || !file.open(QIODevice::ReadOnly))
+	{
+		qCritical() << "NetRender - requested texture is not available:" << hash.toHex();
+		return QByteArray();
+	}
+	return file.readAll();
+}
+
+bool cNetRenderTextureCache::Find(const QByteArray &hash, QByteArray *data)
+{
+	if (QByteArray *cached = memoryCache.object(hash))
+	{
+		*data = *cached;
+		return true;
+	}
+
+	QFile file(CachedFileName(hash));
+	if (!file.open(QIODevice::ReadOnly)) return false;
+
+	QByteArray content = file.readAll();
+	file.close();
+	if (Hash(content) != hash)
+	{
+		WriteLog("NetRender - corrupted texture in cache: " + file.fileName(), 1);
+		file.remove();
+		return false;
+	}
+
+	memoryCache.insert(hash, new QByteArray(content), int(content.size() / 1024 + 1));
+	*data = content;
+	return true;
+}
+
+void cNetRenderTextureCache::Insert(const QByteArray &hash, const QByteArray &data)
+{
+	memoryCache.insert(hash, new QByteArray(data), int(data.size() / 1024 + 1));
+
+	// the same folder can be used by many clients on one machine, so file is replaced atomically
+	QSaveFile file(CachedFileName(hash));
+	if (file.open(QIODevice::WriteOnly))
+	{
+		file.write(data);
+		if (file.commit())
+		{
+			LimitDiskUsage();
+			return;
+		}
+	}
+	qCritical() << "NetRender - cannot save texture in cache:" << file.fileName();
+}
+
+QString cNetRenderTextureCache::CachedFileName(const QByteArray &hash) const
+{
+	return cacheFolder + QDir::separator() + hash.toHex();
+}
+
+void cNetRenderTextureCache::LimitDiskUsage() const
+{
+	// the oldest textures are deleted first
+	const QFileInfoList cachedFiles =
+		QDir(cacheFolder).entryInfoList(QDir::Files, QDir::Time | QDir::Reversed);
+
+	qint64 totalSize = 0;
+	for (const QFileInfo &fileInfo : cachedFiles)
+		totalSize += fileInfo.size();
+
+	for (const QFileInfo &fileInfo : cachedFiles)
+	{
+		if (totalSize <= maxDiskUsage) break;
+		totalSize -= fileInfo.size();
+		QFile::remove(fileInfo.absoluteFilePath());
+	}
+}
@@ -0,0 +1,90 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2014-17 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cNetRenderTextureCache - content addressed cache of textures used by NetRender
+ *
+ * Textures are identified by hash of their content. The server sends only names and hashes of
+ * textures together with the job. Client looks for them in memory and on the disk and asks the
+ * server only for missing ones, so the same texture is transferred only once.
+ */
+
+#ifndef MANDELBULBER2_SRC_NETRENDER_TEXTURE_CACHE_HPP_
+#define MANDELBULBER2_SRC_NETRENDER_TEXTURE_CACHE_HPP_
+
+#include <QByteArray>
+#include <QCache>
+#include <QDateTime>
+#include <QMap>
+#include <QString>
+
+class cNetRenderTextureCache
+{
+public:
+	cNetRenderTextureCache(const QString &_cacheFolder);
+
+	// content hash used as texture identifier
+	static QByteArray Hash(const QByteArray &data);
+
+	// server side: hash of file content (file is read again only when it was modified)
+	QByteArray HashOfFile(const QString &fileName);
+	// server side: content of file which was hashed by HashOfFile()
+	QByteArray FileContent(const QByteArray &hash) const;
+
+	// client side: looks for texture in memory and then on the disk
+	bool Find(const QByteArray &hash, QByteArray *data);
+	// client side: stores texture in memory and on the disk
+	void Insert(const QByteArray &hash, const QByteArray &data);
+
+	// limit of memory used by cache [kB]
+	static const int maxMemoryUsage = 512 * 1024;
+	// limit of disk space used by cache [B]
+	static const qint64 maxDiskUsage = 2048 * 1024 * 1024LL;
+
+private:
+	QString CachedFileName(const QByteArray &hash) const;
+	void LimitDiskUsage() const;
+
+	struct sFileHash
+	{
+		sFileHash() : size(0) {}
+		QDateTime lastModified;
+		qint64 size;
+		QByteArray hash;
+	};
+
+	QString cacheFolder;
+	QMap<QString, sFileHash> fileHashes;
+	QMap<QByteArray, QString> filesByHash;
+	QCache<QByteArray, QByteArray> memoryCache; // cost in kB
+};
+
+#endif /* MANDELBULBER2_SRC_NETRENDER_TEXTURE_CACHE_HPP_ */
@@ -286,6 +286,34 @@ cNineFractals::cNineFractals(const cFractalContainer *par, const cParameterConta
 			useAdditionalBailoutCond[0] = true;
 		}
 	}
+
+	SelectSingleFormulaLoop();
+}
+
+void cNineFractals::SelectSingleFormulaLoop()
+{
+	singleFormulaLoop = fractal::singleFormulaLoopNone;
+
+	// only for single formula which doesn't need any special treatment in main iteration loop
+	if (isHybrid || isBoolean) return;
+	if (!fractalFormulaFunctions[0] || useAdditionalBailoutCond[0]) return;
+
+	switch (fractals[0]->formula)
+	{
+		case fractal::none:
+		case fractal::aboxMod1:
+		case fractal::amazingSurf:
+		case fractal::scatorPower2:
+		case fractal::scatorPower2Real:
+		case fractal::scatorPower2Imaginary:
+		case fractal::testingLog:
+		case fractal::pseudoKleinianStdDE: return;
+
+		case fractal::mandelbulb: singleFormulaLoop = fractal::singleFormulaLoopMandelbulb; break;
+		case fractal::mandelbox: singleFormulaLoop = fractal::singleFormulaLoopMandelbox; break;
+		case fractal::mengerSponge: singleFormulaLoop = fractal::singleFormulaLoopMengerSponge; break;
+		default: singleFormulaLoop = fractal::singleFormulaLoopGeneric; break;
+	}
 }
 
 void cNineFractals::CreateSequence(const cParameterContainer *generalPar)
@@ -94,6 +94,10 @@ public:
 		return coloringFunction[formulaIndex];
 	}
 
+	inline fractal::enumSingleFormulaLoop GetSingleFormulaLoop() const { return singleFormulaLoop; }
+	// forces general iteration loop (used for benchmarking)
+	void DisableSingleFormulaLoop() { singleFormulaLoop = fractal::singleFormulaLoopNone; }
+
 	static int GetIndexOnFractalList(fractal::enumFractalFormula formula);
 
 #ifdef USE_OPENCL
@@ -129,8 +133,10 @@ private:
 	double initialWAxis[NUMBER_OF_FRACTALS];
 	bool useAdditionalBailoutCond[NUMBER_OF_FRACTALS];
 	fractalFormulaFcn fractalFormulaFunctions[NUMBER_OF_FRACTALS];
+	fractal::enumSingleFormulaLoop singleFormulaLoop;
 
 	void CreateSequence(const cParameterContainer *generalPar);
+	void SelectSingleFormulaLoop();
 };
 
 #endif /* MANDELBULBER2_SRC_NINE_FRACTALS_HPP_ */
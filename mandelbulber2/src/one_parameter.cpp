@@ -136,7 +136,6 @@ template <class T>
 T cOneParameter::Get(enumValueSelection selection) const
 {
 	T val = T();
-	actualVal.Get(val);
 
 	switch (selection)
 	{
@@ -161,6 +160,14 @@ bool cOneParameter::isDefaultValue() const
 	return (actualVal == defaultVal);
 }
 
+bool cOneParameter::IsEqual(const cOneParameter &other) const
+{
+	if (isEmpty || other.isEmpty) return isEmpty == other.isEmpty;
+	if (GetValueType() != other.GetValueType()) return false;
+	if (morphType != other.morphType || parType != other.parType) return false;
+	return actualVal == other.actualVal && defaultVal == other.defaultVal;
+}
+
 cMultiVal cOneParameter::GetMultiVal(enumValueSelection selection) const
 {
 	switch (selection)
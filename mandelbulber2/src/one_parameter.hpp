@@ -86,6 +86,7 @@ public:
 	void SetMorphType(enumMorphType _morphType) { morphType = _morphType; }
 	void SetOriginalContainerName(const QString &containerName) { originalContainer = containerName; }
 	bool isDefaultValue() const;
+	bool IsEqual(const cOneParameter &other) const;
 	cMultiVal GetMultiVal(enumValueSelection selection) const;
 	void SetMultiVal(cMultiVal multi, enumValueSelection selection);
 	bool IsEmpty() const { return isEmpty; }
@@ -152,7 +152,7 @@ bool cOpenClEngineRenderDOF::RenderDOF(const sParamRender *paramRender,
 	// sorting z-buffer
 	emit updateProgressAndStatus(QObject::tr("OpenCL DOF"), QObject::tr("Sorting Z-Buffer"), 0.0);
 
-	cPostRenderingDOF::QuickSortZBuffer(tempSort, 1, numberOfPixels - 1);
+	cPostRenderingDOF::SortZBuffer(tempSort, numberOfPixels);
 
 	for (int pass = 0; pass < numberOfPasses; pass++)
 	{
@@ -44,31 +44,144 @@
 
 using namespace parameterContainer;
 
+cParameterNames &cParameterNames::Instance()
+{
+	static cParameterNames registry;
+	return registry;
+}
+
+int cParameterNames::registerName(const QString &name)
+{
+	// lock has to be already locked for write
+	QHash<QString, int>::const_iterator it = handles.constFind(name);
+	if (it != handles.constEnd()) return it.value();
+
+	int handle = names.size();
+	names.append(name);
+	handles.insert(name, handle);
+	return handle;
+}
+
+int cParameterNames::Handle(const QString &name)
+{
+	int handle = FindHandle(name);
+	if (handle >= 0) return handle;
+
+	cParameterNames &registry = Instance();
+	QWriteLocker lock(&registry.lock);
+	return registry.registerName(name);
+}
+
+int cParameterNames::Handle(const QString &name, int index)
+{
+	int handle = FindHandle(name, index);
+	if (handle >= 0) return handle;
+
+	cParameterNames &registry = Instance();
+	QWriteLocker lock(&registry.lock);
+	int baseHandle = registry.registerName(name);
+	handle = registry.registerName(name + "_" + QString::number(index));
+	registry.indexedHandles.insert(qMakePair(baseHandle, index), handle);
+	return handle;
+}
+
+int cParameterNames::FindHandle(const QString &name)
+{
+	cParameterNames &registry = Instance();
+	QReadLocker lock(&registry.lock);
+	return registry.handles.value(name, -1);
+}
+
+int cParameterNames::FindHandle(const QString &name, int index)
+{
+	cParameterNames &registry = Instance();
+	{
+		QReadLocker lock(&registry.lock);
+		int baseHandle = registry.handles.value(name, -1);
+		if (baseHandle >= 0)
+		{
+			int handle = registry.indexedHandles.value(qMakePair(baseHandle, index), -1);
+			if (handle >= 0) return handle;
+		}
+	}
+
+	// name could be registered without index (e.g. loaded from settings file)
+	int handle = FindHandle(name + "_" + QString::number(index));
+	if (handle >= 0)
+	{
+		QWriteLocker lock(&registry.lock);
+		int baseHandle = registry.registerName(name);
+		registry.indexedHandles.insert(qMakePair(baseHandle, index), handle);
+	}
+	return handle;
+}
+
+QString cParameterNames::Name(int handle)
+{
+	cParameterNames &registry = Instance();
+	QReadLocker lock(&registry.lock);
+	return registry.names.value(handle);
+}
+
+QVector<sParameterHandle> cParameterContainer::Handles(const QString &name, int count)
+{
+	QVector<sParameterHandle> list;
+	list.reserve(count);
+	for (int i = 0; i < count; i++)
+		list.append(Handle(name, i));
+	return list;
+}
+
 cParameterContainer::cParameterContainer()
 {
-	myMap.clear();
+	values.clear();
 }
 
 cParameterContainer::~cParameterContainer()
 {
-	myMap.clear();
+	values.clear();
 }
 
 cParameterContainer &cParameterContainer::operator=(const cParameterContainer &par)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
-	myMap = par.myMap;
+	values = par.values;
+	handles = par.handles;
+	slots = par.slots;
 	containerName = par.containerName;
 	return *this;
 }
 
+void cParameterContainer::insertSlot(int handle, const cOneParameter &parameter)
+{
+	slots.insert(handle, values.size());
+	values.append(parameter);
+	handles.append(handle);
+}
+
+void cParameterContainer::removeSlot(int slot)
+{
+	// last parameter is moved into the freed slot
+	int last = values.size() - 1;
+	slots.remove(handles.at(slot));
+	if (slot != last)
+	{
+		cOneParameter lastValue = values.at(last);
+		values[slot] = lastValue;
+		handles[slot] = handles.at(last);
+		slots.insert(handles.at(slot), slot);
+	}
+	values.removeLast();
+	handles.removeLast();
+}
+
 // defining of params without limits
 template <class T>
 void cParameterContainer::addParam(QString name, T defaultVal, enumMorphType morphType,
 	enumParameterType parType, QStringList enumLookup)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
 	cOneParameter newRecord;
 	newRecord.Set(defaultVal, valueDefault);
@@ -78,13 +191,14 @@ void cParameterContainer::addParam(QString name, T defaultVal, enumMorphType mor
 	newRecord.SetOriginalContainerName(containerName);
 	newRecord.SetEnumLookup(enumLookup);
 
-	if (myMap.find(name) != myMap.end())
+	int handle = cParameterNames::Handle(name);
+	if (slots.contains(handle))
 	{
 		qWarning() << "addParam(): element '" << name << "' already existed" << endl;
 	}
 	else
 	{
-		myMap.insert(name, newRecord);
+		insertSlot(handle, newRecord);
 	}
 }
 template void cParameterContainer::addParam<double>(QString name, double defaultVal,
@@ -109,7 +223,7 @@ template <class T>
 void cParameterContainer::addParam(QString name, T defaultVal, T minVal, T maxVal,
 	enumMorphType morphType, enumParameterType parType)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
 	cOneParameter newRecord;
 	newRecord.Set(defaultVal, valueDefault);
@@ -120,13 +234,14 @@ void cParameterContainer::addParam(QString name, T defaultVal, T minVal, T maxVa
 	newRecord.SetParameterType(parType);
 	newRecord.SetOriginalContainerName(containerName);
 
-	if (myMap.find(name) != myMap.end())
+	int handle = cParameterNames::Handle(name);
+	if (slots.contains(handle))
 	{
 		qWarning() << "addParam(): element '" << name << "' already existed" << endl;
 	}
 	else
 	{
-		myMap.insert(name, newRecord);
+		insertSlot(handle, newRecord);
 	}
 }
 template void cParameterContainer::addParam<double>(QString name, double defaultVal, double minVal,
@@ -145,7 +260,7 @@ template <class T>
 void cParameterContainer::addParam(QString name, int index, T defaultVal, enumMorphType morphType,
 	enumParameterType parType, QStringList enumLookup)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
 	if (index >= 0)
 	{
@@ -157,14 +272,15 @@ void cParameterContainer::addParam(QString name, int index, T defaultVal, enumMo
 		newRecord.SetOriginalContainerName(containerName);
 		newRecord.SetEnumLookup(enumLookup);
 
-		QString indexName = nameWithIndex(&name, index);
-		if (myMap.find(indexName) != myMap.end())
+		int handle = cParameterNames::Handle(name, index);
+		if (slots.contains(handle))
 		{
-			qWarning() << "addParam(): element '" << indexName << "' already existed" << endl;
+			qWarning() << "addParam(): element '" << cParameterNames::Name(handle) << "' already existed"
+								 << endl;
 		}
 		else
 		{
-			myMap.insert(indexName, newRecord);
+			insertSlot(handle, newRecord);
 		}
 	}
 	else
@@ -193,7 +309,7 @@ template <class T>
 void cParameterContainer::addParam(QString name, int index, T defaultVal, T minVal, T maxVal,
 	enumMorphType morphType, enumParameterType parType)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
 	if (index >= 0)
 	{
@@ -206,14 +322,15 @@ void cParameterContainer::addParam(QString name, int index, T defaultVal, T minV
 		newRecord.SetParameterType(parType);
 		newRecord.SetOriginalContainerName(containerName);
 
-		QString indexName = nameWithIndex(&name, index);
-		if (myMap.find(indexName) != myMap.end())
+		int handle = cParameterNames::Handle(name, index);
+		if (slots.contains(handle))
 		{
-			qWarning() << "addParam(): element '" << indexName << "' already existed" << endl;
+			qWarning() << "addParam(): element '" << cParameterNames::Name(handle) << "' already existed"
+								 << endl;
 		}
 		else
 		{
-			myMap.insert(indexName, newRecord);
+			insertSlot(handle, newRecord);
 		}
 	}
 	else
@@ -237,13 +354,12 @@ template void cParameterContainer::addParam<sRGB>(QString name, int index, sRGB
 template <class T>
 void cParameterContainer::Set(QString name, T val)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
-	QMap<QString, cOneParameter>::iterator it;
-	it = myMap.find(name);
-	if (it != myMap.end())
+	int slot = findSlot(name);
+	if (slot >= 0)
 	{
-		it->Set(val, valueActual);
+		values[slot].Set(val, valueActual);
 	}
 	else
 	{
@@ -263,20 +379,18 @@ template void cParameterContainer::Set<cColorPalette>(QString name, cColorPalett
 template <class T>
 void cParameterContainer::Set(QString name, int index, T val)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
 	if (index >= 0)
 	{
-		QString indexName = nameWithIndex(&name, index);
-		QMap<QString, cOneParameter>::iterator it;
-		it = myMap.find(indexName);
-		if (it != myMap.end())
+		int slot = findSlot(name, index);
+		if (slot >= 0)
 		{
-			it->Set(val, valueActual);
+			values[slot].Set(val, valueActual);
 		}
 		else
 		{
-			qWarning() << "Set(): element '" << indexName << "' doesn't exists" << endl;
+			qWarning() << "Set(): element '" << name << "_" << index << "' doesn't exists" << endl;
 		}
 	}
 	else
@@ -296,14 +410,13 @@ template void cParameterContainer::Set<bool>(QString name, int index, bool val);
 template <class T>
 T cParameterContainer::Get(QString name) const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
-	QMap<QString, cOneParameter>::const_iterator it;
-	it = myMap.find(name);
+	int slot = findSlot(name);
 	T val = T();
-	if (it != myMap.end())
+	if (slot >= 0)
 	{
-		val = it.value().Get<T>(valueActual);
+		val = values.at(slot).Get<T>(valueActual);
 	}
 	else
 	{
@@ -324,21 +437,19 @@ template cColorPalette cParameterContainer::Get<cColorPalette>(QString name) con
 template <class T>
 T cParameterContainer::Get(QString name, int index) const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
 	T val = T();
 	if (index >= 0)
 	{
-		QString indexName = nameWithIndex(&name, index);
-		QMap<QString, cOneParameter>::const_iterator it;
-		it = myMap.find(indexName);
-		if (it != myMap.end())
+		int slot = findSlot(name, index);
+		if (slot >= 0)
 		{
-			val = it.value().Get<T>(valueActual);
+			val = values.at(slot).Get<T>(valueActual);
 		}
 		else
 		{
-			qWarning() << "Get(): element '" << indexName << "' doesn't exists" << endl;
+			qWarning() << "Get(): element '" << name << "_" << index << "' doesn't exists" << endl;
 		}
 	}
 	else
@@ -359,14 +470,13 @@ template bool cParameterContainer::Get<bool>(QString name, int index) const;
 template <class T>
 T cParameterContainer::GetDefault(QString name) const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
-	QMap<QString, cOneParameter>::const_iterator it;
-	it = myMap.find(name);
+	int slot = findSlot(name);
 	T val = T();
-	if (it != myMap.end())
+	if (slot >= 0)
 	{
-		val = it.value().Get<T>(valueDefault);
+		val = values.at(slot).Get<T>(valueDefault);
 	}
 	else
 	{
@@ -387,21 +497,19 @@ template cColorPalette cParameterContainer::GetDefault<cColorPalette>(QString na
 template <class T>
 T cParameterContainer::GetDefault(QString name, int index) const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
 	T val = T();
 	if (index >= 0)
 	{
-		QString indexName = nameWithIndex(&name, index);
-		QMap<QString, cOneParameter>::const_iterator it;
-		it = myMap.find(indexName);
-		if (it != myMap.end())
+		int slot = findSlot(name, index);
+		if (slot >= 0)
 		{
-			val = it.value().Get<T>(valueDefault);
+			val = values.at(slot).Get<T>(valueDefault);
 		}
 		else
 		{
-			qWarning() << "GetDefault(): element '" << indexName << "' doesn't exists" << endl;
+			qWarning() << "GetDefault(): element '" << name << "_" << index << "' doesn't exists" << endl;
 		}
 	}
 	else
@@ -419,25 +527,76 @@ template CVector4 cParameterContainer::GetDefault<CVector4>(QString name, int in
 template sRGB cParameterContainer::GetDefault<sRGB>(QString name, int index) const;
 template bool cParameterContainer::GetDefault<bool>(QString name, int index) const;
 
-QString cParameterContainer::nameWithIndex(QString *str, int index)
+// set parameter value by handle
+template <class T>
+void cParameterContainer::Set(const sParameterHandle &handle, T val)
 {
-	QString name = *str + "_" + QString::number(index);
-	return name;
+	QWriteLocker lock(&m_lock);
+
+	int slot = slots.value(handle.id, -1);
+	if (slot >= 0)
+	{
+		values[slot].Set(val, valueActual);
+	}
+	else
+	{
+		qWarning() << "Set(): element '" << cParameterNames::Name(handle.id) << "' doesn't exists"
+							 << endl;
+	}
 }
+template void cParameterContainer::Set<double>(const sParameterHandle &handle, double val);
+template void cParameterContainer::Set<int>(const sParameterHandle &handle, int val);
+template void cParameterContainer::Set<QString>(const sParameterHandle &handle, QString val);
+template void cParameterContainer::Set<CVector3>(const sParameterHandle &handle, CVector3 val);
+template void cParameterContainer::Set<CVector4>(const sParameterHandle &handle, CVector4 val);
+template void cParameterContainer::Set<sRGB>(const sParameterHandle &handle, sRGB val);
+template void cParameterContainer::Set<bool>(const sParameterHandle &handle, bool val);
+template void cParameterContainer::Set<cColorPalette>(
+	const sParameterHandle &handle, cColorPalette val);
+
+// get parameter value by handle
+template <class T>
+T cParameterContainer::Get(const sParameterHandle &handle) const
+{
+	QReadLocker lock(&m_lock);
+
+	int slot = slots.value(handle.id, -1);
+	T val = T();
+	if (slot >= 0)
+	{
+		val = values.at(slot).Get<T>(valueActual);
+	}
+	else
+	{
+		qWarning() << "Get(): element '" << cParameterNames::Name(handle.id) << "' doesn't exists"
+							 << endl;
+	}
+	return val;
+}
+template double cParameterContainer::Get<double>(const sParameterHandle &handle) const;
+template int cParameterContainer::Get<int>(const sParameterHandle &handle) const;
+template QString cParameterContainer::Get<QString>(const sParameterHandle &handle) const;
+template CVector3 cParameterContainer::Get<CVector3>(const sParameterHandle &handle) const;
+template CVector4 cParameterContainer::Get<CVector4>(const sParameterHandle &handle) const;
+template sRGB cParameterContainer::Get<sRGB>(const sParameterHandle &handle) const;
+template bool cParameterContainer::Get<bool>(const sParameterHandle &handle) const;
+template cColorPalette cParameterContainer::Get<cColorPalette>(
+	const sParameterHandle &handle) const;
 
 void cParameterContainer::Copy(QString name, const cParameterContainer *sourceContainer)
 {
-	QMutexLocker lock(&m_lock);
+	if (sourceContainer == this) return;
+
+	QWriteLocker lock(&m_lock);
 
-	QMap<QString, cOneParameter>::const_iterator itSource;
-	QMap<QString, cOneParameter>::iterator itDest;
-	itDest = myMap.find(name);
-	if (itDest != myMap.end())
+	int slotDest = findSlot(name);
+	if (slotDest >= 0)
 	{
-		itSource = sourceContainer->myMap.find(name);
-		if (itSource != myMap.end())
+		QReadLocker lockSource(&sourceContainer->m_lock);
+		int slotSource = sourceContainer->findSlot(name);
+		if (slotSource >= 0)
 		{
-			itDest.value() = itSource.value();
+			values[slotDest] = sourceContainer->values.at(slotSource);
 		}
 		else
 		{
@@ -452,9 +611,12 @@ void cParameterContainer::Copy(QString name, const cParameterContainer *sourceCo
 
 QList<QString> cParameterContainer::GetListOfParameters() const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
-	QList<QString> list = myMap.keys();
+	QList<QString> list;
+	list.reserve(handles.size());
+	for (int handle : handles)
+		list.append(cParameterNames::Name(handle));
 	std::sort(list.begin(), list.end(), compareStrings);
 	return list;
 }
@@ -475,15 +637,14 @@ void cParameterContainer::PrintListOfParameters() const
 
 enumVarType cParameterContainer::GetVarType(QString name) const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
 	enumVarType type = typeNull;
 
-	QMap<QString, cOneParameter>::const_iterator it;
-	it = myMap.find(name);
-	if (it != myMap.end())
+	int slot = findSlot(name);
+	if (slot >= 0)
 	{
-		type = it.value().GetValueType();
+		type = values.at(slot).GetValueType();
 	}
 	else
 	{
@@ -494,15 +655,14 @@ enumVarType cParameterContainer::GetVarType(QString name) const
 
 enumParameterType cParameterContainer::GetParameterType(QString name) const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
 	enumParameterType type = paramStandard;
 
-	QMap<QString, cOneParameter>::const_iterator it;
-	it = myMap.find(name);
-	if (it != myMap.end())
+	int slot = findSlot(name);
+	if (slot >= 0)
 	{
-		type = it.value().GetParameterType();
+		type = values.at(slot).GetParameterType();
 	}
 	else
 	{
@@ -513,15 +673,14 @@ enumParameterType cParameterContainer::GetParameterType(QString name) const
 
 bool cParameterContainer::isDefaultValue(QString name) const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
 	bool isDefault = true;
 
-	QMap<QString, cOneParameter>::const_iterator it;
-	it = myMap.find(name);
-	if (it != myMap.end())
+	int slot = findSlot(name);
+	if (slot >= 0)
 	{
-		isDefault = it.value().isDefaultValue();
+		isDefault = values.at(slot).isDefaultValue();
 	}
 	else
 	{
@@ -533,58 +692,119 @@ bool cParameterContainer::isDefaultValue(QString name) const
 
 void cParameterContainer::ResetAllToDefault()
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
-	QMap<QString, cOneParameter>::iterator it = myMap.begin();
-	while (it != myMap.end())
+	for (cOneParameter &record : values)
 	{
-		cOneParameter record = it.value();
 		if (record.GetParameterType() != paramApp)
-			it.value().SetMultiVal(record.GetMultiVal(valueDefault), valueActual);
-		++it;
+			record.SetMultiVal(record.GetMultiVal(valueDefault), valueActual);
 	}
 }
 
 bool cParameterContainer::IfExists(const QString &name) const
 {
-	QMap<QString, cOneParameter>::const_iterator it;
-	it = myMap.find(name);
-	if (it != myMap.end())
+	QReadLocker lock(&m_lock);
+
+	return findSlot(name) >= 0;
+}
+
+void cParameterContainer::DeleteParameter(const QString &name)
+{
+	QWriteLocker lock(&m_lock);
+
+	int slot = findSlot(name);
+	if (slot >= 0)
 	{
-		return true;
+		removeSlot(slot);
 	}
 	else
 	{
-		return false;
+		qWarning() << "DeleteParameter(): element '" << name << "' doesn't exists" << endl;
 	}
 }
 
-void cParameterContainer::DeleteParameter(const QString &name)
+void cParameterContainer::GetDifferences(const cParameterContainer &other,
+	QMap<QString, cOneParameter> *thisValues, QMap<QString, cOneParameter> *otherValues) const
 {
-	QMutexLocker lock(&m_lock);
+	if (&other == this) return;
+
+	QReadLocker lock(&m_lock);
+	QReadLocker lockOther(&other.m_lock);
 
-	QMap<QString, cOneParameter>::iterator it;
-	it = myMap.find(name);
-	if (it != myMap.end())
+	// unmodified copies share the data
+	if (values.isSharedWith(other.values) && handles.isSharedWith(other.handles)) return;
+
+	for (int slot = 0; slot < values.size(); slot++)
 	{
-		myMap.remove(name);
+		int otherSlot = other.slots.value(handles.at(slot), -1);
+		if (otherSlot < 0)
+		{
+			// removed parameter
+			QString name = cParameterNames::Name(handles.at(slot));
+			thisValues->insert(name, values.at(slot));
+			otherValues->insert(name, cOneParameter());
+		}
+		else if (!values.at(slot).IsEqual(other.values.at(otherSlot)))
+		{
+			QString name = cParameterNames::Name(handles.at(slot));
+			thisValues->insert(name, values.at(slot));
+			otherValues->insert(name, other.values.at(otherSlot));
+		}
 	}
-	else
+
+	for (int otherSlot = 0; otherSlot < other.values.size(); otherSlot++)
 	{
-		qWarning() << "DeleteParameter(): element '" << name << "' doesn't exists" << endl;
+		if (!slots.contains(other.handles.at(otherSlot)))
+		{
+			// added parameter
+			QString name = cParameterNames::Name(other.handles.at(otherSlot));
+			thisValues->insert(name, cOneParameter());
+			otherValues->insert(name, other.values.at(otherSlot));
+		}
+	}
+}
+
+bool cParameterContainer::IsEqual(const cParameterContainer &other) const
+{
+	QMap<QString, cOneParameter> thisValues;
+	QMap<QString, cOneParameter> otherValues;
+	GetDifferences(other, &thisValues, &otherValues);
+	return thisValues.isEmpty();
+}
+
+void cParameterContainer::ApplyParameters(const QMap<QString, cOneParameter> &parameters)
+{
+	QWriteLocker lock(&m_lock);
+
+	for (QMap<QString, cOneParameter>::const_iterator it = parameters.constBegin();
+			 it != parameters.constEnd(); ++it)
+	{
+		int handle = cParameterNames::Handle(it.key());
+		int slot = slots.value(handle, -1);
+		if (it.value().IsEmpty())
+		{
+			if (slot >= 0) removeSlot(slot);
+		}
+		else if (slot >= 0)
+		{
+			values[slot] = it.value();
+		}
+		else
+		{
+			insertSlot(handle, it.value());
+		}
 	}
 }
 
 cOneParameter cParameterContainer::GetAsOneParameter(QString name) const
 {
-	QMutexLocker lock(&m_lock);
+	QReadLocker lock(&m_lock);
 
-	QMap<QString, cOneParameter>::const_iterator it;
-	it = myMap.find(name);
+	int slot = findSlot(name);
 	cOneParameter val;
-	if (it != myMap.end())
+	if (slot >= 0)
 	{
-		val = it.value();
+		val = values.at(slot);
 	}
 	else
 	{
@@ -596,13 +816,12 @@ cOneParameter cParameterContainer::GetAsOneParameter(QString name) const
 
 void cParameterContainer::SetFromOneParameter(QString name, const cOneParameter &parameter)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
-	QMap<QString, cOneParameter>::iterator it;
-	it = myMap.find(name);
-	if (it != myMap.end())
+	int slot = findSlot(name);
+	if (slot >= 0)
 	{
-		it.value() = parameter;
+		values[slot] = parameter;
 	}
 	else
 	{
@@ -614,9 +833,10 @@ void cParameterContainer::SetFromOneParameter(QString name, const cOneParameter
 
 void cParameterContainer::AddParamFromOneParameter(QString name, const cOneParameter &parameter)
 {
-	QMutexLocker lock(&m_lock);
+	QWriteLocker lock(&m_lock);
 
-	if (myMap.find(name) != myMap.end())
+	int handle = cParameterNames::Handle(name);
+	if (slots.contains(handle))
 	{
 		qWarning() << "cParameterContainer::AddParamFromOneParameter(QString name, const cOneParameter "
 									"&parameter): element '"
@@ -624,6 +844,6 @@ void cParameterContainer::AddParamFromOneParameter(QString name, const cOneParam
 	}
 	else
 	{
-		myMap.insert(name, parameter);
+		insertSlot(handle, parameter);
 	}
 }
@@ -40,13 +40,50 @@
 #include "one_parameter.hpp"
 
 using namespace parameterContainer;
+
+// interned parameter name
+struct sParameterHandle
+{
+	sParameterHandle() : id(-1) {}
+	explicit sParameterHandle(int _id) : id(_id) {}
+	bool IsValid() const { return id >= 0; }
+	int id;
+};
+
+// registry of all parameter names used by containers. Names are interned once into integer
+// handles, so containers find parameters by handle instead of comparing strings
+class cParameterNames
+{
+public:
+	// handle of name, registers the name if it is new
+	static int Handle(const QString &name);
+	static int Handle(const QString &name, int index);
+	// handle of already registered name, -1 if the name is unknown
+	static int FindHandle(const QString &name);
+	static int FindHandle(const QString &name, int index);
+	static QString Name(int handle);
+
+private:
+	static cParameterNames &Instance();
+	int registerName(const QString &name);
+
+	QHash<QString, int> handles;
+	// handles of indexed names (handle of base name, index)
+	QHash<QPair<int, int>, int> indexedHandles;
+	QVector<QString> names;
+	QReadWriteLock lock;
+};
+
 class cParameterContainer
 {
 public:
 	cParameterContainer();
 
 	cParameterContainer(const cParameterContainer &par)
-			: myMap(par.myMap), containerName(par.containerName)
+			: values(par.values),
+				handles(par.handles),
+				slots(par.slots),
+				containerName(par.containerName)
 	{
 	}
 
@@ -81,6 +118,22 @@ public:
 	template <class T>
 	T GetDefault(QString name, int index) const;
 
+	// handles for repeated access to the same parameter without name lookups
+	static sParameterHandle Handle(const QString &name)
+	{
+		return sParameterHandle(cParameterNames::Handle(name));
+	}
+	static sParameterHandle Handle(const QString &name, int index)
+	{
+		return sParameterHandle(cParameterNames::Handle(name, index));
+	}
+	// handles of indexed parameter for indexes [0, count)
+	static QVector<sParameterHandle> Handles(const QString &name, int count);
+	template <class T>
+	void Set(const sParameterHandle &handle, T val);
+	template <class T>
+	T Get(const sParameterHandle &handle) const;
+
 	cOneParameter GetAsOneParameter(QString name) const;
 	void SetFromOneParameter(QString name, const cOneParameter &parameter);
 	void AddParamFromOneParameter(QString name, const cOneParameter &parameter);
@@ -96,20 +149,58 @@ public:
 	QString GetContainerName() const { return containerName; }
 	bool IfExists(const QString &name) const;
 	void DeleteParameter(const QString &name);
+	// parameters which differ in other container, with values from both containers.
+	// Empty parameter means that the parameter doesn't exist in the container
+	void GetDifferences(const cParameterContainer &other, QMap<QString, cOneParameter> *thisValues,
+		QMap<QString, cOneParameter> *otherValues) const;
+	bool IsEqual(const cParameterContainer &other) const;
+	// sets parameters from the list, adds missing ones and deletes those stored as empty
+	void ApplyParameters(const QMap<QString, cOneParameter> &parameters);
 
 private:
-	static QString nameWithIndex(QString *str, int index);
+	// slot in values array, -1 if the parameter doesn't exist
+	int findSlot(const QString &name) const
+	{
+		return slots.value(cParameterNames::FindHandle(name), -1);
+	}
+	int findSlot(const QString &name, int index) const
+	{
+		return slots.value(cParameterNames::FindHandle(name, index), -1);
+	}
+	void insertSlot(int handle, const cOneParameter &parameter);
+	void removeSlot(int slot);
 
 	static bool compareStrings(const QString &p1, const QString &p2)
 	{
 		return QString::compare(p1, p2, Qt::CaseInsensitive) < 0;
 	}
 
-	// std::map container
-	QMap<QString, cOneParameter> myMap;
+	// flat array of parameters, with handles of their names
+	QVector<cOneParameter> values;
+	QVector<int> handles;
+	// slots in values array for name handles
+	QHash<int, int> slots;
 	QString containerName;
 
-	mutable QMutex m_lock;
+	// parameters can be read in parallel
+	mutable QReadWriteLock m_lock;
 };
 
+// handle of parameter cached in a static variable at the call site. Used where parameter
+// structures are built repeatedly, so names are interned only once. Arguments as for Get()
+#define PARAMETER_HANDLE(...)                                                                      \
+	([]() -> const sParameterHandle & {                                                              \
+		static const sParameterHandle handle = cParameterContainer::Handle(__VA_ARGS__);               \
+		return handle;                                                                                 \
+	}())
+
+// cached handle of indexed parameter where index changes at the call site (e.g. in loop).
+// Index has to be in range [0, count)
+#define PARAMETER_HANDLE_INDEXED(name, index, count)                                               \
+	([](int i) -> const sParameterHandle & {                                                         \
+		static const QVector<sParameterHandle> handles =                                               \
+			cParameterContainer::Handles(name, count);                                                   \
+		return handles.at(i);                                                                          \
+	}(index))
+
 #endif /* MANDELBULBER2_SRC_PARAMETERS_HPP_ */
@@ -0,0 +1,92 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cPixelRandom - stateless counter-based random number generator for rendering
+ *
+ * Every random number is a hash (PCG) of the key and a counter. The key is made from
+ * pixel coordinates, sample number and frame number, so the numbers used for a pixel
+ * don't depend on which thread renders the pixel, on the number of threads or on
+ * the computer in NetRender. Rendering of the same scene gives always the same noise.
+ */
+
+#ifndef MANDELBULBER2_SRC_PIXEL_RANDOM_HPP_
+#define MANDELBULBER2_SRC_PIXEL_RANDOM_HPP_
+
+#include <QtGlobal>
+
+class cPixelRandom
+{
+public:
+	cPixelRandom() : key(0), counter(0) {}
+
+	// starts new sequence of random numbers for given pixel, sample and frame
+	inline void SetKey(int x, int y, int sample, int frame)
+	{
+		key = Hash(quint32(x) + Hash(quint32(y) + Hash(quint32(sample) + Hash(quint32(frame)))));
+		counter = 0;
+	}
+
+	// random integer number from 0 to max (including max), the same range as Random(int max)
+	inline int Random(int max) { return int(NextUInt() % quint32(max + 1)); }
+
+	// random double number from 0.0 to 1.0 (excluding 1.0)
+	inline double RandomDouble() { return NextUInt() * (1.0 / 4294967296.0); }
+
+	// fills array with count random numbers from 0.0 to 1.0. Numbers are independent of each
+	// other, so the loop can be vectorized
+	inline void RandomBatch(double *out, int count)
+	{
+		const quint32 batchKey = key;
+		const quint32 firstCounter = counter;
+#pragma omp simd
+		for (int i = 0; i < count; i++)
+		{
+			out[i] = Hash(batchKey + Hash(firstCounter + quint32(i))) * (1.0 / 4294967296.0);
+		}
+		counter += quint32(count);
+	}
+
+	// PCG-RXS-M-XS hash of 32-bit number
+	static inline quint32 Hash(quint32 value)
+	{
+		quint32 state = value * 747796405u + 2891336453u;
+		quint32 word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+		return (word >> 22u) ^ word;
+	}
+
+private:
+	inline quint32 NextUInt() { return Hash(key + Hash(counter++)); }
+
+	quint32 key;
+	quint32 counter;
+};
+
+#endif /* MANDELBULBER2_SRC_PIXEL_RANDOM_HPP_ */
@@ -45,6 +45,8 @@ cPostEffectHdrBlur::cPostEffectHdrBlur(cImage *_image) : QObject(), image(_image
 	tempImage = new sRGBFloat[image->GetHeight() * image->GetWidth()];
 	radius = 0;
 	intensity = 0;
+	frameWidth = image->GetWidth();
+	frameHeight = image->GetHeight();
 }
 
 cPostEffectHdrBlur::~cPostEffectHdrBlur()
@@ -58,7 +60,7 @@ void cPostEffectHdrBlur::Render(bool *stopRequest)
 	memcpy(tempImage, image->GetPostImageFloatPtr(),
 		image->GetHeight() * image->GetWidth() * sizeof(sRGBFloat));
 
-	const double blurSize = radius * (image->GetWidth() + image->GetHeight()) * 0.001;
+	const double blurSize = radius * (frameWidth + frameHeight) * 0.001;
 	const double blurSize2 = blurSize * blurSize;
 	const int intBlurSize = blurSize + 1;
 	const double limiter = intensity;
@@ -137,3 +139,9 @@ void cPostEffectHdrBlur::SetParameters(double _radius, double _intensity)
 	radius = _radius;
 	intensity = _intensity;
 }
+
+void cPostEffectHdrBlur::SetFrameSize(int width, int height)
+{
+	frameWidth = width;
+	frameHeight = height;
+}
@@ -48,6 +48,8 @@ public:
 	cPostEffectHdrBlur(cImage *_image);
 	~cPostEffectHdrBlur() override;
 	void SetParameters(double _radius, double _intensity);
+	// blur radius is relative to the size of the whole frame (image can contain only a tile of it)
+	void SetFrameSize(int width, int height);
 
 	void Render(bool *stopRequest);
 
@@ -55,6 +57,8 @@ public:
 	sRGBFloat *tempImage;
 	double radius;
 	double intensity;
+	int frameWidth;
+	int frameHeight;
 
 signals:
 	void updateProgressAndStatus(const QString &text, const QString &progressText, double progress);
@@ -34,9 +34,13 @@
 
 #include "primitives.h"
 
+#include <algorithm>
+#include <numeric>
+
 #include <QtAlgorithms>
 
 #include "displacement_map.hpp"
+#include "material.h"
 #include "parameters.hpp"
 #include "system.hpp"
 
@@ -255,8 +259,11 @@ cPrimitives::cPrimitives(const cParameterContainer *par, QVector<cObjectData> *o
 			primitive->objectId = objectData->size() - 1;
 		}
 		allPrimitives.append(primitive);
+		if (primitive->enable) AddToArrays(primitive, par);
 	}
 
+	BuildPrimitivesBvh();
+
 	allPrimitivesPosition = par->Get<CVector3>("all_primitives_position");
 	allPrimitivesRotation = par->Get<CVector3>("all_primitives_rotation");
 	mRotAllPrimitivesRotation.SetRotation2(allPrimitivesRotation / 180.0 * M_PI);
@@ -269,6 +276,179 @@ cPrimitives::~cPrimitives()
 	qDeleteAll(allPrimitives);
 }
 
+bool cPrimitives::GetBound(
+	const sPrimitiveBasic *primitive, const cParameterContainer *par, sPrimitiveBound *bound)
+{
+	// bounds come from triangle inequality for every distance function. Components of point are
+	// not smaller than its length / sqrt(3), or / sqrt(2) for two components
+	bound->center = primitive->position;
+	bound->scale = 1.0;
+	switch (primitive->objectType)
+	{
+		case objBox:
+		{
+			const sPrimitiveBox *box = static_cast<const sPrimitiveBox *>(primitive);
+			if (box->repeat.Length() > 0.0) return false;
+			CVector3 halfSize = box->size.Abs() * 0.5;
+			if (box->empty)
+			{
+				bound->scale = 1.0 / sqrt(3.0);
+				bound->radius = sqrt(3.0) * max(halfSize.x, max(halfSize.y, halfSize.z));
+			}
+			else
+			{
+				bound->radius = halfSize.Length() + max(box->rounding, 0.0);
+			}
+			break;
+		}
+		case objSphere:
+		{
+			const sPrimitiveSphere *sphere = static_cast<const sPrimitiveSphere *>(primitive);
+			if (sphere->repeat.Length() > 0.0) return false;
+			bound->radius = sphere->radius;
+			break;
+		}
+		case objCylinder:
+		{
+			const sPrimitiveCylinder *cylinder = static_cast<const sPrimitiveCylinder *>(primitive);
+			if (cylinder->repeat.Length() > 0.0) return false;
+			bound->scale = 1.0 / M_SQRT2;
+			bound->radius = M_SQRT2 * max(fabs(cylinder->height) * 0.5, fabs(cylinder->radius));
+			break;
+		}
+		case objCircle:
+		{
+			const sPrimitiveCircle *circle = static_cast<const sPrimitiveCircle *>(primitive);
+			bound->scale = 1.0 / M_SQRT2;
+			bound->radius = M_SQRT2 * fabs(circle->radius);
+			break;
+		}
+		case objRectangle:
+		{
+			const sPrimitiveRectangle *rectangle = static_cast<const sPrimitiveRectangle *>(primitive);
+			bound->radius = CVector2<double>(rectangle->width, rectangle->height).Length() * 0.5;
+			break;
+		}
+		default:
+			// planes and water are infinite, cones and toruses are not bounded yet
+			return false;
+	}
+
+	// displacement map can move the surface towards the point
+	bound->margin = 0.0;
+	QString useDisplacement = cMaterial::Name("use_displacement_texture", primitive->materialId);
+	if (par->IfExists(useDisplacement) && par->Get<bool>(useDisplacement))
+	{
+		bound->margin = max(0.0,
+			par->Get<double>(cMaterial::Name("displacement_texture_height", primitive->materialId)));
+	}
+	return true;
+}
+
+void cPrimitives::AddToArrays(const sPrimitiveBasic *primitive, const cParameterContainer *par)
+{
+	sPrimitiveEntry entry;
+	entry.type = primitive->objectType;
+	entry.objectId = primitive->objectId;
+	switch (primitive->objectType)
+	{
+		case objPlane:
+			entry.index = planes.size();
+			planes.append(*static_cast<const sPrimitivePlane *>(primitive));
+			break;
+		case objBox:
+			entry.index = boxes.size();
+			boxes.append(*static_cast<const sPrimitiveBox *>(primitive));
+			break;
+		case objSphere:
+			entry.index = spheres.size();
+			spheres.append(*static_cast<const sPrimitiveSphere *>(primitive));
+			break;
+		case objWater:
+			// water depends on distance to other primitives, so it is evaluated separately at the end
+			waters.append(*static_cast<const sPrimitiveWater *>(primitive));
+			return;
+		case objCone:
+			entry.index = cones.size();
+			cones.append(*static_cast<const sPrimitiveCone *>(primitive));
+			break;
+		case objCylinder:
+			entry.index = cylinders.size();
+			cylinders.append(*static_cast<const sPrimitiveCylinder *>(primitive));
+			break;
+		case objTorus:
+			entry.index = toruses.size();
+			toruses.append(*static_cast<const sPrimitiveTorus *>(primitive));
+			break;
+		case objCircle:
+			entry.index = circles.size();
+			circles.append(*static_cast<const sPrimitiveCircle *>(primitive));
+			break;
+		case objRectangle:
+			entry.index = rectangles.size();
+			rectangles.append(*static_cast<const sPrimitiveRectangle *>(primitive));
+			break;
+		default: return;
+	}
+
+	sPrimitiveBound bound;
+	if (GetBound(primitive, par, &bound))
+	{
+		boundedPrimitives.append(entry);
+		bounds.append(bound);
+	}
+	else
+	{
+		unboundedPrimitives.append(entry);
+	}
+}
+
+void cPrimitives::BuildPrimitivesBvh()
+{
+	const int maxPrimitivesInLeaf = 2;
+
+	bvhNodes.clear();
+	if (boundedPrimitives.isEmpty()) return;
+
+	QVector<int> order(boundedPrimitives.size());
+	std::iota(order.begin(), order.end(), 0);
+
+	// sphere enclosing spheres of all primitives of the node
+	auto makeBound = [&](int first, int count, CVector3 minCorner, CVector3 maxCorner) {
+		sPrimitiveBound nodeBound;
+		nodeBound.center = (minCorner + maxCorner) * 0.5;
+		nodeBound.radius = 0.0;
+		nodeBound.scale = 1.0;
+		nodeBound.margin = 0.0;
+		for (int i = first; i < first + count; i++)
+		{
+			const sPrimitiveBound &bound = bounds.at(order.at(i));
+			nodeBound.radius =
+				max(nodeBound.radius, (bound.center - nodeBound.center).Length() + bound.radius);
+			nodeBound.scale = min(nodeBound.scale, bound.scale);
+			nodeBound.margin = max(nodeBound.margin, bound.margin);
+		}
+		return nodeBound;
+	};
+
+	BuildBvh(&bvhNodes, &order, 0, order.size(), maxPrimitivesInLeaf,
+		[&](int i) { return bounds.at(i).center; }, [&](int i) { return bounds.at(i).radius; },
+		makeBound);
+
+	// leaves point to consecutive ranges of arrays
+	QVector<sPrimitiveEntry> sortedPrimitives;
+	QVector<sPrimitiveBound> sortedBounds;
+	sortedPrimitives.reserve(order.size());
+	sortedBounds.reserve(order.size());
+	for (int i : order)
+	{
+		sortedPrimitives.append(boundedPrimitives.at(i));
+		sortedBounds.append(bounds.at(i));
+	}
+	boundedPrimitives = sortedPrimitives;
+	bounds = sortedBounds;
+}
+
 double sPrimitivePlane::PrimitiveDistance(CVector3 _point) const
 {
 	CVector3 point = _point - position;
@@ -431,6 +611,34 @@ double sPrimitiveTorus::PrimitiveDistance(CVector3 _point) const
 	return empty ? fabs(dist) : dist;
 }
 
+inline double cPrimitives::PrimitiveDistance(const sPrimitiveEntry &entry, CVector3 point) const
+{
+	switch (entry.type)
+	{
+		case objPlane: return planes[entry.index].PrimitiveDistance(point);
+		case objBox: return boxes[entry.index].PrimitiveDistance(point);
+		case objSphere: return spheres[entry.index].PrimitiveDistance(point);
+		case objCone: return cones[entry.index].PrimitiveDistance(point);
+		case objCylinder: return cylinders[entry.index].PrimitiveDistance(point);
+		case objTorus: return toruses[entry.index].PrimitiveDistance(point);
+		case objCircle: return circles[entry.index].PrimitiveDistance(point);
+		case objRectangle: return rectangles[entry.index].PrimitiveDistance(point);
+		default: return 1e20;
+	}
+}
+
+inline void cPrimitives::EvaluatePrimitive(const sPrimitiveEntry &entry, CVector3 point,
+	sRenderData *data, double *distance, int *closestObject) const
+{
+	double distTemp = PrimitiveDistance(entry, point);
+	distTemp = DisplacementMap(distTemp, point, entry.objectId, data);
+	if (distTemp < *distance)
+	{
+		*closestObject = entry.objectId;
+		*distance = distTemp;
+	}
+}
+
 double cPrimitives::TotalDistance(
 	CVector3 point, double fractalDistance, int *closestObjectId, sRenderData *data) const
 {
@@ -443,29 +651,32 @@ double cPrimitives::TotalDistance(
 		CVector3 point2 = point - allPrimitivesPosition;
 		point2 = mRotAllPrimitivesRotation.RotateVector(point2);
 
-		for (auto primitive : allPrimitives)
+		for (const sPrimitiveEntry &entry : unboundedPrimitives)
 		{
-			if (primitive->enable)
+			EvaluatePrimitive(entry, point2, data, &distance, &closestObject);
+		}
+
+		// primitives which cannot be closer than already found distance are skipped
+		auto isFarther = [&distance](double boundDistance) {
+			return boundDistance > 0.0 && boundDistance >= distance;
+		};
+		TraverseBvh(bvhNodes, point2, isFarther, [&](int first, int count) {
+			for (int i = first; i < first + count; i++)
 			{
-				sPrimitiveWater *water = dynamic_cast<sPrimitiveWater *>(primitive);
-				double distTemp;
-				if (water)
-				{
-					distTemp = water->PrimitiveDistanceWater(point2, distance);
-				}
-				else
-				{
-					distTemp = primitive->PrimitiveDistance(point2);
-				}
-				distTemp = DisplacementMap(distTemp, point2, primitive->objectId, data);
-				if (distTemp < distance)
-				{
-					closestObject = primitive->objectId;
-					// color = plane.color;
-					// reflect = plane.reflect;
-				}
-				distance = min(distance, distTemp);
+				if (isFarther(bounds[i].Distance(point2))) continue;
+				EvaluatePrimitive(boundedPrimitives[i], point2, data, &distance, &closestObject);
+			}
+		});
+
+		for (const sPrimitiveWater &water : waters)
+		{
+			double distTemp = water.PrimitiveDistanceWater(point2, distance);
+			distTemp = DisplacementMap(distTemp, point2, water.objectId, data);
+			if (distTemp < distance)
+			{
+				closestObject = water.objectId;
 			}
+			distance = min(distance, distTemp);
 		}
 
 	} // if is any primitive
@@ -39,6 +39,7 @@
 
 #include "QtCore"
 #include "algebra.hpp"
+#include "bvh.hpp"
 #include "color_structures.hpp"
 #include "object_data.hpp"
 #include "object_types.hpp"
@@ -64,13 +65,12 @@ struct sPrimitiveBasic : cObjectData
 	bool enable;
 	int objectId;
 	virtual ~sPrimitiveBasic() = default;
-	virtual double PrimitiveDistance(CVector3 _point) const = 0;
 };
 
 struct sPrimitivePlane : sPrimitiveBasic
 {
 	bool empty;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
 };
 
 struct sPrimitiveBox : sPrimitiveBasic
@@ -78,7 +78,7 @@ struct sPrimitiveBox : sPrimitiveBasic
 	bool empty;
 	double rounding;
 	CVector3 repeat;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
 };
 
 struct sPrimitiveSphere : sPrimitiveBasic
@@ -86,7 +86,7 @@ struct sPrimitiveSphere : sPrimitiveBasic
 	bool empty;
 	double radius;
 	CVector3 repeat;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
 };
 
 struct sPrimitiveWater : sPrimitiveBasic
@@ -99,7 +99,7 @@ struct sPrimitiveWater : sPrimitiveBasic
 	double waveFromObjectsRelativeAmplitude;
 	int iterations;
 	int animFrame;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
 	double PrimitiveDistanceWater(CVector3 _point, double distanceFromAnother) const;
 };
 
@@ -111,7 +111,7 @@ struct sPrimitiveCone : sPrimitiveBasic
 	double height;
 	CVector2<double> wallNormal;
 	CVector3 repeat;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
 };
 
 struct sPrimitiveCylinder : sPrimitiveBasic
@@ -121,7 +121,7 @@ struct sPrimitiveCylinder : sPrimitiveBasic
 	double radius;
 	double height;
 	CVector3 repeat;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
 };
 
 struct sPrimitiveTorus : sPrimitiveBasic
@@ -132,20 +132,42 @@ struct sPrimitiveTorus : sPrimitiveBasic
 	double tubeRadius;
 	double tubeRadiusLPow;
 	CVector3 repeat;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
 };
 
 struct sPrimitiveCircle : sPrimitiveBasic
 {
 	double radius;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
 };
 
 struct sPrimitiveRectangle : sPrimitiveBasic
 {
 	double height;
 	double width;
-	double PrimitiveDistance(CVector3 _point) const override;
+	double PrimitiveDistance(CVector3 _point) const;
+};
+
+// sphere bounding primitive with displacement. Distance estimated for the primitive is not smaller
+// than scale * (distance from center - radius) - margin
+struct sPrimitiveBound
+{
+	CVector3 center;
+	double radius;
+	double scale;
+	double margin;
+	double Distance(CVector3 point) const
+	{
+		return scale * ((point - center).Length() - radius) - margin;
+	}
+};
+
+// primitive in arrays of its type
+struct sPrimitiveEntry
+{
+	fractal::enumObjectType type;
+	int index;
+	int objectId;
 };
 
 QString PrimitiveNames(fractal::enumObjectType primitiveType);
@@ -169,8 +191,34 @@ public:
 	CRotationMatrix mRotAllPrimitivesRotation;
 
 private:
+	static bool GetBound(const sPrimitiveBasic *primitive, const cParameterContainer *par,
+		sPrimitiveBound *bound);
+	void AddToArrays(const sPrimitiveBasic *primitive, const cParameterContainer *par);
+	void BuildPrimitivesBvh();
+	double PrimitiveDistance(const sPrimitiveEntry &entry, CVector3 point) const;
+	void EvaluatePrimitive(const sPrimitiveEntry &entry, CVector3 point, sRenderData *data,
+		double *distance, int *closestObject) const;
+
 	QList<sPrimitiveBasic *> allPrimitives;
 
+	// enabled primitives grouped by type for evaluation without virtual calls
+	QVector<sPrimitivePlane> planes;
+	QVector<sPrimitiveBox> boxes;
+	QVector<sPrimitiveSphere> spheres;
+	QVector<sPrimitiveWater> waters;
+	QVector<sPrimitiveCone> cones;
+	QVector<sPrimitiveCylinder> cylinders;
+	QVector<sPrimitiveTorus> toruses;
+	QVector<sPrimitiveCircle> circles;
+	QVector<sPrimitiveRectangle> rectangles;
+
+	// infinite or repeated primitives, which are evaluated always
+	QVector<sPrimitiveEntry> unboundedPrimitives;
+	// finite primitives in order of leaves of bounding volume hierarchy
+	QVector<sPrimitiveEntry> boundedPrimitives;
+	QVector<sPrimitiveBound> bounds;
+	QVector<sBvhNode<sPrimitiveBound>> bvhNodes;
+
 	static double Plane(CVector3 point, CVector3 position, CVector3 normal)
 	{
 		return (normal.Dot(point - position));
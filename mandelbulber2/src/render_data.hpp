@@ -35,6 +35,8 @@
 #ifndef MANDELBULBER2_SRC_RENDER_DATA_HPP_
 #define MANDELBULBER2_SRC_RENDER_DATA_HPP_
 
+#include <QMutex>
+
 #include "lights.hpp"
 #include "material.h"
 #include "object_data.hpp"
@@ -59,19 +61,41 @@ struct sTextures
 	};
 };
 
+// object with its material. One cache line holds two of them
+struct alignas(32) sRenderObject
+{
+	const cObjectData *object;
+	const cMaterial *material;
+	bool displacementMap; // material has loaded displacement texture
+	bool fractalizedTexture; // texture coordinates are fractalized
+};
+
 struct sRenderData
 {
-	sRenderData() : rendererID(0), stopRequest(nullptr), lastPercentage(1.0), reduceDetail(1.0) {}
+	sRenderData()
+			: rendererID(0),
+				stopRequest(nullptr),
+				lastPercentage(1.0),
+				reduceDetail(1.0),
+				tiledRendering(false),
+				anyDisplacementMap(false),
+				anyFractalizedTexture(false)
+	{
+	}
 
 	int rendererID;
 	cRegion<int> screenRegion;
 	cRegion<double> imageRegion;
+	// in tiled rendering the image buffer contains only one tile of the whole frame
+	bool tiledRendering;
+	CVector2<int> tileOffset; // position of the tile in the whole frame
 	sTextures textures;
 	cLights lights;
 	bool *stopRequest;
 	double lastPercentage;
 	double reduceDetail;
 	cStatistics statistics;
+	QMutex statisticsMutex; // rendering threads merge their own statistics into 'statistics'
 	QList<int> netRenderStartingPositions;
 	cRenderingConfiguration configuration;
 
@@ -79,6 +103,12 @@ struct sRenderData
 	QVector<cObjectData> objectData;
 	cStereo stereo;
 
+	// objects indexed by object ID, built by ValidateObjects(). Materials and objects mustn't be
+	// modified while rendering
+	QVector<sRenderObject> objects;
+	bool anyDisplacementMap;
+	bool anyFractalizedTexture;
+
 	void ValidateObjects()
 	{
 		for (cObjectData &object : objectData)
@@ -103,6 +133,25 @@ struct sRenderData
 				object.materialId = substituteMaterialId;
 			}
 		}
+
+		BuildObjectTable();
+	}
+
+	void BuildObjectTable()
+	{
+		objects.resize(objectData.size());
+		anyDisplacementMap = false;
+		anyFractalizedTexture = false;
+		for (int i = 0; i < objectData.size(); i++)
+		{
+			sRenderObject &entry = objects[i];
+			entry.object = &objectData.at(i);
+			entry.material = &materials.constFind(objectData.at(i).materialId).value();
+			entry.displacementMap = entry.material->displacementTexture.IsLoaded();
+			entry.fractalizedTexture = entry.material->textureFractalize;
+			anyDisplacementMap |= entry.displacementMap;
+			anyFractalizedTexture |= entry.fractalizedTexture;
+		}
 	}
 };
 
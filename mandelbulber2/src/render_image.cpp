@@ -49,6 +49,7 @@
 #include "render_data.hpp"
 #include "render_ssao.h"
 #include "render_worker.hpp"
+#include "render_worker_pool.hpp"
 #include "scheduler.hpp"
 #include "stereo.h"
 #include "system.hpp"
@@ -92,10 +93,8 @@ bool cRenderer::RenderImage()
 		if (progressive == 0) progressive = 1;
 
 		// prepare multiple threads
-		QThread **thread = new QThread *[data->configuration.GetNumberOfThreads()];
 		cRenderWorker::sThreadData *threadData =
 			new cRenderWorker::sThreadData[data->configuration.GetNumberOfThreads()];
-		cRenderWorker **worker = new cRenderWorker *[data->configuration.GetNumberOfThreads()];
 
 		if (scheduler) delete scheduler;
 		scheduler = new cScheduler(data->screenRegion, progressive);
@@ -128,6 +127,19 @@ bool cRenderer::RenderImage()
 			threadData[i].scheduler = scheduler;
 		}
 
+		QVector<int> threadStartLines;
+		for (int i = 0; i < data->configuration.GetNumberOfThreads(); i++)
+			threadStartLines.append(threadData[i].startLine);
+		scheduler->InitThreadRanges(threadStartLines);
+
+		// workers are created once and run by threads of the worker pool in every progressive pass
+		QList<cRenderWorker *> workers;
+		for (int i = 0; i < data->configuration.GetNumberOfThreads(); i++)
+		{
+			workers.append(new cRenderWorker(params, fractal, &threadData[i], data, image));
+		}
+		cRenderWorkerPool::sJob job;
+
 		QString statusText;
 		QString progressTxt;
 
@@ -145,21 +157,8 @@ bool cRenderer::RenderImage()
 		{
 			WriteLogDouble("Progressive loop", scheduler->GetProgressiveStep(), 2);
 
-			for (int i = 0; i < data->configuration.GetNumberOfThreads(); i++)
-			{
-				WriteLog(QString("Thread ") + QString::number(i) + " create", 3);
-				thread[i] = new QThread;
-				worker[i] = new cRenderWorker(
-					params, fractal, &threadData[i], data, image); // Warning! not needed to delete object
-				worker[i]->moveToThread(thread[i]);
-				QObject::connect(thread[i], SIGNAL(started()), worker[i], SLOT(doWork()));
-				QObject::connect(worker[i], SIGNAL(finished()), thread[i], SLOT(quit()));
-				QObject::connect(worker[i], SIGNAL(finished()), worker[i], SLOT(deleteLater()));
-				thread[i]->setObjectName("RenderWorker #" + QString::number(i));
-				thread[i]->start();
-				thread[i]->setPriority(GetQThreadPriority(systemData.threadsPriority));
-				WriteLog(QString("Thread ") + QString::number(i) + " started", 3);
-			}
+			gRenderWorkerPool->Start(&job, workers, GetQThreadPriority(systemData.threadsPriority));
+			WriteLog(QString("Started ") + QString::number(workers.size()) + " render workers", 3);
 
 			while (!scheduler->AllLinesDone())
 			{
@@ -170,8 +169,7 @@ bool cRenderer::RenderImage()
 				{
 					scheduler->Stop();
 
-					image->CompileImage();
-					image->ConvertTo8bit();
+					image->CompileImageAndConvertTo8bit();
 					if (data->configuration.UseImageRefresh())
 					{
 						image->SetFastPreview(true);
@@ -180,7 +178,9 @@ bool cRenderer::RenderImage()
 					}
 				}
 
-				Wait(10); // wait 10ms
+				// wait max 10ms. Wakes up immediately when workers are finished. With NetRender lines
+				// can be still rendered by other computers when local workers are already finished
+				if (gRenderWorkerPool->WaitForJob(&job, 10) && !scheduler->AllLinesDone()) Wait(10);
 
 				if (data->configuration.UseRefreshRenderedList())
 				{
@@ -200,7 +200,7 @@ bool cRenderer::RenderImage()
 				if (timerProgressRefresh.elapsed() > 1000)
 				{
 					emit updateProgressAndStatus(statusText, progressTxt, percentDone);
-					emit updateStatistics(data->statistics);
+					emit updateStatistics(GetStatistics());
 					timerProgressRefresh.restart();
 				}
 
@@ -213,7 +213,7 @@ bool cRenderer::RenderImage()
 						timerRefresh.restart();
 
 						emit updateProgressAndStatus(statusText, progressTxt, percentDone);
-						emit updateStatistics(data->statistics);
+						emit updateStatistics(GetStatistics());
 
 						QSet<int> set_listToRefresh = listToRefresh.toSet(); // removing duplicates
 						listToRefresh = set_listToRefresh.toList();
@@ -233,9 +233,7 @@ bool cRenderer::RenderImage()
 							}
 						}
 
-						image->CompileImage(&listToRefresh);
-
-						image->ConvertTo8bit();
+						image->CompileImageAndConvertTo8bit(&listToRefresh);
 
 						if (data->configuration.UseImageRefresh())
 						{
@@ -307,17 +305,16 @@ bool cRenderer::RenderImage()
 				}		// isPreview
 			}			// while scheduler
 
-			for (int i = 0; i < data->configuration.GetNumberOfThreads(); i++)
+			while (!gRenderWorkerPool->WaitForJob(&job, 10))
 			{
-				while (thread[i]->isRunning())
-				{
-					gApplication->processEvents();
-				};
-				WriteLog(QString("Thread ") + QString::number(i) + " finished", 2);
-				delete thread[i];
+				gApplication->processEvents();
 			}
+			WriteLog("Render workers finished", 2);
 		} while (scheduler->ProgressiveNextStep());
 
+		qDeleteAll(workers);
+		workers.clear();
+
 		// send last rendered lines
 		if (data->configuration.UseNetRender() && gNetRender->IsClient()
 				&& gNetRender->GetStatus() == CNetRender::netRender_WORKING)
@@ -395,27 +392,27 @@ bool cRenderer::RenderImage()
 					this, SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)));
 				connect(&dof, SIGNAL(updateImage()), this, SIGNAL(updateImage()));
 
+				// blur size is relative to the whole frame, also when only a tile is rendered
+				double dofRadius =
+					params->DOFRadius * (params->imageWidth + params->imageHeight) / 2000.0;
+
 				if (data->stereo.isEnabled() && (data->stereo.GetMode() == cStereo::stereoLeftRight
 																					|| data->stereo.GetMode() == cStereo::stereoTopBottom))
 				{
 					cRegion<int> region;
 					region = data->stereo.GetRegion(
 						CVector2<int>(image->GetWidth(), image->GetHeight()), cStereo::eyeLeft);
-					dof.Render(region, params->DOFRadius * (image->GetWidth() + image->GetHeight()) / 2000.0,
-						params->DOFFocus, params->DOFNumberOfPasses, params->DOFBlurOpacity,
-						params->DOFMaxRadius, data->stopRequest);
+					dof.Render(region, dofRadius, params->DOFFocus, params->DOFNumberOfPasses,
+						params->DOFBlurOpacity, params->DOFMaxRadius, data->stopRequest);
 					region = data->stereo.GetRegion(
 						CVector2<int>(image->GetWidth(), image->GetHeight()), cStereo::eyeRight);
-					dof.Render(region, params->DOFRadius * (image->GetWidth() + image->GetHeight()) / 2000.0,
-						params->DOFFocus, params->DOFNumberOfPasses, params->DOFBlurOpacity,
-						params->DOFMaxRadius, data->stopRequest);
+					dof.Render(region, dofRadius, params->DOFFocus, params->DOFNumberOfPasses,
+						params->DOFBlurOpacity, params->DOFMaxRadius, data->stopRequest);
 				}
 				else
 				{
-					dof.Render(data->screenRegion,
-						params->DOFRadius * (image->GetWidth() + image->GetHeight()) / 2000.0, params->DOFFocus,
-						params->DOFNumberOfPasses, params->DOFBlurOpacity, params->DOFMaxRadius,
-						data->stopRequest);
+					dof.Render(data->screenRegion, dofRadius, params->DOFFocus, params->DOFNumberOfPasses,
+						params->DOFBlurOpacity, params->DOFMaxRadius, data->stopRequest);
 				}
 			}
 
@@ -423,6 +420,7 @@ bool cRenderer::RenderImage()
 			{
 				cPostEffectHdrBlur *hdrBlur = new cPostEffectHdrBlur(image);
 				hdrBlur->SetParameters(params->hdrBlurRadius, params->hdrBlurIntensity);
+				hdrBlur->SetFrameSize(params->imageWidth, params->imageHeight);
 				connect(hdrBlur, SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)),
 					this, SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)));
 				hdrBlur->Render(data->stopRequest);
@@ -455,7 +453,7 @@ bool cRenderer::RenderImage()
 
 		// update histograms
 		data->statistics.time = progressText.getTime();
-		emit updateStatistics(data->statistics);
+		emit updateStatistics(GetStatistics());
 		emit updateProgressAndStatus(statusText, progressTxt, percentDone);
 
 		if (data->configuration.UseNetRender())
@@ -467,9 +465,7 @@ bool cRenderer::RenderImage()
 			}
 		}
 
-		delete[] thread;
 		delete[] threadData;
-		delete[] worker;
 
 		WriteLog("cRenderer::RenderImage(): memory released", 2);
 
@@ -485,13 +481,22 @@ bool cRenderer::RenderImage()
 	}
 }
 
+// copy of statistics which are concurrently updated by rendering threads
+cStatistics cRenderer::GetStatistics() const
+{
+	QMutexLocker lock(&data->statisticsMutex);
+	return data->statistics;
+}
+
 void cRenderer::CreateLineData(int y, QByteArray *lineData) const
 {
 	if (y >= 0 && y < image->GetHeight())
 	{
 		int width = image->GetWidth();
-		sAllImageData *lineOfImage = new sAllImageData[width];
 		size_t dataSize = sizeof(sAllImageData) * width;
+		// line is written directly into the output buffer
+		lineData->fill(0, CastSizeToInt(dataSize));
+		sAllImageData *lineOfImage = reinterpret_cast<sAllImageData *>(lineData->data());
 		for (int x = 0; x < width; x++)
 		{
 			lineOfImage[x].imageFloat = image->GetPixelImage(x, y);
@@ -504,8 +509,6 @@ void cRenderer::CreateLineData(int y, QByteArray *lineData) const
 			if (image->GetImageOptional()->optionalSpecular)
 				lineOfImage[x].normalSpecular = image->GetPixelSpecular(x, y);
 		}
-		lineData->append(reinterpret_cast<char *>(lineOfImage), CastSizeToInt(dataSize));
-		delete[] lineOfImage;
 	}
 	else
 	{
@@ -518,7 +521,8 @@ void cRenderer::NewLinesArrived(QList<int> lineNumbers, QList<QByteArray> lines)
 	for (int i = 0; i < lineNumbers.size(); i++)
 	{
 		int y = lineNumbers.at(i);
-		if (y >= 0 && y < image->GetHeight())
+		if (y >= 0 && y < image->GetHeight()
+				&& size_t(lines.at(i).size()) >= sizeof(sAllImageData) * image->GetWidth())
 		{
 			sAllImageData *lineOfImage = (sAllImageData *)lines.at(i).data();
 			int width = image->GetWidth();
@@ -538,8 +542,8 @@ void cRenderer::NewLinesArrived(QList<int> lineNumbers, QList<QByteArray> lines)
 		else
 		{
 			qCritical() << "cRenderer::NewLinesArrived(QList<int> lineNumbers, QList<QByteArray> lines): "
-										 "wrong line number:"
-									<< y;
+										 "wrong line number or size:"
+									<< y << lines.at(i).size();
 			return;
 		}
 	}
@@ -57,6 +57,7 @@ public:
 
 private:
 	void CreateLineData(int y, QByteArray *lineData) const;
+	cStatistics GetStatistics() const;
 
 	const sParamRender *params;
 	const cNineFractals *fractal;
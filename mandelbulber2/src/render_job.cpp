@@ -94,6 +94,7 @@ cRenderJob::cRenderJob(const cParameterContainer *_params, const cFractalContain
 	totalNumberOfCPUs = systemData.numberOfThreads;
 	renderData = nullptr;
 	useSizeFromImage = false;
+	useTile = false;
 	stopRequest = _stopRequest;
 
 	id++;
@@ -146,9 +147,17 @@ bool cRenderJob::Init(enumMode _mode, const cRenderingConfiguration &config)
 		paramsContainer->Set("image_height", height);
 	}
 
+	// image_width and image_height still describe the whole frame, only the buffer is smaller
+	if (useTile)
+	{
+		width = tile.width;
+		height = tile.height;
+	}
+
 	sImageOptional imageOptional;
 	imageOptional.optionalNormal = paramsContainer->Get<bool>("normal_enabled");
 	imageOptional.optionalSpecular = paramsContainer->Get<bool>("specular_enabled");
+	imageOptional.optionalHalfFloat = paramsContainer->Get<bool>("optional_layers_half_float");
 
 	emit updateProgressAndStatus(
 		QObject::tr("Initialization"), QObject::tr("Setting up image buffers"), 0.0);
@@ -227,7 +236,7 @@ bool cRenderJob::InitImage(int w, int h, const sImageOptional &optional)
 			emit SetMinimumWidgetSize(image->GetPreviewWidth(), image->GetPreviewHeight());
 		}
 
-		// qDebug() << "Memory for image: " << image->GetUsedMB() << " MB" << endl;
+		WriteLog(image->GetMemoryReport(), 2);
 		return true;
 	}
 }
@@ -252,7 +261,21 @@ void cRenderJob::PrepareData(const cRenderingConfiguration &config)
 
 	// renderData->screenRegion.Set(width*0.15, height*0.15, width*0.85, height*0.85);
 	renderData->screenRegion.Set(0, 0, width, height);
-	// TODO to correct resolution and aspect ratio according to region data
+
+	// only a part of the frame is rendered. Resolution and aspect ratio are taken from the
+	// frame size (image_width, image_height)
+	if (useTile)
+	{
+		cRegion<int> frameRegion(0, 0, paramsContainer->Get<int>("image_width"),
+			paramsContainer->Get<int>("image_height"));
+		CVector2<double> corner1 =
+			frameRegion.transpose(renderData->imageRegion, CVector2<int>(tile.x1, tile.y1));
+		CVector2<double> corner2 =
+			frameRegion.transpose(renderData->imageRegion, CVector2<int>(tile.x2, tile.y2));
+		renderData->imageRegion.Set(corner1.x, corner1.y, corner2.x, corner2.y);
+		renderData->tiledRendering = true;
+		renderData->tileOffset = CVector2<int>(tile.x1, tile.y1);
+	}
 
 	// textures are deleted with destruction of renderData
 
@@ -261,7 +284,7 @@ void cRenderJob::PrepareData(const cRenderingConfiguration &config)
 
 	int frameNo = paramsContainer->Get<int>("frame_no");
 
-	if (gNetRender->IsClient() && renderData->configuration.UseNetRender())
+	if (renderData->configuration.UseNetRenderTextures())
 	{
 		// get received textures from NetRender buffer
 		if (paramsContainer->Get<bool>("textured_background"))
@@ -447,12 +470,15 @@ bool cRenderJob::Execute()
 			renderData->ValidateObjects();
 
 			// recalculation of some parameters;
-			params->resolution = 1.0 / image->GetHeight();
+			params->resolution = 1.0 / params->imageHeight;
 			ReduceDetail();
 
 			// initialize histograms
 			renderData->statistics.histogramIterations.Resize(paramsContainer->Get<int>("N"));
 			renderData->statistics.histogramStepCount.Resize(1000);
+			const int antiAliasingSize = paramsContainer->Get<int>("antialiasing_size");
+			renderData->statistics.histogramAntiAliasingSamples.Resize(
+				antiAliasingSize * antiAliasingSize);
 			renderData->statistics.Reset();
 			renderData->statistics.usedDEType = fractals->GetDETypeString();
 
@@ -669,6 +695,7 @@ bool cRenderJob::Execute()
 	inProgress = false;
 
 	WriteLog("cRenderJob::Execute(void): finished", 2);
+	WriteLog(image->GetMemoryReport(), 2);
 
 	image->ReleaseImage();
 
@@ -693,7 +720,12 @@ void cRenderJob::UpdateParameters(
 	*paramsContainer = *_params;
 	*fractalContainer = *_fractal;
 
-	if (renderData->stereo.isEnabled() && !gNetRender->IsClient())
+	if (useSizeFromImage)
+	{
+		paramsContainer->Set("image_width", image->GetWidth());
+		paramsContainer->Set("image_height", image->GetHeight());
+	}
+	else if (renderData->stereo.isEnabled() && !gNetRender->IsClient())
 	{
 		paramsContainer->Set("image_width", width);
 		paramsContainer->Set("image_height", height);
@@ -44,6 +44,7 @@
 #include "camera_target.hpp"
 #include "fractal_container.hpp"
 #include "parameters.hpp"
+#include "region.hpp"
 #include "statistics.h"
 
 // forward declarations
@@ -75,12 +76,20 @@ public:
 	cImage *GetImagePtr() const { return image; }
 	int GetNumberOfCPUs() const { return totalNumberOfCPUs; }
 	void UseSizeFromImage(bool modeInput) { useSizeFromImage = modeInput; }
+	// renders only given part of the frame (in pixels of the whole image). Has to be called
+	// before Init(). Stereo and OpenCL rendering are not supported in this mode
+	void SetTile(const cRegion<int> &_tile)
+	{
+		tile = _tile;
+		useTile = true;
+	}
 	void ChangeCameraTargetPosition(cCameraTarget &cameraTarget) const;
 
 	void UpdateParameters(const cParameterContainer *_params, const cFractalContainer *_fractal);
 	void UpdateConfig(const cRenderingConfiguration &config) const;
 	static int GetRunningJobCount() { return runningJobs; }
 	cStatistics GetStatistics() const;
+	QStringList CreateListOfUsedTextures() const;
 
 public slots:
 	void slotExecute();
@@ -89,12 +98,13 @@ private:
 	bool InitImage(int w, int h, const sImageOptional &optional);
 	void PrepareData(const cRenderingConfiguration &config);
 	void ReduceDetail() const;
-	QStringList CreateListOfUsedTextures() const;
 
 	bool hasQWidget;
 	bool inProgress;
 	bool ready;
 	bool useSizeFromImage;
+	bool useTile;
+	cRegion<int> tile;
 	cImage *image;
 	cFractalContainer *fractalContainer;
 	cParameterContainer *paramsContainer;
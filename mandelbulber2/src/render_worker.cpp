@@ -34,6 +34,8 @@
 
 #include "render_worker.hpp"
 
+#include <algorithm>
+
 #include <QtCore>
 
 #include "ao_modes.h"
@@ -70,6 +72,9 @@ cRenderWorker::cRenderWorker(const sParamRender *_params, const cNineFractals *_
 	baseY = CVector3(0.0, 1.0, 0.0);
 	baseZ = CVector3(0.0, 0.0, 1.0);
 	maxRaymarchingSteps = 10000;
+	stepBufferNeeded = false;
+	prepared = false;
+	threadStatistics = new cStatistics;
 	reflectionsMax = 0;
 	actualHue = 0.0;
 	stopRequest = false;
@@ -99,6 +104,8 @@ cRenderWorker::~cRenderWorker()
 	}
 
 	if (rayStack) delete[] rayStack;
+
+	delete threadStatistics;
 }
 
 // main render engine function called as multiple threads
@@ -106,8 +113,10 @@ void cRenderWorker::doWork()
 {
 	// here will be rendering thread
 	int width = image->GetWidth();
-	int height = image->GetHeight();
-	double aspectRatio = double(width) / height;
+	// size of the whole frame (in tiled rendering the image buffer contains only a tile of it)
+	int frameWidth = params->imageWidth;
+	int frameHeight = params->imageHeight;
+	double aspectRatio = double(frameWidth) / frameHeight;
 
 	if (params->perspectiveType == params::perspEquirectangular) aspectRatio = 2.0;
 
@@ -115,32 +124,84 @@ void cRenderWorker::doWork()
 	bool antiAliasing = params->antialiasingEnabled;
 	int antiAliasingSize = params->antialiasingSize;
 
+	// adaptive anti-aliasing: two samples in opposite corners of the pixel are rendered first.
+	// Remaining samples are rendered only if there is a high contrast or an edge
+	bool adaptiveAntiAliasing = antiAliasing && params->antialiasingAdaptive && !monteCarlo
+															&& !data->stereo.isEnabled() && antiAliasingSize > 1;
+	const int lastAntiAliasingSample = antiAliasingSize * antiAliasingSize - 1;
+	sAntiAliasingSample previousPixelSample;
+	// first samples of the actual line and of the line above, to detect edges between lines
+	std::vector<sAntiAliasingSample> lineSamples;
+	std::vector<sAntiAliasingSample> lineAboveSamples;
+	int lineOfSamples = -1; // line stored in lineAboveSamples
+	if (adaptiveAntiAliasing)
+	{
+		lineSamples.resize(width);
+		lineAboveSamples.resize(width);
+	}
+
 	if (data->stereo.isEnabled() && (params->perspectiveType != params::perspEquirectangular))
 		aspectRatio = data->stereo.ModifyAspectRatio(aspectRatio);
 
-	PrepareMainVectors();
-	PrepareReflectionBuffer();
-	if (params->ambientOcclusionEnabled && params->ambientOcclusionMode == params::AOModeMultipleRays)
-		PrepareAOVectors();
+	// the same worker is used for all progressive passes, so everything is prepared only once
+	if (!prepared)
+	{
+		PrepareMainVectors();
+		PrepareReflectionBuffer();
+
+		// histograms of the thread have to be the same size as global ones
+		threadStatistics->histogramIterations.Resize(data->statistics.histogramIterations.GetSize());
+		threadStatistics->histogramStepCount.Resize(data->statistics.histogramStepCount.GetSize());
+		threadStatistics->histogramAntiAliasingSamples.Resize(
+			data->statistics.histogramAntiAliasingSamples.GetSize());
+		if (params->ambientOcclusionEnabled
+				&& params->ambientOcclusionMode == params::AOModeMultipleRays)
+			PrepareAOVectors();
+
+		prepared = true;
+	}
 
 	// init of scheduler
 	cScheduler *scheduler = threadData->scheduler;
 
+	// neighbouring primary rays are marched together as a cone until it touches the surface.
+	// Not possible when rays don't start from the same point or when steps are needed for
+	// volumetric effects. Cone bound is derived only for linear (three-point) projection
+	bool packetMode = params->rayPacketsEnabled && !monteCarlo && !data->stereo.isEnabled()
+										&& params->perspectiveType == params::perspThreePoint
+										&& !IsVolumetricShaderEnabled();
+	int packetEnd = -1;
+	double packetMinScan = 0.0;
+
 	// start point for ray-marching
 	CVector3 start = params->camera;
 
-	scheduler->InitFirstLine(threadData->id, threadData->startLine);
-
 	bool lastLineWasBroken = false;
 
 	// main loop for y
-	for (int ys = threadData->startLine; scheduler->ThereIsStillSomethingToDo(threadData->id);
+	for (int ys = scheduler->FirstLine(threadData->id);
+			 scheduler->ThereIsStillSomethingToDo(threadData->id);
 			 ys = scheduler->NextLine(threadData->id, ys, lastLineWasBroken))
 	{
 		// skip if line is out of region
 		if (ys < 0) break;
 		if (ys < data->screenRegion.y1 || ys > data->screenRegion.y2) continue;
 
+		packetEnd = -1;
+		previousPixelSample.valid = false;
+
+		const int lineAbove = ys - scheduler->GetProgressiveStep();
+		const bool lineAboveUsed = adaptiveAntiAliasing && lineAbove >= data->screenRegion.y1;
+		if (lineAboveUsed && lineOfSamples != lineAbove)
+		{
+			// line above was rendered by other worker. Its samples are calculated again, so the result
+			// doesn't depend on the order of lines
+			AntiAliasingFirstSamples(lineAbove, aspectRatio, packetMode, &lineAboveSamples);
+			lineOfSamples = lineAbove;
+		}
+		if (adaptiveAntiAliasing)
+			std::fill(lineSamples.begin(), lineSamples.end(), sAntiAliasingSample());
+
 		// main loop for x
 		for (int xs = 0; xs < width; xs += scheduler->GetProgressiveStep())
 		{
@@ -176,6 +237,12 @@ void cRenderWorker::doWork()
 					&& imagePoint.Length() > 0.5 / params->fov)
 				hemisphereCut = true;
 
+			if (packetMode && xs >= packetEnd)
+			{
+				packetEnd = min(xs + rayPacketSize * scheduler->GetProgressiveStep(), width);
+				packetMinScan = PacketRayMarching(xs, packetEnd, ys, aspectRatio);
+			}
+
 			// Ray marching
 			int repeats = data->stereo.GetNumberOfRepeats();
 
@@ -202,18 +269,30 @@ void cRenderWorker::doWork()
 
 			CVector2<double> originalImagePoint = imagePoint;
 
+			sAntiAliasingSample firstSample;
+
 			for (int repeat = 0; repeat < repeats; repeat++)
 			{
+				// random numbers depend only on pixel, sample and frame
+				random.SetKey(
+					xs + data->tileOffset.x, ys + data->tileOffset.y, repeat, params->frameNo);
 
 				CVector3 viewVector;
 				CVector3 startRay;
 
 				if (antiAliasing)
 				{
-					int xStep = repeat / antiAliasingSize;
-					int yStep = repeat % antiAliasingSize;
-					double xOffset = double(xStep) / antiAliasingSize / image->GetWidth() * aspectRatio;
-					double yOffset = double(yStep) / antiAliasingSize / image->GetHeight();
+					// for adaptive mode the second sample is taken from the opposite corner of the pixel
+					int sample = repeat;
+					if (adaptiveAntiAliasing && repeat == 1)
+						sample = lastAntiAliasingSample;
+					else if (adaptiveAntiAliasing && repeat == lastAntiAliasingSample)
+						sample = 1;
+
+					int xStep = sample / antiAliasingSize;
+					int yStep = sample % antiAliasingSize;
+					double xOffset = double(xStep) / antiAliasingSize / frameWidth * aspectRatio;
+					double yOffset = double(yStep) / antiAliasingSize / frameHeight;
 					imagePoint.x = originalImagePoint.x + xOffset;
 					imagePoint.y = originalImagePoint.y + yOffset;
 				}
@@ -225,9 +304,9 @@ void cRenderWorker::doWork()
 						// MC anti-aliasing
 						imagePoint.x =
 							originalImagePoint.x
-							+ (double(Random(1000)) / 1000.0 - 0.5) / image->GetWidth() * aspectRatio;
+							+ (double(random.Random(1000)) / 1000.0 - 0.5) / frameWidth * aspectRatio;
 						imagePoint.y =
-							originalImagePoint.y + (double(Random(1000)) / 1000.0 - 0.5) / image->GetHeight();
+							originalImagePoint.y + (double(random.Random(1000)) / 1000.0 - 0.5) / frameHeight;
 					}
 
 					viewVector = CalculateViewVector(imagePoint, params->fov, params->perspectiveType, mRot);
@@ -248,7 +327,7 @@ void cRenderWorker::doWork()
 				sRGBFloat rgbFromHsv;
 				if (params->DOFMonteCarlo && params->DOFMonteCarloChromaticAberration)
 				{
-					actualHue = Random(3600) / 10.0;
+					actualHue = random.Random(3600) / 10.0;
 					rgbFromHsv = Hsv2rgb(fmod(360.0f + actualHue - 60.0f, 360.0f), 1.0f, 2.0f);
 					CVector3 randVector(
 						0.0, actualHue / 20000.0 * params->DOFMonteCarloCACameraDispersion, 0.0);
@@ -302,30 +381,8 @@ void cRenderWorker::doWork()
 
 				if (!hemisphereCut) // in fulldome mode, will not render pixels out of the fulldome
 				{
-					sRayRecursionIn recursionIn;
-
-					sRayMarchingIn rayMarchingIn;
-					CVector3 direction = viewVector;
-					direction.Normalize();
-					rayMarchingIn.binaryEnable = true;
-					rayMarchingIn.direction = direction;
-					rayMarchingIn.maxScan = params->viewDistanceMax;
-					rayMarchingIn.minScan = 0; // params->viewDistanceMin;
-					rayMarchingIn.start = startRay;
-					rayMarchingIn.invertMode = false;
-					recursionIn.rayMarchingIn = rayMarchingIn;
-					recursionIn.calcInside = false;
-					recursionIn.resultShader = resultShader;
-					recursionIn.objectColour = objectColour;
-					recursionIn.rayBranch = rayBranchReflection;
-
-					sRayRecursionInOut recursionInOut;
-					sRayMarchingInOut rayMarchingInOut;
-					rayMarchingInOut.buffCount = &rayBuffer[0].buffCount;
-					rayMarchingInOut.stepBuff = rayBuffer[0].stepBuff;
-					recursionInOut.rayMarchingInOut = rayMarchingInOut;
-
-					sRayRecursionOut recursionOut = RayRecursion(recursionIn, recursionInOut);
+					sRayRecursionOut recursionOut =
+						TracePrimaryRay(startRay, viewVector, packetMode ? packetMinScan : 0.0);
 
 					resultShader = recursionOut.resultShader;
 					objectColour = recursionOut.objectColour;
@@ -402,8 +459,44 @@ void cRenderWorker::doWork()
 					}
 				}
 
+				if (adaptiveAntiAliasing)
+				{
+					sAntiAliasingSample actualSample(finalPixel, depth, normal);
+					if (repeat == 0)
+					{
+						firstSample = actualSample;
+					}
+					else if (repeat == 1)
+					{
+						bool refine = NeedsAntiAliasingRefinement(firstSample, actualSample);
+						if (previousPixelSample.valid)
+							refine |= NeedsAntiAliasingRefinement(firstSample, previousPixelSample);
+						if (lineAboveUsed && lineAboveSamples[xs].valid)
+							refine |= NeedsAntiAliasingRefinement(firstSample, lineAboveSamples[xs]);
+
+						if (!refine)
+						{
+							repeats = repeat + 1;
+							break;
+						}
+					}
+				}
+
 			} // next repeat
 
+			if (adaptiveAntiAliasing)
+			{
+				previousPixelSample = firstSample;
+				lineSamples[xs] = firstSample;
+			}
+
+			if (antiAliasing && !monteCarlo)
+			{
+				threadStatistics->histogramAntiAliasingSamples.Add(repeats);
+				threadStatistics->totalNumberOfAntiAliasingSamples += repeats;
+				threadStatistics->numberOfAntiAliasedPixels++;
+			}
+
 			if (monteCarlo || antiAliasing)
 			{
 				if (data->stereo.isEnabled() && data->stereo.GetMode() == cStereo::stereoRedCyan)
@@ -424,8 +517,8 @@ void cRenderWorker::doWork()
 					colour.G = finalColourDOF.G / repeats;
 					colour.B = finalColourDOF.B / repeats;
 				}
-				data->statistics.totalNumberOfDOFRepeats += repeats;
-				data->statistics.totalNoise += monteCarloNoise;
+				threadStatistics->totalNumberOfDOFRepeats += repeats;
+				threadStatistics->totalNoise += monteCarloNoise;
 			}
 			else if (data->stereo.isEnabled() && data->stereo.GetMode() == cStereo::stereoRedCyan)
 			{
@@ -456,16 +549,147 @@ void cRenderWorker::doWork()
 				}
 			}
 
-			data->statistics.numberOfRenderedPixels++;
+			threadStatistics->numberOfRenderedPixels++;
 
 		} // next xs
-	}		// next ys
+
+		// samples of the line can be used for the next line only if all pixels were rendered
+		if (adaptiveAntiAliasing)
+		{
+			if (!lastLineWasBroken && !systemData.globalStopRequest)
+			{
+				lineSamples.swap(lineAboveSamples);
+				lineOfSamples = ys;
+			}
+			else
+			{
+				lineOfSamples = -1;
+			}
+		}
+
+		MergeStatistics();
+	} // next ys
+
+	MergeStatistics();
 
 	// emit signal to main thread when finished
 	emit finished();
 	return;
 }
 
+// ray-marching and shading of primary ray with all reflections and refractions
+cRenderWorker::sRayRecursionOut cRenderWorker::TracePrimaryRay(
+	CVector3 start, CVector3 viewVector, double minScan)
+{
+	sRayRecursionIn recursionIn;
+
+	sRayMarchingIn rayMarchingIn;
+	CVector3 direction = viewVector;
+	direction.Normalize();
+	rayMarchingIn.binaryEnable = true;
+	rayMarchingIn.direction = direction;
+	rayMarchingIn.maxScan = params->viewDistanceMax;
+	rayMarchingIn.minScan = minScan; // params->viewDistanceMin;
+	rayMarchingIn.start = start;
+	rayMarchingIn.invertMode = false;
+	recursionIn.rayMarchingIn = rayMarchingIn;
+	recursionIn.calcInside = false;
+	recursionIn.resultShader = sRGBAfloat();
+	recursionIn.objectColour = sRGBAfloat();
+	recursionIn.rayBranch = rayBranchReflection;
+
+	sRayRecursionInOut recursionInOut;
+	sRayMarchingInOut rayMarchingInOut;
+	rayMarchingInOut.rayBuffer = &rayBuffer[0];
+	recursionInOut.rayMarchingInOut = rayMarchingInOut;
+
+	return RayRecursion(recursionIn, recursionInOut);
+}
+
+// first samples of adaptive anti-aliasing for all pixels of the line, calculated exactly as in
+// doWork(). Pixels which are not rendered in actual progressive pass get invalid samples
+void cRenderWorker::AntiAliasingFirstSamples(
+	int ys, double aspectRatio, bool packetMode, std::vector<sAntiAliasingSample> *samples)
+{
+	cScheduler *scheduler = threadData->scheduler;
+	const int width = image->GetWidth();
+	int packetEnd = -1;
+	double packetMinScan = 0.0;
+
+	for (int xs = 0; xs < width; xs += scheduler->GetProgressiveStep())
+	{
+		(*samples)[xs] = sAntiAliasingSample();
+
+		if (scheduler->GetProgressivePass() > 1 && xs % (scheduler->GetProgressiveStep() * 2) == 0
+				&& ys % (scheduler->GetProgressiveStep() * 2) == 0)
+			continue;
+		if (xs < data->screenRegion.x1 || xs > data->screenRegion.x2) continue;
+
+		CVector2<double> imagePoint =
+			data->screenRegion.transpose(data->imageRegion, CVector2<int>(xs, ys));
+		imagePoint.x *= aspectRatio;
+
+		if (packetMode && xs >= packetEnd)
+		{
+			packetEnd = min(xs + rayPacketSize * scheduler->GetProgressiveStep(), width);
+			packetMinScan = PacketRayMarching(xs, packetEnd, ys, aspectRatio);
+		}
+
+		if (params->perspectiveType == params::perspFishEyeCut
+				&& imagePoint.Length() > 0.5 / params->fov)
+		{
+			(*samples)[xs] = sAntiAliasingSample(sRGBFloat(), 1e20, CVector3());
+			continue;
+		}
+
+		random.SetKey(xs + data->tileOffset.x, ys + data->tileOffset.y, 0, params->frameNo);
+		CVector3 viewVector =
+			CalculateViewVector(imagePoint, params->fov, params->perspectiveType, mRot);
+		sRayRecursionOut recursionOut =
+			TracePrimaryRay(params->camera, viewVector, packetMode ? packetMinScan : 0.0);
+
+		sRGBFloat color(
+			recursionOut.resultShader.R, recursionOut.resultShader.G, recursionOut.resultShader.B);
+		double depth = recursionOut.found ? recursionOut.rayMarchingOut.depth : 1e20;
+		(*samples)[xs] = sAntiAliasingSample(color, depth, recursionOut.normal);
+	}
+}
+
+// checks if samples of the pixel differ in brightness, depth or surface orientation
+bool cRenderWorker::NeedsAntiAliasingRefinement(
+	const sAntiAliasingSample &sample1, const sAntiAliasingSample &sample2) const
+{
+	const float contrast = fabs(sample1.color.R - sample2.color.R)
+												 + fabs(sample1.color.G - sample2.color.G)
+												 + fabs(sample1.color.B - sample2.color.B);
+	if (contrast > 3.0 * params->antialiasingAdaptiveThreshold) return true;
+
+	// one sample hits the object and the other one the background
+	const bool found1 = sample1.depth < 1e19;
+	const bool found2 = sample2.depth < 1e19;
+	if (found1 != found2) return true;
+
+	if (found1 && found2)
+	{
+		if (fabs(sample1.depth - sample2.depth) > 0.1 * min(sample1.depth, sample2.depth))
+			return true;
+		if (sample1.normal.Dot(sample2.normal) < 0.9) return true;
+	}
+	return false;
+}
+
+// adds statistics of this thread to global statistics
+void cRenderWorker::MergeStatistics() const
+{
+	{
+		QMutexLocker lock(&data->statisticsMutex);
+		data->statistics.Merge(*threadStatistics);
+	}
+
+	// clear counters but keep sizes of histograms
+	threadStatistics->Reset();
+}
+
 // calculation of base vectors
 void cRenderWorker::PrepareMainVectors()
 {
@@ -514,16 +738,43 @@ void cRenderWorker::PrepareReflectionBuffer()
 	if (!params->raytracedReflections) reflectionsMax = 0;
 	rayBuffer = new sRayBuffer[reflectionsMax + 4];
 
+	// ray-marching steps are needed only by volumetric effects and by absorption of light
+	// inside transparent objects
+	stepBufferNeeded =
+		IsVolumetricShaderEnabled() || data->configuration.UseForcedStepBuffer();
+	for (const cMaterial &material : data->materials)
+	{
+		if (material.transparencyOfSurface > 0.0) stepBufferNeeded = true;
+	}
+
 	for (int i = 0; i < reflectionsMax + 3; i++)
 	{
-		// rayMarching buffers
-		rayBuffer[i].stepBuff = new sStep[maxRaymarchingSteps + 2];
+		// rayMarching buffers are allocated when the first step is recorded
+		rayBuffer[i].stepBuff = nullptr;
 		rayBuffer[i].buffCount = 0;
+		rayBuffer[i].buffSize = 0;
 	}
 
 	rayStack = new sRayStack[reflectionsMax + 1];
 }
 
+// enlarges buffer for ray-marching steps keeping already recorded steps
+void cRenderWorker::GrowStepBuffer(sRayBuffer *buffer, int size) const
+{
+	int newSize =
+		max(max(size, buffer->buffSize * 2), data->configuration.GetInitialStepBufferSize());
+	newSize = min(newSize, maxRaymarchingSteps + 2);
+
+	sStep *newBuff = new sStep[newSize];
+	if (buffer->stepBuff)
+	{
+		std::copy(buffer->stepBuff, buffer->stepBuff + buffer->buffCount, newBuff);
+		delete[] buffer->stepBuff;
+	}
+	buffer->stepBuff = newBuff;
+	buffer->buffSize = newSize;
+}
+
 // calculating vectors for AmbientOcclusion
 void cRenderWorker::PrepareAOVectors()
 {
@@ -613,7 +864,8 @@ void cRenderWorker::RayMarching(
 	double search_limit = 1.0 - search_accuracy;
 	int counter = 0;
 	double step = 0.0;
-	(*inOut->buffCount) = 0;
+	sRayBuffer *buffer = inOut->rayBuffer;
+	buffer->buffCount = 0;
 	double distThresh = 0;
 	out->objectId = 0;
 
@@ -656,38 +908,54 @@ void cRenderWorker::RayMarching(
 
 		//-------------------- 4.18us for Calculate distance --------------
 
+		// step data is recorded only if any shader uses it
+		sStep *stepData = nullptr;
+		if (stepBufferNeeded)
+		{
+			if (i >= buffer->buffSize) GrowStepBuffer(buffer, i + 1);
+			stepData = &buffer->stepBuff[i];
+		}
+
 		// printf("Distance = %g\n", dist/distThresh);
-		inOut->stepBuff[i].distance = dist;
-		inOut->stepBuff[i].iters = distanceOut.iters;
-		inOut->stepBuff[i].distThresh = distThresh;
+		if (stepData)
+		{
+			stepData->distance = dist;
+			stepData->iters = distanceOut.iters;
+			stepData->distThresh = distThresh;
+		}
 
-		data->statistics.histogramIterations.Add(distanceOut.iters);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+		threadStatistics->histogramIterations.Add(distanceOut.iters);
+		threadStatistics->totalNumberOfIterations += distanceOut.totalIters;
 
 		if (dist > 3.0) dist = 3.0;
 		if (dist < distThresh)
 		{
-			if (dist < 0.1 * distThresh) data->statistics.missedDE++;
+			if (dist < 0.1 * distThresh) threadStatistics->missedDE++;
 			found = true;
 			break;
 		}
 
-		inOut->stepBuff[i].step = step;
+		if (stepData) stepData->step = step;
 		if (params->interiorMode)
 		{
-			step = (dist - 0.8 * distThresh) * params->DEFactor * (1.0 - Random(1000) / 10000.0);
+			step =
+				(dist - 0.8 * distThresh) * params->DEFactor * (1.0 - random.Random(1000) / 10000.0);
 			;
 		}
 		else
 		{
-			step = (dist - 0.5 * distThresh) * params->DEFactor * (1.0 - Random(1000) / 10000.0);
+			step =
+				(dist - 0.5 * distThresh) * params->DEFactor * (1.0 - random.Random(1000) / 10000.0);
 			;
 		}
-		inOut->stepBuff[i].point = point;
-		// qDebug() << "i" << i << "dist" << inOut->stepBuff[i].distance << "iters" <<
-		// inOut->stepBuff[i].iters << "distThresh" << inOut->stepBuff[i].distThresh << "step" <<
-		// inOut->stepBuff[i].step << "point" << inOut->stepBuff[i].point.Debug();
-		(*inOut->buffCount) = i + 1;
+		if (stepData)
+		{
+			stepData->point = point;
+			// qDebug() << "i" << i << "dist" << stepData->distance << "iters" << stepData->iters
+			//				 << "distThresh" << stepData->distThresh << "step" << stepData->step << "point"
+			//				 << stepData->point.Debug();
+			buffer->buffCount = i + 1;
+		}
 		// divided by length of view Vector to eliminate overstepping when fov is big
 		scan += step / in.direction.Length();
 		if (scan > in.maxScan)
@@ -739,8 +1007,8 @@ void cRenderWorker::RayMarching(
 
 			out->objectId = distanceOut.objectId;
 
-			data->statistics.histogramIterations.Add(distanceOut.iters);
-			data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+			threadStatistics->histogramIterations.Add(distanceOut.iters);
+			threadStatistics->totalNumberOfIterations += distanceOut.totalIters;
 
 			step *= 0.5;
 		}
@@ -754,14 +1022,75 @@ void cRenderWorker::RayMarching(
 
 	//---------- 7.19605us for binary searching ---------------
 
-	data->statistics.histogramStepCount.Add(counter);
+	threadStatistics->histogramStepCount.Add(counter);
 
 	out->found = found;
 	out->lastDist = dist;
 	out->depth = scan;
 	out->distThresh = distThresh;
 	out->point = point;
-	data->statistics.numberOfRaymarchings++;
+	threadStatistics->numberOfRaymarchings++;
+}
+
+// Cone marching of packet of primary rays [xStart, xEnd) x [y, y + 1]. Returns distance which
+// is safe to skip for all rays of the packet
+double cRenderWorker::PacketRayMarching(int xStart, int xEnd, int y, double aspectRatio) const
+{
+	// view vectors for corners of the packet
+	CVector3 cornerVectors[4];
+	int cornerX[4] = {xStart, xEnd, xStart, xEnd};
+	int cornerY[4] = {y, y, y + 1, y + 1};
+	CVector2<double> centerImagePoint(0.0, 0.0);
+	for (int i = 0; i < 4; i++)
+	{
+		CVector2<double> imagePoint =
+			data->screenRegion.transpose(data->imageRegion, CVector2<int>(cornerX[i], cornerY[i]));
+		imagePoint.x *= aspectRatio;
+		centerImagePoint += imagePoint;
+		cornerVectors[i] = CalculateViewVector(imagePoint, params->fov, params->perspectiveType, mRot);
+		cornerVectors[i].Normalize();
+	}
+	centerImagePoint *= 0.25;
+	CVector3 direction =
+		CalculateViewVector(centerImagePoint, params->fov, params->perspectiveType, mRot);
+	direction.Normalize();
+
+	// distance between central ray and the farthest ray of the packet per unit of depth.
+	// Three-point projection maps the packet to a rectangle on a plane, so the angle to the
+	// central ray is largest in one of the corners
+	double spread = 0.0;
+	for (int i = 0; i < 4; i++)
+		spread = max(spread, (cornerVectors[i] - direction).Length());
+
+	double stepFactor = min(params->DEFactor, 1.0);
+	double scan = 0.0;
+	for (int i = 0; i < maxRaymarchingSteps; i++)
+	{
+		CVector3 point = params->camera + direction * scan;
+		double distThresh = CalcDistThresh(point);
+		sDistanceIn distanceIn(point, distThresh, false);
+		sDistanceOut distanceOut;
+		double dist = CalculateDistance(*params, *fractal, distanceIn, &distanceOut, data);
+		threadStatistics->totalNumberOfIterations += distanceOut.totalIters;
+
+		// stop when cone becomes too wide. Further rays have to be marched separately
+		double coneRadius = spread * scan;
+		if (dist < 2.0 * coneRadius + distThresh || CheckNAN(dist)) break;
+
+		double nextScan = scan + (dist - coneRadius) * stepFactor * 0.9;
+		if (nextScan > params->viewDistanceMax) break;
+		scan = nextScan;
+	}
+	return scan;
+}
+
+// checks if there is used any shader which needs data of all ray-marching steps
+bool cRenderWorker::IsVolumetricShaderEnabled() const
+{
+	return params->glowEnabled || params->fogEnabled || params->volFogEnabled
+				 || params->iterFogEnabled || params->fakeLightsEnabled
+				 || params->volumetricLightAnyEnabled
+				 || (data->lights.IsAnyLightEnabled() && params->auxLightVisibility > 0);
 }
 
 cRenderWorker::sRayRecursionOut cRenderWorker::RayRecursion(
@@ -785,7 +1114,7 @@ cRenderWorker::sRayRecursionOut cRenderWorker::RayRecursion(
 	{
 		if (rayStack[rayIndex].goDeeper)
 		{
-			*inOut.rayMarchingInOut.buffCount = 0;
+			inOut.rayMarchingInOut.rayBuffer->buffCount = 0;
 
 			// trace the light in given direction
 			sRayMarchingOut rayMarchingOut;
@@ -803,12 +1132,11 @@ cRenderWorker::sRayRecursionOut cRenderWorker::RayRecursion(
 			shaderInputData.viewVector = rayStack[rayIndex].in.rayMarchingIn.direction;
 			shaderInputData.lastDist = rayMarchingOut.lastDist;
 			shaderInputData.depth = rayMarchingOut.depth;
-			shaderInputData.stepCount = *inOut.rayMarchingInOut.buffCount;
-			shaderInputData.stepBuff = inOut.rayMarchingInOut.stepBuff;
+			shaderInputData.stepCount = inOut.rayMarchingInOut.rayBuffer->buffCount;
+			shaderInputData.stepBuff = inOut.rayMarchingInOut.rayBuffer->stepBuff;
 			shaderInputData.invertMode = rayStack[rayIndex].in.calcInside;
 			shaderInputData.objectId = rayMarchingOut.objectId;
-			cObjectData objectData = data->objectData[shaderInputData.objectId];
-			shaderInputData.material = &data->materials[objectData.materialId];
+			shaderInputData.material = data->objects.at(shaderInputData.objectId).material;
 
 			double reflect = shaderInputData.material->reflectance;
 			double transparent = shaderInputData.material->transparencyOfSurface;
@@ -888,8 +1216,7 @@ cRenderWorker::sRayRecursionOut cRenderWorker::RayRecursion(
 
 							// setup buffers for ray data
 
-							rayMarchingInOut.buffCount = &rayBuffer[rayIndex].buffCount;
-							rayMarchingInOut.stepBuff = rayBuffer[rayIndex].stepBuff;
+							rayMarchingInOut.rayBuffer = &rayBuffer[rayIndex];
 							inOut.rayMarchingInOut = rayMarchingInOut;
 
 							// recursion for reflection
@@ -950,8 +1277,7 @@ cRenderWorker::sRayRecursionOut cRenderWorker::RayRecursion(
 							recursionIn.rayBranch = rayBranchRefraction;
 
 							// setup buffers for ray data
-							rayMarchingInOut.buffCount = &rayBuffer[rayIndex].buffCount;
-							rayMarchingInOut.stepBuff = rayBuffer[rayIndex].stepBuff;
+							rayMarchingInOut.rayBuffer = &rayBuffer[rayIndex];
 							inOut.rayMarchingInOut = rayMarchingInOut;
 
 							// recursion for refraction
@@ -994,8 +1320,7 @@ cRenderWorker::sRayRecursionOut cRenderWorker::RayRecursion(
 			sRGBAfloat reflectShader = rayStack[rayIndex].reflectShader;
 			sRGBAfloat transparentShader = rayStack[rayIndex].transparentShader;
 
-			inOut.rayMarchingInOut.buffCount = &rayBuffer[rayIndex].buffCount;
-			inOut.rayMarchingInOut.stepBuff = rayBuffer[rayIndex].stepBuff;
+			inOut.rayMarchingInOut.rayBuffer = &rayBuffer[rayIndex];
 
 			// prepare data for shaders
 			CVector3 lightVector = shadowVector;
@@ -1007,12 +1332,11 @@ cRenderWorker::sRayRecursionOut cRenderWorker::RayRecursion(
 			shaderInputData.viewVector = rayStack[rayIndex].in.rayMarchingIn.direction;
 			shaderInputData.lastDist = rayMarchingOut.lastDist;
 			shaderInputData.depth = rayMarchingOut.depth;
-			shaderInputData.stepCount = *inOut.rayMarchingInOut.buffCount;
-			shaderInputData.stepBuff = inOut.rayMarchingInOut.stepBuff;
+			shaderInputData.stepCount = inOut.rayMarchingInOut.rayBuffer->buffCount;
+			shaderInputData.stepBuff = inOut.rayMarchingInOut.rayBuffer->stepBuff;
 			shaderInputData.invertMode = rayStack[rayIndex].in.calcInside;
 			shaderInputData.objectId = rayMarchingOut.objectId;
-			cObjectData objectData = data->objectData[shaderInputData.objectId];
-			shaderInputData.material = &data->materials[objectData.materialId];
+			shaderInputData.material = data->objects.at(shaderInputData.objectId).material;
 
 			shaderInputData.normal = recursionOut.normal;
 
@@ -1224,8 +1548,9 @@ void cRenderWorker::MonteCarloDOF(CVector3 *startRay, CVector3 *viewVector) cons
 {
 	if (params->perspectiveType == params::perspThreePoint)
 	{
-		double randR = 0.0015 * params->DOFRadius * params->DOFFocus * sqrt(Random(65536) / 65536.0);
-		float randAngle = Random(65536);
+		double randR =
+			0.0015 * params->DOFRadius * params->DOFFocus * sqrt(random.Random(65536) / 65536.0);
+		float randAngle = random.Random(65536);
 		CVector3 randVector(randR * sin(randAngle), 0.0, randR * cos(randAngle));
 		CVector3 randVectorRot = mRot.RotateVector(randVector);
 		CVector3 viewVectorTemp = *viewVector;
@@ -1236,8 +1561,9 @@ void cRenderWorker::MonteCarloDOF(CVector3 *startRay, CVector3 *viewVector) cons
 	else
 	{
 		CVector3 viewVectorTemp = *viewVector;
-		double randR = 0.0015 * params->DOFRadius * params->DOFFocus * sqrt(Random(65536) / 65536.0);
-		float randAngle = Random(65536);
+		double randR =
+			0.0015 * params->DOFRadius * params->DOFFocus * sqrt(random.Random(65536) / 65536.0);
+		float randAngle = random.Random(65536);
 		CVector3 randVector(randR * sin(randAngle), 0.0, randR * cos(randAngle));
 
 		CVector3 side = viewVectorTemp.Cross(params->topVector);
@@ -35,11 +35,14 @@
 #ifndef MANDELBULBER2_SRC_RENDER_WORKER_HPP_
 #define MANDELBULBER2_SRC_RENDER_WORKER_HPP_
 
+#include <vector>
+
 #include <QObject>
 #include <QThread>
 
 #include "algebra.hpp"
 #include "color_structures.hpp"
+#include "pixel_random.hpp"
 #include "texture_enums.hpp"
 
 // forward declarations
@@ -51,6 +54,7 @@ struct sRenderData;
 struct sParamRender;
 class cNineFractals;
 class cScheduler;
+class cStatistics;
 
 // ambient occlusion data
 struct sVectorsAround
@@ -97,10 +101,13 @@ private:
 		double distThresh;
 	};
 
+	// steps are recorded only if some shader needs them. Buffer grows when needed, so stepBuff
+	// (and pointers to its steps) are valid only until the next RayMarching() with this buffer
 	struct sRayBuffer
 	{
 		sStep *stepBuff;
 		int buffCount;
+		int buffSize;
 	};
 
 	struct sRayMarchingIn
@@ -117,8 +124,7 @@ private:
 	struct sRayMarchingInOut
 	{
 		inline sRayMarchingInOut &operator=(const sRayMarchingInOut &assign) = default;
-		sStep *stepBuff;
-		int *buffCount;
+		sRayBuffer *rayBuffer;
 	};
 
 	struct sRayMarchingOut
@@ -178,7 +184,7 @@ private:
 		int stepCount;
 		int objectId;
 		bool invertMode;
-		cMaterial *material;
+		const cMaterial *material;
 		sRGBFloat texDiffuse;
 		sRGBFloat texColor;
 		sRGBFloat texLuminosity;
@@ -194,10 +200,28 @@ private:
 		bool goDeeper;
 	};
 
+	// single sample of the pixel used by adaptive anti-aliasing
+	struct sAntiAliasingSample
+	{
+		sAntiAliasingSample() : depth(1e20), valid(false) {}
+		sAntiAliasingSample(sRGBFloat _color, double _depth, CVector3 _normal)
+				: color(_color), normal(_normal), depth(_depth), valid(true)
+		{
+		}
+		sRGBFloat color;
+		CVector3 normal;
+		double depth;
+		bool valid;
+	};
+
 	// functions
 	void PrepareMainVectors();
 	void PrepareReflectionBuffer();
+	void GrowStepBuffer(sRayBuffer *buffer, int size) const;
+	void MergeStatistics() const;
 	void RayMarching(sRayMarchingIn &in, sRayMarchingInOut *inOut, sRayMarchingOut *out) const;
+	double PacketRayMarching(int xStart, int xEnd, int y, double aspectRatio) const;
+	bool IsVolumetricShaderEnabled() const;
 	double CalcDistThresh(CVector3 point) const;
 	double CalcDelta(CVector3 point) const;
 	static double IterOpacity(
@@ -206,6 +230,11 @@ private:
 	void MonteCarloDOF(CVector3 *startRay, CVector3 *viewVector) const;
 	double MonteCarloDOFNoiseEstimation(
 		sRGBFloat pixel, int repeat, sRGBFloat pixelSum, sRGBFloat &StdDevSum);
+	bool NeedsAntiAliasingRefinement(
+		const sAntiAliasingSample &sample1, const sAntiAliasingSample &sample2) const;
+	sRayRecursionOut TracePrimaryRay(CVector3 start, CVector3 viewVector, double minScan);
+	void AntiAliasingFirstSamples(
+		int ys, double aspectRatio, bool packetMode, std::vector<sAntiAliasingSample> *samples);
 
 	// shaders
 	sRGBAfloat ObjectShader(const sShaderInputData &input, sRGBAfloat *surfaceColour,
@@ -233,8 +262,8 @@ private:
 	sRGBAfloat VolumetricShader(
 		const sShaderInputData &input, sRGBAfloat oldPixel, sRGBAfloat *opacityOut) const;
 
-	sRGBFloat TextureShader(
-		const sShaderInputData &input, texture::enumTextureSelection texSelect, cMaterial *mat) const;
+	sRGBFloat TextureShader(const sShaderInputData &input, texture::enumTextureSelection texSelect,
+		const cMaterial *mat) const;
 	CVector3 NormalMapShader(const sShaderInputData &input) const;
 	sRGBFloat IridescenceShader(const sShaderInputData &input) const;
 	sRGBFloat GlobalIlumination(const sShaderInputData &input, sRGBAfloat objectColor) const;
@@ -248,6 +277,19 @@ private:
 
 	// internal variables
 	int maxRaymarchingSteps;
+	static const int rayPacketSize = 8; // number of primary rays marched together as a cone
+	bool stepBufferNeeded;
+	bool prepared;
+
+	// random number generator keyed by actually rendered pixel
+	mutable cPixelRandom random;
+
+	// buffers for lights illuminating actually shaded point
+	mutable std::vector<int> auxLightIndices;
+	mutable std::vector<double> auxLightWeights;
+
+	// statistics collected by this thread. Merged to global statistics after every line
+	cStatistics *threadStatistics;
 	CRotationMatrix mRot;
 	CRotationMatrix mRotInv;
 	CVector3 baseX;
@@ -0,0 +1,138 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cRenderWorkerPool - long-lived threads which run cRenderWorker::doWork()
+ */
+
+#include "render_worker_pool.hpp"
+
+#include "render_worker.hpp"
+#include "system.hpp"
+
+cRenderWorkerPool *gRenderWorkerPool = nullptr;
+
+cRenderWorkerPool::cRenderWorkerPool()
+{
+	availableThreads = 0;
+	quit = false;
+}
+
+cRenderWorkerPool::~cRenderWorkerPool()
+{
+	{
+		QMutexLocker lock(&mutex);
+		quit = true;
+		taskAvailable.wakeAll();
+	}
+
+	for (cPoolThread *thread : threads)
+	{
+		thread->wait();
+		delete thread;
+	}
+}
+
+void cRenderWorkerPool::Start(
+	sJob *job, const QList<cRenderWorker *> &workers, QThread::Priority priority)
+{
+	QMutexLocker lock(&mutex);
+
+	job->unfinishedWorkers = workers.size();
+	for (cRenderWorker *worker : workers)
+	{
+		tasks.enqueue(sTask{worker, job, priority});
+	}
+
+	// every task has to get a thread immediately
+	while (availableThreads < tasks.size())
+	{
+		cPoolThread *thread = new cPoolThread(this);
+		thread->setObjectName("RenderWorker #" + QString::number(threads.size()));
+		threads.append(thread);
+		availableThreads++;
+		thread->start();
+		WriteLog(
+			QString("Render worker pool: thread ") + QString::number(threads.size()) + " created", 3);
+	}
+
+	if (tasks.size() == 1)
+		taskAvailable.wakeOne();
+	else
+		taskAvailable.wakeAll();
+}
+
+bool cRenderWorkerPool::WaitForJob(sJob *job, unsigned long timeMs)
+{
+	QMutexLocker lock(&mutex);
+
+	if (timeMs == ULONG_MAX)
+	{
+		// workers of other jobs also wake up this thread
+		while (job->unfinishedWorkers > 0)
+			workerFinished.wait(&mutex);
+	}
+	else if (job->unfinishedWorkers > 0)
+	{
+		workerFinished.wait(&mutex, timeMs);
+	}
+	return job->unfinishedWorkers == 0;
+}
+
+int cRenderWorkerPool::GetNumberOfThreads()
+{
+	QMutexLocker lock(&mutex);
+	return threads.size();
+}
+
+void cRenderWorkerPool::cPoolThread::run()
+{
+	QMutexLocker lock(&pool->mutex);
+	while (true)
+	{
+		while (pool->tasks.isEmpty() && !pool->quit)
+		{
+			pool->taskAvailable.wait(&pool->mutex);
+		}
+		if (pool->quit) break;
+
+		sTask task = pool->tasks.dequeue();
+		pool->availableThreads--;
+		lock.unlock();
+
+		setPriority(task.priority);
+		task.worker->doWork();
+
+		lock.relock();
+		pool->availableThreads++;
+		task.job->unfinishedWorkers--;
+		pool->workerFinished.wakeAll();
+	}
+}
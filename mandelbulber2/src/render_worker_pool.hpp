@@ -0,0 +1,107 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cRenderWorkerPool - long-lived threads which run cRenderWorker::doWork()
+ *
+ * Threads are created once and reused for all progressive passes, frames and queue items.
+ * A group of workers started together forms a job. The thread which started the job is
+ * woken up with a condition variable when the workers are finished. When all threads are
+ * busy (e.g. thumbnails are rendered during main render) the pool creates new threads, so
+ * workers never have to wait for other jobs.
+ */
+
+#ifndef MANDELBULBER2_SRC_RENDER_WORKER_POOL_HPP_
+#define MANDELBULBER2_SRC_RENDER_WORKER_POOL_HPP_
+
+#include <climits>
+
+#include <QList>
+#include <QMutex>
+#include <QQueue>
+#include <QThread>
+#include <QWaitCondition>
+
+class cRenderWorker;
+
+class cRenderWorkerPool
+{
+public:
+	// group of workers started together
+	struct sJob
+	{
+		int unfinishedWorkers = 0;
+	};
+
+	cRenderWorkerPool();
+	~cRenderWorkerPool();
+
+	// starts doWork() of all workers in pool threads and returns immediately
+	void Start(sJob *job, const QList<cRenderWorker *> &workers, QThread::Priority priority);
+
+	// waits until all workers of the job are finished or the time is out. Returns true if finished
+	bool WaitForJob(sJob *job, unsigned long timeMs = ULONG_MAX);
+
+	int GetNumberOfThreads();
+
+private:
+	struct sTask
+	{
+		cRenderWorker *worker;
+		sJob *job;
+		QThread::Priority priority;
+	};
+
+	class cPoolThread : public QThread
+	{
+	public:
+		explicit cPoolThread(cRenderWorkerPool *_pool) : pool(_pool) {}
+
+	protected:
+		void run() override;
+
+	private:
+		cRenderWorkerPool *pool;
+	};
+
+	QMutex mutex;
+	QWaitCondition taskAvailable;
+	QWaitCondition workerFinished;
+	QQueue<sTask> tasks;
+	QList<cPoolThread *> threads;
+
+	// threads which are not running any task (waiting or just created)
+	int availableThreads;
+	bool quit;
+};
+
+extern cRenderWorkerPool *gRenderWorkerPool;
+
+#endif /* MANDELBULBER2_SRC_RENDER_WORKER_POOL_HPP_ */
@@ -43,8 +43,11 @@ cRenderingConfiguration::cRenderingConfiguration()
 	enableProgressiveRender = true;
 	enableImageRefresh = true;
 	enableNetRender = false;
+	enableNetRenderTextures = false;
 	enableMultiThread = true;
 	enableIgnoreErrors = false;
+	forceStepBuffer = false;
+	initialStepBufferSize = 256;
 	refreshRate = 1000;
 	maxRenderTime = 1e50;
 }
@@ -54,6 +57,11 @@ bool cRenderingConfiguration::UseNetRender() const
 	return (gNetRender->IsClient() || gNetRender->IsServer()) && enableNetRender;
 }
 
+bool cRenderingConfiguration::UseNetRenderTextures() const
+{
+	return gNetRender->IsClient() && (enableNetRender || enableNetRenderTextures);
+}
+
 bool cRenderingConfiguration::UseImageRefresh() const
 {
 	return enableImageRefresh;
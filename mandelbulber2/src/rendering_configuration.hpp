@@ -44,11 +44,21 @@ public:
 	void DisableProgressiveRender() { enableProgressiveRender = false; }
 	void EnableNetRender() { enableNetRender = true; }
 	void DisableNetRender() { enableNetRender = false; }
+	// NetRender client renders whole frames, but textures are received from the server
+	void EnableNetRenderTextures() { enableNetRenderTextures = true; }
 	void DisableMultiThread() { enableMultiThread = false; }
 	void EnableIgnoreErrors() { enableIgnoreErrors = true; }
 	void SetMaxRenderTime(double _maxRenderTime) { maxRenderTime = _maxRenderTime; }
+	// ray-marching steps are recorded also when no shader needs them. Buffers for steps start with
+	// given size, so they have to grow while the ray is marched (used by tests)
+	void ForceStepBuffer(int initialSize)
+	{
+		forceStepBuffer = true;
+		initialStepBufferSize = initialSize;
+	}
 
 	bool UseNetRender() const;
+	bool UseNetRenderTextures() const;
 	bool UseImageRefresh() const;
 	bool UseProgressive() const;
 	bool UseRefreshRenderedList() const;
@@ -56,14 +66,19 @@ public:
 	bool UseIgnoreErrors() const;
 	int GetNumberOfThreads() const;
 	double GetMaxRenderTime() const { return maxRenderTime; }
+	bool UseForcedStepBuffer() const { return forceStepBuffer; }
+	int GetInitialStepBufferSize() const { return initialStepBufferSize; }
 	int GetRefreshRate() const;
 
 private:
 	bool enableImageRefresh;
 	bool enableProgressiveRender;
 	bool enableNetRender;
+	bool enableNetRenderTextures;
 	bool enableMultiThread;
 	bool enableIgnoreErrors;
+	bool forceStepBuffer;
+	int initialStepBufferSize;
 	double maxRenderTime;
 	int refreshRate;
 };
@@ -32,12 +32,16 @@
  * cScheduler class - class to schedule rendering job between CPU cores
  *
  * The image to render is divided into [height] horizontal lines of size [width] x 1.
- * Each line will be managed by the scheduler and given to the asking threads,
- * while the image renders.
+ * Each thread owns a contiguous range of lines which it renders from the top.
+ * When a thread runs out of own lines it steals the bottom half of the biggest
+ * range of another thread. Ranges are packed into one atomic word, so taking
+ * and stealing lines is lock-free.
  */
 
 #include "scheduler.hpp"
 
+#include <algorithm>
+
 #include <QtCore>
 
 #include "system.hpp"
@@ -48,9 +52,11 @@ cScheduler::cScheduler(cRegion<int> screenRegion, int progressive)
 	startLine = screenRegion.y1;
 	endLine = screenRegion.y2;
 	numberOfLines = screenRegion.height;
-	linePendingThreadId = new int[endLine];
-	lineDone = new bool[endLine];
-	lastLinesDone = new bool[endLine];
+	linePendingThreadId = new std::atomic<int>[endLine];
+	lineDone = new std::atomic<bool>[endLine];
+	lastLinesDone = new std::atomic<bool>[endLine];
+	threadRanges = nullptr;
+	numberOfThreads = 0;
 	stopRequest = false;
 	progressiveStep = progressive;
 	progressivePass = 1;
@@ -63,32 +69,59 @@ cScheduler::~cScheduler()
 	delete[] lineDone;
 	delete[] linePendingThreadId;
 	delete[] lastLinesDone;
+	delete[] threadRanges;
 }
 
 void cScheduler::Reset() const
 {
-	memset(linePendingThreadId, 0, sizeof(int) * endLine);
-	memset(lineDone, 0, sizeof(bool) * endLine);
-	memset(lastLinesDone, 0, sizeof(bool) * endLine);
+	for (int i = 0; i < endLine; i++)
+	{
+		linePendingThreadId[i].store(0, std::memory_order_relaxed);
+		lineDone[i].store(false, std::memory_order_relaxed);
+		lastLinesDone[i].store(false, std::memory_order_relaxed);
+	}
 }
 
-bool cScheduler::ThereIsStillSomethingToDo(int threadId) const
+// thread with id = i + 1 starts rendering at threadStartLines[i]
+void cScheduler::InitThreadRanges(const QVector<int> &_threadStartLines)
 {
-	bool result = false;
-	for (int i = startLine; i < endLine; i++)
+	threadStartLines = _threadStartLines;
+	numberOfThreads = threadStartLines.size();
+	delete[] threadRanges;
+	threadRanges = new std::atomic<quint64>[numberOfThreads];
+	InitRanges();
+}
+
+void cScheduler::InitRanges()
+{
+	// rows are lines aligned to the actual progressive step
+	int firstRow = startLine / progressiveStep;
+	int lastRow = (endLine + progressiveStep - 1) / progressiveStep;
+
+	// order threads by their starting lines. Every thread owns lines from its starting line up to
+	// the starting line of the next one
+	QVector<QPair<int, int>> startRows;
+	for (int i = 0; i < numberOfThreads; i++)
 	{
-		// qDebug() << "ThereIsStillSomethingToDo:" << i << lineDone[i];
-		if (!lineDone[i] && (linePendingThreadId[i] == threadId || linePendingThreadId[i] == 0))
-		{
-			result = true;
-			break;
-		}
+		int row = qBound(firstRow, threadStartLines.at(i) / progressiveStep, lastRow);
+		startRows.append(qMakePair(row, i));
 	}
+	std::sort(startRows.begin(), startRows.end());
 
-	if (stopRequest) result = false;
-	if (systemData.globalStopRequest) result = false;
+	for (int i = 0; i < numberOfThreads; i++)
+	{
+		int begin = (i == 0) ? firstRow : startRows.at(i).first;
+		int end = (i == numberOfThreads - 1) ? lastRow : startRows.at(i + 1).first;
+		threadRanges[startRows.at(i).second] = PackRange(begin, end);
+	}
+}
 
-	return result;
+bool cScheduler::ThereIsStillSomethingToDo(int threadId) const
+{
+	Q_UNUSED(threadId);
+	// lines are handed out exclusively, so the thread can always finish the line it owns.
+	// NextLine() returns -1 when there is nothing left to take
+	return !stopRequest && !systemData.globalStopRequest;
 }
 
 bool cScheduler::AllLinesDone() const
@@ -97,7 +130,7 @@ bool cScheduler::AllLinesDone() const
 	for (int i = startLine; i < endLine; i++)
 	{
 		// qDebug() << "AllLinesDone:" << i << lineDone[i];
-		if (!lineDone[i])
+		if (!lineDone[i].load(std::memory_order_relaxed))
 		{
 			result = false;
 			break;
@@ -113,7 +146,9 @@ bool cScheduler::ShouldIBreak(int threadId, int actualLine) const
 {
 	if (actualLine >= 0)
 	{
-		return threadId != linePendingThreadId[actualLine] || stopRequest;
+		// line can be taken away only by NetRender server (already rendered by other client)
+		return threadId != linePendingThreadId[actualLine].load(std::memory_order_relaxed)
+					 || stopRequest;
 	}
 	else
 	{
@@ -123,117 +158,109 @@ bool cScheduler::ShouldIBreak(int threadId, int actualLine) const
 	}
 }
 
+int cScheduler::FirstLine(int threadId)
+{
+	return ClaimLine(threadId);
+}
+
 int cScheduler::NextLine(int threadId, int actualLine, bool lastLineWasBroken)
 {
-	mutex.lock();
 	// qDebug() << "threadID:" << threadId << " Actual line:" << actualLine;
 
-	int nextLine;
-
-	if (!lastLineWasBroken)
+	if (!lastLineWasBroken && actualLine >= 0)
 	{
 		for (int i = 0; i < progressiveStep; i++)
 		{
 			if (actualLine + i < endLine)
 			{
-				lineDone[actualLine + i] = true;
-				lastLinesDone[actualLine + i] = true;
+				lineDone[actualLine + i].store(true, std::memory_order_relaxed);
+				lastLinesDone[actualLine + i].store(true, std::memory_order_relaxed);
 			}
 		}
 	}
-	else
-	{
-		// qDebug() << "threadID:" << threadId << " lastLineWasBroken, line:" << actualLine;
-	}
 
-	// next line is not occupied by any thread
-	if (actualLine < endLine - progressiveStep
-			&& linePendingThreadId[actualLine + progressiveStep] == 0 && !lastLineWasBroken)
-	{
-		nextLine = actualLine + progressiveStep;
-		// qDebug() << "threadID:" << threadId << " one after:" << nextLine;
-	}
-	else
-	// next line is occupied or it's last line. There is needed to find new optimal line for rendering
+	return ClaimLine(threadId);
+}
+
+int cScheduler::ClaimLine(int threadId)
+{
+	int threadIndex = threadId - 1;
+	if (threadIndex < 0 || threadIndex >= numberOfThreads)
 	{
-		nextLine = FindBiggestGap();
-		// qDebug() << "threadID:" << threadId << " gap:" << nextLine;
+		qCritical() << "cScheduler::ClaimLine(int threadId): wrong thread id" << threadId;
+		return -1;
 	}
 
-	if (nextLine >= 0)
+	while (!stopRequest)
 	{
-		if (linePendingThreadId[nextLine] == 0)
+		int row = PopOwnRow(threadIndex);
+		if (row < 0) row = StealRow(threadIndex);
+		if (row < 0) return -1; // nothing left to render
+
+		int line = row * progressiveStep;
+
+		// line could be already rendered by other NetRender client
+		if (line < startLine || line >= endLine) continue;
+		if (lineDone[line].load(std::memory_order_relaxed)) continue;
+
+		for (int i = 0; i < progressiveStep; i++)
 		{
-			for (int i = 0; i < progressiveStep; i++)
-			{
-				if (nextLine + i < endLine)
-				{
-					linePendingThreadId[nextLine + i] = threadId;
-				}
-			}
+			if (line + i < endLine)
+				linePendingThreadId[line + i].store(threadId, std::memory_order_relaxed);
 		}
+		// qDebug() << "threadID:" << threadId << " Next line:" << line;
+		return line;
 	}
-	mutex.unlock();
+	return -1;
+}
 
-	if (nextLine < 0)
+int cScheduler::PopOwnRow(int threadIndex)
+{
+	std::atomic<quint64> &range = threadRanges[threadIndex];
+	quint64 actualRange = range.load();
+	forever
 	{
-		// qCritical() << "cScheduler::NextLine(int threadId, int actualLine): not possible to find new
-		// line";
-		return -1;
+		int begin = RangeBegin(actualRange);
+		int end = RangeEnd(actualRange);
+		if (begin >= end) return -1;
+		if (range.compare_exchange_weak(actualRange, PackRange(begin + 1, end))) return begin;
 	}
-
-	// qDebug() << "threadID:" << threadId << " Next line:" << nextLine;
-	return nextLine;
 }
 
-int cScheduler::FindBiggestGap() const
+int cScheduler::StealRow(int threadIndex)
 {
-	bool firstFreeFound = false;
-	int firstFree = -1;
-	int lastFree;
-	int maxHole = 0;
-	int theBest = -1;
-
-	for (int i = startLine; i < endLine; i++)
+	forever
 	{
-		if (!firstFreeFound && linePendingThreadId[i] == 0)
+		// looking for the biggest range of other threads
+		int victim = -1;
+		int biggestSize = 0;
+		quint64 victimRange = 0;
+		for (int i = 0; i < numberOfThreads; i++)
 		{
-			firstFreeFound = true;
-			firstFree = i;
-			if (i == endLine - 1)
+			if (i == threadIndex) continue;
+			quint64 range = threadRanges[i].load(std::memory_order_relaxed);
+			int size = RangeEnd(range) - RangeBegin(range);
+			if (size > biggestSize)
 			{
-				theBest = i;
-				theBest /= progressiveStep;
-				theBest *= progressiveStep;
-				break;
+				biggestSize = size;
+				victim = i;
+				victimRange = range;
 			}
-			continue;
 		}
+		if (victim < 0) return -1;
 
-		if (firstFreeFound && (linePendingThreadId[i] > 0 || i == endLine - 1))
+		// take the bottom half. Victim keeps rendering from the top of its range
+		int begin = RangeBegin(victimRange);
+		int end = RangeEnd(victimRange);
+		int middle = begin + (end - begin) / 2;
+		if (threadRanges[victim].compare_exchange_strong(victimRange, PackRange(begin, middle)))
 		{
-			lastFree = i;
-			int holeSize = lastFree - firstFree;
-			firstFreeFound = false;
-
-			if (holeSize > maxHole)
-			{
-				maxHole = holeSize;
-				// next line should be in the middle of the biggest gap
-				theBest = (lastFree + firstFree) / 2;
-				theBest /= progressiveStep;
-				theBest *= progressiveStep;
-				// out << "Jump Id: " << threadId  << " first: " << firstFree << " last: " << lastFree <<
-				// endl;
-			}
+			// own range is empty, so nobody else can modify it now
+			threadRanges[threadIndex] = PackRange(middle + 1, end);
+			return middle;
 		}
+		// victim range has changed in meantime - try again
 	}
-	return theBest;
-}
-
-void cScheduler::InitFirstLine(int threadId, int firstLine) const
-{
-	linePendingThreadId[firstLine] = threadId;
 }
 
 QList<int> cScheduler::GetLastRenderedLines() const
@@ -241,10 +268,10 @@ QList<int> cScheduler::GetLastRenderedLines() const
 	QList<int> list;
 	for (int i = startLine; i < endLine; i++)
 	{
-		if (lastLinesDone[i])
+		// line can be marked as done again by rendering thread in the meantime
+		if (lastLinesDone[i].exchange(false, std::memory_order_relaxed))
 		{
 			list.append(i);
-			lastLinesDone[i] = false;
 		}
 	}
 	return list;
@@ -255,7 +282,7 @@ double cScheduler::PercentDone() const
 	int count = 0;
 	for (int i = startLine; i < endLine; i++)
 	{
-		if (lineDone[i]) count++;
+		if (lineDone[i].load(std::memory_order_relaxed)) count++;
 	}
 
 	double progressiveDone, percent_done;
@@ -288,8 +315,12 @@ bool cScheduler::ProgressiveNextStep()
 	}
 	else
 	{
-		memset(linePendingThreadId, 0, sizeof(int) * endLine);
-		memset(lineDone, 0, sizeof(bool) * endLine);
+		for (int i = 0; i < endLine; i++)
+		{
+			linePendingThreadId[i].store(0, std::memory_order_relaxed);
+			lineDone[i].store(false, std::memory_order_relaxed);
+		}
+		InitRanges();
 		return true;
 	}
 }
@@ -298,9 +329,9 @@ void cScheduler::MarkReceivedLines(const QList<int> &lineNumbers) const
 {
 	for (int line : lineNumbers)
 	{
-		lineDone[line] = true;
-		lastLinesDone[line] = true;
-		linePendingThreadId[line] = LINE_DONE_BY_SERVER;
+		lineDone[line].store(true, std::memory_order_relaxed);
+		lastLinesDone[line].store(true, std::memory_order_relaxed);
+		linePendingThreadId[line].store(LINE_DONE_BY_SERVER, std::memory_order_relaxed);
 	}
 }
 
@@ -309,7 +340,7 @@ QList<int> cScheduler::CreateDoneList() const
 	QList<int> list;
 	for (int i = startLine; i < endLine; i++)
 	{
-		if (lineDone[i])
+		if (lineDone[i].load(std::memory_order_relaxed))
 		{
 			list.append(i);
 		}
@@ -318,23 +349,21 @@ QList<int> cScheduler::CreateDoneList() const
 	return list;
 }
 
-void cScheduler::UpdateDoneLines(const QList<int> &done)
+void cScheduler::UpdateDoneLines(const QList<int> &done) const
 {
-	mutex.lock();
 	for (int line : done)
 	{
-		lastLinesDone[line] = false;
-		lineDone[line] = true;
-		linePendingThreadId[line] = LINE_DONE_BY_SERVER;
+		lastLinesDone[line].store(false, std::memory_order_relaxed);
+		lineDone[line].store(true, std::memory_order_relaxed);
+		linePendingThreadId[line].store(LINE_DONE_BY_SERVER, std::memory_order_relaxed);
 	}
-	mutex.unlock();
 }
 
 bool cScheduler::IsLineDoneByServer(int line) const
 {
 	if (line >= startLine && line < endLine)
 	{
-		return linePendingThreadId[line] == LINE_DONE_BY_SERVER;
+		return linePendingThreadId[line].load(std::memory_order_relaxed) == LINE_DONE_BY_SERVER;
 	}
 	return false;
 }
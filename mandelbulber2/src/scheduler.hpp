@@ -32,8 +32,10 @@
  * cScheduler class - class to schedule rendering job between CPU cores
  *
  * The image to render is divided into [height] horizontal lines of size [width] x 1.
- * Each line will be managed by the scheduler and given to the asking threads,
- * while the image renders.
+ * Each thread owns a contiguous range of lines which it renders from the top.
+ * When a thread runs out of own lines it steals the bottom half of the biggest
+ * range of another thread. Ranges are packed into one atomic word, so taking
+ * and stealing lines is lock-free.
  */
 
 #ifndef MANDELBULBER2_SRC_SCHEDULER_HPP_
@@ -43,8 +45,6 @@
 
 #include <atomic>
 
-#include <QMutex>
-
 #include "region.hpp"
 
 class cScheduler
@@ -52,16 +52,17 @@ class cScheduler
 public:
 	cScheduler(cRegion<int> screenRegion, int progressive);
 	~cScheduler();
+	void InitThreadRanges(const QVector<int> &threadStartLines);
+	int FirstLine(int threadId);
 	int NextLine(int threadId, int actualLine, bool lastLineWasBroken);
 	bool ShouldIBreak(int threadId, int actualLine) const;
 	bool ThereIsStillSomethingToDo(int ThreadId) const;
 	bool AllLinesDone() const;
-	void InitFirstLine(int threadId, int firstLine) const;
 	QList<int> GetLastRenderedLines() const;
 	double PercentDone() const;
 	void Stop() { stopRequest = true; }
 	void MarkReceivedLines(const QList<int> &lineNumbers) const;
-	void UpdateDoneLines(const QList<int> &done);
+	void UpdateDoneLines(const QList<int> &done) const;
 
 	int GetProgressiveStep() const { return progressiveStep; }
 	int GetProgressivePass() const { return progressivePass; }
@@ -71,11 +72,27 @@ public:
 
 private:
 	void Reset() const;
-	int FindBiggestGap() const;
+	void InitRanges();
+	int ClaimLine(int threadId);
+	int PopOwnRow(int threadIndex);
+	int StealRow(int threadIndex);
+
+	// range of rows [begin, end) packed into one 64-bit word
+	static quint64 PackRange(int begin, int end)
+	{
+		return (quint64(quint32(begin)) << 32) | quint64(quint32(end));
+	}
+	static int RangeBegin(quint64 range) { return int(quint32(range >> 32)); }
+	static int RangeEnd(quint64 range) { return int(quint32(range & 0xFFFFFFFFu)); }
 
-	int *linePendingThreadId;
-	bool *lineDone;
-	bool *lastLinesDone;
+	// written by rendering threads and NetRender, read by all of them. Only the values of single
+	// lines matter, so relaxed ordering is enough
+	std::atomic<int> *linePendingThreadId;
+	std::atomic<bool> *lineDone;
+	std::atomic<bool> *lastLinesDone;
+	std::atomic<quint64> *threadRanges;
+	QVector<int> threadStartLines;
+	int numberOfThreads;
 	int numberOfLines;
 	int startLine;
 	int endLine;
@@ -83,7 +100,6 @@ private:
 	int progressiveStep;
 	int progressivePass;
 	bool progressiveEnabled;
-	QMutex mutex;
 };
 
 #endif /* MANDELBULBER2_SRC_SCHEDULER_HPP_ */
@@ -51,7 +51,7 @@ sRGBAfloat cRenderWorker::AmbientOcclusion(const sShaderInputData &input) const
 
 	if (params->DOFEnabled && params->DOFMonteCarlo)
 	{
-		int randomSample = Random(AOVectorsCount - 1);
+		int randomSample = random.Random(AOVectorsCount - 1);
 		start = randomSample;
 		end = randomSample;
 	}
@@ -72,7 +72,7 @@ sRGBAfloat cRenderWorker::AmbientOcclusion(const sShaderInputData &input) const
 			sDistanceOut distanceOut;
 			sDistanceIn distanceIn(point2, input.distThresh, false);
 			dist = CalculateDistance(*params, *fractal, distanceIn, &distanceOut, data);
-			data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+			threadStatistics->totalNumberOfIterations += distanceOut.totalIters;
 
 			if (params->iterFogEnabled)
 			{
@@ -32,6 +32,7 @@
  * cRenderWorker::AuxLightsShader method - calculates shading for auxiliary light sources
  */
 #include "fractparams.hpp"
+#include "material.h"
 #include "render_data.hpp"
 #include "render_worker.hpp"
 
@@ -43,11 +44,48 @@ sRGBAfloat cRenderWorker::AuxLightsShader(
 	if (numberOfLights < 4) numberOfLights = 4;
 	sRGBAfloat shadeAuxSum;
 	sRGBAfloat specularAuxSum;
-	for (int i = 0; i < numberOfLights; i++)
+
+	// only lights which can noticeably illuminate the point
+	data->lights.GetLightsAtPoint(input.point, &auxLightIndices);
+	int numberOfCandidates = int(auxLightIndices.size());
+
+	if (params->auxLightSamplingEnabled && numberOfCandidates > params->auxLightSamplingCount)
+	{
+		// stochastic sampling of lights with probability proportional to estimated unshadowed
+		// illumination. Sum of contributions divided by probabilities is unbiased
+		auxLightWeights.resize(numberOfCandidates);
+		double totalWeight = 0.0;
+		for (int i = 0; i < numberOfCandidates; i++)
+		{
+			totalWeight += cLights::SamplingWeight(data->lights.GetLight(auxLightIndices[i]),
+				input.point, input.normal, input.material->shading);
+			auxLightWeights[i] = totalWeight;
+		}
+
+		int samples = params->auxLightSamplingCount;
+		for (int sample = 0; sample < samples; sample++)
+		{
+			double inverseProbability;
+			int i = cLights::SampleCandidate(auxLightWeights, random.RandomDouble(), &inverseProbability);
+			float factor = inverseProbability / samples;
+
+			const sLight *light = data->lights.GetLight(auxLightIndices[i]);
+			sRGBAfloat specularAuxOutTemp;
+			sRGBAfloat shadeAux =
+				LightShading(input, surfaceColor, light, numberOfLights, &specularAuxOutTemp);
+			shadeAuxSum.R += shadeAux.R * factor;
+			shadeAuxSum.G += shadeAux.G * factor;
+			shadeAuxSum.B += shadeAux.B * factor;
+			specularAuxSum.R += specularAuxOutTemp.R * factor;
+			specularAuxSum.G += specularAuxOutTemp.G * factor;
+			specularAuxSum.B += specularAuxOutTemp.B * factor;
+		}
+	}
+	else
 	{
-		const sLight *light = data->lights.GetLight(i);
-		if (i < params->auxLightNumber || light->enabled)
+		for (int i = 0; i < numberOfCandidates; i++)
 		{
+			const sLight *light = data->lights.GetLight(auxLightIndices[i]);
 			sRGBAfloat specularAuxOutTemp;
 			sRGBAfloat shadeAux =
 				LightShading(input, surfaceColor, light, numberOfLights, &specularAuxOutTemp);
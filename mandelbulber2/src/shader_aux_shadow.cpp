@@ -70,10 +70,10 @@ double cRenderWorker::AuxShadow(
 	if (params->DOFMonteCarlo && params->monteCarloSoftShadows)
 	{
 		CVector3 randomVector;
-		randomVector.x = Random(10000) / 5000.0 - 1.0;
-		randomVector.y = Random(10000) / 5000.0 - 1.0;
-		randomVector.z = Random(10000) / 5000.0 - 1.0;
-		double randomSphereRadius = pow(Random(10000) / 10000.0, 1.0 / 3.0);
+		randomVector.x = random.Random(10000) / 5000.0 - 1.0;
+		randomVector.y = random.Random(10000) / 5000.0 - 1.0;
+		randomVector.z = random.Random(10000) / 5000.0 - 1.0;
+		double randomSphereRadius = pow(random.Random(10000) / 10000.0, 1.0 / 3.0);
 		CVector3 randomSphere = randomVector * (softRange * randomSphereRadius / randomVector.Length());
 		lightVector += randomSphere;
 	}
@@ -93,7 +93,7 @@ double cRenderWorker::AuxShadow(
 		sDistanceOut distanceOut;
 		sDistanceIn distanceIn(point2, input.distThresh, false);
 		dist = CalculateDistance(*params, *fractal, distanceIn, &distanceOut);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+		threadStatistics->totalNumberOfIterations += distanceOut.totalIters;
 
 		bool limitsReached = false;
 		if (params->limitsEnabled)
@@ -45,36 +45,21 @@ CVector3 cRenderWorker::CalculateNormals(const sShaderInputData &input) const
 		double delta = input.distThresh * params->smoothness;
 		if (params->interiorMode) delta = input.distThresh * 0.2 * params->smoothness;
 
-		double sx1, sx2, sy1, sy2, sz1, sz2;
-		sDistanceOut distanceOut;
-
-		CVector3 deltaX(delta, 0.0, 0.0);
-		sDistanceIn distanceIn1(input.point + deltaX, input.distThresh, true);
-		sx1 = CalculateDistance(*params, *fractal, distanceIn1, &distanceOut, data);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
-		sDistanceIn distanceIn2(input.point - deltaX, input.distThresh, true);
-		sx2 = CalculateDistance(*params, *fractal, distanceIn2, &distanceOut, data);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
-
-		CVector3 deltaY(0.0, delta, 0.0);
-		sDistanceIn distanceIn3(input.point + deltaY, input.distThresh, true);
-		sy1 = CalculateDistance(*params, *fractal, distanceIn3, &distanceOut, data);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
-		sDistanceIn distanceIn4(input.point - deltaY, input.distThresh, true);
-		sy2 = CalculateDistance(*params, *fractal, distanceIn4, &distanceOut, data);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+		// all six points are calculated as one batch (x+, x-, y+, y-, z+, z-)
+		const CVector3 &p = input.point;
+		const double px[6] = {p.x + delta, p.x - delta, p.x, p.x, p.x, p.x};
+		const double py[6] = {p.y, p.y, p.y + delta, p.y - delta, p.y, p.y};
+		const double pz[6] = {p.z, p.z, p.z, p.z, p.z + delta, p.z - delta};
 
-		CVector3 deltaZ(0.0, 0.0, delta);
-		sDistanceIn distanceIn5(input.point + deltaZ, input.distThresh, true);
-		sz1 = CalculateDistance(*params, *fractal, distanceIn5, &distanceOut, data);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
-		sDistanceIn distanceIn6(input.point - deltaZ, input.distThresh, true);
-		sz2 = CalculateDistance(*params, *fractal, distanceIn6, &distanceOut, data);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+		sDistanceOut distanceOut[6];
+		sDistanceBatchIn distanceIn(px, py, pz, 6, input.distThresh, true);
+		CalculateDistanceBatch(*params, *fractal, distanceIn, distanceOut, data);
+		for (int i = 0; i < 6; i++)
+			threadStatistics->totalNumberOfIterations += distanceOut[i].totalIters;
 
-		normal.x = sx1 - sx2;
-		normal.y = sy1 - sy2;
-		normal.z = sz1 - sz2;
+		normal.x = distanceOut[0].distance - distanceOut[1].distance;
+		normal.y = distanceOut[2].distance - distanceOut[3].distance;
+		normal.z = distanceOut[4].distance - distanceOut[5].distance;
 	}
 
 	// calculating normal vector based on average value of binary central difference
@@ -96,7 +81,7 @@ CVector3 cRenderWorker::CalculateNormals(const sShaderInputData &input) const
 
 					sDistanceIn distanceIn(point3, input.distThresh, true);
 					double dist = CalculateDistance(*params, *fractal, distanceIn, &distanceOut, data);
-					data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+					threadStatistics->totalNumberOfIterations += distanceOut.totalIters;
 					normal += point2 * dist;
 				}
 			}
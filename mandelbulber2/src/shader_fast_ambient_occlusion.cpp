@@ -55,7 +55,7 @@ sRGBAfloat cRenderWorker::FastAmbientOcclusion(const sShaderInputData &input) co
 		double dist = CalculateDistance(*params, *fractal, distanceIn, &distanceOut, data);
 		if (dist > lastDist * 2) dist = lastDist * 2.0;
 		lastDist = dist;
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+		threadStatistics->totalNumberOfIterations += distanceOut.totalIters;
 		aoTemp +=
 			1.0 / pow(2.0, i) * (scan - params->ambientOcclusionFastTune * dist) / input.distThresh;
 	}
@@ -47,9 +47,11 @@ sRGBFloat cRenderWorker::GlobalIlumination(
 	for (int rayDepth = 0; rayDepth < params->reflectionsMax; rayDepth++)
 	{
 		CVector3 reflectedDirection = inputCopy.normal;
-		double randomX = (Random(20000) - 10000) / 10000.0;
-		double randomY = (Random(20000) - 10000) / 10000.0;
-		double randomZ = (Random(20000) - 10000) / 10000.0;
+		double randomNumbers[3];
+		random.RandomBatch(randomNumbers, 3);
+		double randomX = randomNumbers[0] * 2.0 - 1.0;
+		double randomY = randomNumbers[1] * 2.0 - 1.0;
+		double randomZ = randomNumbers[2] * 2.0 - 1.0;
 		CVector3 randomVector(randomX * 1.2, randomY * 1.2, randomZ * 1.2);
 		CVector3 randomizedDirection = reflectedDirection + randomVector;
 		randomizedDirection.Normalize();
@@ -94,8 +96,7 @@ sRGBFloat cRenderWorker::GlobalIlumination(
 			sRGBAfloat specular;
 			sRGBFloat iridescence;
 
-			cObjectData objectData = data->objectData[inputCopy.objectId];
-			inputCopy.material = &data->materials[objectData.materialId];
+			inputCopy.material = data->objects.at(inputCopy.objectId).material;
 
 			// letting colors from textures (before normal map shader)
 			if (inputCopy.material->colorTexture.IsLoaded())
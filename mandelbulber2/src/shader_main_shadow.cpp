@@ -70,10 +70,10 @@ sRGBAfloat cRenderWorker::MainShadow(const sShaderInputData &input) const
 	if (params->DOFMonteCarlo && params->monteCarloSoftShadows)
 	{
 		CVector3 randomVector;
-		randomVector.x = Random(10000) / 5000.0 - 1.0;
-		randomVector.y = Random(10000) / 5000.0 - 1.0;
-		randomVector.z = Random(10000) / 5000.0 - 1.0;
-		double randomSphereRadius = pow(Random(10000) / 10000.0, 1.0 / 3.0);
+		randomVector.x = random.Random(10000) / 5000.0 - 1.0;
+		randomVector.y = random.Random(10000) / 5000.0 - 1.0;
+		randomVector.z = random.Random(10000) / 5000.0 - 1.0;
+		double randomSphereRadius = pow(random.Random(10000) / 10000.0, 1.0 / 3.0);
 		CVector3 randomSphere = randomVector * (softRange * randomSphereRadius / randomVector.Length());
 		shadowVect += randomSphere;
 	}
@@ -93,7 +93,7 @@ sRGBAfloat cRenderWorker::MainShadow(const sShaderInputData &input) const
 		sDistanceOut distanceOut;
 		sDistanceIn distanceIn(point2, dist_thresh, false);
 		dist = CalculateDistance(*params, *fractal, distanceIn, &distanceOut, data);
-		data->statistics.totalNumberOfIterations += distanceOut.totalIters;
+		threadStatistics->totalNumberOfIterations += distanceOut.totalIters;
 
 		bool limitsReached = false;
 		if (params->limitsEnabled)
@@ -41,7 +41,7 @@ using std::max;
 
 CVector3 cRenderWorker::NormalMapShader(const sShaderInputData &input) const
 {
-	cObjectData objectData = data->objectData[input.objectId];
+	const cObjectData &objectData = *data->objects.at(input.objectId).object;
 	CVector3 texX, texY;
 	double texturePixelSize;
 	CVector2<double> texPoint =
@@ -44,7 +44,7 @@ sRGBAfloat cRenderWorker::ObjectShader(const sShaderInputData &_input, sRGBAfloa
 	// normal vector
 	CVector3 vn = _input.normal;
 	sShaderInputData input = _input;
-	cMaterial *mat = input.material;
+	const cMaterial *mat = input.material;
 	input.normal = vn;
 
 	// main light
@@ -50,7 +50,7 @@ sRGBAfloat cRenderWorker::SpecularHighlight(
 	shade2 = pow(shade2, 30.0f / specularWidth / diffuse) / diffuse;
 	if (roughness > 0.0f)
 	{
-		shade2 *= (1.0 + Random(1000) / 1000.0f * roughness);
+		shade2 *= (1.0 + random.Random(1000) / 1000.0f * roughness);
 	}
 	if (shade2 > 15.0f) shade2 = 15.0f;
 	specular.R =
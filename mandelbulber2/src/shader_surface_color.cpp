@@ -40,7 +40,7 @@ sRGBAfloat cRenderWorker::SurfaceColour(const sShaderInputData &input) const
 {
 	sRGBAfloat out;
 
-	switch (data->objectData[input.objectId].objectType)
+	switch (data->objects.at(input.objectId).object->objectType)
 	{
 		case fractal::objFractal:
 		{
@@ -41,10 +41,10 @@
 
 using std::max;
 
-sRGBFloat cRenderWorker::TextureShader(
-	const sShaderInputData &input, texture::enumTextureSelection texSelect, cMaterial *mat) const
+sRGBFloat cRenderWorker::TextureShader(const sShaderInputData &input,
+	texture::enumTextureSelection texSelect, const cMaterial *mat) const
 {
-	cObjectData objectData = data->objectData[input.objectId];
+	const cObjectData &objectData = *data->objects.at(input.objectId).object;
 	double texturePixelSize = 0.0;
 	CVector3 textureVectorX, textureVectorY;
 
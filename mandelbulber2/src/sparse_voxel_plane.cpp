@@ -0,0 +1,205 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cSparseVoxelPlane - calculates distances for a plane of voxels for voxel and mesh export
+ */
+
+#include "sparse_voxel_plane.hpp"
+
+#include <algorithm>
+
+#include "calculate_distance.hpp"
+#include "compute_fractal.hpp"
+#include "fractparams.hpp"
+#include "nine_fractals.hpp"
+#include "render_data.hpp"
+
+cSparseVoxelPlane::cSparseVoxelPlane(const sParamRender *params, const cNineFractals *fractals,
+	sRenderData *renderData, double distThresh, double voxelStep, bool sparse)
+{
+	this->params = params;
+	this->fractals = fractals;
+	this->renderData = renderData;
+	this->distThresh = distThresh;
+	this->voxelStep = voxelStep;
+	this->sparse = sparse;
+	numberOfCalculatedVoxels = 0;
+	numberOfSkippedVoxels = 0;
+}
+
+void cSparseVoxelPlane::Calculate(
+	const sVoxelPlane &plane, double *distances, double *colorIndices, bool *stop)
+{
+	skipped.assign(plane.sizeU * plane.sizeV, 0);
+
+	if (sparse)
+	{
+		// big blocks first, then smaller blocks inside big blocks which were not empty
+		CalculateEmptyBlocks(plane, 16, distances, stop);
+		CalculateEmptyBlocks(plane, 4, distances, stop);
+	}
+
+	CalculateVoxels(plane, distances, colorIndices, stop);
+}
+
+void cSparseVoxelPlane::CalculateEmptyBlocks(
+	const sVoxelPlane &plane, int blockSize, double *distances, bool *stop)
+{
+	const long long blocksU = (plane.sizeU + blockSize - 1) / blockSize;
+	const long long blocksV = (plane.sizeV + blockSize - 1) / blockSize;
+	const double stepULength = plane.stepU.Length();
+	const double stepVLength = plane.stepV.Length();
+
+	// distance estimation is trusted in the same way as for ray-marching steps
+	const double deFactor = std::min(params->DEFactor, 1.0);
+
+	long long skippedVoxels = 0;
+
+#pragma omp parallel for schedule(dynamic, 1) reduction(+ : skippedVoxels)
+	for (long long bu = 0; bu < blocksU; bu++)
+	{
+		if (*stop) continue;
+
+		const long long u1 = bu * blockSize;
+		const long long u2 = std::min(u1 + blockSize, plane.sizeU) - 1;
+
+		// centers of blocks in this row, which are not inside empty bigger blocks
+		std::vector<long long> blocks;
+		std::vector<double> xs, ys, zs;
+		for (long long bv = 0; bv < blocksV; bv++)
+		{
+			const long long v1 = bv * blockSize;
+			if (skipped[u1 * plane.sizeV + v1]) continue;
+			const long long v2 = std::min(v1 + blockSize, plane.sizeV) - 1;
+
+			CVector3 center =
+				plane.origin + plane.stepU * (0.5 * (u1 + u2)) + plane.stepV * (0.5 * (v1 + v2));
+			blocks.push_back(bv);
+			xs.push_back(center.x);
+			ys.push_back(center.y);
+			zs.push_back(center.z);
+		}
+		if (blocks.empty()) continue;
+
+		std::vector<sDistanceOut> distanceOut(blocks.size());
+		const sDistanceBatchIn distanceIn(
+			xs.data(), ys.data(), zs.data(), int(blocks.size()), distThresh, false);
+		CalculateDistanceBatch(*params, *fractals, distanceIn, distanceOut.data(), renderData);
+
+		for (size_t n = 0; n < blocks.size(); n++)
+		{
+			const long long v1 = blocks[n] * blockSize;
+			const long long v2 = std::min(v1 + blockSize, plane.sizeV) - 1;
+
+			// distance from the center to the farthest voxel of the block
+			const double sizeU = (u2 - u1) * stepULength;
+			const double sizeV = (v2 - v1) * stepVLength;
+			const double radius = 0.5 * sqrt(sizeU * sizeU + sizeV * sizeV);
+
+			// lower limit of distance for all voxels of the block. There has to be a margin of one
+			// voxel, because edges between voxels of neighbouring blocks are also used by mesh export
+			const double emptyDistance = distanceOut[n].distance * deFactor - radius;
+			if (emptyDistance <= distThresh + voxelStep) continue;
+
+			for (long long u = u1; u <= u2; u++)
+			{
+				for (long long v = v1; v <= v2; v++)
+				{
+					skipped[u * plane.sizeV + v] = 1;
+					distances[u * plane.strideU + v * plane.strideV] = emptyDistance;
+				}
+			}
+			skippedVoxels += (u2 - u1 + 1) * (v2 - v1 + 1);
+		}
+	}
+
+	numberOfSkippedVoxels += skippedVoxels;
+}
+
+void cSparseVoxelPlane::CalculateVoxels(
+	const sVoxelPlane &plane, double *distances, double *colorIndices, bool *stop)
+{
+	long long calculatedVoxels = 0;
+
+	// every thread calculates whole rows of voxels, which are computed in batches
+#pragma omp parallel for schedule(dynamic, 1) reduction(+ : calculatedVoxels)
+	for (long long u = 0; u < plane.sizeU; u++)
+	{
+		if (*stop) continue;
+
+		std::vector<long long> vs;
+		std::vector<double> xs, ys, zs;
+		for (long long v = 0; v < plane.sizeV; v++)
+		{
+			if (skipped[u * plane.sizeV + v])
+			{
+				// there is no surface near empty voxels, so their color doesn't matter. It only has
+				// to be defined, because the buffer still contains values of the previous plane
+				if (colorIndices) colorIndices[u * plane.strideU + v * plane.strideV] = 0.0;
+				continue;
+			}
+
+			CVector3 point = plane.origin + plane.stepU * double(u) + plane.stepV * double(v);
+			vs.push_back(v);
+			xs.push_back(point.x);
+			ys.push_back(point.y);
+			zs.push_back(point.z);
+		}
+		if (vs.empty()) continue;
+
+		std::vector<sDistanceOut> distanceOut(vs.size());
+		const sDistanceBatchIn distanceIn(
+			xs.data(), ys.data(), zs.data(), int(vs.size()), distThresh, false);
+		CalculateDistanceBatch(*params, *fractals, distanceIn, distanceOut.data(), renderData);
+
+		for (size_t n = 0; n < vs.size(); n++)
+		{
+			const long long address = u * plane.strideU + vs[n] * plane.strideV;
+			distances[address] = distanceOut[n].distance;
+
+			if (colorIndices)
+			{
+				const cMaterial *material = renderData->objects.at(distanceOut[n].objectId).material;
+
+				sFractalIn fractIn(
+					CVector3(xs[n], ys[n], zs[n]), params->minN, params->N, params->common, -1, material);
+				sFractalOut fractOut;
+
+				Compute<fractal::calcModeColouring>(*fractals, fractIn, &fractOut);
+
+				colorIndices[address] = fractOut.colorIndex;
+			}
+		}
+		calculatedVoxels += vs.size();
+	}
+
+	numberOfCalculatedVoxels += calculatedVoxels;
+}
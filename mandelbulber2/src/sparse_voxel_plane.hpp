@@ -0,0 +1,101 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cSparseVoxelPlane - calculates distances for a plane of voxels for voxel and mesh export
+ *
+ * In sparse mode the plane is divided into blocks of voxels. The distance is calculated
+ * in the center of every block and when it is bigger than the distance to any voxel of
+ * the block, the whole block is empty and its voxels are not calculated one by one.
+ * Blocks which are not empty are divided into smaller blocks and the test is repeated.
+ * Only voxels near the surface are calculated with full resolution.
+ */
+
+#ifndef MANDELBULBER2_SRC_SPARSE_VOXEL_PLANE_HPP_
+#define MANDELBULBER2_SRC_SPARSE_VOXEL_PLANE_HPP_
+
+#include <vector>
+
+#include "algebra.hpp"
+
+// forward declarations
+class cNineFractals;
+struct sParamRender;
+struct sRenderData;
+
+// voxel (u, v) is placed at origin + u * stepU + v * stepV and stored at index
+// u * strideU + v * strideV. stepU and stepV have to be perpendicular
+struct sVoxelPlane
+{
+	CVector3 origin;
+	CVector3 stepU;
+	CVector3 stepV;
+	long long sizeU;
+	long long sizeV;
+	long long strideU;
+	long long strideV;
+};
+
+class cSparseVoxelPlane
+{
+public:
+	// voxelStep is the biggest distance between neighbouring voxels in the volume
+	cSparseVoxelPlane(const sParamRender *params, const cNineFractals *fractals,
+		sRenderData *renderData, double distThresh, double voxelStep, bool sparse);
+
+	// calculates distances for all voxels of the plane. Empty voxels which were skipped get
+	// distance bigger than distThresh and color index 0. Color indices are calculated only when
+	// colorIndices is not nullptr (needs renderData)
+	void Calculate(const sVoxelPlane &plane, double *distances, double *colorIndices, bool *stop);
+
+	long long GetNumberOfCalculatedVoxels() const { return numberOfCalculatedVoxels; }
+	long long GetNumberOfSkippedVoxels() const { return numberOfSkippedVoxels; }
+
+private:
+	void CalculateEmptyBlocks(
+		const sVoxelPlane &plane, int blockSize, double *distances, bool *stop);
+	void CalculateVoxels(
+		const sVoxelPlane &plane, double *distances, double *colorIndices, bool *stop);
+
+	const sParamRender *params;
+	const cNineFractals *fractals;
+	sRenderData *renderData;
+	double distThresh;
+	double voxelStep;
+	bool sparse;
+
+	// marks voxels which belong to empty blocks
+	std::vector<char> skipped;
+
+	long long numberOfCalculatedVoxels;
+	long long numberOfSkippedVoxels;
+};
+
+#endif /* MANDELBULBER2_SRC_SPARSE_VOXEL_PLANE_HPP_ */
@@ -42,6 +42,7 @@
 #include "color_structures.hpp"
 #include "common_math.h"
 #include "fractparams.hpp"
+#include "pixel_random.hpp"
 #include "render_data.hpp"
 
 cSSAOWorker::cSSAOWorker(
@@ -69,6 +70,20 @@ void cSSAOWorker::doWork()
 	int startX = threadData->region.x1;
 	int endX = threadData->region.x2;
 
+	// origin and size of the frame used to calculate view directions. In tiled rendering the image
+	// contains only a tile of the whole frame
+	int frameX1 = startX;
+	int frameY1 = startLine;
+	int frameWidth = width;
+	int frameHeight = height;
+	if (data->tiledRendering)
+	{
+		frameX1 = -data->tileOffset.x;
+		frameY1 = -data->tileOffset.y;
+		frameWidth = params->imageWidth;
+		frameHeight = params->imageHeight;
+	}
+
 	double *cosine = new double[quality];
 	double *sine = new double[quality];
 	for (int i = 0; i < quality; i++)
@@ -79,8 +94,8 @@ void cSSAOWorker::doWork()
 
 	params::enumPerspectiveType perspectiveType = params->perspectiveType;
 
-	double scale_factor = double(width) / (quality * quality) / 2.0;
-	double aspectRatio = double(width) / height;
+	double scale_factor = double(frameWidth) / (quality * quality) / 2.0;
+	double aspectRatio = double(frameWidth) / frameHeight;
 
 	if (perspectiveType == params::perspEquirectangular) aspectRatio = 2.0;
 
@@ -122,8 +137,8 @@ void cSSAOWorker::doWork()
 				double x2, y2;
 				if (perspectiveType == params::perspFishEye || perspectiveType == params::perspFishEyeCut)
 				{
-					x2 = M_PI * (double(x - startX) / width - 0.5) * aspectRatio;
-					y2 = M_PI * (double(y - startLine) / height - 0.5);
+					x2 = M_PI * (double(x - frameX1) / frameWidth - 0.5) * aspectRatio;
+					y2 = M_PI * (double(y - frameY1) / frameHeight - 0.5);
 					double r = sqrt(x2 * x2 + y2 * y2);
 					if (r != 0.0)
 					{
@@ -133,15 +148,15 @@ void cSSAOWorker::doWork()
 				}
 				else if (perspectiveType == params::perspEquirectangular)
 				{
-					x2 = M_PI * (double(x - startX) / width - 0.5) * aspectRatio;
-					y2 = M_PI * (double(y - startLine) / height - 0.5);
+					x2 = M_PI * (double(x - frameX1) / frameWidth - 0.5) * aspectRatio;
+					y2 = M_PI * (double(y - frameY1) / frameHeight - 0.5);
 					x2 = sin(fov * x2) * cos(fov * y2) * z;
 					y2 = sin(fov * y2) * z;
 				}
 				else
 				{
-					x2 = (double(x - startX) / width - 0.5) * aspectRatio;
-					y2 = double(y - startLine) / height - 0.5;
+					x2 = (double(x - frameX1) / frameWidth - 0.5) * aspectRatio;
+					y2 = double(y - frameY1) / frameHeight - 0.5;
 					x2 = x2 * z * fov;
 					y2 = y2 * z * fov;
 				}
@@ -151,7 +166,11 @@ void cSSAOWorker::doWork()
 				int maxRandom = 62831 / quality;
 				double rRandom = 1.0;
 
-				if (params->SSAO_random_mode) rRandom = 0.5 + Random(65536) / 65536.0;
+				// random numbers depend only on the pixel, so the noise is the same for any thread
+				cPixelRandom random;
+				random.SetKey(x + data->tileOffset.x, y + data->tileOffset.y, 0, params->frameNo);
+
+				if (params->SSAO_random_mode) rRandom = 0.5 + random.Random(65536) / 65536.0;
 
 				for (int angleIndex = 0; angleIndex < quality; angleIndex++)
 				{
@@ -159,7 +178,7 @@ void cSSAOWorker::doWork()
 					double angle = angleIndex;
 					if (params->SSAO_random_mode)
 					{
-						angle = angleStep * angleIndex + Random(maxRandom) / 10000.0;
+						angle = angleStep * angleIndex + random.Random(maxRandom) / 10000.0;
 						ca = cos(angle);
 						sa = sin(angle);
 					}
@@ -185,8 +204,8 @@ void cSSAOWorker::doWork()
 						if (perspectiveType == params::perspFishEye
 								|| perspectiveType == params::perspFishEyeCut)
 						{
-							xx2 = M_PI * ((xx - startX) / width - 0.5) * aspectRatio;
-							yy2 = M_PI * ((yy - startLine) / height - 0.5);
+							xx2 = M_PI * ((xx - frameX1) / frameWidth - 0.5) * aspectRatio;
+							yy2 = M_PI * ((yy - frameY1) / frameHeight - 0.5);
 							double r2 = sqrt(xx2 * xx2 + yy2 * yy2);
 							if (r != 0.0)
 							{
@@ -196,15 +215,15 @@ void cSSAOWorker::doWork()
 						}
 						else if (perspectiveType == params::perspEquirectangular)
 						{
-							xx2 = M_PI * ((xx - startX) / width - 0.5) * aspectRatio;
-							yy2 = M_PI * ((yy - startLine) / height - 0.5);
+							xx2 = M_PI * ((xx - frameX1) / frameWidth - 0.5) * aspectRatio;
+							yy2 = M_PI * ((yy - frameY1) / frameHeight - 0.5);
 							xx2 = sin(fov * xx2) * cos(fov * yy2) * z2;
 							yy2 = sin(fov * yy2) * z2;
 						}
 						else
 						{
-							xx2 = ((xx - startX) / width - 0.5) * aspectRatio;
-							yy2 = (yy - startLine) / height - 0.5;
+							xx2 = ((xx - frameX1) / frameWidth - 0.5) * aspectRatio;
+							yy2 = (yy - frameY1) / frameHeight - 0.5;
 							xx2 = xx2 * (z2 * fov);
 							yy2 = yy2 * (z2 * fov);
 						}
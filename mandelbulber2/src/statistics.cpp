@@ -41,6 +41,8 @@ cStatistics::cStatistics()
 	numberOfRaymarchings = 0;
 	numberOfRenderedPixels = 0;
 	totalNumberOfDOFRepeats = 0;
+	totalNumberOfAntiAliasingSamples = 0;
+	numberOfAntiAliasedPixels = 0;
 	totalNoise = 0;
 	time = 0.0;
 }
@@ -54,7 +56,27 @@ void cStatistics::Reset()
 	numberOfRaymarchings = 0;
 	numberOfRenderedPixels = 0;
 	totalNumberOfDOFRepeats = 0;
+	totalNumberOfAntiAliasingSamples = 0;
+	numberOfAntiAliasedPixels = 0;
+	totalNoise = 0;
 	time = 0.0;
 	histogramIterations.Clear();
 	histogramStepCount.Clear();
+	histogramAntiAliasingSamples.Clear();
+}
+
+// adds statistics collected by one rendering thread
+void cStatistics::Merge(const cStatistics &shard)
+{
+	totalNumberOfIterations += shard.totalNumberOfIterations;
+	missedDE += shard.missedDE;
+	numberOfRaymarchings += shard.numberOfRaymarchings;
+	numberOfRenderedPixels += shard.numberOfRenderedPixels;
+	totalNumberOfDOFRepeats += shard.totalNumberOfDOFRepeats;
+	totalNumberOfAntiAliasingSamples += shard.totalNumberOfAntiAliasingSamples;
+	numberOfAntiAliasedPixels += shard.numberOfAntiAliasedPixels;
+	totalNoise += shard.totalNoise;
+	histogramIterations.Merge(shard.histogramIterations);
+	histogramStepCount.Merge(shard.histogramStepCount);
+	histogramAntiAliasingSamples.Merge(shard.histogramAntiAliasingSamples);
 }
@@ -43,11 +43,14 @@ public:
 	~cStatistics();
 	cHistogram histogramIterations;
 	cHistogram histogramStepCount;
+	cHistogram histogramAntiAliasingSamples;
 	long long totalNumberOfIterations;
 	int missedDE;
 	int numberOfRaymarchings;
 	size_t numberOfRenderedPixels;
 	long long totalNumberOfDOFRepeats;
+	long long totalNumberOfAntiAliasingSamples;
+	size_t numberOfAntiAliasedPixels;
 	double totalNoise;
 	double time;
 	QString usedDEType;
@@ -65,7 +68,13 @@ public:
 		return double(totalNumberOfDOFRepeats) / numberOfRenderedPixels;
 	}
 	double GetAverageDOFNoise() const { return totalNoise / numberOfRenderedPixels; }
+	double GetAverageAntiAliasingSamples() const
+	{
+		if (numberOfAntiAliasedPixels == 0) return 1.0;
+		return double(totalNumberOfAntiAliasingSamples) / numberOfAntiAliasedPixels;
+	}
 	void Reset();
+	void Merge(const cStatistics &shard);
 };
 
 #endif /* MANDELBULBER2_SRC_STATISTICS_H_ */
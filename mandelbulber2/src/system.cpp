@@ -270,6 +270,7 @@ bool CreateDefaultFolders()
 	result &= CreateFolder(systemData.GetThumbnailsFolder());
 	result &= CreateFolder(systemData.GetToolbarFolder());
 	result &= CreateFolder(systemData.GetHttpCacheFolder());
+	result &= CreateFolder(systemData.GetNetRenderTexturesFolder());
 	result &= CreateFolder(systemData.GetCustomWindowStateFolder());
 	result &= CreateFolder(systemData.GetSettingsFolder());
 	result &= CreateFolder(systemData.GetSlicesFolder());
@@ -34,22 +34,54 @@
 
 #include "test.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QImage>
+#include <QProcess>
+
 #include "animation_flight.hpp"
 #include "animation_frames.hpp"
 #include "animation_keyframes.hpp"
+#include "calculate_distance.hpp"
 #include "cimage.hpp"
+#include "compute_fractal.hpp"
+#include "displacement_map.hpp"
+#include "dof.hpp"
+#include "file_mesh.hpp"
 #include "files.h"
+#include "fractal_container.hpp"
+#include "fractparams.hpp"
 #include "headless.h"
+#include "image_save_queue.hpp"
 #include "initparameters.hpp"
 #include "interface.hpp"
 #include "keyframes.hpp"
+#include "lights.hpp"
+#include "marchingcubes.h"
+#include "material.h"
 #include "netrender.hpp"
+#include "netrender_frame_scheduler.hpp"
+#include "netrender_texture_cache.hpp"
+#include "nine_fractals.hpp"
 #include "opencl_global.h"
 #include "opencl_hardware.h"
+#include "pixel_random.hpp"
+#include "primitives.h"
+#include "render_data.hpp"
 #include "render_job.hpp"
 #include "rendering_configuration.hpp"
+#include "sparse_voxel_plane.hpp"
 #include "settings.hpp"
+#include "statistics.h"
 #include "system.hpp"
+#include "texture.hpp"
+#include "texture_cache.hpp"
+#include "tiled_render.hpp"
+#include "undo.h"
 
 QString Test::testFolder()
 {
@@ -216,6 +248,271 @@ void Test::netrender() const
 	delete netRenderServer;
 }
 
+void Test::netrenderFrames() const
+{
+	if (IsBenchmarking()) return; // no reasonable generic network benchmark
+
+	// scheduling of frame ranges
+	QList<int> frames;
+	for (int i = 0; i < 100; i++)
+		frames.append(i);
+	cNetRenderFrameScheduler scheduler(frames, 1.0);
+	QCOMPARE(scheduler.AssignFrames(1), QList<int>({0}));
+	QCOMPARE(scheduler.AssignFrames(2), QList<int>({1}));
+	QVERIFY(scheduler.FrameDone(1, 0, 0.1));
+	QCOMPARE(scheduler.AssignFrames(1).size(), 10); // fast worker gets range for 1 second
+	QVERIFY(scheduler.FrameDone(2, 1, 1.0));
+	QCOMPARE(scheduler.AssignFrames(2), QList<int>({12}));
+	scheduler.WorkerLost(1); // frames 2 - 11 go back to queue
+	QCOMPARE(scheduler.AssignFrames(2), QList<int>({2}));
+
+	// idle worker helps the slowest one at the end of animation
+	cNetRenderFrameScheduler lastFrames(QList<int>({0, 1}), 1.0);
+	lastFrames.AssignFrames(1);
+	lastFrames.AssignFrames(2);
+	QVERIFY(lastFrames.FrameDone(1, 0, 0.1));
+	QCOMPARE(lastFrames.AssignFrames(1), QList<int>({1}));
+	QVERIFY(lastFrames.FrameDone(1, 1, 0.1));
+	QVERIFY(!lastFrames.FrameDone(2, 1, 0.2));
+	QVERIFY(lastFrames.IsFinished());
+
+	// rendering of keyframe animation by separate client processes over localhost
+	const int port = 5557;
+	const int numberOfClients = 2;
+	gNetRender->SetServer(port);
+
+	QList<QProcess *> clientProcesses;
+	for (int i = 0; i < numberOfClients; i++)
+	{
+		QProcess *process = new QProcess;
+		process->start(QCoreApplication::applicationFilePath(),
+			QStringList({"-n", "--host", "127.0.0.1", "--port", QString::number(port)}));
+		clientProcesses.append(process);
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	bool clientsReady = false;
+	while (!clientsReady && timer.elapsed() < 30000)
+	{
+		QTest::qWait(100);
+		clientsReady = gNetRender->GetClientCount() == numberOfClients;
+		for (int i = 0; i < gNetRender->GetClientCount(); i++)
+			if (gNetRender->GetClientStatus(i) != CNetRender::netRender_READY) clientsReady = false;
+	}
+
+	bool renderResult = false;
+	int savedFrames = 0;
+	int framesFromClients = 0;
+	if (clientsReady)
+	{
+		const QString exampleKeyframeFile =
+			QDir::toNativeSeparators(systemData.sharedDir + QDir::separator() + "examples"
+															 + QDir::separator() + "keyframe_anim_mandelbulb.fract");
+
+		cParameterContainer *testPar = new cParameterContainer;
+		cFractalContainer *testParFractal = new cFractalContainer;
+		cAnimationFrames *testAnimFrames = new cAnimationFrames;
+		cKeyframes *testKeyframes = new cKeyframes;
+
+		testPar->SetContainerName("main");
+		InitParams(testPar);
+		InitMaterialParams(1, testPar);
+		for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+		{
+			testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+			InitFractalParams(&testParFractal->at(i));
+		}
+		cImage *image = new cImage(testPar->Get<int>("image_width"), testPar->Get<int>("image_height"));
+
+		cSettings parSettings(cSettings::formatFullText);
+		parSettings.BeQuiet(true);
+		parSettings.LoadFromFile(exampleKeyframeFile);
+		parSettings.Decode(testPar, testParFractal, testAnimFrames, testKeyframes);
+		testPar->Set("image_width", 32);
+		testPar->Set("image_height", 32);
+		testPar->Set("keyframe_first_to_render", 50);
+		testPar->Set("keyframe_last_to_render", 70);
+		testPar->Set("anim_keyframe_dir", testFolder() + QDir::separator());
+		testPar->Set("netrender_distribute_frames", true);
+
+		cKeyframeAnimation *testKeyframeAnimation = new cKeyframeAnimation(
+			gMainInterface, testKeyframes, image, nullptr, testPar, testParFractal, nullptr);
+		renderResult = testKeyframeAnimation->slotRenderKeyframes();
+		savedFrames = QDir(testFolder()).entryList(QDir::Files).size();
+		for (int i = 0; i < gNetRender->GetClientCount(); i++)
+			framesFromClients += gNetRender->GetClient(i).framesRendered;
+
+		delete image;
+		delete testKeyframes;
+		delete testAnimFrames;
+		delete testParFractal;
+		delete testPar;
+		delete testKeyframeAnimation;
+	}
+
+	for (int i = gNetRender->GetClientCount() - 1; i >= 0; i--)
+		gNetRender->KickAndKillClient(i);
+	QTest::qWait(500);
+	for (QProcess *process : clientProcesses)
+	{
+		if (!process->waitForFinished(5000)) process->kill();
+		delete process;
+	}
+	gNetRender->DeleteServer();
+
+	QVERIFY2(clientsReady, "clients not connected to server.");
+	QVERIFY2(renderResult, "keyframe render failed.");
+	QCOMPARE(savedFrames, 20);
+	QVERIFY2(framesFromClients > 0, "no frame was rendered by clients.");
+}
+
+void Test::netrenderTextureCache() const
+{
+	if (IsBenchmarking()) return; // no reasonable generic network benchmark
+
+	QByteArray content(100000, 0);
+	for (int i = 0; i < content.size(); i++)
+		content[i] = char(i * 7 + i / 13);
+	const QString textureFile = testFolder() + QDir::separator() + "texture.bin";
+	QFile file(textureFile);
+	QVERIFY(file.open(QIODevice::WriteOnly));
+	file.write(content);
+	file.close();
+
+	// server side: hash of file and content for given hash
+	cNetRenderTextureCache serverCache(testFolder());
+	const QByteArray hash = serverCache.HashOfFile(textureFile);
+	QCOMPARE(hash, cNetRenderTextureCache::Hash(content));
+	QCOMPARE(serverCache.FileContent(hash), content);
+	QVERIFY(serverCache.HashOfFile(testFolder() + QDir::separator() + "missing.bin").isEmpty());
+
+	// client side: texture is kept in memory and on the disk
+	const QString cacheFolder = testFolder() + QDir::separator() + "cache";
+	CreateFolder(cacheFolder);
+	QByteArray data;
+	cNetRenderTextureCache clientCache(cacheFolder);
+	QVERIFY(!clientCache.Find(hash, &data));
+	clientCache.Insert(hash, content);
+	QVERIFY(clientCache.Find(hash, &data));
+	QCOMPARE(data, content);
+
+	cNetRenderTextureCache restartedClientCache(cacheFolder);
+	data.clear();
+	QVERIFY(restartedClientCache.Find(hash, &data));
+	QCOMPARE(data, content);
+
+	// corrupted file is not used
+	QFile cachedFile(cacheFolder + QDir::separator() + hash.toHex());
+	QVERIFY(cachedFile.open(QIODevice::WriteOnly));
+	cachedFile.write("corrupted");
+	cachedFile.close();
+	cNetRenderTextureCache corruptedClientCache(cacheFolder);
+	QVERIFY(!corruptedClientCache.Find(hash, &data));
+}
+
+void Test::netrenderThroughputWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { netrenderThroughput(); }
+	}
+	else
+	{
+		netrenderThroughput();
+	}
+}
+
+void Test::netrenderThroughput() const
+{
+	// sends rendered lines from client to server over localhost with every compression method
+	// and prints number of lines per second and CPU time per MB
+	const int width = IsBenchmarking() ? 200 * difficulty : 100;
+	const int linesPerMessage = 16;
+	const int numberOfMessages = IsBenchmarking() ? 500 : 10;
+	const int port = 5558;
+
+	QList<int> lineNumbers;
+	QList<QByteArray> lines;
+	for (int y = 0; y < linesPerMessage; y++)
+	{
+		QByteArray line(int(sizeof(sAllImageData)) * width, 0);
+		sAllImageData *pixels = reinterpret_cast<sAllImageData *>(line.data());
+		for (int x = 0; x < width; x++)
+		{
+			const float value = 0.5f + 0.5f * sinf(x * 0.05f) * cosf(y * 0.1f);
+			pixels[x].imageFloat = sRGBFloat(value, value * 0.5f, 1.0f - value);
+			pixels[x].alphaBuffer = 65535;
+			pixels[x].opacityBuffer = 65535;
+			pixels[x].colourBuffer = sRGB8(200, 100, 50);
+			pixels[x].zBuffer = 10.0f + value;
+		}
+		lineNumbers.append(y);
+		lines.append(line);
+	}
+	const double megabytes = double(numberOfMessages) * linesPerMessage * lines.first().size() / 1e6;
+
+	const int defaultCompression = gPar->Get<int>("netrender_compression");
+	const QStringList codecNames({"none", "lzo", "zlib"});
+	for (int codec = 0; codec < codecNames.size(); codec++)
+	{
+		gPar->Set("netrender_compression", codec);
+		CNetRender *netRenderServer = new CNetRender(1);
+		CNetRender *netRenderClient = new CNetRender(1);
+		netRenderServer->SetServer(port);
+		netRenderClient->SetClient("127.0.0.1", port);
+
+		QElapsedTimer timer;
+		timer.start();
+		while (netRenderClient->GetStatus() != CNetRender::netRender_READY && timer.elapsed() < 5000)
+			QTest::qWait(10);
+		netRenderServer->SendSetup(0, 1, QList<int>());
+		QTest::qWait(100);
+		QCOMPARE(netRenderServer->GetClientCount(), 1);
+		QCOMPARE(netRenderServer->GetClient(0).codec, codec);
+
+		QEventLoop loop;
+		QTimer watchdog;
+		watchdog.setSingleShot(true);
+		QObject::connect(&watchdog, SIGNAL(timeout()), &loop, SLOT(quit()));
+		int receivedLines = 0;
+		bool dataCorrect = true;
+		QObject::connect(netRenderServer, &CNetRender::NewLinesArrived,
+			[&](QList<int> receivedLineNumbers, QList<QByteArray> receivedData) {
+				receivedLines += receivedLineNumbers.size();
+				if (receivedLineNumbers != lineNumbers || receivedData != lines) dataCorrect = false;
+				loop.quit();
+			});
+
+		timer.restart();
+		const std::clock_t cpuStart = std::clock();
+		for (int i = 0; i < numberOfMessages; i++)
+		{
+			// the same like in rendering: next lines are sent after acknowledge
+			netRenderClient->SendRenderedLines(lineNumbers, lines);
+			watchdog.start(10000);
+			while (receivedLines < (i + 1) * linesPerMessage && watchdog.isActive())
+				loop.exec();
+		}
+		const double seconds = qMax(timer.nsecsElapsed() / 1e9, 1e-9);
+		const double cpuSeconds = double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+		WriteLogCout(QString("compression: %1 lines/s: %2 MB/s: %3 CPU time per MB: %4 ms\n")
+									 .arg(codecNames.at(codec))
+									 .arg(receivedLines / seconds, 0, 'f', 0)
+									 .arg(megabytes / seconds, 0, 'f', 1)
+									 .arg(1000.0 * cpuSeconds / megabytes, 0, 'f', 2),
+			1);
+
+		delete netRenderClient;
+		delete netRenderServer;
+
+		QCOMPARE(receivedLines, numberOfMessages * linesPerMessage);
+		QVERIFY2(dataCorrect, "received lines are different than sent ones.");
+	}
+	gPar->Set("netrender_compression", defaultCompression);
+}
+
 void Test::testFlightWrapper() const
 {
 	if (IsBenchmarking())
@@ -560,3 +857,2377 @@ void Test::renderImageSave() const
 	delete testParFractal;
 	delete testPar;
 }
+
+void Test::renderThreadScalingWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { renderThreadScaling(); }
+	}
+	else
+	{
+		renderThreadScaling();
+	}
+}
+
+void Test::renderThreadScaling() const
+{
+	// this renders the same image with 1, 2, 4 ... N threads
+	// and prints the render time and speedup for each number of threads
+	const QString simpleExampleFileName =
+		QDir::toNativeSeparators(systemData.sharedDir + QDir::separator() + "examples"
+														 + QDir::separator() + "mandelbox001.fract");
+
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	cAnimationFrames *testAnimFrames = new cAnimationFrames;
+	cKeyframes *testKeyframes = new cKeyframes;
+
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	/****************** TEMPORARY CODE FOR MATERIALS *******************/
+
+	InitMaterialParams(1, testPar);
+
+	/*******************************************************************/
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+	bool stopRequest = false;
+	cImage *image = new cImage(testPar->Get<int>("image_width"), testPar->Get<int>("image_height"));
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+
+	cSettings parSettings(cSettings::formatFullText);
+	parSettings.BeQuiet(true);
+	parSettings.LoadFromFile(simpleExampleFileName);
+	parSettings.Decode(testPar, testParFractal, testAnimFrames, testKeyframes);
+	testPar->Set("image_width", IsBenchmarking() ? 40 * difficulty : 100);
+	testPar->Set("image_height", IsBenchmarking() ? 20 * difficulty : 50);
+
+	const int maxNumberOfThreads = systemData.numberOfThreads;
+	QList<int> threadCounts;
+	for (int threads = 1; threads < maxNumberOfThreads; threads *= 2)
+		threadCounts.append(threads);
+	threadCounts.append(maxNumberOfThreads);
+
+	qint64 singleThreadTime = 0;
+	for (int threads : threadCounts)
+	{
+		systemData.numberOfThreads = threads;
+		QElapsedTimer timer;
+		timer.start();
+
+		cRenderJob *renderJob = new cRenderJob(testPar, testParFractal, image, &stopRequest);
+		renderJob->Init(cRenderJob::still, config);
+
+		if (IsBenchmarking())
+			renderJob->Execute();
+		else
+			QVERIFY2(renderJob->Execute(), "thread scaling render failed.");
+		delete renderJob;
+
+		qint64 elapsed = qMax(timer.elapsed(), qint64(1));
+		if (threads == 1) singleThreadTime = elapsed;
+		WriteLogCout(QString("threads: %1 render time: %2 ms speedup: %3\n")
+									 .arg(threads)
+									 .arg(elapsed)
+									 .arg(double(singleThreadTime) / elapsed, 0, 'f', 2),
+			1);
+	}
+	systemData.numberOfThreads = maxNumberOfThreads;
+
+	delete image;
+	delete testKeyframes;
+	delete testAnimFrames;
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::singleFormulaLoopWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { singleFormulaLoop(); }
+	}
+	else
+	{
+		singleFormulaLoop();
+	}
+}
+
+void Test::singleFormulaLoop() const
+{
+	// this computes the same grid of points with the specialized single formula loop
+	// and with the general iteration loop, checks if results are the same
+	// and prints the time of one iteration for both loops
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	const QList<fractal::enumFractalFormula> formulas = {
+		fractal::mandelbulb, fractal::mandelbox, fractal::mengerSponge, fractal::quaternion};
+	const int gridSize = IsBenchmarking() ? 10 * difficulty : 20;
+
+	for (fractal::enumFractalFormula formula : formulas)
+	{
+		testPar->Set("formula", 1, int(formula));
+		sParamRender *params = new sParamRender(testPar);
+		cNineFractals *fractals = new cNineFractals(testParFractal, testPar);
+		QVERIFY2(fractals->GetSingleFormulaLoop() != fractal::singleFormulaLoopNone,
+			"single formula loop not selected.");
+
+		QVector<sFractalOut> results[2];
+		qint64 elapsed[2];
+		qint64 totalIters[2];
+		for (int pass = 0; pass < 2; pass++)
+		{
+			// second pass with general loop
+			if (pass == 1) fractals->DisableSingleFormulaLoop();
+
+			results[pass].resize(gridSize * gridSize * gridSize);
+			totalIters[pass] = 0;
+			QElapsedTimer timer;
+			timer.start();
+			int index = 0;
+			for (int x = 0; x < gridSize; x++)
+			{
+				for (int y = 0; y < gridSize; y++)
+				{
+					for (int z = 0; z < gridSize; z++)
+					{
+						CVector3 point = CVector3(x, y, z) * (3.0 / gridSize) - CVector3(1.5, 1.5, 1.5);
+						sFractalIn fractIn(point, params->minN, params->N, params->common, -1);
+						sFractalOut &fractOut = results[pass][index++];
+						fractOut.colorIndex = 0.0;
+						Compute<fractal::calcModeNormal>(*fractals, fractIn, &fractOut);
+						totalIters[pass] += fractOut.iters;
+					}
+				}
+			}
+			elapsed[pass] = qMax(timer.nsecsElapsed(), qint64(1));
+		}
+
+		for (int i = 0; i < results[0].size(); i++)
+		{
+			QCOMPARE(results[0][i].iters, results[1][i].iters);
+			QCOMPARE(results[0][i].distance, results[1][i].distance);
+		}
+
+		const double timeSpecialized = double(elapsed[0]) / qMax(totalIters[0], qint64(1));
+		const double timeGeneral = double(elapsed[1]) / qMax(totalIters[1], qint64(1));
+		WriteLogCout(
+			QString("formula: %1 iteration time: specialized %2 ns, general %3 ns, speedup: %4\n")
+				.arg(fractalList[cNineFractals::GetIndexOnFractalList(formula)].nameInComboBox)
+				.arg(timeSpecialized, 0, 'f', 2)
+				.arg(timeGeneral, 0, 'f', 2)
+				.arg(timeGeneral / timeSpecialized, 0, 'f', 2),
+			1);
+
+		delete fractals;
+		delete params;
+	}
+
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::statisticsShardingWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { statisticsSharding(); }
+	}
+	else
+	{
+		statisticsSharding();
+	}
+}
+
+void Test::statisticsSharding() const
+{
+	// this renders the same image with 1 thread and with all threads. Every thread collects
+	// statistics of ray-marching on its own and merges them after every line, so the totals
+	// have to be the same for any number of threads. It prints render time and iterations per
+	// second for both renders
+	const QString simpleExampleFileName =
+		QDir::toNativeSeparators(systemData.sharedDir + QDir::separator() + "examples"
+														 + QDir::separator() + "mandelbox001.fract");
+
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	cAnimationFrames *testAnimFrames = new cAnimationFrames;
+	cKeyframes *testKeyframes = new cKeyframes;
+
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+	bool stopRequest = false;
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+
+	cSettings parSettings(cSettings::formatFullText);
+	parSettings.BeQuiet(true);
+	parSettings.LoadFromFile(simpleExampleFileName);
+	parSettings.Decode(testPar, testParFractal, testAnimFrames, testKeyframes);
+	const int width = IsBenchmarking() ? 40 * difficulty : 100;
+	const int height = IsBenchmarking() ? 20 * difficulty : 50;
+	testPar->Set("image_width", width);
+	testPar->Set("image_height", height);
+	cImage *image = new cImage(width, height);
+
+	const int maxNumberOfThreads = systemData.numberOfThreads;
+	const QList<int> threadCounts = {1, maxNumberOfThreads};
+	QList<cStatistics> statistics;
+
+	for (int threads : threadCounts)
+	{
+		systemData.numberOfThreads = threads;
+		QElapsedTimer timer;
+		timer.start();
+
+		cRenderJob *renderJob = new cRenderJob(testPar, testParFractal, image, &stopRequest);
+		renderJob->Init(cRenderJob::still, config);
+		QVERIFY2(renderJob->Execute(), "statistics render failed.");
+		statistics.append(renderJob->GetStatistics());
+		delete renderJob;
+
+		const qint64 elapsed = qMax(timer.elapsed(), qint64(1));
+		WriteLogCout(QString("threads: %1 render time: %2 ms, %3 Miterations/s\n")
+									 .arg(threads)
+									 .arg(elapsed)
+									 .arg(statistics.last().totalNumberOfIterations / (elapsed * 1000.0), 0, 'f', 2),
+			1);
+	}
+	systemData.numberOfThreads = maxNumberOfThreads;
+
+	// no counter can be lost when statistics are merged from many threads
+	for (const cStatistics &oneStatistics : statistics)
+	{
+		QCOMPARE(oneStatistics.numberOfRenderedPixels, size_t(width * height));
+		QVERIFY(oneStatistics.totalNumberOfIterations > 0);
+	}
+	QCOMPARE(statistics.last().totalNumberOfIterations, statistics.first().totalNumberOfIterations);
+	QCOMPARE(statistics.last().numberOfRaymarchings, statistics.first().numberOfRaymarchings);
+	QCOMPARE(statistics.last().histogramIterations.GetCount(),
+		statistics.first().histogramIterations.GetCount());
+
+	delete image;
+	delete testKeyframes;
+	delete testAnimFrames;
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::pixelRandomWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { pixelRandom(); }
+	}
+	else
+	{
+		pixelRandom();
+	}
+}
+
+void Test::pixelRandom() const
+{
+	// random numbers generated for every pixel have to be the same for any number of threads
+	const int width = IsBenchmarking() ? 64 * difficulty : 256;
+	const int height = width;
+	const int samples = 4;
+	const int numbersPerSample = 16;
+
+	QVector<double> reference;
+	for (int threads = 1; threads <= qMax(4, systemData.numberOfThreads); threads *= 2)
+	{
+		QVector<double> sums(width * height, 0.0);
+
+#pragma omp parallel for num_threads(threads) schedule(dynamic, 1)
+		for (int y = 0; y < height; y++)
+		{
+			cPixelRandom random;
+			for (int x = 0; x < width; x++)
+			{
+				double sum = 0.0;
+				for (int sample = 0; sample < samples; sample++)
+				{
+					random.SetKey(x, y, sample, 0);
+					for (int i = 0; i < numbersPerSample; i++)
+						sum += random.RandomDouble();
+				}
+				sums[x + y * width] = sum;
+			}
+		}
+
+		if (reference.isEmpty())
+		{
+			reference = sums;
+			double mean = 0.0;
+			for (double sum : sums)
+				mean += sum;
+			mean /= double(width) * height * samples * numbersPerSample;
+			WriteLogCout(QString("pixel random mean value: %1\n").arg(mean), 1);
+			QVERIFY(fabs(mean - 0.5) < 0.01);
+		}
+		else
+		{
+			QVERIFY(sums == reference);
+		}
+	}
+
+	// batch has to give the same numbers as single calls
+	cPixelRandom random1, random2;
+	random1.SetKey(10, 20, 3, 7);
+	random2.SetKey(10, 20, 3, 7);
+	double batch[numbersPerSample];
+	random1.RandomBatch(batch, numbersPerSample);
+	for (int i = 0; i < numbersPerSample; i++)
+		QCOMPARE(batch[i], random2.RandomDouble());
+
+	// the same range as global Random(max)
+	for (int i = 0; i < 10000; i++)
+	{
+		int value = random1.Random(10);
+		QVERIFY(value >= 0 && value <= 10);
+	}
+}
+
+void Test::imageLayersWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { imageLayers(); }
+	}
+	else
+	{
+		imageLayers();
+	}
+}
+
+void Test::imageLayers() const
+{
+	// half float conversion
+	const float values[] = {0.0f, 1.0f, 0.5f, -2.25f, 0.1f, 1e-5f, 3.14159f, 65504.0f};
+	for (float value : values)
+	{
+		float converted = HalfToFloat(FloatToHalf(value));
+		QVERIFY(fabs(converted - value) <= fabs(value) * 1e-3f + 1e-7f);
+	}
+	QVERIFY(HalfToFloat(FloatToHalf(1e6f)) > 65504.0f); // infinity
+
+	// optional layers stored as half floats, 8-bit layers allocated only when converted
+	const int size = IsBenchmarking() ? 512 * difficulty : 512;
+	sImageOptional optional;
+	optional.optionalNormal = true;
+	optional.optionalSpecular = true;
+	optional.optionalHalfFloat = true;
+	cImage image(1, 1, true);
+	QVERIFY(image.ChangeSize(size, size, optional));
+
+	const int usedMBBefore = image.GetUsedMB();
+	WriteLogCout(image.GetMemoryReport() + "\n", 1);
+	QVERIFY(usedMBBefore < image.GetUsedMBAllLayersAllocated());
+
+	image.PutPixelNormal(10, 20, sRGBFloat(0.25f, 0.5f, 0.75f));
+	sRGBFloat normal = image.GetPixelNormal(10, 20);
+	QCOMPARE(normal.R, 0.25f);
+	QCOMPARE(normal.G, 0.5f);
+	QCOMPARE(normal.B, 0.75f);
+
+	image.ConvertTo8bit();
+	image.ConvertNormalTo8Bit();
+	QVERIFY(image.GetUsedMB() > usedMBBefore);
+	QCOMPARE(int(image.GetPixelNormal8(10, 20).G), 127);
+}
+
+void Test::tiledRenderWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { tiledRender(); }
+	}
+	else
+	{
+		tiledRender();
+	}
+}
+
+void Test::tiledRender() const
+{
+	// tiles have to cover the whole frame without overlapping
+	const int tileFrameWidth = 101;
+	const int tileFrameHeight = 37;
+	for (int tiles = 1; tiles <= 8; tiles++)
+	{
+		QVector<int> coverage(tileFrameWidth * tileFrameHeight, 0);
+		for (int i = 0; i < tiles * tiles; i++)
+		{
+			cRegion<int> tile = cTiledRenderer::TileRegion(tileFrameWidth, tileFrameHeight, tiles, i);
+			for (int y = tile.y1; y < tile.y2; y++)
+				for (int x = tile.x1; x < tile.x2; x++)
+					coverage[x + y * tileFrameWidth]++;
+		}
+		QCOMPARE(coverage.count(1), coverage.size());
+	}
+
+	// image rendered in tiles has to be the same as rendered in one piece
+	const QString simpleExampleFileName =
+		QDir::toNativeSeparators(systemData.sharedDir + QDir::separator() + "examples"
+														 + QDir::separator() + "mandelbox001.fract");
+
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	cAnimationFrames *testAnimFrames = new cAnimationFrames;
+	cKeyframes *testKeyframes = new cKeyframes;
+
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	cSettings parSettings(cSettings::formatFullText);
+	parSettings.BeQuiet(true);
+	parSettings.LoadFromFile(simpleExampleFileName);
+	parSettings.Decode(testPar, testParFractal, testAnimFrames, testKeyframes);
+	const int width = IsBenchmarking() ? 40 * difficulty : 120;
+	const int height = IsBenchmarking() ? 30 * difficulty : 90;
+	testPar->Set("image_width", width);
+	testPar->Set("image_height", height);
+	testPar->Set("opencl_enabled", false);
+	testPar->Set("tiles", 3);
+
+	bool stopRequest = false;
+	cImage *image = new cImage(width, height);
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+	cRenderJob *renderJob = new cRenderJob(testPar, testParFractal, image, &stopRequest);
+	renderJob->Init(cRenderJob::still, config);
+	QVERIFY2(renderJob->Execute(), "example render failed.");
+	delete renderJob;
+
+	const QString tiledFileName = testFolder() + QDir::separator() + "tiled.png";
+	cTiledRenderer tiledRenderer(testPar, testParFractal, &stopRequest);
+	QVERIFY2(tiledRenderer.RenderAndSave(tiledFileName, false), "tiled render failed.");
+
+	QImage tiledImage(tiledFileName);
+	QCOMPARE(tiledImage.width(), width);
+	QCOMPARE(tiledImage.height(), height);
+
+	double totalDifference = 0.0;
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			sRGB16 pixel = image->GetPixelImage16(x, y);
+			QRgb tiledPixel = tiledImage.pixel(x, y);
+			totalDifference += abs((pixel.R >> 8) - qRed(tiledPixel))
+												 + abs((pixel.G >> 8) - qGreen(tiledPixel))
+												 + abs((pixel.B >> 8) - qBlue(tiledPixel));
+		}
+	}
+	// small differences are allowed because of rounding of pixel coordinates
+	QVERIFY(totalDifference / (width * height * 3) < 1.0);
+
+	delete image;
+	delete testKeyframes;
+	delete testAnimFrames;
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::imageCompileWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { imageCompile(); }
+	}
+	else
+	{
+		imageCompile();
+	}
+}
+
+void Test::imageCompile() const
+{
+	// compares fused and vectorised CompileImageAndConvertTo8bit() with per pixel conversion
+	const int width = IsBenchmarking() ? 400 * difficulty : 640;
+	const int height = IsBenchmarking() ? 300 * difficulty : 480;
+	cImage image(width, height);
+
+	sImageAdjustments adjustments;
+	adjustments.brightness = 1.2f;
+	adjustments.contrast = 1.1f;
+	adjustments.imageGamma = 2.2f;
+	adjustments.saturation = 1.3f;
+	adjustments.hdrEnabled = true;
+	image.SetImageParameters(adjustments);
+
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			float blue = float((x * 7 + y * 13) % 256) / 64.0f;
+			image.PutPixelPostImage(
+				x, y, sRGBFloat(float(x) / width * 2.0f, float(y) / height, blue));
+		}
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	QVector<sRGB8> reference(width * height);
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			sRGB16 pixel = image.CalculatePixel(image.GetPixelPostImage(x, y));
+			reference[x + y * width] = sRGB8(pixel.R / 256, pixel.G / 256, pixel.B / 256);
+		}
+	}
+	qint64 referenceTime = qMax(timer.nsecsElapsed(), qint64(1));
+
+	timer.restart();
+	sRGB8 *image8 = reinterpret_cast<sRGB8 *>(image.CompileImageAndConvertTo8bit());
+	qint64 fusedTime = qMax(timer.nsecsElapsed(), qint64(1));
+
+	WriteLogCout(QString("image compile %1x%2: per pixel %3 ms, fused %4 ms, speedup: %5\n")
+								 .arg(width)
+								 .arg(height)
+								 .arg(referenceTime / 1e6, 0, 'f', 2)
+								 .arg(fusedTime / 1e6, 0, 'f', 2)
+								 .arg(double(referenceTime) / fusedTime, 0, 'f', 2),
+		1);
+
+	// vectorised code can differ by rounding
+	int maxDifference = 0;
+	for (int i = 0; i < width * height; i++)
+	{
+		maxDifference = qMax(maxDifference, abs(int(image8[i].R) - int(reference[i].R)));
+		maxDifference = qMax(maxDifference, abs(int(image8[i].G) - int(reference[i].G)));
+		maxDifference = qMax(maxDifference, abs(int(image8[i].B) - int(reference[i].B)));
+	}
+	QVERIFY(maxDifference <= 1);
+
+	// separate passes give the same result
+	QVector<sRGB8> fused(image8, image8 + width * height);
+	image.CompileImage();
+	image.ConvertTo8bit();
+	QVERIFY(memcmp(fused.data(), image.GetImage8Ptr(), sizeof(sRGB8) * width * height) == 0);
+}
+
+void Test::undoDeltaWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { undoDelta(); }
+	}
+	else
+	{
+		undoDelta();
+	}
+}
+
+void Test::undoDelta() const
+{
+	// stores single parameter changes and checks if undo / redo restore complete state
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	cUndo undo;
+	bool refreshFrames = false;
+	bool refreshKeyframes = false;
+	const int steps = IsBenchmarking() ? 100 * difficulty : 20;
+
+	undo.Store(testPar, testParFractal);
+	for (int i = 1; i <= steps; i++)
+	{
+		testPar->Set("N", i);
+		testParFractal->at(1).Set("power", double(i));
+		undo.Store(testPar, testParFractal);
+	}
+	// nothing changed, so nothing should be stored
+	undo.Store(testPar, testParFractal);
+	QCOMPARE(undo.GetNumberOfRecords(), steps);
+
+	// every record holds only two changed parameters
+	QVERIFY(undo.GetUsedMemory() < qint64(steps) * 2 * 1024);
+
+	for (int i = steps - 1; i >= 0; i--)
+	{
+		QVERIFY(undo.Undo(
+			testPar, testParFractal, nullptr, nullptr, &refreshFrames, &refreshKeyframes));
+		if (i > 0)
+		{
+			QCOMPARE(testPar->Get<int>("N"), i);
+			QCOMPARE(testParFractal->at(1).Get<double>("power"), double(i));
+		}
+	}
+
+	cParameterContainer initialPar;
+	initialPar.SetContainerName("main");
+	InitParams(&initialPar);
+	InitMaterialParams(1, &initialPar);
+	QVERIFY(testPar->IsEqual(initialPar));
+
+	for (int i = 1; i <= steps; i++)
+	{
+		QVERIFY(undo.Redo(
+			testPar, testParFractal, nullptr, nullptr, &refreshFrames, &refreshKeyframes));
+		QCOMPARE(testPar->Get<int>("N"), i);
+		QCOMPARE(testParFractal->at(1).Get<double>("power"), double(i));
+	}
+	QVERIFY(!refreshFrames && !refreshKeyframes);
+
+	delete testPar;
+	delete testParFractal;
+}
+
+void Test::parameterAccessWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { parameterAccess(); }
+	}
+	else
+	{
+		parameterAccess();
+	}
+}
+
+void Test::parameterAccess() const
+{
+	// checks access by interned handles and measures building of render data from parameters
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	const sParameterHandle handleN = cParameterContainer::Handle("N");
+	const sParameterHandle handleFormula = cParameterContainer::Handle("formula", 2);
+	testPar->Set(handleN, 123);
+	QCOMPARE(testPar->Get<int>("N"), 123);
+	testPar->Set("formula", 2, int(fractal::mandelbox));
+	QCOMPARE(testPar->Get<int>(handleFormula), int(fractal::mandelbox));
+	QCOMPARE(cParameterNames::Name(handleFormula.id), QString("formula_2"));
+
+	// removing parameter keeps the remaining ones accessible
+	const QList<QString> listOfParameters = testPar->GetListOfParameters();
+	cParameterContainer copy = *testPar;
+	copy.DeleteParameter(listOfParameters.first());
+	QVERIFY(!copy.IfExists(listOfParameters.first()));
+	for (int i = 1; i < listOfParameters.size(); i++)
+	{
+		QVERIFY(copy.IfExists(listOfParameters[i]));
+		QCOMPARE(copy.Get<QString>(listOfParameters[i]), testPar->Get<QString>(listOfParameters[i]));
+	}
+	QCOMPARE(copy.GetListOfParameters().size(), listOfParameters.size() - 1);
+
+	// reference: previous storage of parameters in QMap with names as keys, locked by a mutex
+	QMap<QString, cOneParameter> referenceMap;
+	for (const QString &parameterName : listOfParameters)
+		referenceMap.insert(parameterName, testPar->GetAsOneParameter(parameterName));
+	QMutex referenceLock;
+
+	const int lookups = IsBenchmarking() ? 100000 * difficulty : 10000;
+	QElapsedTimer timer;
+	qint64 sum = 0;
+	timer.start();
+	for (int i = 0; i < lookups; i++)
+	{
+		QMutexLocker lock(&referenceLock);
+		sum += referenceMap.find("N").value().Get<int>(valueActual);
+	}
+	const double nsPerMapLookup = double(timer.nsecsElapsed()) / lookups;
+	timer.start();
+	for (int i = 0; i < lookups; i++)
+		sum -= testPar->Get<int>("N");
+	const double nsPerNameLookup = double(timer.nsecsElapsed()) / lookups;
+	timer.start();
+	for (int i = 0; i < lookups; i++)
+		sum += testPar->Get<int>(PARAMETER_HANDLE("N"));
+	const double nsPerCachedHandleLookup = double(timer.nsecsElapsed()) / lookups;
+	timer.start();
+	for (int i = 0; i < lookups; i++)
+		sum -= testPar->Get<int>(handleN);
+	const double nsPerHandleLookup = double(timer.nsecsElapsed()) / lookups;
+	QCOMPARE(sum, qint64(0));
+
+	const int constructions = IsBenchmarking() ? 100 * difficulty : 20;
+	timer.start();
+	for (int i = 0; i < constructions; i++)
+	{
+		sParamRender *params = new sParamRender(testPar);
+		cNineFractals *fractals = new cNineFractals(testParFractal, testPar);
+		QCOMPARE(params->N, 123);
+		delete params;
+		delete fractals;
+	}
+	const double usPerConstruction = double(timer.nsecsElapsed()) / constructions / 1000.0;
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("parameter lookup in QMap (previous): %1 ns, by name: %2 ns, "
+												 "by handle: %3 ns, by cached handle: %4 ns\n")
+									 .arg(nsPerMapLookup, 0, 'f', 1)
+									 .arg(nsPerNameLookup, 0, 'f', 1)
+									 .arg(nsPerHandleLookup, 0, 'f', 1)
+									 .arg(nsPerCachedHandleLookup, 0, 'f', 1),
+			1);
+		WriteLogCout(
+			QString("render data construction: %1 us\n").arg(usPerConstruction, 0, 'f', 1), 1);
+	}
+
+	delete testPar;
+	delete testParFractal;
+}
+
+void Test::primitivesCullingWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { primitivesCulling(); }
+	}
+	else
+	{
+		primitivesCulling();
+	}
+}
+
+void Test::primitivesCulling() const
+{
+	// distances found with bounding volume hierarchy have to be the same as for all primitives
+	using namespace fractal;
+	cParameterContainer *testPar = new cParameterContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+
+	const QList<enumObjectType> types = {
+		objSphere, objBox, objCylinder, objCircle, objRectangle, objTorus, objCone};
+	const int numberOfPrimitives = IsBenchmarking() ? 20 * difficulty : 50;
+	cPixelRandom random;
+	random.SetKey(0, 0, 0, 0);
+	for (int i = 0; i < numberOfPrimitives; i++)
+	{
+		enumObjectType type = types[i % types.size()];
+		QString name = QString("primitive_%1_%2").arg(PrimitiveNames(type)).arg(i + 1);
+		InitPrimitiveParams(type, name, testPar);
+		testPar->Set(name + "_enabled", true);
+		testPar->Set(name + "_position",
+			CVector3(random.RandomDouble(), random.RandomDouble(), random.RandomDouble()) * 20.0);
+		testPar->Set(name + "_rotation", CVector3(random.RandomDouble() * 180.0, 0.0, 0.0));
+		if (type == objBox)
+		{
+			testPar->Set(name + "_empty", i % 2 == 0);
+			testPar->Set(name + "_rounding", 0.1);
+		}
+		if (type == objSphere || type == objCylinder) testPar->Set(name + "_empty", i % 3 == 0);
+	}
+
+	QVector<cObjectData> objectData;
+	cPrimitives primitives(testPar, &objectData);
+	QCOMPARE(primitives.GetListOfPrimitives()->size(), numberOfPrimitives);
+
+	const int numberOfPoints = IsBenchmarking() ? 20000 * difficulty : 10000;
+	QVector<CVector3> points;
+	for (int i = 0; i < numberOfPoints; i++)
+	{
+		points.append(
+			CVector3(random.RandomDouble(), random.RandomDouble(), random.RandomDouble()) * 30.0
+			- CVector3(5.0, 5.0, 5.0));
+	}
+
+	QElapsedTimer timer;
+	timer.start();
+	QVector<double> distances(numberOfPoints);
+	QVector<int> closestObjects(numberOfPoints);
+	for (int i = 0; i < numberOfPoints; i++)
+	{
+		closestObjects[i] = -1;
+		distances[i] = primitives.TotalDistance(points[i], 1e20, &closestObjects[i], nullptr);
+	}
+	const double culledTime = timer.nsecsElapsed();
+
+	// reference: all primitives evaluated one by one
+	auto primitiveDistance = [](const sPrimitiveBasic *primitive, CVector3 point) -> double {
+		switch (primitive->objectType)
+		{
+			case objSphere:
+				return static_cast<const sPrimitiveSphere *>(primitive)->PrimitiveDistance(point);
+			case objBox:
+				return static_cast<const sPrimitiveBox *>(primitive)->PrimitiveDistance(point);
+			case objCylinder:
+				return static_cast<const sPrimitiveCylinder *>(primitive)->PrimitiveDistance(point);
+			case objCircle:
+				return static_cast<const sPrimitiveCircle *>(primitive)->PrimitiveDistance(point);
+			case objRectangle:
+				return static_cast<const sPrimitiveRectangle *>(primitive)->PrimitiveDistance(point);
+			case objTorus:
+				return static_cast<const sPrimitiveTorus *>(primitive)->PrimitiveDistance(point);
+			case objCone:
+				return static_cast<const sPrimitiveCone *>(primitive)->PrimitiveDistance(point);
+			default: return 1e20;
+		}
+	};
+	timer.start();
+	QVector<double> referenceDistances(numberOfPoints);
+	QVector<int> referenceClosestObjects(numberOfPoints);
+	for (int i = 0; i < numberOfPoints; i++)
+	{
+		CVector3 point = primitives.mRotAllPrimitivesRotation.RotateVector(
+			points[i] - primitives.allPrimitivesPosition);
+		referenceDistances[i] = 1e20;
+		referenceClosestObjects[i] = -1;
+		for (const sPrimitiveBasic *primitive : *primitives.GetListOfPrimitives())
+		{
+			double dist = primitiveDistance(primitive, point);
+			if (dist < referenceDistances[i])
+			{
+				referenceDistances[i] = dist;
+				referenceClosestObjects[i] = primitive->objectId;
+			}
+		}
+	}
+	const double referenceTime = timer.nsecsElapsed();
+
+	for (int i = 0; i < numberOfPoints; i++)
+	{
+		QCOMPARE(distances[i], referenceDistances[i]);
+		QCOMPARE(closestObjects[i], referenceClosestObjects[i]);
+	}
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("primitives: %1, time per point with culling: %2 ns, without: %3 ns\n")
+									 .arg(numberOfPrimitives)
+									 .arg(culledTime / numberOfPoints, 0, 'f', 1)
+									 .arg(referenceTime / numberOfPoints, 0, 'f', 1),
+			1);
+	}
+
+	delete testPar;
+}
+
+void Test::lightsCullingWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { lightsCulling(); }
+	}
+	else
+	{
+		lightsCulling();
+	}
+}
+
+void Test::lightsCulling() const
+{
+	// lights found with bounding volume hierarchy have to be the same as found by checking
+	// intensity of every light
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	const double threshold = 1e-3;
+	testPar->Set("random_lights_group", true);
+	testPar->Set("random_lights_number", IsBenchmarking() ? 100 * difficulty : 200);
+	testPar->Set("aux_light_culling_threshold", threshold);
+	testPar->Set("aux_light_enabled", 1, true);
+
+	cLights lights(testPar, testParFractal);
+	const int numberOfLights = lights.GetNumberOfLights();
+
+	const int numberOfPoints = IsBenchmarking() ? 10000 * difficulty : 2000;
+	cPixelRandom random;
+	random.SetKey(0, 0, 0, 0);
+	std::vector<int> indices;
+	qint64 numberOfFoundLights = 0;
+	qint64 queryTime = 0;
+	QElapsedTimer timer;
+	for (int i = 0; i < numberOfPoints; i++)
+	{
+		CVector3 point =
+			CVector3(random.RandomDouble(), random.RandomDouble(), random.RandomDouble()) * 6.0
+			- CVector3(3.0, 3.0, 3.0);
+		timer.start();
+		lights.GetLightsAtPoint(point, &indices);
+		queryTime += timer.nsecsElapsed();
+		numberOfFoundLights += indices.size();
+
+		QList<int> found;
+		for (int index : indices)
+			found.append(index);
+		std::sort(found.begin(), found.end());
+
+		QList<int> expected;
+		for (int index = 0; index < numberOfLights; index++)
+		{
+			const sLight *light = lights.GetLight(index);
+			double distance = (light->position - point).Length();
+			double intensity = 100.0 * light->intensity / (distance * distance) / numberOfLights / 6.0;
+			if (light->enabled && light->intensity > 0.0f && intensity > threshold)
+				expected.append(index);
+		}
+		QCOMPARE(found, expected);
+	}
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("lights: %1, evaluated per point: %2, query time: %3 ns\n")
+									 .arg(numberOfLights)
+									 .arg(double(numberOfFoundLights) / numberOfPoints, 0, 'f', 1)
+									 .arg(double(queryTime) / numberOfPoints, 0, 'f', 1),
+			1);
+	}
+
+	delete testPar;
+	delete testParFractal;
+}
+
+void Test::renderObjectTableWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { renderObjectTable(); }
+	}
+	else
+	{
+		renderObjectTable();
+	}
+}
+
+void Test::renderObjectTable() const
+{
+	// table of objects has to point to materials assigned to objects and has flags of materials
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	InitMaterialParams(2, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+	InitPrimitiveParams(fractal::objSphere, "primitive_sphere_1", testPar);
+	testPar->Set("primitive_sphere_1_enabled", true);
+	testPar->Set("primitive_sphere_1_material_id", 2);
+
+	sRenderData *renderData = new sRenderData;
+	renderData->objectData.resize(NUMBER_OF_FRACTALS);
+	sParamRender *params = new sParamRender(testPar, &renderData->objectData);
+	cNineFractals *fractals = new cNineFractals(testParFractal, testPar);
+	CreateMaterialsMap(testPar, &renderData->materials, true);
+	renderData->ValidateObjects();
+
+	QCOMPARE(renderData->objects.size(), renderData->objectData.size());
+	for (int i = 0; i < renderData->objects.size(); i++)
+	{
+		const sRenderObject &object = renderData->objects.at(i);
+		QCOMPARE(object.object, &renderData->objectData.at(i));
+		QCOMPARE(object.material,
+			&renderData->materials.constFind(renderData->objectData.at(i).materialId).value());
+		QVERIFY(!object.displacementMap && !object.fractalizedTexture);
+	}
+	QCOMPARE(renderData->objects.last().material->id, 2);
+	QVERIFY(!renderData->anyDisplacementMap && !renderData->anyFractalizedTexture);
+
+	// without any displacement and fractalized textures points and distances are not changed
+	const int calls = IsBenchmarking() ? 1000000 * difficulty : 100000;
+	QElapsedTimer timer;
+	timer.start();
+	double sum = 0.0;
+	for (int i = 0; i < calls; i++)
+	{
+		double reduce = 1.0;
+		CVector3 point(i * 1e-5, 0.0, 0.0);
+		CVector3 pointFractalized =
+			FractalizeTexture(point, renderData, *params, *fractals, i % 2, &reduce);
+		sum += DisplacementMap(1.0, pointFractalized, i % 2, renderData, reduce) + pointFractalized.x;
+	}
+	const double nsPerCall = double(timer.nsecsElapsed()) / calls;
+	// computed in double: (calls - 1) * calls overflows int for the benchmark sizes
+	const double expectedSum = calls + (calls - 1.0) * calls / 2.0 * 1e-5;
+	QVERIFY(qAbs(sum - expectedSum) <= 1e-9 * expectedSum);
+
+	testPar->Set(cMaterial::Name("texture_fractalize", 2), true);
+	CreateMaterialsMap(testPar, &renderData->materials, true);
+	renderData->ValidateObjects();
+	QVERIFY(renderData->objects.last().fractalizedTexture);
+	QVERIFY(renderData->anyFractalizedTexture);
+	QVERIFY(!renderData->objects.first().fractalizedTexture);
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("displacement and fractalization lookups: %1 ns per point\n")
+									 .arg(nsPerCall, 0, 'f', 1),
+			1);
+	}
+
+	delete params;
+	delete fractals;
+	delete renderData;
+	delete testPar;
+	delete testParFractal;
+}
+
+void Test::textureCacheWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { textureCache(); }
+	}
+	else
+	{
+		textureCache();
+	}
+}
+
+void Test::textureCache() const
+{
+	// the same file is decoded only once and mipmaps are created at first use
+	const int size = IsBenchmarking() ? 256 * difficulty : 256;
+	QImage image(size, size, QImage::Format_RGB888);
+	for (int y = 0; y < size; y++)
+		for (int x = 0; x < size; x++)
+			image.setPixel(x, y, qRgb(x % 256, y % 256, (x * y) % 256));
+	const QString textureFile = testFolder() + QDir::separator() + "texture.png";
+	QVERIFY(image.save(textureFile));
+
+	cTextureCache::Instance()->Clear();
+
+	QElapsedTimer timer;
+	timer.start();
+	cTexture texture(textureFile, cTexture::useMipmaps, 0, true);
+	const qint64 firstLoadTime = timer.nsecsElapsed();
+	QVERIFY(texture.IsLoaded());
+	QCOMPARE(texture.Width(), size);
+	QCOMPARE(cTextureCache::Instance()->Count(), 1);
+
+	timer.restart();
+	cTexture textureFromCache(textureFile, cTexture::doNotUseMipmaps, 0, true);
+	const qint64 secondLoadTime = timer.nsecsElapsed();
+	QCOMPARE(cTextureCache::Instance()->Count(), 1);
+	QCOMPARE(textureFromCache.FastPixel(size - 1, 3).R, texture.FastPixel(size - 1, 3).R);
+
+	QSharedPointer<const cTextureData> data = cTextureCache::Instance()->Load(textureFile, 0);
+	QVERIFY(cTextureCache::Instance()->FromQByteArray(QByteArray()).isNull());
+	QCOMPARE(data->NumberOfCreatedMipmaps(), 0);
+
+	// pixel without footprint and texture without mipmaps don't need any mipmap
+	texture.Pixel(CVector2<double>(0.3, 0.6));
+	QCOMPARE(data->NumberOfCreatedMipmaps(), 0);
+	textureFromCache.Pixel(CVector2<double>(0.3, 0.6), 0.1);
+	QCOMPARE(data->NumberOfCreatedMipmaps(), 0);
+
+	// this footprint needs only first two levels
+	const double pixelSize = size / 2.0;
+	const sRGBFloat pixel = texture.Pixel(CVector2<double>(0.3, 0.6), pixelSize);
+	QCOMPARE(data->NumberOfCreatedMipmaps(), 2);
+	QVERIFY(pixel.R > 0.0f && pixel.G > 0.0f);
+	QVERIFY(data->NumberOfCreatedMipmaps() < data->NumberOfMipmaps());
+
+	// copies share pixel data
+	cTexture textureCopy = texture;
+	QCOMPARE(textureCopy.Pixel(CVector2<double>(0.3, 0.6), pixelSize).R, pixel.R);
+
+	// modified file has to be loaded again
+	image.setPixel(size - 1, 3, qRgb(0, 0, 0));
+	QVERIFY(image.save(textureFile, "PNG", 0));
+	cTexture modifiedTexture(textureFile, cTexture::useMipmaps, 0, true);
+	QCOMPARE(cTextureCache::Instance()->Count(), 2);
+	QCOMPARE(modifiedTexture.FastPixel(size - 1, 3).R, quint16(0));
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("texture loading: %1 ms from file, %2 ms from cache\n")
+									 .arg(firstLoadTime * 1e-6, 0, 'f', 3)
+									 .arg(secondLoadTime * 1e-6, 0, 'f', 3),
+			1);
+	}
+
+	cTextureCache::Instance()->Clear();
+}
+
+void Test::distanceBatchWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { distanceBatch(); }
+	}
+	else
+	{
+		distanceBatch();
+	}
+}
+
+void Test::distanceBatch() const
+{
+	// CalculateDistanceBatch() has to give the same distances as CalculateDistance() point by point.
+	// Vectorized lanes can round differently, so the points where the number of iterations
+	// differs (very close to the bailout) are only counted
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	// Menger sponge is calculated point by point also in batch mode
+	const QList<fractal::enumFractalFormula> formulas = {
+		fractal::mandelbulb, fractal::mandelbox, fractal::mengerSponge};
+	const int gridSize = IsBenchmarking() ? 10 * difficulty : 24;
+	const int count = gridSize * gridSize * gridSize;
+
+	std::vector<double> x(count), y(count), z(count);
+	for (int i = 0; i < count; i++)
+	{
+		x[i] = (i % gridSize) * (3.0 / gridSize) - 1.5;
+		y[i] = (i / gridSize % gridSize) * (3.0 / gridSize) - 1.5;
+		z[i] = (i / (gridSize * gridSize)) * (3.0 / gridSize) - 1.5;
+	}
+	const double detailSize = 1e-5;
+
+	for (fractal::enumFractalFormula formula : formulas)
+	{
+		testPar->Set("formula", 1, int(formula));
+		sParamRender *params = new sParamRender(testPar);
+		cNineFractals *fractals = new cNineFractals(testParFractal, testPar);
+
+		std::vector<sDistanceOut> scalarOut(count), batchOut(count);
+
+		QElapsedTimer timer;
+		timer.start();
+		for (int i = 0; i < count; i++)
+		{
+			const sDistanceIn in(CVector3(x[i], y[i], z[i]), detailSize, false);
+			CalculateDistance(*params, *fractals, in, &scalarOut[i]);
+		}
+		const qint64 scalarTime = qMax(timer.nsecsElapsed(), qint64(1));
+
+		timer.restart();
+		const sDistanceBatchIn batchIn(x.data(), y.data(), z.data(), count, detailSize, false);
+		CalculateDistanceBatch(*params, *fractals, batchIn, batchOut.data());
+		const qint64 batchTime = qMax(timer.nsecsElapsed(), qint64(1));
+
+		int differentIters = 0;
+		for (int i = 0; i < count; i++)
+		{
+			if (scalarOut[i].iters != batchOut[i].iters)
+			{
+				differentIters++;
+				continue;
+			}
+			const double distance = scalarOut[i].distance;
+			QVERIFY2(fabs(batchOut[i].distance - distance) <= 1e-6 * qMax(1.0, fabs(distance)),
+				QString("distance %1 instead of %2 at point %3")
+					.arg(batchOut[i].distance)
+					.arg(distance)
+					.arg(i)
+					.toLocal8Bit()
+					.constData());
+			QCOMPARE(batchOut[i].maxiter, scalarOut[i].maxiter);
+		}
+		QVERIFY2(differentIters <= count / 100, "too many points with different iteration count");
+
+		if (IsBenchmarking())
+		{
+			WriteLogCout(QString("formula: %1 distance: scalar %2 ns, batch %3 ns per point\n")
+										 .arg(fractalList[cNineFractals::GetIndexOnFractalList(formula)].nameInComboBox)
+										 .arg(double(scalarTime) / count, 0, 'f', 1)
+										 .arg(double(batchTime) / count, 0, 'f', 1),
+				1);
+		}
+
+		delete fractals;
+		delete params;
+	}
+
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::dofGatherWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { dofGather(); }
+	}
+	else
+	{
+		dofGather();
+	}
+}
+
+void Test::dofGather() const
+{
+	// phase I of DOF (gather) calculated with tiles has to give the same image as the previous
+	// implementation, which looked at the whole square around every pixel
+	const int width = IsBenchmarking() ? 64 * difficulty : 160;
+	const int height = IsBenchmarking() ? 48 * difficulty : 120;
+	const float deep = 5.0f;
+	const float neutral = 3.0f;
+	const float maxRadius = 8.0f;
+
+	cImage *image = new cImage(width, height);
+	cPixelRandom random;
+	random.SetKey(0, 0, 0, 0);
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			// left part is in focus, the rest goes from near to far objects
+			const float z = (x < width / 4) ? neutral : 1.0f + 9.0f * float(y) / height;
+			image->PutPixelZBuffer(x, y, z);
+			image->PutPixelAlpha(x, y, 65535);
+			image->PutPixelPostImage(x, y, sRGBFloat(float(random.RandomDouble()),
+																			 float(random.RandomDouble()), float(x) / width));
+		}
+	}
+	const cRegion<int> region(0, 0, width, height);
+
+	// previous implementation of phase I
+	auto referenceGather = [&](int x, int y) -> sRGBFloat {
+		float z = image->GetPixelZBuffer(x, y);
+		float blur1 = (z - neutral) / z * deep;
+		float blur = fabs(blur1);
+		if (blur > maxRadius) blur = maxRadius;
+		int size = int(blur);
+		int xStart = qMax(x - size, 0);
+		int xStop = qMin(x + size, region.x2 - 1);
+		int yStart = qMax(y - size, 0);
+		int yStop = qMin(y + size, region.y2 - 1);
+
+		float totalWeight = 0.0f;
+		sRGBFloat tempPixel;
+		for (int yy = yStart; yy <= yStop; yy++)
+		{
+			for (int xx = xStart; xx <= xStop; xx++)
+			{
+				float dx = x - xx;
+				float dy = y - yy;
+				float r = sqrtf(dx * dx + dy * dy);
+				float weight = blur - r;
+				if (weight < 0.0f) weight = 0.0f;
+				if (weight > 1.0f) weight = 1.0f;
+
+				float z2 = image->GetPixelZBuffer(xx, yy);
+				float blur2 = (z2 - neutral) / z2 * deep;
+				if (blur1 > blur2)
+				{
+					if (blur1 * blur2 < 0)
+					{
+						weight = 0.0;
+					}
+					else
+					{
+						float weight2 = 0.0f;
+						if (blur1 > 0.0f)
+							weight2 = 1.1f - blur1 / blur2;
+						else
+							weight2 = 1.1f - blur2 / blur1;
+						if (weight2 < 0.0f) weight2 = 0.0f;
+						weight *= weight2 * 10.0f;
+					}
+				}
+
+				totalWeight += weight;
+				if (weight > 0.0f)
+				{
+					sRGBFloat pix = image->GetPixelPostImage(xx, yy);
+					tempPixel.R += pix.R * weight;
+					tempPixel.G += pix.G * weight;
+					tempPixel.B += pix.B * weight;
+				}
+			}
+		}
+
+		if (totalWeight > 0.0f)
+		{
+			return sRGBFloat(
+				tempPixel.R / totalWeight, tempPixel.G / totalWeight, tempPixel.B / totalWeight);
+		}
+		else
+		{
+			return image->GetPixelPostImage(x, y);
+		}
+	};
+
+	QElapsedTimer timer;
+	timer.start();
+	std::vector<sRGBFloat> reference(quint64(width) * height);
+#pragma omp parallel for schedule(dynamic, 1)
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+			reference[quint64(x) + quint64(y) * width] = referenceGather(x, y);
+	}
+	const qint64 referenceTime = qMax(timer.nsecsElapsed(), qint64(1));
+
+	// without passes of phase II only the gather is done
+	bool stopRequest = false;
+	cPostRenderingDOF dof(image);
+	timer.restart();
+	dof.Render(region, deep, neutral, 0, 1.0f, maxRadius, &stopRequest);
+	const qint64 tiledTime = qMax(timer.nsecsElapsed(), qint64(1));
+
+	for (int y = 0; y < height; y++)
+	{
+		for (int x = 0; x < width; x++)
+		{
+			const sRGBFloat pixel = image->GetPixelPostImage(x, y);
+			const sRGBFloat &expected = reference[quint64(x) + quint64(y) * width];
+			const float error = qMax(fabsf(pixel.R - expected.R),
+				qMax(fabsf(pixel.G - expected.G), fabsf(pixel.B - expected.B)));
+			QVERIFY2(error < 1e-4f, QString("pixel %1, %2 differs by %3")
+																.arg(x)
+																.arg(y)
+																.arg(error)
+																.toLocal8Bit()
+																.constData());
+		}
+	}
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("DOF gather: previous %1 ms, tiled %2 ms, speedup: %3\n")
+									 .arg(referenceTime * 1e-6, 0, 'f', 2)
+									 .arg(tiledTime * 1e-6, 0, 'f', 2)
+									 .arg(double(referenceTime) / tiledTime, 0, 'f', 2),
+			1);
+	}
+
+	delete image;
+}
+
+void Test::meshExportWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { meshExport(); }
+	}
+	else
+	{
+		meshExport();
+	}
+}
+
+// mesh file which keeps a copy of everything streamed to it
+class cRecordingMeshFile : public MeshFileSavePLY
+{
+public:
+	cRecordingMeshFile(QString filename, structSaveMeshConfig meshConfig)
+			: MeshFileSavePLY(filename, meshConfig, structSaveMeshData())
+	{
+	}
+	void AppendVertices(const double *_vertices, const sRGB8 *_colors, quint64 count) override
+	{
+		vertices.insert(vertices.end(), _vertices, _vertices + count * 3);
+		colors.insert(colors.end(), _colors, _colors + count);
+		MeshFileSavePLY::AppendVertices(_vertices, _colors, count);
+	}
+	void AppendPolygons(const long long *_polygons, quint64 count) override
+	{
+		polygons.insert(polygons.end(), _polygons, _polygons + count * 3);
+		MeshFileSavePLY::AppendPolygons(_polygons, count);
+	}
+
+	std::vector<double> vertices;
+	std::vector<sRGB8> colors;
+	std::vector<long long> polygons;
+};
+
+void Test::meshExport() const
+{
+	// mesh generated by streaming marching cubes has to have one vertex for every edge of the voxel
+	// grid which crosses the surface and the same triangles as cube by cube meshing of the whole
+	// volume. Streamed PLY file has to be the same as the file saved from the mesh in memory
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+	testPar->Set("voxel_skip_empty_space", false);
+
+	sRenderData *renderData = new sRenderData;
+	renderData->objectData.resize(NUMBER_OF_FRACTALS);
+	sParamRender *params = new sParamRender(testPar, &renderData->objectData);
+	cNineFractals *fractals = new cNineFractals(testParFractal, testPar);
+	CreateMaterialsMap(testPar, &renderData->materials, true);
+	renderData->ValidateObjects();
+
+	const int size = IsBenchmarking() ? 16 * difficulty : 32;
+	const CVector3 lower(-1.5, -1.5, -1.5);
+	const CVector3 upper(1.5, 1.5, 1.5);
+	const double step = 3.0 / size;
+	const double distThresh = 0.5 * step / params->detailLevel;
+	bool stop = false;
+
+	const QString streamedFile = testFolder() + QDir::separator() + "streamed.ply";
+	const MeshFileSave::structSaveMeshConfig meshConfig(MeshFileSave::MESH_FILE_TYPE_PLY,
+		{MeshFileSave::MESH_CONTENT_GEOMETRY, MeshFileSave::MESH_CONTENT_COLOR},
+		MeshFileSave::MESH_BINARY);
+	cRecordingMeshFile *meshFile = new cRecordingMeshFile(streamedFile, meshConfig);
+	QVERIFY(meshFile->BeginStream());
+
+	QElapsedTimer timer;
+	timer.start();
+	MarchingCubes *marchingCubes = new MarchingCubes(testPar, testParFractal, params, fractals,
+		renderData, size, size, size, lower, upper, distThresh, &stop, meshFile);
+	marchingCubes->RunMarchingCube();
+	delete marchingCubes;
+	QVERIFY(meshFile->EndStream());
+	const qint64 streamedTime = timer.elapsed();
+
+	// reference: whole volume of voxels calculated at once and meshed cube by cube. The first
+	// voxel plane is not used by marching cubes (it's outside the exported box)
+	timer.restart();
+	const long long sizeB = size + 1;
+	std::vector<double> voxels(sizeB * sizeB * sizeB);
+	std::vector<double> colorIndices(sizeB * sizeB * sizeB);
+	cSparseVoxelPlane voxelPlane(params, fractals, renderData, distThresh, step, false);
+	for (long long i = 1; i <= size; i++)
+	{
+		sVoxelPlane plane;
+		plane.origin = CVector3(lower.x + step * i, lower.y, lower.z);
+		plane.stepU = CVector3(0.0, step, 0.0);
+		plane.stepV = CVector3(0.0, 0.0, step);
+		plane.sizeU = sizeB;
+		plane.sizeV = sizeB;
+		plane.strideU = sizeB;
+		plane.strideV = 1;
+		voxelPlane.Calculate(
+			plane, &voxels[i * sizeB * sizeB], &colorIndices[i * sizeB * sizeB], &stop);
+	}
+	auto inside = [&](long long i, long long j, long long k) {
+		return voxels[(i * sizeB + j) * sizeB + k] <= distThresh;
+	};
+
+	long long expectedVertices = 0;
+	long long expectedTriangles = 0;
+	for (long long i = 1; i <= size; i++)
+	{
+		for (long long j = 0; j <= size; j++)
+		{
+			for (long long k = 0; k <= size; k++)
+			{
+				if (i < size && inside(i, j, k) != inside(i + 1, j, k)) expectedVertices++;
+				if (j < size && inside(i, j, k) != inside(i, j + 1, k)) expectedVertices++;
+				if (k < size && inside(i, j, k) != inside(i, j, k + 1)) expectedVertices++;
+
+				if (i == size || j == size || k == size) continue;
+				unsigned int cubeIndex = 0;
+				if (inside(i, j, k)) cubeIndex |= 1;
+				if (inside(i + 1, j, k)) cubeIndex |= 2;
+				if (inside(i + 1, j + 1, k)) cubeIndex |= 4;
+				if (inside(i, j + 1, k)) cubeIndex |= 8;
+				if (inside(i, j, k + 1)) cubeIndex |= 16;
+				if (inside(i + 1, j, k + 1)) cubeIndex |= 32;
+				if (inside(i + 1, j + 1, k + 1)) cubeIndex |= 64;
+				if (inside(i, j + 1, k + 1)) cubeIndex |= 128;
+				expectedTriangles += MarchingCubes::NumberOfTriangles(cubeIndex);
+			}
+		}
+	}
+	const qint64 referenceTime = timer.elapsed();
+
+	const long long numberOfVertices = meshFile->vertices.size() / 3;
+	QVERIFY(expectedTriangles > 0);
+	QCOMPARE(numberOfVertices, expectedVertices);
+	QCOMPARE(qint64(meshFile->polygons.size() / 3), qint64(expectedTriangles));
+
+	// all vertices are welded, so every index points to a vertex
+	for (long long index : meshFile->polygons)
+	{
+		QVERIFY(index >= 0 && index < numberOfVertices);
+	}
+
+	// the same mesh saved from memory
+	const QString savedFile = testFolder() + QDir::separator() + "saved.ply";
+	MeshFileSave *memoryMeshFile = MeshFileSave::create(savedFile, meshConfig,
+		MeshFileSave::structSaveMeshData(&meshFile->vertices, &meshFile->polygons, &meshFile->colors));
+	memoryMeshFile->SaveMesh();
+	delete memoryMeshFile;
+
+	QFile streamed(streamedFile);
+	QFile saved(savedFile);
+	QVERIFY(streamed.open(QIODevice::ReadOnly));
+	QVERIFY(saved.open(QIODevice::ReadOnly));
+	const QByteArray streamedContent = streamed.readAll();
+	const QString vertexHeader = QString("element vertex %1\n").arg(expectedVertices);
+	const QString faceHeader = QString("element face %1\n").arg(expectedTriangles);
+	QVERIFY(streamedContent.contains(vertexHeader.toLatin1()));
+	QVERIFY(streamedContent.contains(faceHeader.toLatin1()));
+	QVERIFY(streamedContent == saved.readAll());
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("mesh export %1^3: streamed %2 ms, reference volume %3 ms, "
+												 "%4 vertices, %5 triangles\n")
+									 .arg(size)
+									 .arg(streamedTime)
+									 .arg(referenceTime)
+									 .arg(numberOfVertices)
+									 .arg(expectedTriangles),
+			1);
+	}
+
+	delete meshFile;
+	delete fractals;
+	delete params;
+	delete renderData;
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::sparseVoxelPlaneWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { sparseVoxelPlane(); }
+	}
+	else
+	{
+		sparseVoxelPlane();
+	}
+}
+
+void Test::sparseVoxelPlane() const
+{
+	// voxel planes calculated with skipping of empty space have to give the same voxels inside
+	// the surface as dense planes. Skipped voxels have to get defined distances and colors
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	sRenderData *renderData = new sRenderData;
+	renderData->objectData.resize(NUMBER_OF_FRACTALS);
+	sParamRender *params = new sParamRender(testPar, &renderData->objectData);
+	cNineFractals *fractals = new cNineFractals(testParFractal, testPar);
+	CreateMaterialsMap(testPar, &renderData->materials, true);
+	renderData->ValidateObjects();
+
+	// bigger volume than the fractal, so there is a lot of empty space
+	const int size = IsBenchmarking() ? 32 * difficulty : 64;
+	const double step = 6.0 / size;
+	const double distThresh = 0.5 * step / params->detailLevel;
+	const long long sizeB = size + 1;
+	bool stop = false;
+
+	cSparseVoxelPlane densePlane(params, fractals, renderData, distThresh, step, false);
+	cSparseVoxelPlane sparsePlane(params, fractals, renderData, distThresh, step, true);
+
+	std::vector<double> denseDistances(sizeB * sizeB), denseColors(sizeB * sizeB);
+	std::vector<double> sparseDistances(sizeB * sizeB), sparseColors(sizeB * sizeB);
+	qint64 denseTime = 0;
+	qint64 sparseTime = 0;
+	long long skippedVoxels = 0;
+
+	for (int i = 0; i <= size; i += IsBenchmarking() ? 1 : 4)
+	{
+		sVoxelPlane plane;
+		plane.origin = CVector3(-3.0 + step * i, -3.0, -3.0);
+		plane.stepU = CVector3(0.0, step, 0.0);
+		plane.stepV = CVector3(0.0, 0.0, step);
+		plane.sizeU = sizeB;
+		plane.sizeV = sizeB;
+		plane.strideU = sizeB;
+		plane.strideV = 1;
+
+		QElapsedTimer timer;
+		timer.start();
+		densePlane.Calculate(plane, denseDistances.data(), denseColors.data(), &stop);
+		denseTime += timer.nsecsElapsed();
+
+		// buffers are reused for all planes, so garbage has to be overwritten. NaN cannot be used as
+		// marker, because isnan() is optimized out with -ffast-math
+		const double notWritten = -1e300;
+		std::fill(sparseDistances.begin(), sparseDistances.end(), notWritten);
+		std::fill(sparseColors.begin(), sparseColors.end(), notWritten);
+		timer.restart();
+		sparsePlane.Calculate(plane, sparseDistances.data(), sparseColors.data(), &stop);
+		sparseTime += timer.nsecsElapsed();
+
+		for (long long n = 0; n < sizeB * sizeB; n++)
+		{
+			const double dense = denseDistances[n];
+			const double sparse = sparseDistances[n];
+			QVERIFY(sparse != notWritten && sparseColors[n] != notWritten);
+			QCOMPARE(sparse <= distThresh, dense <= distThresh);
+
+			const bool calculated = fabs(sparse - dense) <= 1e-12 * qMax(1.0, fabs(dense));
+			if (calculated)
+			{
+				QCOMPARE(sparseColors[n], denseColors[n]);
+			}
+			else
+			{
+				// empty voxel: estimated lower limit of distance instead of the real one
+				QVERIFY(sparse > distThresh);
+				QCOMPARE(sparseColors[n], 0.0);
+				skippedVoxels++;
+			}
+		}
+	}
+	QVERIFY(skippedVoxels > 0);
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("voxel planes %1^2: dense %2 ms, sparse %3 ms, %4% voxels skipped\n")
+									 .arg(sizeB)
+									 .arg(denseTime * 1e-6, 0, 'f', 1)
+									 .arg(sparseTime * 1e-6, 0, 'f', 1)
+									 .arg(100.0 * sparsePlane.GetNumberOfSkippedVoxels()
+													/ qMax(1LL, sparsePlane.GetNumberOfSkippedVoxels()
+																			+ sparsePlane.GetNumberOfCalculatedVoxels()),
+										 0, 'f', 1),
+			1);
+	}
+
+	delete fractals;
+	delete params;
+	delete renderData;
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::renderReproducibilityWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { renderReproducibility(); }
+	}
+	else
+	{
+		renderReproducibility();
+	}
+}
+
+void Test::renderReproducibility() const
+{
+	// image rendered with random effects (ambient occlusion with many rays, global illumination
+	// and Monte Carlo DOF) has to be exactly the same for 1 and for many threads
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	const int width = IsBenchmarking() ? 32 * difficulty : 64;
+	const int height = IsBenchmarking() ? 24 * difficulty : 48;
+	testPar->Set("image_width", width);
+	testPar->Set("image_height", height);
+	testPar->Set("ambient_occlusion_enabled", true);
+	testPar->Set("ambient_occlusion_mode", int(params::AOModeMultipleRays));
+	testPar->Set("ambient_occlusion_quality", 2);
+	testPar->Set("DOF_enabled", true);
+	testPar->Set("DOF_monte_carlo", true);
+	testPar->Set("DOF_MC_global_illumination", true);
+	testPar->Set("DOF_samples", 16);
+	testPar->Set("DOF_min_samples", 4);
+
+	bool stopRequest = false;
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+	config.DisableNetRender();
+	config.EnableIgnoreErrors();
+
+	const int maxNumberOfThreads = systemData.numberOfThreads;
+	const QList<int> threadCounts = {1, qMax(4, maxNumberOfThreads)};
+	QList<cImage *> images;
+
+	for (int threads : threadCounts)
+	{
+		systemData.numberOfThreads = threads;
+		cImage *image = new cImage(width, height);
+		QElapsedTimer timer;
+		timer.start();
+
+		cRenderJob *renderJob = new cRenderJob(testPar, testParFractal, image, &stopRequest);
+		renderJob->Init(cRenderJob::still, config);
+		QVERIFY2(renderJob->Execute(), "reproducibility render failed.");
+		delete renderJob;
+		images.append(image);
+
+		if (IsBenchmarking())
+		{
+			WriteLogCout(
+				QString("threads: %1 render time: %2 ms\n").arg(threads).arg(timer.elapsed()), 1);
+		}
+	}
+	systemData.numberOfThreads = maxNumberOfThreads;
+
+	const size_t numberOfPixels = size_t(width) * size_t(height);
+	QVERIFY(memcmp(images.first()->GetPostImageFloatPtr(), images.last()->GetPostImageFloatPtr(),
+						numberOfPixels * sizeof(sRGBFloat))
+					== 0);
+	QVERIFY(memcmp(images.first()->GetImage16Ptr(), images.last()->GetImage16Ptr(),
+						numberOfPixels * sizeof(sRGB16))
+					== 0);
+	QVERIFY(memcmp(images.first()->GetZBufferPtr(), images.last()->GetZBufferPtr(),
+						numberOfPixels * sizeof(float))
+					== 0);
+
+	qDeleteAll(images);
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::lightsCullingRenderWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { lightsCullingRender(); }
+	}
+	else
+	{
+		lightsCullingRender();
+	}
+}
+
+void Test::lightsCullingRender() const
+{
+	// every culled light is darker than threshold, so image rendered with culling can differ from
+	// image rendered with all lights at most by number of lights * threshold
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	const int width = IsBenchmarking() ? 32 * difficulty : 64;
+	const int height = IsBenchmarking() ? 24 * difficulty : 48;
+	const int numberOfRandomLights = IsBenchmarking() ? 100 * difficulty : 100;
+	const double threshold = 1e-4;
+	testPar->Set("image_width", width);
+	testPar->Set("image_height", height);
+	testPar->Set("random_lights_group", true);
+	testPar->Set("random_lights_number", numberOfRandomLights);
+	testPar->Set("aux_light_enabled", 1, true);
+
+	bool stopRequest = false;
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+	config.DisableNetRender();
+	config.EnableIgnoreErrors();
+
+	QList<cImage *> images;
+	QList<qint64> renderTimes;
+	for (double cullingThreshold : {0.0, threshold})
+	{
+		testPar->Set("aux_light_culling_threshold", cullingThreshold);
+		cImage *image = new cImage(width, height);
+		QElapsedTimer timer;
+		timer.start();
+
+		cRenderJob *renderJob = new cRenderJob(testPar, testParFractal, image, &stopRequest);
+		renderJob->Init(cRenderJob::still, config);
+		QVERIFY2(renderJob->Execute(), "render with lights failed.");
+		delete renderJob;
+		images.append(image);
+		renderTimes.append(timer.elapsed());
+	}
+
+	const qint64 numberOfPixels = qint64(width) * height;
+	const sRGBFloat *allLights = images.first()->GetPostImageFloatPtr();
+	const sRGBFloat *culledLights = images.last()->GetPostImageFloatPtr();
+	double sumOfDifferences = 0.0;
+	for (qint64 i = 0; i < numberOfPixels; i++)
+	{
+		sumOfDifferences += fabs(allLights[i].R - culledLights[i].R)
+												+ fabs(allLights[i].G - culledLights[i].G)
+												+ fabs(allLights[i].B - culledLights[i].B);
+	}
+	const double meanDifference = sumOfDifferences / (numberOfPixels * 3);
+	const int numberOfLights = numberOfRandomLights + 1;
+	QVERIFY2(meanDifference <= numberOfLights * threshold,
+		QString("mean difference %1").arg(meanDifference).toLocal8Bit().constData());
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("lights: %1, render time all lights: %2 ms, culled lights: %3 ms\n")
+									 .arg(numberOfLights)
+									 .arg(renderTimes.first())
+									 .arg(renderTimes.last()),
+			1);
+	}
+
+	qDeleteAll(images);
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::lightsSamplingWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { lightsSampling(); }
+	}
+	else
+	{
+		lightsSampling();
+	}
+}
+
+void Test::lightsSampling() const
+{
+	// contributions of sampled lights multiplied by inverse probability have to give on average
+	// the sum of contributions of all lights. Contribution used here differs from sampling weight,
+	// like shadowed illumination calculated by the shader
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	testPar->Set("random_lights_group", true);
+	testPar->Set("random_lights_number", 100);
+	testPar->Set("aux_light_enabled", 1, true);
+	cLights lights(testPar, testParFractal);
+
+	const CVector3 point(0.3, -0.2, 0.5);
+	CVector3 normal(0.5, -1.0, 0.7);
+	normal.Normalize();
+	const double materialShading = 1.0;
+
+	std::vector<int> indices;
+	lights.GetLightsAtPoint(point, &indices);
+	QVERIFY(indices.size() > 1);
+
+	std::vector<double> cumulativeWeights;
+	std::vector<double> contributions;
+	double totalWeight = 0.0;
+	double exactSum = 0.0;
+	for (int index : indices)
+	{
+		const sLight *light = lights.GetLight(index);
+		totalWeight += cLights::SamplingWeight(light, point, normal, materialShading);
+		cumulativeWeights.push_back(totalWeight);
+
+		CVector3 d = light->position - point;
+		double distance2 = d.Dot(d);
+		double cosine = qMax(normal.Dot(d) / sqrt(distance2), 0.0);
+		double contribution = light->intensity * cosine / distance2;
+		contributions.push_back(contribution);
+		exactSum += contribution;
+	}
+	QVERIFY(exactSum > 0.0);
+
+	const int samples = 8;
+	const int numberOfEstimates = IsBenchmarking() ? 100000 * difficulty : 100000;
+	cPixelRandom random;
+	random.SetKey(0, 0, 0, 0);
+	double sumOfEstimates = 0.0;
+	double sumOfSquares = 0.0;
+	for (int n = 0; n < numberOfEstimates; n++)
+	{
+		double estimate = 0.0;
+		for (int sample = 0; sample < samples; sample++)
+		{
+			double inverseProbability;
+			int i =
+				cLights::SampleCandidate(cumulativeWeights, random.RandomDouble(), &inverseProbability);
+			estimate += contributions[i] * inverseProbability / samples;
+		}
+		sumOfEstimates += estimate;
+		sumOfSquares += estimate * estimate;
+	}
+	const double mean = sumOfEstimates / numberOfEstimates;
+	const double variance = qMax(sumOfSquares / numberOfEstimates - mean * mean, 0.0);
+	const double standardError = sqrt(variance / numberOfEstimates);
+
+	// random sequence is fixed, so this limit is not exceeded by chance
+	QVERIFY2(fabs(mean - exactSum) <= 5.0 * standardError + 1e-9 * exactSum,
+		QString("mean %1, exact sum %2, standard error %3")
+			.arg(mean)
+			.arg(exactSum)
+			.arg(standardError)
+			.toLocal8Bit()
+			.constData());
+
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::imageSaveQueueWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { imageSaveQueue(); }
+	}
+	else
+	{
+		imageSaveQueue();
+	}
+}
+
+void Test::imageSaveQueue() const
+{
+	// every saved file has to contain the image from the moment of Enqueue(), also when the source
+	// image is modified right after and when the queue has to wait for the memory limit
+	const bool backgroundSaving = gPar->Get<bool>("save_images_in_background");
+	const int memoryLimit = gPar->Get<int>("save_images_in_background_memory_limit");
+	gPar->Set("save_images_in_background", true);
+	// every frame is bigger than the limit, so each Enqueue() waits until the queue is empty
+	gPar->Set("save_images_in_background_memory_limit", 1);
+
+	const int width = IsBenchmarking() ? 256 * difficulty : 512;
+	const int height = IsBenchmarking() ? 256 * difficulty : 512;
+	const int numberOfFrames = 8;
+	cImage image(width, height);
+	QVERIFY(image.GetUsedMB() > 1);
+
+	auto fillImage = [&](float value) {
+		for (int y = 0; y < height; y++)
+			for (int x = 0; x < width; x++)
+				image.PutPixelImage(x, y, sRGBFloat(value, 1.0f - value, 0.5f * value));
+		image.CompileImage();
+		image.ConvertTo8bit();
+	};
+
+	QList<sRGB8> expectedColors;
+	QStringList fileNames;
+	QElapsedTimer timer;
+	timer.start();
+	{
+		cImageSaveQueue saveQueue;
+		for (int frame = 0; frame < numberOfFrames; frame++)
+		{
+			fillImage(float(frame + 1) / (numberOfFrames + 1));
+			expectedColors.append(image.GetPixelImage8(width / 2, height / 2));
+			QString fileName =
+				testFolder() + QDir::separator() + QString("queued_frame_%1.png").arg(frame);
+			fileNames.append(fileName);
+			saveQueue.Enqueue(fileName, ImageFileSave::IMAGE_FILE_TYPE_PNG, &image);
+
+			// source image is reused for the next frame immediately
+			fillImage(0.0f);
+		}
+		// destructor saves all queued frames
+	}
+	const qint64 saveTime = timer.elapsed();
+
+	gPar->Set("save_images_in_background", backgroundSaving);
+	gPar->Set("save_images_in_background_memory_limit", memoryLimit);
+
+	for (int frame = 0; frame < numberOfFrames; frame++)
+	{
+		QImage savedImage(fileNames.at(frame));
+		QVERIFY2(!savedImage.isNull(), fileNames.at(frame).toLocal8Bit().constData());
+		QCOMPARE(savedImage.width(), width);
+		QCOMPARE(savedImage.height(), height);
+		const QRgb saved = savedImage.pixel(width / 2, height / 2);
+		const sRGB8 expected = expectedColors.at(frame);
+		QVERIFY(qAbs(qRed(saved) - int(expected.R)) <= 1);
+		QVERIFY(qAbs(qGreen(saved) - int(expected.G)) <= 1);
+		QVERIFY(qAbs(qBlue(saved) - int(expected.B)) <= 1);
+	}
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("saved %1 frames %2x%3 in %4 ms\n")
+									 .arg(numberOfFrames)
+									 .arg(width)
+									 .arg(height)
+									 .arg(saveTime),
+			1);
+	}
+}
+
+void Test::adaptiveAntiAliasingWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { adaptiveAntiAliasing(); }
+	}
+	else
+	{
+		adaptiveAntiAliasing();
+	}
+}
+
+void Test::adaptiveAntiAliasing() const
+{
+	// adaptive anti-aliasing has to give the same image as full anti-aliasing within the threshold,
+	// with less samples. Result can't depend on number of threads (edges are detected also with
+	// the line above, which can be rendered by other thread)
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	const int width = IsBenchmarking() ? 64 * difficulty : 96;
+	const int height = IsBenchmarking() ? 48 * difficulty : 72;
+	const int antiAliasingSize = 3;
+	const int fullSamples = antiAliasingSize * antiAliasingSize;
+	const double threshold = testPar->Get<double>("antialiasing_adaptive_threshold");
+	testPar->Set("image_width", width);
+	testPar->Set("image_height", height);
+	testPar->Set("antialiasing_enabled", true);
+	testPar->Set("antialiasing_size", antiAliasingSize);
+
+	bool stopRequest = false;
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+	config.DisableNetRender();
+	config.EnableIgnoreErrors();
+
+	struct sAntiAliasingRender
+	{
+		bool adaptive;
+		int threads;
+	};
+	const int maxNumberOfThreads = systemData.numberOfThreads;
+	const QList<sAntiAliasingRender> renders = {
+		{false, maxNumberOfThreads}, {true, maxNumberOfThreads}, {true, 1}};
+	QList<cImage *> images;
+	QList<cStatistics> statistics;
+	QList<qint64> renderTimes;
+
+	for (const sAntiAliasingRender &render : renders)
+	{
+		testPar->Set("antialiasing_adaptive", render.adaptive);
+		systemData.numberOfThreads = render.threads;
+		cImage *image = new cImage(width, height);
+		QElapsedTimer timer;
+		timer.start();
+
+		cRenderJob *renderJob = new cRenderJob(testPar, testParFractal, image, &stopRequest);
+		renderJob->Init(cRenderJob::still, config);
+		QVERIFY2(renderJob->Execute(), "anti-aliased render failed.");
+		renderTimes.append(timer.elapsed());
+		statistics.append(renderJob->GetStatistics());
+		delete renderJob;
+		images.append(image);
+	}
+	systemData.numberOfThreads = maxNumberOfThreads;
+
+	const qint64 numberOfPixels = qint64(width) * height;
+
+	// full anti-aliasing renders all samples of every pixel. Pixels of lines which were started by
+	// two threads at once can be counted twice
+	const cHistogram &fullHistogram = statistics.at(0).histogramAntiAliasingSamples;
+	QVERIFY(fullHistogram.GetCount() >= numberOfPixels);
+	QCOMPARE(qint64(fullHistogram.GetHist(fullSamples)), fullHistogram.GetCount());
+
+	// adaptive anti-aliasing renders two samples, or all of them at edges
+	const cHistogram &adaptiveHistogram = statistics.at(2).histogramAntiAliasingSamples;
+	QCOMPARE(adaptiveHistogram.GetCount(), numberOfPixels);
+	QCOMPARE(qint64(adaptiveHistogram.GetHist(2) + adaptiveHistogram.GetHist(fullSamples)),
+		numberOfPixels);
+	QVERIFY(adaptiveHistogram.GetHist(2) > 0);
+	QVERIFY(adaptiveHistogram.GetHist(fullSamples) > 0);
+	QVERIFY(adaptiveHistogram.GetSum() < numberOfPixels * fullSamples);
+
+	const sRGBFloat *full = images.at(0)->GetPostImageFloatPtr();
+	const sRGBFloat *adaptive = images.at(1)->GetPostImageFloatPtr();
+	double sumOfDifferences = 0.0;
+	double maxDifference = 0.0;
+	for (qint64 i = 0; i < numberOfPixels; i++)
+	{
+		const double differenceRG =
+			qMax(fabs(full[i].R - adaptive[i].R), fabs(full[i].G - adaptive[i].G));
+		const double difference = qMax(differenceRG, double(fabs(full[i].B - adaptive[i].B)));
+		sumOfDifferences += difference;
+		maxDifference = qMax(maxDifference, difference);
+	}
+	const double meanDifference = sumOfDifferences / numberOfPixels;
+	QVERIFY2(meanDifference <= threshold && maxDifference <= threshold,
+		QString("mean difference %1, max difference %2")
+			.arg(meanDifference)
+			.arg(maxDifference)
+			.toLocal8Bit()
+			.constData());
+
+	QVERIFY(memcmp(images.at(1)->GetPostImageFloatPtr(), images.at(2)->GetPostImageFloatPtr(),
+						numberOfPixels * sizeof(sRGBFloat))
+					== 0);
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("full anti-aliasing: %1 ms, adaptive: %2 ms, samples per pixel: %3\n")
+									 .arg(renderTimes.at(0))
+									 .arg(renderTimes.at(1))
+									 .arg(double(adaptiveHistogram.GetSum()) / numberOfPixels, 0, 'f', 2),
+			1);
+	}
+
+	qDeleteAll(images);
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::stepBufferGrowthWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { stepBufferGrowth(); }
+	}
+	else
+	{
+		stepBufferGrowth();
+	}
+}
+
+void Test::stepBufferGrowth() const
+{
+	// recording of ray-marching steps doesn't change the result, also when buffers of steps grow
+	// while rays are marched. Checked for scene without step recording, with transparent material
+	// and with volumetric effects
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	const int width = IsBenchmarking() ? 32 * difficulty : 48;
+	const int height = IsBenchmarking() ? 24 * difficulty : 36;
+	const qint64 numberOfPixels = qint64(width) * height;
+	testPar->Set("image_width", width);
+	testPar->Set("image_height", height);
+
+	enum enumScene
+	{
+		scenePlain,
+		sceneTransparent,
+		sceneVolumetric
+	};
+
+	for (int scene : {scenePlain, sceneTransparent, sceneVolumetric})
+	{
+		testPar->Set("glow_enabled", scene == sceneVolumetric);
+		testPar->Set("basic_fog_enabled", scene == sceneVolumetric);
+		testPar->Set(cMaterial::Name("transparency_of_surface", 1),
+			scene == sceneTransparent ? 0.5 : 0.0);
+
+		QList<cImage *> images;
+		for (bool forced : {false, true})
+		{
+			bool stopRequest = false;
+			cRenderingConfiguration config;
+			config.DisableRefresh();
+			config.DisableProgressiveRender();
+			config.DisableNetRender();
+			config.EnableIgnoreErrors();
+			// buffers of one step have to grow many times during every ray-marching
+			if (forced) config.ForceStepBuffer(1);
+
+			cImage *image = new cImage(width, height);
+			cRenderJob *renderJob = new cRenderJob(testPar, testParFractal, image, &stopRequest);
+			renderJob->Init(cRenderJob::still, config);
+			QVERIFY2(renderJob->Execute(), "render with step buffer failed.");
+			delete renderJob;
+			images.append(image);
+		}
+
+		QVERIFY2(memcmp(images.first()->GetPostImageFloatPtr(),
+							 images.last()->GetPostImageFloatPtr(), numberOfPixels * sizeof(sRGBFloat))
+							 == 0,
+			QString("scene %1").arg(scene).toLocal8Bit().constData());
+		QVERIFY(memcmp(images.first()->GetZBufferPtr(), images.last()->GetZBufferPtr(),
+							numberOfPixels * sizeof(float))
+						== 0);
+		qDeleteAll(images);
+	}
+
+	delete testParFractal;
+	delete testPar;
+}
+
+void Test::rayPacketsWrapper() const
+{
+	if (IsBenchmarking())
+	{
+		QBENCHMARK_ONCE { rayPackets(); }
+	}
+	else
+	{
+		rayPackets();
+	}
+}
+
+void Test::rayPackets() const
+{
+	// cone marching of ray packets has to find the same surface as marching of single rays. Depth
+	// of every pixel is allowed to differ by the distance threshold. A few rays which graze thin
+	// parts of the fractal can hit or miss them depending on positions of ray-marching steps
+	cParameterContainer *testPar = new cParameterContainer;
+	cFractalContainer *testParFractal = new cFractalContainer;
+	testPar->SetContainerName("main");
+	InitParams(testPar);
+	InitMaterialParams(1, testPar);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		testParFractal->at(i).SetContainerName(QString("fractal") + QString::number(i));
+		InitFractalParams(&testParFractal->at(i));
+	}
+
+	const int width = IsBenchmarking() ? 64 * difficulty : 64;
+	const int height = IsBenchmarking() ? 48 * difficulty : 48;
+	const qint64 numberOfPixels = qint64(width) * height;
+	testPar->Set("image_width", width);
+	testPar->Set("image_height", height);
+	// packets are not used with volumetric effects
+	testPar->Set("glow_enabled", false);
+
+	bool stopRequest = false;
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+	config.DisableNetRender();
+	config.EnableIgnoreErrors();
+
+	QList<cImage *> images;
+	QList<cStatistics> statistics;
+	QList<qint64> renderTimes;
+	for (bool packets : {false, true})
+	{
+		testPar->Set("ray_packets_enabled", packets);
+		cImage *image = new cImage(width, height);
+		QElapsedTimer timer;
+		timer.start();
+
+		cRenderJob *renderJob = new cRenderJob(testPar, testParFractal, image, &stopRequest);
+		renderJob->Init(cRenderJob::still, config);
+		QVERIFY2(renderJob->Execute(), "render with ray packets failed.");
+		renderTimes.append(timer.elapsed());
+		statistics.append(renderJob->GetStatistics());
+		delete renderJob;
+		images.append(image);
+	}
+
+	// the same formula as cRenderWorker::CalcDistThresh() with resolution = 1 / height
+	const double distThreshPerDepth =
+		testPar->Get<double>("fov") / height / testPar->Get<double>("detail_level");
+	const float *zSingle = images.at(0)->GetZBufferPtr();
+	const float *zPackets = images.at(1)->GetZBufferPtr();
+	const sRGBFloat *single = images.at(0)->GetPostImageFloatPtr();
+	const sRGBFloat *packets = images.at(1)->GetPostImageFloatPtr();
+	qint64 depthMismatches = 0;
+	double sumOfDifferences = 0.0;
+	for (qint64 i = 0; i < numberOfPixels; i++)
+	{
+		const double depth = qMin(zSingle[i], zPackets[i]);
+		if (fabs(zSingle[i] - zPackets[i]) > depth * distThreshPerDepth) depthMismatches++;
+
+		const double differenceRG =
+			qMax(fabs(single[i].R - packets[i].R), fabs(single[i].G - packets[i].G));
+		sumOfDifferences += qMax(differenceRG, double(fabs(single[i].B - packets[i].B)));
+	}
+	const double meanDifference = sumOfDifferences / numberOfPixels;
+	QVERIFY2(depthMismatches <= numberOfPixels / 100 && meanDifference <= 0.01,
+		QString("pixels with different depth %1, mean difference %2")
+			.arg(depthMismatches)
+			.arg(meanDifference)
+			.toLocal8Bit()
+			.constData());
+
+	// packets skip empty space with one distance estimation for the whole packet
+	const double iterationsSingle = statistics.at(0).GetTotalNumberOfIterations();
+	const double iterationsPackets = statistics.at(1).GetTotalNumberOfIterations();
+	QVERIFY(iterationsPackets < iterationsSingle);
+
+	if (IsBenchmarking())
+	{
+		WriteLogCout(QString("single rays: %1 ms, %2 Miterations, ray packets: %3 ms, %4 Miterations\n")
+									 .arg(renderTimes.at(0))
+									 .arg(iterationsSingle * 1e-6, 0, 'f', 2)
+									 .arg(renderTimes.at(1))
+									 .arg(iterationsPackets * 1e-6, 0, 'f', 2),
+			1);
+	}
+
+	qDeleteAll(images);
+	delete testParFractal;
+	delete testPar;
+}
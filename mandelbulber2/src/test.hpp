@@ -69,16 +69,68 @@ private:
 	void testKeyframe() const;
 	void renderSimple() const;
 	void renderImageSave() const;
+	void renderThreadScaling() const;
+	void singleFormulaLoop() const;
+	void statisticsSharding() const;
+	void pixelRandom() const;
+	void imageLayers() const;
+	void tiledRender() const;
+	void imageCompile() const;
+	void undoDelta() const;
+	void netrenderThroughput() const;
+	void parameterAccess() const;
+	void primitivesCulling() const;
+	void lightsCulling() const;
+	void renderObjectTable() const;
+	void textureCache() const;
+	void distanceBatch() const;
+	void dofGather() const;
+	void meshExport() const;
+	void sparseVoxelPlane() const;
+	void renderReproducibility() const;
+	void lightsCullingRender() const;
+	void lightsSampling() const;
+	void imageSaveQueue() const;
+	void adaptiveAntiAliasing() const;
+	void stepBufferGrowth() const;
+	void rayPackets() const;
 
 private slots:
 	static void init();
 	static void cleanup();
 	void renderExamplesWrapper() const;
 	void netrender() const;
+	void netrenderFrames() const;
+	void netrenderTextureCache() const;
 	void testFlightWrapper() const;
 	void testKeyframeWrapper() const;
 	void renderSimpleWrapper() const;
 	void testImageSaveWrapper() const;
+	void renderThreadScalingWrapper() const;
+	void singleFormulaLoopWrapper() const;
+	void statisticsShardingWrapper() const;
+	void pixelRandomWrapper() const;
+	void imageLayersWrapper() const;
+	void tiledRenderWrapper() const;
+	void imageCompileWrapper() const;
+	void undoDeltaWrapper() const;
+	void netrenderThroughputWrapper() const;
+	void parameterAccessWrapper() const;
+	void primitivesCullingWrapper() const;
+	void lightsCullingWrapper() const;
+	void renderObjectTableWrapper() const;
+	void textureCacheWrapper() const;
+	void distanceBatchWrapper() const;
+	void dofGatherWrapper() const;
+	void meshExportWrapper() const;
+	void sparseVoxelPlaneWrapper() const;
+	void renderReproducibilityWrapper() const;
+	void lightsCullingRenderWrapper() const;
+	void lightsSamplingWrapper() const;
+	void imageSaveQueueWrapper() const;
+	void adaptiveAntiAliasingWrapper() const;
+	void stepBufferGrowthWrapper() const;
+	void rayPacketsWrapper() const;
 };
 
 #endif /* MANDELBULBER2_SRC_TEST_HPP_ */
@@ -31,7 +31,7 @@
  *
  * cTexture class - simple bitmap container with pixel interpolation
  *
- * This class holds an sRGB8 *bitmap to store texture information. The class
+ * This class holds a pointer to sRGBA16 bitmap shared through cTextureCache. The class
  * can be initialized by loading an image file, or by loading a QByteArray (network).
  * Pixel(...) gets the pixel at a given point. The image data is MipMap-ped and
  * bicubic interpolated to give a "smooth" result.
@@ -43,14 +43,11 @@
 #include "common_math.h"
 #include "error_message.hpp"
 #include "files.h"
-#include "qimage.h"
 #include "resource_http_provider.hpp"
 
 // constructor
 cTexture::cTexture(QString filename, enumUseMipmaps mode, int frameNo, bool beQuiet)
 {
-	bitmap = nullptr;
-
 	WriteLogString("Loading texture", filename, 2);
 
 	WriteLogString("Loading texture - AnimatedFileName()", filename, 3);
@@ -63,180 +60,61 @@ cTexture::cTexture(QString filename, enumUseMipmaps mode, int frameNo, bool beQu
 	cResourceHttpProvider httpProvider(filename);
 	if (httpProvider.IsUrl()) filename = httpProvider.cacheAndGetFilename();
 
-	// try to load image if it's PNG format (this one supports 16-bit depth images)
-	WriteLogString("Loading texture - LoadPNG()", filename, 3);
-	bitmap = LoadPNG(filename, width, height);
-
-	// if not, try to use Qt image loader
-	if (!bitmap)
-	{
-		WriteLogString("Loading texture - loading using QImage", filename, 3);
-		QImage qImage;
-		qImage.load(filename);
-		qImage = qImage.convertToFormat(QImage::Format_RGB888);
-		if (!qImage.isNull())
-		{
-			width = qImage.width();
-			height = qImage.height();
-			bitmap = new sRGBA16[width * height];
-			for (int y = 0; y < height; y++)
-			{
-				sRGB8 *line = reinterpret_cast<sRGB8 *>(qImage.scanLine(y));
-				for (int x = 0; x < width; x++)
-				{
-					const sRGBA16 pixel(static_cast<unsigned short>(line[x].R) * 256,
-						static_cast<unsigned short>(line[x].G) * 256,
-						static_cast<unsigned short>(line[x].B) * 256, 65535);
-					bitmap[x + y * width] = pixel;
-				}
-			}
-		}
-	}
+	// the same file is decoded only once and shared by all textures which use it
+	QSharedPointer<const cTextureData> loadedData =
+		cTextureCache::Instance()->Load(filename, frameNo);
 
-	if (bitmap)
+	if (loadedData)
 	{
 		loaded = true;
 		originalFileName = filename;
-		if (mode == useMipmaps)
-		{
-			WriteLogString("Loading texture - CreateMipMaps()", filename, 3);
-			CreateMipMaps();
-		}
+		SetData(loadedData, mode);
 	}
 	else
 	{
 		if (!beQuiet)
 			cErrorMessage::showMessage(
 				QObject::tr("Can't load texture!\n") + filename, cErrorMessage::errorMessage);
-		width = 100;
-		height = 100;
 		loaded = false;
-		bitmap = new sRGBA16[100 * 100];
-		memset(bitmap, 255, sizeof(sRGBA16) * 100 * 100);
+		SetData(cTextureCache::Empty(), doNotUseMipmaps);
 	}
 
 	WriteLogString("Loading texture - finished", filename, 3);
 }
 
-// copy constructor
-cTexture::cTexture(const cTexture &tex)
-{
-	width = tex.width;
-	height = tex.height;
-	loaded = tex.loaded;
-	originalFileName = tex.originalFileName;
-	bitmap = new sRGBA16[width * height];
-	memcpy(bitmap, tex.bitmap, sizeof(sRGBA16) * width * height);
-	mipmaps = tex.mipmaps;
-	mipmapSizes = tex.mipmapSizes;
-}
-
-cTexture &cTexture::operator=(const cTexture &tex)
-{
-	if (bitmap)
-	{
-		delete[] bitmap;
-		bitmap = nullptr;
-	}
-	width = tex.width;
-	height = tex.height;
-	loaded = tex.loaded;
-	originalFileName = tex.originalFileName;
-	bitmap = new sRGBA16[width * height];
-	memcpy(bitmap, tex.bitmap, sizeof(sRGBA16) * width * height);
-	mipmaps = tex.mipmaps;
-	mipmapSizes = tex.mipmapSizes;
-
-	return *this;
-}
-
-cTexture &cTexture::operator=(cTexture &&tex)
-{
-	if (bitmap)
-	{
-		delete[] bitmap;
-		bitmap = nullptr;
-	}
-	width = tex.width;
-	height = tex.height;
-	loaded = tex.loaded;
-	originalFileName = tex.originalFileName;
-	mipmaps = tex.mipmaps;
-	mipmapSizes = tex.mipmapSizes;
-
-	// move
-	bitmap = tex.bitmap;
-	tex.bitmap = nullptr;
-	tex.loaded = false;
-
-	return *this;
-}
-
 void cTexture::FromQByteArray(QByteArray *buffer, enumUseMipmaps mode)
 {
-	if (bitmap)
-	{
-		delete[] bitmap;
-	}
-
-	bitmap = nullptr;
-	QImage qImage(*buffer);
-	qImage.loadFromData(*buffer);
-	qImage = qImage.convertToFormat(QImage::Format_RGB888);
+	QSharedPointer<const cTextureData> loadedData =
+		cTextureCache::Instance()->FromQByteArray(*buffer);
 
-	if (!qImage.isNull())
+	if (loadedData)
 	{
-		width = qImage.width();
-		height = qImage.height();
-		bitmap = new sRGBA16[width * height];
-		for (int y = 0; y < height; y++)
-		{
-			sRGB8 *line = reinterpret_cast<sRGB8 *>(qImage.scanLine(y));
-			for (int x = 0; x < width; x++)
-			{
-				const sRGBA16 pixel(static_cast<unsigned short>(line[x].R) * 256,
-					static_cast<unsigned short>(line[x].G) * 256,
-					static_cast<unsigned short>(line[x].B) * 256, 65535);
-				bitmap[x + y * width] = pixel;
-			}
-		}
-
 		loaded = true;
-
-		if (mode == useMipmaps)
-		{
-			CreateMipMaps();
-		}
+		SetData(loadedData, mode);
 	}
 	else
 	{
 		cErrorMessage::showMessage(
 			QObject::tr("Can't load texture from QByteArray!\n"), cErrorMessage::errorMessage);
-		width = 100;
-		height = 100;
 		loaded = false;
-		bitmap = new sRGBA16[100 * 100];
-		memset(bitmap, 255, sizeof(sRGBA16) * 100 * 100);
+		SetData(cTextureCache::Empty(), doNotUseMipmaps);
 	}
 }
 
 cTexture::cTexture()
 {
-	width = 100;
-	height = 100;
 	loaded = false;
-	bitmap = new sRGBA16[100 * 100];
-	memset(bitmap, 255, sizeof(sRGBA16) * 100 * 100);
+	SetData(cTextureCache::Empty(), doNotUseMipmaps);
 }
 
-// destructor
-cTexture::~cTexture()
+void cTexture::SetData(QSharedPointer<const cTextureData> _data, enumUseMipmaps mode)
 {
-	if (bitmap)
-	{
-		delete[] bitmap;
-		bitmap = nullptr;
-	}
+	data = _data;
+	bitmap = data->Bitmap();
+	width = data->Width();
+	height = data->Height();
+	// mipmaps are created by cTextureData at first use
+	numberOfMipmaps = (mode == useMipmaps) ? data->NumberOfMipmaps() : 0;
 }
 
 // read pixel
@@ -379,12 +257,12 @@ CVector3 cTexture::NormalMap(
 sRGBFloat cTexture::MipMap(double x, double y, double pixelSize) const
 {
 	pixelSize /= double(max(width, height));
-	if (mipmaps.size() > 0 && pixelSize > 0)
+	if (numberOfMipmaps > 0 && pixelSize > 0)
 	{
 		if (pixelSize < 1e-20) pixelSize = 1e-20;
 		double dMipLayer = -log(pixelSize) / log(2.0);
 		if (dMipLayer < 0) dMipLayer = 0;
-		if (dMipLayer + 1 >= mipmaps.size() - 1) dMipLayer = mipmaps.size() - 1;
+		if (dMipLayer + 1 >= numberOfMipmaps - 1) dMipLayer = numberOfMipmaps - 1;
 
 		const int layerBig = int(dMipLayer);
 		const int layerSmall = int(dMipLayer + 1);
@@ -393,26 +271,14 @@ sRGBFloat cTexture::MipMap(double x, double y, double pixelSize) const
 		const double trans = dMipLayer - layerBig;
 		const double transN = 1.0 - trans;
 
-		const sRGBA16 *bigBitmap, *smallBitmap;
-		CVector2<int> bigBitmapSize, smallBitmapSize;
-		if (layerBig >= 0 && layerBig <= mipmaps.length() && layerSmall >= 0
-				&& layerSmall <= mipmaps.length())
+		if (layerBig >= 0 && layerBig <= numberOfMipmaps && layerSmall >= 0
+				&& layerSmall <= numberOfMipmaps)
 		{
-			if (layerBig == 0)
-			{
-				bigBitmap = bitmap;
-				smallBitmap = mipmaps[layerSmall - 1].data();
-				bigBitmapSize.x = width;
-				bigBitmapSize.y = height;
-				smallBitmapSize = mipmapSizes[layerSmall - 1];
-			}
-			else
-			{
-				bigBitmap = mipmaps[layerBig - 1].data();
-				smallBitmap = mipmaps[layerSmall - 1].data();
-				bigBitmapSize = mipmapSizes[layerBig - 1];
-				smallBitmapSize = mipmapSizes[layerSmall - 1];
-			}
+			const sRGBA16 *bigBitmap = data->Mipmap(layerBig);
+			const sRGBA16 *smallBitmap = data->Mipmap(layerSmall);
+			const CVector2<int> bigBitmapSize = data->MipmapSize(layerBig);
+			const CVector2<int> smallBitmapSize = data->MipmapSize(layerSmall);
+
 			const sRGBFloat pixelFromBig = BicubicInterpolation(
 				x / sizeMultipleBig, y / sizeMultipleBig, bigBitmap, bigBitmapSize.x, bigBitmapSize.y);
 			const sRGBFloat pixelFromSmall = BicubicInterpolation(x / sizeMultipleSmall,
@@ -434,41 +300,3 @@ sRGBFloat cTexture::MipMap(double x, double y, double pixelSize) const
 		return BicubicInterpolation(x, y, bitmap, width, height);
 	}
 }
-
-void cTexture::CreateMipMaps()
-{
-	int prevW = width;
-	int prevH = height;
-	int w = width / 2;
-	int h = height / 2;
-	sRGBA16 *prevBitmap = bitmap;
-	while (w > 0 && h > 0)
-	{
-		QVector<sRGBA16> newMipmapV(w * h);
-		sRGBA16 *newMipmap = newMipmapV.data();
-
-		for (int y = 0; y < h; y++)
-		{
-			for (int x = 0; x < w; x++)
-			{
-				sRGBA16 newPixel;
-				const sRGBA16 p1 = prevBitmap[WrapInt(x * 2, prevW) + WrapInt(y * 2, prevH) * prevW];
-				const sRGBA16 p2 = prevBitmap[WrapInt(x * 2 + 1, prevW) + WrapInt(y * 2, prevH) * prevW];
-				const sRGBA16 p3 = prevBitmap[WrapInt(x * 2, prevW) + WrapInt(y * 2 + 1, prevH) * prevW];
-				const sRGBA16 p4 =
-					prevBitmap[WrapInt(x * 2 + 1, prevW) + WrapInt(y * 2 + 1, prevH) * prevW];
-				newPixel.R = static_cast<unsigned short>((int(p1.R) + p2.R + p3.R + p4.R) / 4);
-				newPixel.G = static_cast<unsigned short>((int(p1.G) + p2.G + p3.G + p4.G) / 4);
-				newPixel.B = static_cast<unsigned short>((int(p1.B) + p2.B + p3.B + p4.B) / 4);
-				newMipmap[x + y * w] = newPixel;
-			}
-		}
-		mipmapSizes.append(CVector2<int>(w, h));
-		mipmaps.append(newMipmapV);
-		prevH = h;
-		prevW = w;
-		w /= 2;
-		h /= 2;
-		prevBitmap = mipmaps.last().data();
-	}
-}
@@ -31,8 +31,9 @@
  *
  * cTexture class - simple bitmap container with pixel interpolation
  *
- * This class holds an sRGB8 *bitmap to store texture information. The class
+ * This class holds a pointer to sRGBA16 bitmap shared through cTextureCache. The class
  * can be initialized by loading an image file, or by loading a QByteArray (network).
+ * Copying is cheap, because pixel data is never modified after loading.
  * Pixel(...) gets the pixel at a given point. The image data is MipMap-ped and
  * bicubic interpolated to give a "smooth" result.
  * more information on Mipmaps:  https://en.wikipedia.org/wiki/Mipmap
@@ -42,11 +43,12 @@
 #define MANDELBULBER2_SRC_TEXTURE_HPP_
 
 #include <qbytearray.h>
-#include <qlist.h>
+#include <qsharedpointer.h>
 #include <qstring.h>
 
 #include "algebra.hpp"
 #include "color_structures.hpp"
+#include "texture_cache.hpp"
 
 class cTexture
 {
@@ -59,11 +61,7 @@ public:
 
 	cTexture(QString filename, enumUseMipmaps mode, int frameNo, bool beQuiet);
 	cTexture();
-	cTexture(const cTexture &tex);
-	cTexture &operator=(const cTexture &tex);
-	cTexture &operator=(cTexture &&tex);
 
-	~cTexture();
 	int Height() const { return height; }
 	int Width() const { return width; }
 	sRGBFloat Pixel(double x, double y, double pixelSize = 0.0) const;
@@ -80,15 +78,14 @@ private:
 	sRGBA16 LinearInterpolation(double x, double y) const;
 	static sRGBFloat BicubicInterpolation(double x, double y, const sRGBA16 *bitmap, int w, int h);
 	sRGBFloat MipMap(double x, double y, double pixelSize) const;
-	void CreateMipMaps();
-	static int WrapInt(int a, int size) { return (a + size) % size; }
-	sRGBA16 *bitmap;
+	void SetData(QSharedPointer<const cTextureData> _data, enumUseMipmaps mode);
+	QSharedPointer<const cTextureData> data;
+	const sRGBA16 *bitmap;
 	int width;
 	int height;
+	int numberOfMipmaps;
 	bool loaded;
 	QString originalFileName;
-	QList<QVector<sRGBA16>> mipmaps;
-	QList<CVector2<int>> mipmapSizes;
 };
 
 #endif /* MANDELBULBER2_SRC_TEXTURE_HPP_ */
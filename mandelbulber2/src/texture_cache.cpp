@@ -0,0 +1,237 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2014-17 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cTextureCache - process-wide cache of decoded textures
+ */
+
+#include "texture_cache.hpp"
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QImage>
+#include <QMutexLocker>
+
+#include "files.h"
+#include "netrender_texture_cache.hpp"
+#include "system.hpp"
+
+cTextureData::cTextureData(sRGBA16 *_bitmap, int _width, int _height)
+		: bitmap(_bitmap), width(_width), height(_height), mipmapsCreated(0)
+{
+	int w = width / 2;
+	int h = height / 2;
+	while (w > 0 && h > 0)
+	{
+		mipmapSizes.append(CVector2<int>(w, h));
+		w /= 2;
+		h /= 2;
+	}
+	mipmaps.resize(mipmapSizes.size());
+}
+
+cTextureData::~cTextureData()
+{
+	delete[] bitmap;
+}
+
+const sRGBA16 *cTextureData::Mipmap(int level) const
+{
+	if (level == 0) return bitmap;
+	if (level > mipmapsCreated.loadAcquire()) CreateMipmaps(level);
+	return mipmaps.at(level - 1).constData();
+}
+
+qint64 cTextureData::MemoryUsage() const
+{
+	// all mipmaps together are not bigger than 1/3 of the bitmap
+	return qint64(width) * height * qint64(sizeof(sRGBA16)) * 4 / 3;
+}
+
+void cTextureData::CreateMipmaps(int level) const
+{
+	QMutexLocker lock(&mipmapsMutex);
+
+	// other thread could create them in the meantime
+	for (int layer = mipmapsCreated.loadAcquire() + 1; layer <= level; layer++)
+	{
+		const CVector2<int> prevSize = MipmapSize(layer - 1);
+		const int prevW = prevSize.x;
+		const int prevH = prevSize.y;
+		const sRGBA16 *prevBitmap = (layer == 1) ? bitmap : mipmaps.at(layer - 2).constData();
+		const int w = mipmapSizes.at(layer - 1).x;
+		const int h = mipmapSizes.at(layer - 1).y;
+
+		QVector<sRGBA16> newMipmapV(w * h);
+		sRGBA16 *newMipmap = newMipmapV.data();
+
+		for (int y = 0; y < h; y++)
+		{
+			for (int x = 0; x < w; x++)
+			{
+				sRGBA16 newPixel;
+				const sRGBA16 p1 = prevBitmap[WrapInt(x * 2, prevW) + WrapInt(y * 2, prevH) * prevW];
+				const sRGBA16 p2 = prevBitmap[WrapInt(x * 2 + 1, prevW) + WrapInt(y * 2, prevH) * prevW];
+				const sRGBA16 p3 = prevBitmap[WrapInt(x * 2, prevW) + WrapInt(y * 2 + 1, prevH) * prevW];
+				const sRGBA16 p4 =
+					prevBitmap[WrapInt(x * 2 + 1, prevW) + WrapInt(y * 2 + 1, prevH) * prevW];
+				newPixel.R = static_cast<unsigned short>((int(p1.R) + p2.R + p3.R + p4.R) / 4);
+				newPixel.G = static_cast<unsigned short>((int(p1.G) + p2.G + p3.G + p4.G) / 4);
+				newPixel.B = static_cast<unsigned short>((int(p1.B) + p2.B + p3.B + p4.B) / 4);
+				newMipmap[x + y * w] = newPixel;
+			}
+		}
+		mipmaps[layer - 1] = newMipmapV;
+
+		// rendering threads can use this level from now
+		mipmapsCreated.storeRelease(layer);
+	}
+}
+
+cTextureCache::cTextureCache() : cache(maxMemoryUsage) {}
+
+cTextureCache *cTextureCache::Instance()
+{
+	static cTextureCache instance;
+	return &instance;
+}
+
+QSharedPointer<const cTextureData> cTextureCache::Load(const QString &fileName, int frameNo)
+{
+	const QFileInfo fileInfo(fileName);
+	const QString key = QString("%1|%2|%3|%4")
+												.arg(fileName)
+												.arg(frameNo)
+												.arg(fileInfo.lastModified().toMSecsSinceEpoch())
+												.arg(fileInfo.size());
+
+	QSharedPointer<const cTextureData> data = Find(key);
+	if (data) return data;
+
+	// try to load image if it's PNG format (this one supports 16-bit depth images)
+	int width = 0;
+	int height = 0;
+	WriteLogString("Loading texture - LoadPNG()", fileName, 3);
+	sRGBA16 *bitmap = LoadPNG(fileName, width, height);
+
+	// if not, try to use Qt image loader
+	if (!bitmap)
+	{
+		WriteLogString("Loading texture - loading using QImage", fileName, 3);
+		bitmap = ImageToBitmap(QImage(fileName), width, height);
+	}
+
+	if (!bitmap) return data;
+
+	data.reset(new cTextureData(bitmap, width, height));
+	Insert(key, data);
+	return data;
+}
+
+QSharedPointer<const cTextureData> cTextureCache::FromQByteArray(const QByteArray &buffer)
+{
+	const QString key = "data|" + QString(cNetRenderTextureCache::Hash(buffer).toHex());
+
+	QSharedPointer<const cTextureData> data = Find(key);
+	if (data) return data;
+
+	int width = 0;
+	int height = 0;
+	sRGBA16 *bitmap = ImageToBitmap(QImage::fromData(buffer), width, height);
+	if (!bitmap) return data;
+
+	data.reset(new cTextureData(bitmap, width, height));
+	Insert(key, data);
+	return data;
+}
+
+QSharedPointer<const cTextureData> cTextureCache::Empty()
+{
+	static const QSharedPointer<const cTextureData> empty = []() {
+		sRGBA16 *bitmap = new sRGBA16[100 * 100];
+		memset(bitmap, 255, sizeof(sRGBA16) * 100 * 100);
+		return QSharedPointer<const cTextureData>(new cTextureData(bitmap, 100, 100));
+	}();
+	return empty;
+}
+
+void cTextureCache::Clear()
+{
+	QMutexLocker lock(&mutex);
+	cache.clear();
+}
+
+int cTextureCache::Count() const
+{
+	QMutexLocker lock(&mutex);
+	return cache.count();
+}
+
+QSharedPointer<const cTextureData> cTextureCache::Find(const QString &key)
+{
+	QMutexLocker lock(&mutex);
+	if (QSharedPointer<const cTextureData> *cached = cache.object(key))
+	{
+		WriteLogString("Loading texture - found in cache", key, 3);
+		return *cached;
+	}
+	return QSharedPointer<const cTextureData>();
+}
+
+void cTextureCache::Insert(const QString &key, const QSharedPointer<const cTextureData> &data)
+{
+	// textures still used by materials stay alive when removed from cache
+	QMutexLocker lock(&mutex);
+	cache.insert(key, new QSharedPointer<const cTextureData>(data),
+		int(qMin(data->MemoryUsage() / 1024 + 1, qint64(maxMemoryUsage))));
+}
+
+sRGBA16 *cTextureCache::ImageToBitmap(const QImage &image, int &outWidth, int &outHeight)
+{
+	if (image.isNull()) return nullptr;
+
+	const QImage rgbImage = image.convertToFormat(QImage::Format_RGB888);
+	outWidth = rgbImage.width();
+	outHeight = rgbImage.height();
+	sRGBA16 *bitmap = new sRGBA16[outWidth * outHeight];
+	for (int y = 0; y < outHeight; y++)
+	{
+		const uchar *line = rgbImage.constScanLine(y);
+		sRGBA16 *outLine = bitmap + y * outWidth;
+		for (int x = 0; x < outWidth; x++, line += 3)
+		{
+			outLine[x] = sRGBA16(static_cast<unsigned short>(line[0] << 8),
+				static_cast<unsigned short>(line[1] << 8), static_cast<unsigned short>(line[2] << 8),
+				65535);
+		}
+	}
+	return bitmap;
+}
@@ -0,0 +1,119 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2014-17 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cTextureCache - process-wide cache of decoded textures
+ *
+ * Textures are identified by resolved file name, frame number, modification time and size of the
+ * file, so consecutive render jobs and animation frames which use the same textures don't load
+ * them again. Pixel data is immutable and shared between all cTexture objects. Mipmaps are
+ * created at first use and only down to the level which was requested.
+ */
+
+#ifndef MANDELBULBER2_SRC_TEXTURE_CACHE_HPP_
+#define MANDELBULBER2_SRC_TEXTURE_CACHE_HPP_
+
+#include <QAtomicInt>
+#include <QByteArray>
+#include <QCache>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+#include "algebra.hpp"
+#include "color_structures.hpp"
+
+class QImage;
+
+class cTextureData
+{
+public:
+	// takes ownership of bitmap allocated with new[]
+	cTextureData(sRGBA16 *_bitmap, int _width, int _height);
+	~cTextureData();
+
+	const sRGBA16 *Bitmap() const { return bitmap; }
+	int Width() const { return width; }
+	int Height() const { return height; }
+	int NumberOfMipmaps() const { return mipmapSizes.size(); }
+	// level 0 is the original bitmap, every next level has half of the size
+	const sRGBA16 *Mipmap(int level) const;
+	CVector2<int> MipmapSize(int level) const
+	{
+		return level == 0 ? CVector2<int>(width, height) : mipmapSizes.at(level - 1);
+	}
+	int NumberOfCreatedMipmaps() const { return mipmapsCreated.loadAcquire(); }
+	qint64 MemoryUsage() const;
+
+private:
+	Q_DISABLE_COPY(cTextureData)
+	void CreateMipmaps(int level) const;
+	static int WrapInt(int a, int size) { return (a + size) % size; }
+
+	sRGBA16 *bitmap;
+	int width;
+	int height;
+	QVector<CVector2<int>> mipmapSizes;
+	// allocated for all levels in constructor, so it is never reallocated while rendering
+	mutable QVector<QVector<sRGBA16>> mipmaps;
+	mutable QAtomicInt mipmapsCreated;
+	mutable QMutex mipmapsMutex;
+};
+
+class cTextureCache
+{
+public:
+	static cTextureCache *Instance();
+
+	// returns null pointer if file can't be loaded
+	QSharedPointer<const cTextureData> Load(const QString &fileName, int frameNo);
+	QSharedPointer<const cTextureData> FromQByteArray(const QByteArray &buffer);
+	// white bitmap used when texture is not loaded
+	static QSharedPointer<const cTextureData> Empty();
+
+	void Clear();
+	int Count() const;
+
+	// limit of memory used by cached textures which are not used by any render job [kB]
+	static const int maxMemoryUsage = 1024 * 1024;
+
+private:
+	cTextureCache();
+	QSharedPointer<const cTextureData> Find(const QString &key);
+	void Insert(const QString &key, const QSharedPointer<const cTextureData> &data);
+	static sRGBA16 *ImageToBitmap(const QImage &image, int &outWidth, int &outHeight);
+
+	QCache<QString, QSharedPointer<const cTextureData>> cache; // cost in kB
+	mutable QMutex mutex;
+};
+
+#endif /* MANDELBULBER2_SRC_TEXTURE_CACHE_HPP_ */
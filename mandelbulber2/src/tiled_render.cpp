@@ -0,0 +1,192 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cTiledRenderer - rendering of very large images tile by tile
+ */
+
+#include "tiled_render.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "ao_modes.h"
+#include "cimage.hpp"
+#include "error_message.hpp"
+#include "file_image.hpp"
+#include "fractal_container.hpp"
+#include "parameters.hpp"
+#include "render_job.hpp"
+#include "rendering_configuration.hpp"
+#include "system.hpp"
+
+cTiledRenderer::cTiledRenderer(
+	const cParameterContainer *_params, const cFractalContainer *_fractal, bool *_stopRequest)
+		: QObject()
+{
+	params = _params;
+	fractal = _fractal;
+	stopRequest = _stopRequest;
+}
+
+cTiledRenderer::~cTiledRenderer()
+{
+	// nothing to destroy
+}
+
+int cTiledRenderer::CalculateHalo(const cParameterContainer *params, int tileWidth, int tileHeight)
+{
+	int frameWidth = params->Get<int>("image_width");
+	int frameHeight = params->Get<int>("image_height");
+	double halo = 0.0;
+
+	if (params->Get<bool>("ambient_occlusion_enabled")
+			&& params->Get<int>("ambient_occlusion_mode") == params::AOModeScreenSpace)
+	{
+		// SSAO samples up to a half of frame width, but most of samples are close to the pixel
+		halo = qMax(halo, frameWidth * 0.5);
+	}
+
+	if (params->Get<bool>("DOF_enabled") && !params->Get<bool>("DOF_monte_carlo"))
+	{
+		// blur radius of DOF is never bigger than DOF_max_radius
+		double dofRadius = params->Get<double>("DOF_radius") * (frameWidth + frameHeight) / 2000.0;
+		halo = qMax(halo, qMin(dofRadius, params->Get<double>("DOF_max_radius")));
+	}
+
+	if (params->Get<bool>("hdr_blur_enabled"))
+	{
+		halo = qMax(halo, params->Get<double>("hdr_blur_radius") * (frameWidth + frameHeight) * 0.001);
+	}
+
+	// memory usage is limited to 4x tile size
+	int maxHalo = qMax(tileWidth, tileHeight) / 2;
+	return qMin(int(ceil(halo)) + 1, maxHalo);
+}
+
+cRegion<int> cTiledRenderer::TileRegion(int frameWidth, int frameHeight, int tiles, int tileIndex)
+{
+	int tileWidth = (frameWidth + tiles - 1) / tiles;
+	int tileHeight = (frameHeight + tiles - 1) / tiles;
+	int x1 = (tileIndex % tiles) * tileWidth;
+	int y1 = (tileIndex / tiles) * tileHeight;
+	return cRegion<int>(qMin(x1, frameWidth), qMin(y1, frameHeight),
+		qMin(x1 + tileWidth, frameWidth), qMin(y1 + tileHeight, frameHeight));
+}
+
+bool cTiledRenderer::RenderAndSave(const QString &filename, bool sixteenBit)
+{
+	WriteLog("cTiledRenderer::RenderAndSave()", 2);
+
+	if (params->Get<bool>("stereo_enabled"))
+	{
+		cErrorMessage::showMessage(QObject::tr("Stereoscopic images cannot be rendered in tiles"),
+			cErrorMessage::errorMessage);
+		return false;
+	}
+
+	int frameWidth = params->Get<int>("image_width");
+	int frameHeight = params->Get<int>("image_height");
+	int tiles = params->Get<int>("tiles");
+	int tileWidth = (frameWidth + tiles - 1) / tiles;
+	int tileHeight = (frameHeight + tiles - 1) / tiles;
+	int halo = CalculateHalo(params, tileWidth, tileHeight);
+
+	WriteLog(QString("Tiled rendering: %1 x %2 tiles, tile size %3 x %4, halo %5")
+						 .arg(tiles)
+						 .arg(tiles)
+						 .arg(tileWidth)
+						 .arg(tileHeight)
+						 .arg(halo),
+		2);
+
+	// tiles are rendered only on CPU
+	cParameterContainer tileParams = *params;
+	tileParams.Set("opencl_enabled", false);
+
+	cRenderingConfiguration config;
+	config.DisableRefresh();
+	config.DisableProgressiveRender();
+	config.DisableNetRender();
+
+	ImageFileSavePNGStream output(filename, frameWidth, frameHeight, sixteenBit);
+	if (!output.IsOpen()) return false;
+
+	// one row of tiles (without halo) is kept until it is written to the file
+	std::vector<sRGB16> rowOfTiles(size_t(frameWidth) * tileHeight);
+
+	cImage tileImage(tileWidth, tileHeight);
+
+	for (int tileIndex = 0; tileIndex < tiles * tiles; tileIndex++)
+	{
+		cRegion<int> tile = TileRegion(frameWidth, frameHeight, tiles, tileIndex);
+
+		if (tile.width > 0 && tile.height > 0)
+		{
+			emit updateProgressAndStatus(QObject::tr("Tiled rendering"),
+				QObject::tr("Rendering tile %1 of %2").arg(tileIndex + 1).arg(tiles * tiles),
+				double(tileIndex) / (tiles * tiles));
+
+			cRegion<int> tileWithHalo(qMax(tile.x1 - halo, 0), qMax(tile.y1 - halo, 0),
+				qMin(tile.x2 + halo, frameWidth), qMin(tile.y2 + halo, frameHeight));
+
+			cRenderJob renderJob(&tileParams, fractal, &tileImage, stopRequest);
+			connect(&renderJob, SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)),
+				this, SIGNAL(updateProgressAndStatus(const QString &, const QString &, double)));
+			renderJob.SetTile(tileWithHalo);
+
+			if (!renderJob.Init(cRenderJob::still, config)) return false;
+			renderJob.Execute();
+			if (*stopRequest) return false;
+
+			for (int y = tile.y1; y < tile.y2; y++)
+			{
+				sRGB16 *row = &rowOfTiles[size_t(y - tile.y1) * frameWidth];
+				for (int x = tile.x1; x < tile.x2; x++)
+				{
+					row[x] = tileImage.GetPixelImage16(x - tileWithHalo.x1, y - tileWithHalo.y1);
+				}
+			}
+		}
+
+		// last tile in the row. Rows can be written to the file
+		if (tileIndex % tiles == tiles - 1)
+		{
+			for (int y = tile.y1; y < tile.y2; y++)
+			{
+				if (!output.WriteRow(&rowOfTiles[size_t(y - tile.y1) * frameWidth])) return false;
+			}
+		}
+	}
+
+	emit updateProgressAndStatus(QObject::tr("Tiled rendering"), QObject::tr("Done"), 1.0);
+
+	return output.Finish();
+}
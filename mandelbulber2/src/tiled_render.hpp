@@ -0,0 +1,78 @@
+/**
+ * Mandelbulber v2, a 3D fractal generator       ,=#MKNmMMKmmßMNWy,
+ *                                             ,B" ]L,,p%%%,,,§;, "K
+ * Copyright (C) 2016-18 Mandelbulber Team     §R-==%w["'~5]m%=L.=~5N
+ *                                        ,=mm=§M ]=4 yJKA"/-Nsaj  "Bw,==,,
+ * This file is part of Mandelbulber.    §R.r= jw",M  Km .mM  FW ",§=ß., ,TN
+ *                                     ,4R =%["w[N=7]J '"5=],""]]M,w,-; T=]M
+ * Mandelbulber is free software:     §R.ß~-Q/M=,=5"v"]=Qf,'§"M= =,M.§ Rz]M"Kw
+ * you can redistribute it and/or     §w "xDY.J ' -"m=====WeC=\ ""%""y=%"]"" §
+ * modify it under the terms of the    "§M=M =D=4"N #"%==A%p M§ M6  R' #"=~.4M
+ * GNU General Public License as        §W =, ][T"]C  §  § '§ e===~ U  !§[Z ]N
+ * published by the                    4M",,Jm=,"=e~  §  §  j]]""N  BmM"py=ßM
+ * Free Software Foundation,          ]§ T,M=& 'YmMMpM9MMM%=w=,,=MT]M m§;'§,
+ * either version 3 of the License,    TWw [.j"5=~N[=§%=%W,T ]R,"=="Y[LFT ]N
+ * or (at your option)                   TW=,-#"%=;[  =Q:["V""  ],,M.m == ]N
+ * any later version.                      J§"mr"] ,=,," =="""J]= M"M"]==ß"
+ *                                          §= "=C=4 §"eM "=B:m|4"]#F,§~
+ * Mandelbulber is distributed in            "9w=,,]w em%wJ '"~" ,=,,ß"
+ * the hope that it will be useful,                 . "K=  ,=RMMMßM"""
+ * but WITHOUT ANY WARRANTY;                            .'''
+ * without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU General Public License
+ * along with Mandelbulber. If not, see <http://www.gnu.org/licenses/>.
+ *
+ * ###########################################################################
+ *
+ * Authors: Krzysztof Marczak (buddhi1980@gmail.com)
+ *
+ * cTiledRenderer - rendering of very large images tile by tile
+ *
+ * The frame is divided into tiles x tiles parts. Every tile is rendered as a separate job into
+ * a small image buffer, extended by a halo region, so post effects which need neighbouring
+ * pixels (SSAO, DOF, HDR blur) give the same result on tile edges. Finished rows of tiles are
+ * streamed directly to the PNG file, so the used memory depends on the tile size, not on the
+ * final resolution.
+ */
+
+#ifndef MANDELBULBER2_SRC_TILED_RENDER_HPP_
+#define MANDELBULBER2_SRC_TILED_RENDER_HPP_
+
+#include <QObject>
+
+#include "region.hpp"
+
+// forward declarations
+class cParameterContainer;
+class cFractalContainer;
+
+class cTiledRenderer : public QObject
+{
+	Q_OBJECT
+public:
+	cTiledRenderer(
+		const cParameterContainer *_params, const cFractalContainer *_fractal, bool *_stopRequest);
+	~cTiledRenderer() override;
+
+	// renders the whole frame and saves it as PNG (8 or 16 bits per channel)
+	bool RenderAndSave(const QString &filename, bool sixteenBit);
+
+	// width of margin around tile needed by post effects (limited to half of tile size)
+	static int CalculateHalo(const cParameterContainer *params, int tileWidth, int tileHeight);
+
+	// part of the frame for given tile index (without halo)
+	static cRegion<int> TileRegion(int frameWidth, int frameHeight, int tiles, int tileIndex);
+
+private:
+	const cParameterContainer *params;
+	const cFractalContainer *fractal;
+	bool *stopRequest;
+
+signals:
+	void updateProgressAndStatus(const QString &text, const QString &progressText, double progress);
+};
+
+#endif /* MANDELBULBER2_SRC_TILED_RENDER_HPP_ */
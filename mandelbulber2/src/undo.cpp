@@ -36,6 +36,10 @@
  * The buffer is a simple LIFO buffer which holds the parameter entries.
  * (A Store() invocation while Undo-ed in the list will truncate to the current level
  * and append the new entry. The Redo entries will be lost.)
+ * Only the state at the current level is stored completely. Every entry holds only the
+ * parameters (and animation frames) which were changed in this step, with values before and
+ * after the change. The oldest entries are removed when the buffer exceeds the memory limit
+ * (undo_memory_limit).
  */
 
 #include "undo.h"
@@ -50,6 +54,7 @@ cUndo gUndo;
 cUndo::cUndo()
 {
 	level = 0;
+	usedMemory = 0;
 }
 
 cUndo::~cUndo() = default;
@@ -57,8 +62,6 @@ cUndo::~cUndo() = default;
 void cUndo::Store(cParameterContainer *par, cFractalContainer *parFractal, cAnimationFrames *frames,
 	cKeyframes *keyframes)
 {
-	sUndoRecord record;
-
 	// autosave
 	WriteLog("Autosave started", 2);
 	cSettings parSettings(cSettings::formatCondensedText);
@@ -67,67 +70,107 @@ void cUndo::Store(cParameterContainer *par, cFractalContainer *parFractal, cAnim
 	WriteLog("Autosave finished", 2);
 
 	WriteLog("cUndo::Store() started", 2);
-	record.mainParams = *par;
-	record.fractParams = *parFractal;
+
+	sUndoRecord record;
+	bool changed = false;
+
+	if (actualState.stored)
+	{
+		actualState.mainParams.GetDifferences(
+			*par, &record.mainParams.before, &record.mainParams.after);
+		changed |= !record.mainParams.before.isEmpty();
+
+		for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+		{
+			actualState.fractParams.at(i).GetDifferences(
+				parFractal->at(i), &record.fractParams[i].before, &record.fractParams[i].after);
+			changed |= !record.fractParams[i].before.isEmpty();
+		}
+
+		if (frames && actualState.hasFrames && !IsEqual(actualState.animationFrames, *frames))
+		{
+			record.framesBefore = actualState.animationFrames;
+			record.framesAfter = *frames;
+			record.framesChanged = true;
+			changed = true;
+		}
+
+		if (keyframes && actualState.hasKeyframes
+				&& (actualState.animationKeyframes.GetFramesPerKeyframe()
+							 != keyframes->GetFramesPerKeyframe()
+						|| !IsEqual(actualState.animationKeyframes, *keyframes)))
+		{
+			record.keyframesBefore = actualState.animationKeyframes;
+			record.keyframesAfter = *keyframes;
+			record.keyframesChanged = true;
+			changed = true;
+		}
+	}
+
+	// copies of containers are cheap (implicit sharing)
+	actualState.mainParams = *par;
+	actualState.fractParams = *parFractal;
 	if (frames)
 	{
-		record.animationFrames = *frames;
-		record.hasFrames = true;
+		actualState.animationFrames = *frames;
+		actualState.hasFrames = true;
 	}
-	else
+	if (keyframes)
 	{
-		record.hasFrames = false;
-		record.animationFrames = cAnimationFrames();
+		actualState.animationKeyframes = *keyframes;
+		actualState.hasKeyframes = true;
 	}
 
-	if (keyframes)
+	// first call stores only the initial state
+	if (!actualState.stored)
 	{
-		record.animationKeyframes = *keyframes;
-		record.hasKeyframes = true;
+		actualState.stored = true;
+		WriteLog("cUndo::Store() finished", 2);
+		return;
 	}
-	else
+
+	if (!changed)
 	{
-		record.hasKeyframes = false;
-		record.animationKeyframes = cKeyframes();
+		WriteLog("cUndo::Store() finished - nothing changed", 2);
+		return;
 	}
 
-	if (undoBuffer.size() > level)
+	// redo entries are lost
+	while (undoBuffer.size() > level)
 	{
-		for (int i = undoBuffer.size() - 1; i >= level; i--)
-		{
-			undoBuffer.removeAt(i);
-		}
+		usedMemory -= undoBuffer.last().usedMemory;
+		undoBuffer.removeLast();
 	}
 
+	record.usedMemory = EstimateMemory(record.mainParams);
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+		record.usedMemory += EstimateMemory(record.fractParams[i]);
+	if (record.framesChanged)
+		record.usedMemory += EstimateMemory(record.framesBefore) + EstimateMemory(record.framesAfter);
+	if (record.keyframesChanged)
+		record.usedMemory +=
+			EstimateMemory(record.keyframesBefore) + EstimateMemory(record.keyframesAfter);
+
 	undoBuffer.append(record);
+	usedMemory += record.usedMemory;
 	level++;
-	WriteLog("cUndo::Store() finished", 2);
+
+	LimitMemory();
+
+	WriteLog(QString("cUndo::Store() finished, %1 records, %2 kB used")
+						 .arg(undoBuffer.size())
+						 .arg(usedMemory / 1024),
+		2);
 }
 
 bool cUndo::Undo(cParameterContainer *par, cFractalContainer *parFractal, cAnimationFrames *frames,
 	cKeyframes *keyframes, bool *refreshFrames, bool *refreshKeyframes)
 {
-	if (level > 1)
+	if (level > 0)
 	{
-		sUndoRecord record;
-		if (undoBuffer.length() >= level)
-		{
-			level--;
-			record = undoBuffer.at(level - 1);
-			*par = record.mainParams;
-			*parFractal = record.fractParams;
-			if (frames && record.hasFrames)
-			{
-				*frames = record.animationFrames;
-				*refreshFrames = true;
-			}
-			if (keyframes && record.hasKeyframes)
-			{
-				*keyframes = record.animationKeyframes;
-				keyframes->RegenerateAudioTracks(par);
-				*refreshKeyframes = true;
-			}
-		}
+		level--;
+		Apply(undoBuffer.at(level), false, par, parFractal, frames, keyframes, refreshFrames,
+			refreshKeyframes);
 		return true;
 	}
 	else
@@ -142,27 +185,127 @@ bool cUndo::Redo(cParameterContainer *par, cFractalContainer *parFractal, cAnima
 {
 	if (level < undoBuffer.size())
 	{
-		sUndoRecord record;
-		record = undoBuffer.at(level);
+		Apply(undoBuffer.at(level), true, par, parFractal, frames, keyframes, refreshFrames,
+			refreshKeyframes);
 		level++;
-		*par = record.mainParams;
-		*parFractal = record.fractParams;
-		if (frames && record.hasFrames)
+		return true;
+	}
+	else
+	{
+		cErrorMessage::showMessage(QObject::tr("No more redo"), cErrorMessage::warningMessage);
+		return false;
+	}
+}
+
+void cUndo::Apply(const sUndoRecord &record, bool redo, cParameterContainer *par,
+	cFractalContainer *parFractal, cAnimationFrames *frames, cKeyframes *keyframes,
+	bool *refreshFrames, bool *refreshKeyframes)
+{
+	// only changed parameters are modified in the stored state
+	actualState.mainParams.ApplyParameters(
+		redo ? record.mainParams.after : record.mainParams.before);
+	*par = actualState.mainParams;
+
+	for (int i = 0; i < NUMBER_OF_FRACTALS; i++)
+	{
+		actualState.fractParams.at(i).ApplyParameters(
+			redo ? record.fractParams[i].after : record.fractParams[i].before);
+	}
+	*parFractal = actualState.fractParams;
+
+	if (record.framesChanged)
+	{
+		actualState.animationFrames = redo ? record.framesAfter : record.framesBefore;
+		if (frames)
 		{
-			*frames = record.animationFrames;
+			*frames = actualState.animationFrames;
 			*refreshFrames = true;
 		}
-		if (keyframes && record.hasKeyframes)
+	}
+
+	if (record.keyframesChanged)
+	{
+		actualState.animationKeyframes = redo ? record.keyframesAfter : record.keyframesBefore;
+		if (keyframes)
 		{
-			*keyframes = record.animationKeyframes;
+			*keyframes = actualState.animationKeyframes;
 			keyframes->RegenerateAudioTracks(par);
 			*refreshKeyframes = true;
 		}
-		return true;
 	}
-	else
+}
+
+void cUndo::LimitMemory()
+{
+	const qint64 memoryLimit = qint64(gPar->Get<int>("undo_memory_limit")) * 1024 * 1024;
+
+	// the oldest entries are removed, but the last step can be always undone
+	while (usedMemory > memoryLimit && undoBuffer.size() > 1 && level > 1)
 	{
-		cErrorMessage::showMessage(QObject::tr("No more redo"), cErrorMessage::warningMessage);
-		return false;
+		usedMemory -= undoBuffer.first().usedMemory;
+		undoBuffer.removeFirst();
+		level--;
+	}
+}
+
+bool cUndo::IsEqual(const cAnimationFrames &frames1, const cAnimationFrames &frames2)
+{
+	if (frames1.GetNumberOfFrames() != frames2.GetNumberOfFrames()) return false;
+
+	QList<cAnimationFrames::sParameterDescription> parameters1 = frames1.GetListOfParameters();
+	QList<cAnimationFrames::sParameterDescription> parameters2 = frames2.GetListOfParameters();
+	if (parameters1.size() != parameters2.size()) return false;
+	for (int i = 0; i < parameters1.size(); i++)
+	{
+		if (parameters1[i].parameterName != parameters2[i].parameterName
+				|| parameters1[i].containerName != parameters2[i].containerName
+				|| parameters1[i].varType != parameters2[i].varType
+				|| parameters1[i].morphType != parameters2[i].morphType)
+			return false;
+	}
+
+	QList<cAnimationFrames::sAnimationFrame> list1 = frames1.GetFrames();
+	QList<cAnimationFrames::sAnimationFrame> list2 = frames2.GetFrames();
+	for (int i = 0; i < list1.size(); i++)
+	{
+		const cAnimationFrames::sAnimationFrame &frame1 = list1.at(i);
+		const cAnimationFrames::sAnimationFrame &frame2 = list2.at(i);
+		if (frame1.alreadyRendered != frame2.alreadyRendered) return false;
+		if (frame1.thumbnail != frame2.thumbnail) return false;
+		if (!frame1.parameters.IsEqual(frame2.parameters)) return false;
+	}
+	return true;
+}
+
+qint64 cUndo::EstimateMemory(const sContainerChange &change)
+{
+	qint64 bytes = 0;
+	const QMap<QString, cOneParameter> *maps[] = {&change.before, &change.after};
+	for (const QMap<QString, cOneParameter> *map : maps)
+	{
+		for (QMap<QString, cOneParameter>::const_iterator it = map->constBegin();
+				 it != map->constEnd(); ++it)
+		{
+			bytes += sizeof(cOneParameter) + it.key().size() * sizeof(QChar) + 64;
+			enumVarType type = it.value().GetValueType();
+			if (!it.value().IsEmpty() && (type == typeString || type == typeColorPalette))
+				bytes += it.value().Get<QString>(valueActual).size() * sizeof(QChar);
+		}
+	}
+	return bytes;
+}
+
+qint64 cUndo::EstimateMemory(const cAnimationFrames &frames)
+{
+	// data of frames are shared with other copies, so it is the upper limit
+	qint64 bytes = 0;
+	const qint64 parameterSize = sizeof(cOneParameter) + 64;
+	const int numberOfParameters = frames.GetListOfParameters().size();
+	QList<cAnimationFrames::sAnimationFrame> list = frames.GetFrames();
+	for (const cAnimationFrames::sAnimationFrame &frame : list)
+	{
+		bytes += sizeof(cAnimationFrames::sAnimationFrame) + numberOfParameters * parameterSize;
+		bytes += qint64(frame.thumbnail.bytesPerLine()) * frame.thumbnail.height();
 	}
+	return bytes;
 }
@@ -36,6 +36,10 @@
  * The buffer is a simple LIFO buffer which holds the parameter entries.
  * (A Store() invocation while Undo-ed in the list will truncate to the current level
  * and append the new entry. The Redo entries will be lost.)
+ * Only the state at the current level is stored completely. Every entry holds only the
+ * parameters (and animation frames) which were changed in this step, with values before and
+ * after the change. The oldest entries are removed when the buffer exceeds the memory limit
+ * (undo_memory_limit).
  */
 
 #ifndef MANDELBULBER2_SRC_UNDO_H_
@@ -59,20 +63,57 @@ public:
 		cKeyframes *keyframes, bool *refreshFrames, bool *refreshKeyframes);
 	bool Redo(cParameterContainer *par, cFractalContainer *parFractal, cAnimationFrames *frames,
 		cKeyframes *keyframes, bool *refreshFrames, bool *refreshKeyframes);
+	qint64 GetUsedMemory() const { return usedMemory; }
+	int GetNumberOfRecords() const { return undoBuffer.size(); }
 
 private:
+	// parameters changed in one step (empty parameter - parameter didn't exist)
+	struct sContainerChange
+	{
+		QMap<QString, cOneParameter> before;
+		QMap<QString, cOneParameter> after;
+	};
+
+	// animations are stored only if they were changed. Copies share data of unchanged frames
 	struct sUndoRecord
 	{
+		sUndoRecord() : framesChanged(false), keyframesChanged(false), usedMemory(0) {}
+		sContainerChange mainParams;
+		sContainerChange fractParams[NUMBER_OF_FRACTALS];
+		cAnimationFrames framesBefore;
+		cAnimationFrames framesAfter;
+		cKeyframes keyframesBefore;
+		cKeyframes keyframesAfter;
+		bool framesChanged;
+		bool keyframesChanged;
+		qint64 usedMemory;
+	};
+
+	// complete state at actual undo level
+	struct sUndoState
+	{
+		sUndoState() : hasFrames(false), hasKeyframes(false), stored(false) {}
 		cParameterContainer mainParams;
 		cFractalContainer fractParams;
 		cAnimationFrames animationFrames;
 		cKeyframes animationKeyframes;
 		bool hasFrames;
 		bool hasKeyframes;
+		bool stored;
 	};
 
+	void Apply(const sUndoRecord &record, bool redo, cParameterContainer *par,
+		cFractalContainer *parFractal, cAnimationFrames *frames, cKeyframes *keyframes,
+		bool *refreshFrames, bool *refreshKeyframes);
+	void LimitMemory();
+	static bool IsEqual(const cAnimationFrames &frames1, const cAnimationFrames &frames2);
+	static qint64 EstimateMemory(const sContainerChange &change);
+	static qint64 EstimateMemory(const cAnimationFrames &frames);
+
 	QList<sUndoRecord> undoBuffer;
+	sUndoState actualState;
 	int level;
+	qint64 usedMemory;
 };
 
 extern cUndo gUndo;
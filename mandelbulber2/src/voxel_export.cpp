@@ -39,6 +39,8 @@
 
 #include "voxel_export.hpp"
 
+#include <vector>
+
 #include <QScopedPointer>
 #include <QVector>
 #include <QtCore>
@@ -55,6 +57,7 @@
 #include "opencl_global.h"
 #include "progress_text.hpp"
 #include "render_data.hpp"
+#include "sparse_voxel_plane.hpp"
 
 cVoxelExport::cVoxelExport(
 	int w, int h, int l, CVector3 limitMin, CVector3 limitMax, QDir folder, int maxIter)
@@ -143,12 +146,15 @@ void cVoxelExport::ProcessVolume()
 			gOpenCl->openClEngineRenderFractal->Unlock();
 			return;
 		}
-
-		voxelDistances.reset(new double[w * h]);
 	}
 
 #endif // USE_OPENCL
 
+	voxelDistances.reset(new double[w * h]);
+
+	cSparseVoxelPlane voxelPlane(params.data(), fractals.data(), renderData.data(), dist_thresh,
+		dMax(stepX, stepY, stepZ), gPar->Get<bool>("voxel_skip_empty_space"));
+
 	for (long long z = 0; z < l; z++)
 	{
 		const QString statusText =
@@ -184,26 +190,20 @@ void cVoxelExport::ProcessVolume()
 
 		if (!openClEnabled)
 		{
-#pragma omp parallel for schedule( \
-	dynamic, 1) // long long is used because size_t doesn't work with msvc and OpenMP
-			for (long long x = 0; x < w; x++)
+			sVoxelPlane plane;
+			plane.origin = CVector3(limitMin.x, limitMin.y, limitMin.z + z * stepZ);
+			plane.stepU = CVector3(stepX, 0.0, 0.0);
+			plane.stepV = CVector3(0.0, stepY, 0.0);
+			plane.sizeU = w;
+			plane.sizeV = h;
+			plane.strideU = 1;
+			plane.strideV = w;
+			voxelPlane.Calculate(plane, voxelDistances.data(), nullptr, &stop);
+
+			for (long long address = 0; address < w * h; address++)
 			{
-				CVector3 point;
-				for (long long y = 0; y < h; y++)
-				{
-					if (stop) break;
-					point.x = limitMin.x + x * stepX;
-					point.y = limitMin.y + y * stepY;
-					point.z = limitMin.z + z * stepZ;
-
-					sDistanceOut distanceOut;
-					const sDistanceIn distanceIn(point, dist_thresh, false);
-
-					const double dist = CalculateDistance(*params, *fractals, distanceIn, &distanceOut);
-
-					voxelLayer[x + y * w] = static_cast<unsigned char>(dist <= dist_thresh);
-				} // for y
-			}		// for x
+				voxelLayer[address] = static_cast<unsigned char>(voxelDistances[address] <= dist_thresh);
+			}
 		}			// if not openClEnabled
 
 		if (stop || !StoreLayer(z))
@@ -220,6 +220,14 @@ void cVoxelExport::ProcessVolume()
 	}
 #endif // USE_OPENCL
 
+	if (!openClEnabled)
+	{
+		WriteLog(QString("Voxel export: %1 voxels calculated, %2 voxels skipped as empty space")
+							 .arg(voxelPlane.GetNumberOfCalculatedVoxels())
+							 .arg(voxelPlane.GetNumberOfSkippedVoxels()),
+			2);
+	}
+
 	QString statusText;
 	if (stop)
 		statusText = tr("Voxel Export finished - Cancelled export");